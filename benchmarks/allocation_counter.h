@@ -0,0 +1,77 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#ifndef UR_CLIENT_LIBRARY_BENCHMARKS_ALLOCATION_COUNTER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_BENCHMARKS_ALLOCATION_COUNTER_H_INCLUDED
+
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+
+namespace urcl
+{
+namespace benchmarks
+{
+/*!
+ * \brief Getter for the number of heap allocations done through operator new by all threads since
+ * program start.
+ *
+ * \returns The number of allocations
+ */
+size_t getNumAllocations();
+
+/*!
+ * \brief Reports the average number of heap allocations per iteration of a benchmark as
+ * "allocs/op" counter. Create it right before the benchmark loop, the counter is set on
+ * destruction.
+ */
+class AllocationCounter
+{
+public:
+  explicit AllocationCounter(benchmark::State& state) : state_(state), start_(getNumAllocations())
+  {
+  }
+
+  ~AllocationCounter()
+  {
+    state_.counters["allocs/op"] =
+        benchmark::Counter(static_cast<double>(getNumAllocations() - start_), benchmark::Counter::kAvgIterations);
+  }
+
+private:
+  benchmark::State& state_;
+  size_t start_;
+};
+
+}  // namespace benchmarks
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_BENCHMARKS_ALLOCATION_COUNTER_H_INCLUDED
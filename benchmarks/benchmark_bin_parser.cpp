@@ -0,0 +1,132 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include <benchmark/benchmark.h>
+
+#include <vector>
+
+#include "allocation_counter.h"
+#include "ur_client_library/comm/bin_parser.h"
+
+using namespace urcl;
+
+namespace
+{
+std::vector<uint8_t> createBuffer(size_t size)
+{
+  std::vector<uint8_t> buffer(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    buffer[i] = static_cast<uint8_t>(i * 37 + 11) & 0x3f;
+  }
+  return buffer;
+}
+
+// Parses a buffer full of values of type T one by one
+template <typename T>
+void parseValues(benchmark::State& state)
+{
+  const size_t count = 64;
+  std::vector<uint8_t> buffer = createBuffer(count * sizeof(T));
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    comm::BinParser bp(buffer.data(), buffer.size());
+    for (size_t i = 0; i < count; ++i)
+    {
+      T val;
+      bp.parse(val);
+      benchmark::DoNotOptimize(val);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * count);
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+}  // namespace
+
+static void BM_BinParserParseUint8(benchmark::State& state)
+{
+  parseValues<uint8_t>(state);
+}
+BENCHMARK(BM_BinParserParseUint8);
+
+static void BM_BinParserParseBool(benchmark::State& state)
+{
+  parseValues<bool>(state);
+}
+BENCHMARK(BM_BinParserParseBool);
+
+static void BM_BinParserParseInt32(benchmark::State& state)
+{
+  parseValues<int32_t>(state);
+}
+BENCHMARK(BM_BinParserParseInt32);
+
+static void BM_BinParserParseUint64(benchmark::State& state)
+{
+  parseValues<uint64_t>(state);
+}
+BENCHMARK(BM_BinParserParseUint64);
+
+static void BM_BinParserParseDouble(benchmark::State& state)
+{
+  parseValues<double>(state);
+}
+BENCHMARK(BM_BinParserParseDouble);
+
+static void BM_BinParserParseVector6d(benchmark::State& state)
+{
+  parseValues<vector6d_t>(state);
+}
+BENCHMARK(BM_BinParserParseVector6d);
+
+static void BM_BinParserParseVector6int32(benchmark::State& state)
+{
+  parseValues<vector6int32_t>(state);
+}
+BENCHMARK(BM_BinParserParseVector6int32);
+
+static void BM_BinParserParseString(benchmark::State& state)
+{
+  // Length prefixed strings, as used in primary interface messages
+  std::vector<uint8_t> buffer(64, 'a');
+  buffer[0] = 63;
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    comm::BinParser bp(buffer.data(), buffer.size());
+    std::string val;
+    bp.parse(val);
+    benchmark::DoNotOptimize(val);
+  }
+  state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_BinParserParseString);
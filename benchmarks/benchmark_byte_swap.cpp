@@ -0,0 +1,127 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include <benchmark/benchmark.h>
+
+#include <endian.h>
+#include <cstring>
+#include <vector>
+
+#include "ur_client_library/comm/bin_parser.h"
+#include "ur_client_library/comm/byte_swap.h"
+
+using namespace urcl;
+
+namespace
+{
+// Converts values one by one, as BinParser did before using the bulk conversion
+void swapBytes64OneByOne(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint64_t val;
+    std::memcpy(&val, src + i * sizeof(val), sizeof(val));
+    val = be64toh(val);
+    std::memcpy(dst + i * sizeof(val), &val, sizeof(val));
+  }
+}
+
+std::vector<uint8_t> createBuffer(size_t size)
+{
+  std::vector<uint8_t> buffer(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    buffer[i] = static_cast<uint8_t>(i * 31 + 7);
+  }
+  return buffer;
+}
+}  // namespace
+
+static void BM_SwapBytes64Scalar(benchmark::State& state)
+{
+  const size_t count = state.range(0);
+  std::vector<uint8_t> src = createBuffer(count * 8);
+  std::vector<uint8_t> dst(count * 8);
+  for (auto _ : state)
+  {
+    swapBytes64OneByOne(src.data(), dst.data(), count);
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * count * 8);
+}
+BENCHMARK(BM_SwapBytes64Scalar)->Arg(6)->Arg(48)->Arg(512);
+
+static void BM_SwapBytes64(benchmark::State& state)
+{
+  const size_t count = state.range(0);
+  std::vector<uint8_t> src = createBuffer(count * 8);
+  std::vector<uint8_t> dst(count * 8);
+  for (auto _ : state)
+  {
+    comm::swapBytes64(src.data(), dst.data(), count);
+    benchmark::DoNotOptimize(dst.data());
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * count * 8);
+  state.SetLabel(comm::getByteSwapKernel());
+}
+BENCHMARK(BM_SwapBytes64)->Arg(6)->Arg(48)->Arg(512);
+
+static void BM_ParseVector6dScalar(benchmark::State& state)
+{
+  std::vector<uint8_t> buffer = createBuffer(sizeof(vector6d_t));
+  vector6d_t val;
+  for (auto _ : state)
+  {
+    comm::BinParser bp(buffer.data(), buffer.size());
+    for (auto& element : val)
+    {
+      bp.parse(element);
+    }
+    benchmark::DoNotOptimize(val);
+  }
+}
+BENCHMARK(BM_ParseVector6dScalar);
+
+static void BM_ParseVector6d(benchmark::State& state)
+{
+  std::vector<uint8_t> buffer = createBuffer(sizeof(vector6d_t));
+  vector6d_t val;
+  for (auto _ : state)
+  {
+    comm::BinParser bp(buffer.data(), buffer.size());
+    bp.parse(val);
+    benchmark::DoNotOptimize(val);
+  }
+  state.SetLabel(comm::getByteSwapKernel());
+}
+BENCHMARK(BM_ParseVector6d);
@@ -0,0 +1,141 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "allocation_counter.h"
+#include "ur_client_library/comm/tcp_socket.h"
+#include "ur_client_library/control/reverse_interface.h"
+#include "ur_client_library/control/trajectory_point_interface.h"
+
+using namespace urcl;
+
+namespace
+{
+// Connects to a server and discards everything it receives, so the server never blocks on writing
+class DrainingClient : public comm::TCPSocket
+{
+public:
+  explicit DrainingClient(const int port) : running_(true)
+  {
+    timeval tv;
+    tv.tv_sec = 0;
+    tv.tv_usec = 100000;
+    TCPSocket::setReceiveTimeout(tv);
+    TCPSocket::setup("127.0.0.1", port);
+    thread_ = std::thread([this]() {
+      uint8_t buffer[4096];
+      size_t read;
+      while (running_)
+      {
+        TCPSocket::read(buffer, sizeof(buffer), read);
+      }
+    });
+  }
+
+  ~DrainingClient()
+  {
+    running_ = false;
+    thread_.join();
+    close();
+  }
+
+private:
+  std::atomic<bool> running_;
+  std::thread thread_;
+};
+
+// Waits for the server side to accept the client connection
+template <typename WriteFunction>
+bool waitForConnection(WriteFunction write)
+{
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (!write())
+  {
+    if (std::chrono::steady_clock::now() > deadline)
+    {
+      return false;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return true;
+}
+}  // namespace
+
+static void BM_ReverseInterfaceWrite(benchmark::State& state)
+{
+  control::ReverseInterface reverse_interface(50101, [](bool) {}, std::chrono::milliseconds(2));
+  DrainingClient client(50101);
+  vector6d_t positions = { 1.2, 3.1, 2.2, -3.4, -1.1, -1.2 };
+  auto write = [&]() { return reverse_interface.write(&positions, comm::ControlMode::MODE_SERVOJ); };
+  if (!waitForConnection(write))
+  {
+    state.SkipWithError("Client could not connect to the reverse interface");
+    return;
+  }
+
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(write());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ReverseInterfaceWrite);
+
+static void BM_TrajectoryPointInterfaceWriteSplinePoint(benchmark::State& state)
+{
+  control::TrajectoryPointInterface trajectory_interface(50102);
+  DrainingClient client(50102);
+  vector6d_t positions = { 1.2, 3.1, 2.2, -1.4, -2.1, -3.2 };
+  vector6d_t velocities = { 0.1, 0.2, 0.3, -0.1, -0.2, -0.3 };
+  vector6d_t accelerations = { 3.2, 1.1, 1.2, -3.4, -1.1, -1.2 };
+  auto write = [&]() {
+    return trajectory_interface.writeTrajectorySplinePoint(&positions, &velocities, &accelerations, 0.5);
+  };
+  if (!waitForConnection(write))
+  {
+    state.SkipWithError("Client could not connect to the trajectory point interface");
+    return;
+  }
+
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    benchmark::DoNotOptimize(write());
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TrajectoryPointInterfaceWriteSplinePoint);
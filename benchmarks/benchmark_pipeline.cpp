@@ -0,0 +1,140 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "canned_data.h"
+#include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/rtde/rtde_parser.h"
+
+using namespace urcl;
+
+namespace
+{
+// Parses a canned data package each time a package is requested
+class CannedDataProducer : public comm::IProducer<rtde_interface::RTDEPackage>
+{
+public:
+  CannedDataProducer(rtde_interface::RTDEParser& parser)
+    : parser_(parser)
+    , capture_(benchmarks::createDataPackageCapture(benchmarks::OUTPUT_RECIPE))
+    , requested_(0)
+    , running_(false)
+  {
+  }
+
+  void startProducer() override
+  {
+    running_ = true;
+  }
+
+  void stopProducer() override
+  {
+    running_ = false;
+  }
+
+  bool tryGet(std::vector<std::unique_ptr<rtde_interface::RTDEPackage>>& products) override
+  {
+    while (running_ && requested_ == 0)
+    {
+      std::this_thread::yield();
+    }
+    if (!running_)
+    {
+      return true;
+    }
+    requested_--;
+    comm::BinParser bp(capture_.data(), capture_.size());
+    return parser_.parse(bp, products);
+  }
+
+  void recycle(std::unique_ptr<rtde_interface::RTDEPackage> product) override
+  {
+    parser_.recycle(std::move(product));
+  }
+
+  void requestPackage()
+  {
+    requested_++;
+  }
+
+private:
+  rtde_interface::RTDEParser& parser_;
+  std::vector<uint8_t> capture_;
+  std::atomic<int> requested_;
+  std::atomic<bool> running_;
+};
+}  // namespace
+
+// Hands one package through a running pipeline per iteration
+static void BM_PipelineRoundTrip(benchmark::State& state)
+{
+  rtde_interface::RTDEParser parser(benchmarks::OUTPUT_RECIPE);
+  parser.setProtocolVersion(2);
+  CannedDataProducer producer(parser);
+  comm::INotifier notifier;
+  const comm::PipelineTransport transport =
+      state.range(0) == 0 ? comm::PipelineTransport::QUEUE : comm::PipelineTransport::LATEST_VALUE;
+  comm::Pipeline<rtde_interface::RTDEPackage> pipeline(producer, "RTDE_PIPELINE", notifier, false, transport);
+  pipeline.init();
+  pipeline.run();
+
+  std::unique_ptr<rtde_interface::RTDEPackage> package;
+  // Fill the package pool before measuring
+  for (size_t i = 0; i < 5; ++i)
+  {
+    producer.requestPackage();
+    pipeline.getLatestProduct(package, std::chrono::milliseconds(1000));
+  }
+
+  {
+    benchmarks::AllocationCounter allocations(state);
+    for (auto _ : state)
+    {
+      producer.requestPackage();
+      if (!pipeline.getLatestProduct(package, std::chrono::milliseconds(1000)))
+      {
+        state.SkipWithError("No package received from pipeline");
+        break;
+      }
+    }
+  }
+  pipeline.stop();
+  state.SetItemsProcessed(state.iterations());
+  state.SetLabel(transport == comm::PipelineTransport::QUEUE ? "queue" : "latest_value");
+}
+BENCHMARK(BM_PipelineRoundTrip)->Arg(0)->Arg(1)->UseRealTime();
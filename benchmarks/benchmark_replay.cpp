@@ -0,0 +1,82 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include <benchmark/benchmark.h>
+
+#include <cstdio>
+#include <memory>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "canned_data.h"
+#include "ur_client_library/comm/replay_producer.h"
+#include "ur_client_library/rtde/rtde_parser.h"
+#include "ur_client_library/rtde/rtde_recorder.h"
+
+using namespace urcl;
+
+static void BM_ReplayRTDERecording(benchmark::State& state)
+{
+  const std::string filename = "benchmark_replay.urcl";
+  std::vector<uint8_t> capture = benchmarks::createDataPackageCapture(benchmarks::OUTPUT_RECIPE);
+  {
+    // Ten seconds of data at 500 Hz
+    comm::RecordingWriter writer(filename, comm::RecordingType::RTDE, 2,
+                                 rtde_interface::RTDERecorder::recipeToMetadata(benchmarks::OUTPUT_RECIPE));
+    for (size_t i = 0; i < 5000; ++i)
+    {
+      writer.append(std::chrono::steady_clock::time_point(std::chrono::milliseconds(2 * i)), capture.data(),
+                    capture.size());
+    }
+  }
+
+  comm::RecordingReader reader(filename);
+  rtde_interface::RTDEParser parser(benchmarks::OUTPUT_RECIPE);
+  parser.setProtocolVersion(2);
+  comm::ReplayProducer<rtde_interface::RTDEPackage> producer(reader, parser, comm::ReplayTiming::AS_FAST_AS_POSSIBLE);
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  products.reserve(1);
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    if (!producer.tryGet(products))
+    {
+      reader.rewind();
+      continue;
+    }
+    producer.recycle(std::move(products.front()));
+    products.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * capture.size());
+  state.SetItemsProcessed(state.iterations());
+  std::remove(filename.c_str());
+}
+BENCHMARK(BM_ReplayRTDERecording);
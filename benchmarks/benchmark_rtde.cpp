@@ -0,0 +1,155 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include "allocation_counter.h"
+#include "canned_data.h"
+#include "ur_client_library/rtde/recipe.h"
+#include "ur_client_library/rtde/rtde_parser.h"
+
+using namespace urcl;
+
+namespace
+{
+using namespace rtde_interface::fields;
+// Same fields as OUTPUT_RECIPE, known at compile time
+using TypedOutputRecipe =
+    rtde_interface::Recipe<Timestamp, ActualQ, ActualQd, SpeedScaling, TargetSpeedFraction, RuntimeState,
+                           ActualTCPForce, ActualTCPPose, ActualDigitalInputBits, ActualDigitalOutputBits,
+                           StandardAnalogInput0, StandardAnalogInput1, StandardAnalogOutput0, StandardAnalogOutput1,
+                           AnalogIoTypes, ToolMode, ToolAnalogInputTypes, ToolAnalogInput0, ToolAnalogInput1,
+                           ToolOutputVoltage, ToolOutputCurrent, ToolTemperature, RobotMode, SafetyMode,
+                           RobotStatusBits, SafetyStatusBits, ActualCurrent, TcpOffset>;
+
+void parseDataPackage(benchmark::State& state, std::shared_ptr<const rtde_interface::DataPackage::RecipeLayout> layout)
+{
+  std::vector<uint8_t> capture = benchmarks::createDataPackageCapture(benchmarks::OUTPUT_RECIPE);
+  rtde_interface::DataPackage package(layout);
+  // Skip the package header, as it is parsed by the RTDEParser
+  const size_t header_size = sizeof(uint16_t) + sizeof(uint8_t);
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    comm::BinParser bp(capture.data() + header_size, capture.size() - header_size);
+    benchmark::DoNotOptimize(package.parseWith(bp));
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * capture.size());
+}
+}  // namespace
+
+static void BM_RTDEParserParse(benchmark::State& state)
+{
+  std::vector<uint8_t> capture = benchmarks::createDataPackageCapture(benchmarks::OUTPUT_RECIPE);
+  rtde_interface::RTDEParser parser(benchmarks::OUTPUT_RECIPE);
+  parser.setProtocolVersion(2);
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  products.reserve(1);
+  const bool recycle = state.range(0) != 0;
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    comm::BinParser bp(capture.data(), capture.size());
+    benchmark::DoNotOptimize(parser.parse(bp, products));
+    if (recycle)
+    {
+      parser.recycle(std::move(products.front()));
+    }
+    products.clear();
+  }
+  state.SetBytesProcessed(state.iterations() * capture.size());
+  state.SetItemsProcessed(state.iterations());
+}
+// Without and with recycling the parsed packages
+BENCHMARK(BM_RTDEParserParse)->Arg(0)->Arg(1);
+
+static void BM_DataPackageParseWith(benchmark::State& state)
+{
+  parseDataPackage(state, std::make_shared<const rtde_interface::DataPackage::RecipeLayout>(benchmarks::OUTPUT_RECIPE));
+}
+BENCHMARK(BM_DataPackageParseWith);
+
+static void BM_DataPackageParseWithTypedRecipe(benchmark::State& state)
+{
+  parseDataPackage(state, TypedOutputRecipe::getLayout());
+}
+BENCHMARK(BM_DataPackageParseWithTypedRecipe);
+
+static void BM_DataPackageGetDataByName(benchmark::State& state)
+{
+  rtde_interface::DataPackage package(benchmarks::OUTPUT_RECIPE);
+  package.initEmpty();
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    vector6d_t actual_q;
+    package.getData("actual_q", actual_q);
+    benchmark::DoNotOptimize(actual_q);
+  }
+}
+BENCHMARK(BM_DataPackageGetDataByName);
+
+static void BM_DataPackageGetDataByHandle(benchmark::State& state)
+{
+  rtde_interface::DataPackage package(benchmarks::OUTPUT_RECIPE);
+  package.initEmpty();
+  auto handle = package.getRecipeLayout()->getFieldHandle<vector6d_t>("actual_q");
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    vector6d_t actual_q;
+    package.getData(handle, actual_q);
+    benchmark::DoNotOptimize(actual_q);
+  }
+}
+BENCHMARK(BM_DataPackageGetDataByHandle);
+
+static void BM_DataPackageSerialize(benchmark::State& state)
+{
+  rtde_interface::DataPackage package(benchmarks::INPUT_RECIPE);
+  package.initEmpty();
+  package.setRecipeID(1);
+  uint8_t buffer[4096];
+  size_t size = 0;
+  benchmarks::AllocationCounter allocations(state);
+  for (auto _ : state)
+  {
+    size = package.serializePackage(buffer);
+    benchmark::DoNotOptimize(buffer);
+    benchmark::ClobberMemory();
+  }
+  state.SetBytesProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_DataPackageSerialize);
@@ -0,0 +1,120 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#ifndef UR_CLIENT_LIBRARY_BENCHMARKS_CANNED_DATA_H_INCLUDED
+#define UR_CLIENT_LIBRARY_BENCHMARKS_CANNED_DATA_H_INCLUDED
+
+#include <string>
+#include <vector>
+
+#include "ur_client_library/comm/package_serializer.h"
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace benchmarks
+{
+// Output recipe used by the ROS drivers
+const std::vector<std::string> OUTPUT_RECIPE = { "timestamp",
+                                                 "actual_q",
+                                                 "actual_qd",
+                                                 "speed_scaling",
+                                                 "target_speed_fraction",
+                                                 "runtime_state",
+                                                 "actual_TCP_force",
+                                                 "actual_TCP_pose",
+                                                 "actual_digital_input_bits",
+                                                 "actual_digital_output_bits",
+                                                 "standard_analog_input0",
+                                                 "standard_analog_input1",
+                                                 "standard_analog_output0",
+                                                 "standard_analog_output1",
+                                                 "analog_io_types",
+                                                 "tool_mode",
+                                                 "tool_analog_input_types",
+                                                 "tool_analog_input0",
+                                                 "tool_analog_input1",
+                                                 "tool_output_voltage",
+                                                 "tool_output_current",
+                                                 "tool_temperature",
+                                                 "robot_mode",
+                                                 "safety_mode",
+                                                 "robot_status_bits",
+                                                 "safety_status_bits",
+                                                 "actual_current",
+                                                 "tcp_offset" };
+
+// Input recipe used by the ROS drivers
+const std::vector<std::string> INPUT_RECIPE = { "speed_slider_mask",
+                                                "speed_slider_fraction",
+                                                "standard_digital_output_mask",
+                                                "standard_digital_output",
+                                                "configurable_digital_output_mask",
+                                                "configurable_digital_output",
+                                                "tool_digital_output_mask",
+                                                "tool_digital_output",
+                                                "standard_analog_output_mask",
+                                                "standard_analog_output_type",
+                                                "standard_analog_output_0",
+                                                "standard_analog_output_1" };
+
+/*!
+ * \brief Creates a serialized RTDE data package (protocol version 2) for the given recipe, as it
+ * would be received from the robot. The field values are an arbitrary but fixed byte pattern.
+ *
+ * \param recipe The recipe of the package
+ *
+ * \returns The serialized package including its header
+ */
+inline std::vector<uint8_t> createDataPackageCapture(const std::vector<std::string>& recipe)
+{
+  rtde_interface::DataPackage::RecipeLayout layout(recipe);
+  // Package size, package type and recipe id
+  constexpr size_t header_size = sizeof(uint16_t) + sizeof(rtde_interface::PackageType) + sizeof(uint8_t);
+  const uint16_t size = static_cast<uint16_t>(header_size + layout.getStorageSize());
+  uint8_t header[header_size];
+  size_t offset = comm::PackageSerializer::serialize(header, size);
+  offset += comm::PackageSerializer::serialize(header + offset, rtde_interface::PackageType::RTDE_DATA_PACKAGE);
+  offset += comm::PackageSerializer::serialize(header + offset, static_cast<uint8_t>(1));  // recipe id
+
+  std::vector<uint8_t> buffer(header, header + header_size);
+  buffer.resize(size);
+  for (size_t i = offset; i < buffer.size(); ++i)
+  {
+    buffer[i] = static_cast<uint8_t>(i * 37 + 11) & 0x3f;
+  }
+  return buffer;
+}
+
+}  // namespace benchmarks
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_BENCHMARKS_CANNED_DATA_H_INCLUDED
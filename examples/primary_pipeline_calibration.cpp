@@ -78,8 +78,10 @@ int main(int argc, char* argv[])
   // First of all, we need a stream that connects to the robot
   comm::URStream<primary_interface::PrimaryPackage> primary_stream(robot_ip, urcl::primary_interface::UR_PRIMARY_PORT);
 
-  // This will parse the primary packages
+  // This will parse the primary packages. As we are only interested in the calibration, all other
+  // packages are skipped without being decoded.
   primary_interface::PrimaryParser parser;
+  parser.subscribe({ primary_interface::RobotStateType::KINEMATICS_INFO });
 
   // The producer needs both, the stream and the parser to fully work
   comm::URProducer<primary_interface::PrimaryPackage> prod(primary_stream, parser);
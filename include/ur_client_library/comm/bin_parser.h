@@ -29,9 +29,11 @@
 #include <cstring>
 #include <string>
 #include <memory>
+#include <type_traits>
 #include "ur_client_library/log.h"
 #include "ur_client_library/types.h"
 #include "ur_client_library/exceptions.h"
+#include "ur_client_library/comm/byte_swap.h"
 
 namespace urcl
 {
@@ -78,6 +80,29 @@ private:
     return be64toh(val);
   }
 
+  // Below this number of values, converting them inline is faster than calling the bulk conversion
+  static const size_t MIN_BULK_COUNT = 4;
+
+  template <typename T>
+  void swapBytesInline(uint8_t* target, size_t count)
+  {
+    for (size_t i = 0; i < count; ++i)
+    {
+      T val;
+      std::memcpy(&val, buf_pos_ + i * sizeof(T), sizeof(T));
+      val = decode(val);
+      std::memcpy(target + i * sizeof(T), &val, sizeof(T));
+    }
+  }
+
+  void ensureAvailable(size_t bytes)
+  {
+    if (buf_pos_ + bytes > buf_end_)
+      throw UrException("Could not parse received package. This can occur if the driver is started while the robot is "
+                        "booting - please restart the driver once the robot has finished booting. "
+                        "If the problem persists after the robot has booted, please contact the package maintainer.");
+  }
+
 public:
   /*!
    * \brief Creates a new BinParser object from a given buffer.
@@ -120,10 +145,7 @@ public:
   template <typename T>
   T peek()
   {
-    if (buf_pos_ + sizeof(T) > buf_end_)
-      throw UrException("Could not parse received package. This can occur if the driver is started while the robot is "
-                        "booting - please restart the driver once the robot has finished booting. "
-                        "If the problem persists after the robot has booted, please contact the package maintainer.");
+    ensureAvailable(sizeof(T));
     T val;
     std::memcpy(&val, buf_pos_, sizeof(T));
     return decode(val);
@@ -188,10 +210,7 @@ public:
    */
   void parse(vector3d_t& val)
   {
-    for (size_t i = 0; i < val.size(); ++i)
-    {
-      parse(val[i]);
-    }
+    parseArray(val.data(), val.size());
   }
 
   /*!
@@ -201,10 +220,7 @@ public:
    */
   void parse(vector6d_t& val)
   {
-    for (size_t i = 0; i < val.size(); ++i)
-    {
-      parse(val[i]);
-    }
+    parseArray(val.data(), val.size());
   }
 
   /*!
@@ -214,10 +230,7 @@ public:
    */
   void parse(vector6int32_t& val)
   {
-    for (size_t i = 0; i < val.size(); ++i)
-    {
-      parse(val[i]);
-    }
+    parseArray(val.data(), val.size());
   }
 
   /*!
@@ -227,10 +240,7 @@ public:
    */
   void parse(vector6uint32_t& val)
   {
-    for (size_t i = 0; i < val.size(); ++i)
-    {
-      parse(val[i]);
-    }
+    parseArray(val.data(), val.size());
   }
 
   /*!
@@ -291,10 +301,76 @@ public:
   template <typename T, size_t N>
   void parse(std::array<T, N>& array)
   {
-    for (size_t i = 0; i < N; i++)
+    if constexpr (std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8))
+    {
+      parseArray(array.data(), N);
+    }
+    else
+    {
+      for (size_t i = 0; i < N; i++)
+      {
+        parse(array[i]);
+      }
+    }
+  }
+
+  /*!
+   * \brief Parses the next bytes as a contiguous sequence of values of a given type. All values are
+   * converted at once, which is considerably faster than parsing them one by one.
+   *
+   * @tparam T Type of the values, has to be an arithmetic type of 4 or 8 bytes
+   * \param values Pointer to the first of count values to parse to
+   * \param count Number of values to parse
+   */
+  template <typename T>
+  void parseArray(T* values, size_t count)
+  {
+    static_assert(std::is_arithmetic<T>::value && (sizeof(T) == 4 || sizeof(T) == 8),
+                  "Only arithmetic types of 4 or 8 bytes can be parsed as array");
+    parseArray(reinterpret_cast<uint8_t*>(values), sizeof(T), count);
+  }
+
+  /*!
+   * \brief Parses the next bytes as a contiguous sequence of big endian values and stores them in
+   * host encoding. The target buffer doesn't have to be aligned.
+   *
+   * \param target Buffer of at least value_size * count bytes to parse to
+   * \param value_size Size of each value in bytes. Values of 1, 4 or 8 bytes are supported.
+   * \param count Number of values to parse
+   */
+  void parseArray(uint8_t* target, size_t value_size, size_t count)
+  {
+    const size_t num_bytes = value_size * count;
+    ensureAvailable(num_bytes);
+    switch (value_size)
     {
-      parse(array[i]);
+      case 8:
+        if (count < MIN_BULK_COUNT)
+        {
+          swapBytesInline<uint64_t>(target, count);
+        }
+        else
+        {
+          swapBytes64(buf_pos_, target, count);
+        }
+        break;
+      case 4:
+        if (count < MIN_BULK_COUNT)
+        {
+          swapBytesInline<uint32_t>(target, count);
+        }
+        else
+        {
+          swapBytes32(buf_pos_, target, count);
+        }
+        break;
+      case 1:
+        std::memcpy(target, buf_pos_, num_bytes);
+        break;
+      default:
+        throw UrException("Parsing arrays of " + std::to_string(value_size) + " byte values is not supported");
     }
+    buf_pos_ += num_bytes;
   }
 
   /*!
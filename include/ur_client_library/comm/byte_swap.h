@@ -0,0 +1,80 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#ifndef UR_CLIENT_LIBRARY_BYTE_SWAP_H_INCLUDED
+#define UR_CLIENT_LIBRARY_BYTE_SWAP_H_INCLUDED
+
+#include <cstddef>
+#include <cstdint>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Converts a sequence of 64 bit values between network encoding (big endian) and host
+ * encoding.
+ *
+ * Depending on the CPU, the conversion is done using AVX2 or SSSE3 shuffles with a scalar
+ * fallback. Neither buffer has to be aligned. Source and destination may be identical, but must not
+ * overlap otherwise.
+ *
+ * \param src Buffer containing count values
+ * \param dst Buffer to write count converted values to
+ * \param count Number of values to convert
+ */
+void swapBytes64(const uint8_t* src, uint8_t* dst, size_t count);
+
+/*!
+ * \brief Converts a sequence of 32 bit values between network encoding (big endian) and host
+ * encoding.
+ *
+ * Depending on the CPU, the conversion is done using AVX2 or SSSE3 shuffles with a scalar
+ * fallback. Neither buffer has to be aligned. Source and destination may be identical, but must not
+ * overlap otherwise.
+ *
+ * \param src Buffer containing count values
+ * \param dst Buffer to write count converted values to
+ * \param count Number of values to convert
+ */
+void swapBytes32(const uint8_t* src, uint8_t* dst, size_t count);
+
+/*!
+ * \brief Getter for the name of the conversion kernel selected for this CPU.
+ *
+ * \returns "avx2", "ssse3" or "scalar"
+ */
+const char* getByteSwapKernel();
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_BYTE_SWAP_H_INCLUDED
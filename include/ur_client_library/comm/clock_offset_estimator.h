@@ -0,0 +1,171 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_CLOCK_OFFSET_ESTIMATOR_H_INCLUDED
+#define UR_CLIENT_LIBRARY_CLOCK_OFFSET_ESTIMATOR_H_INCLUDED
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Relation between the robot controller's clock and the host's monotonic clock as estimated
+ * by a ClockOffsetEstimator.
+ */
+struct ClockOffsetEstimate
+{
+  //! Number of samples the estimate is based on. The estimate is only valid if this is at least 2.
+  size_t num_samples = 0;
+  //! Robot time in seconds the estimate refers to. This is the robot time of the latest sample.
+  double robot_time = 0.0;
+  //! Host time corresponding to robot_time, i.e. robot_time + offset
+  std::chrono::steady_clock::time_point host_time;
+  //! Difference between host time and robot time at robot_time
+  std::chrono::nanoseconds offset{ 0 };
+  //! Rate at which the host clock runs faster than the robot clock, e.g. 1e-6 for one microsecond
+  //! per second
+  double drift = 0.0;
+  //! Standard deviation of the samples' transport delay around the estimated relation
+  std::chrono::nanoseconds jitter{ 0 };
+};
+
+/*!
+ * \brief Estimates the offset and drift between the robot controller's clock and the host's
+ * monotonic clock.
+ *
+ * Each sample pairs a timestamp reported by the robot with the point in time at which the host
+ * received it. As samples are taken at the receiving side, they contain the transport delay from
+ * the controller to the host, which is increased by queuing, e.g. after the receiving thread wasn't
+ * scheduled for a while. Therefore, the latest samples are split into ten segments and the estimate
+ * is a least-squares line fit over the sample with the smallest delay of each segment. The offset
+ * contains the minimum transport delay, the spread of the delay is reported as jitter.
+ *
+ * If the robot time jumps backwards, e.g. because the controller got restarted, all previous
+ * samples are discarded. Samples can be added and estimates can be read from different threads.
+ * Adding a sample takes constant time, the estimate is calculated outside of the lock shared with
+ * addSample().
+ */
+class ClockOffsetEstimator
+{
+public:
+  /*!
+   * \brief Creates a new ClockOffsetEstimator.
+   *
+   * \param window_size Number of latest samples the estimate is based on. At least two samples
+   * are used. Samples are discarded a segment at a time, so right after that, up to a tenth of the
+   * window is missing.
+   */
+  explicit ClockOffsetEstimator(const size_t window_size = 1000);
+
+  /*!
+   * \brief Adds a sample to the estimator.
+   *
+   * \param robot_time Timestamp reported by the robot in seconds
+   * \param host_time Point in time at which the timestamp was received on the host
+   */
+  void addSample(const double robot_time, const std::chrono::steady_clock::time_point host_time);
+
+  /*!
+   * \brief Discards all samples.
+   */
+  void reset();
+
+  /*!
+   * \brief Calculates the current estimate.
+   *
+   * \returns The estimate. If less than two samples are available, num_samples is below two and the
+   * remaining values are zero.
+   */
+  ClockOffsetEstimate getEstimate() const;
+
+  /*!
+   * \brief Converts a robot timestamp to the host's monotonic clock.
+   *
+   * \param robot_time Timestamp reported by the robot in seconds
+   *
+   * \returns The estimated host time corresponding to robot_time or a default constructed time
+   * point, if no estimate is available.
+   */
+  std::chrono::steady_clock::time_point toHostTime(const double robot_time) const;
+
+  /*!
+   * \brief Converts a point in time of the host's monotonic clock to robot time. This can e.g. be
+   * used to predict the robot time at which a command will arrive.
+   *
+   * \param host_time Point in time of the host's monotonic clock
+   *
+   * \returns The estimated robot time in seconds or 0, if no estimate is available.
+   */
+  double toRobotTime(const std::chrono::steady_clock::time_point host_time) const;
+
+private:
+  static constexpr size_t NUM_SEGMENTS = 10;
+
+  // Consecutive samples summarized by their sample with the smallest delay and by running moments
+  struct Segment
+  {
+    size_t num_samples = 0;
+    // Robot time and difference of host time minus robot time in seconds of the sample with the
+    // smallest difference
+    double min_robot_time = 0.0;
+    double min_difference = 0.0;
+    // Robot time of the latest sample
+    double latest_robot_time = 0.0;
+    // Means and sums of squared deviations from the means, updated using Welford's algorithm
+    double mean_robot_time = 0.0;
+    double mean_difference = 0.0;
+    double m2_robot_time = 0.0;
+    double m2_difference = 0.0;
+    double co_moment = 0.0;
+  };
+
+  // Calculates the estimate from a copy of the segments. The difference at the estimate's robot
+  // time is returned in seconds, as it is needed for precise conversions.
+  ClockOffsetEstimate calculateEstimate(double& estimated_difference) const;
+
+  mutable std::mutex mutex_;
+  // Ring buffer of num_slots_ segments, of which num_segments_ are in use with the latest one at
+  // current_
+  std::array<Segment, NUM_SEGMENTS> segments_;
+  size_t num_slots_;
+  size_t segment_size_;
+  size_t current_;
+  size_t num_segments_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_CLOCK_OFFSET_ESTIMATOR_H_INCLUDED
@@ -0,0 +1,161 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_EVENT_LOOP_H_INCLUDED
+#define UR_CLIENT_LIBRARY_EVENT_LOOP_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Single-threaded reactor dispatching socket events to registered handlers.
+ *
+ * File descriptors are registered together with the epoll events of interest and a handler that
+ * is called from the loop's thread whenever one of these events occurs. Multiple TCPServer objects
+ * can share one loop, so all of their sockets are served by a single thread.
+ *
+ * Registrations can be added and removed from any thread as well as from within handlers. Once
+ * remove() returns, the removed handler is not running and won't be called anymore.
+ */
+class EventLoop
+{
+public:
+  /*!
+   * \brief Handler for events on a file descriptor. The occurred epoll events are passed to it.
+   */
+  using Handler = std::function<void(const uint32_t events)>;
+
+  /*!
+   * \brief Creates a new EventLoop object. The loop doesn't handle any events until start() is
+   * called.
+   *
+   * \param name Name used for log output
+   * \param cpu CPU core the loop's thread gets pinned to. A negative value doesn't pin the thread.
+   */
+  explicit EventLoop(const std::string& name = "EventLoop", const int cpu = -1);
+  ~EventLoop();
+
+  EventLoop(const EventLoop&) = delete;
+  EventLoop& operator=(const EventLoop&) = delete;
+
+  /*!
+   * \brief Starts handling events in a new thread. Does nothing if the loop is already running.
+   */
+  void start();
+
+  /*!
+   * \brief Stops handling events and joins the loop's thread. Registrations are kept, so the loop
+   * can be restarted. Must not be called from within a handler.
+   */
+  void stop();
+
+  /*!
+   * \brief Registers a file descriptor. A previous registration of the same file descriptor is
+   * replaced.
+   *
+   * \param fd The file descriptor to watch
+   * \param events Epoll events to watch for, e.g. EPOLLIN or EPOLLIN | EPOLLET
+   * \param handler Function called from the loop's thread when one of the events occurs
+   *
+   * \returns True on success, false if the file descriptor couldn't be registered
+   */
+  bool add(const int fd, const uint32_t events, Handler handler);
+
+  /*!
+   * \brief Removes the registration of a file descriptor. Does nothing if the file descriptor isn't
+   * registered.
+   *
+   * \param fd The file descriptor to remove
+   */
+  void remove(const int fd);
+
+  /*!
+   * \brief Checks whether the calling thread is the loop's thread.
+   *
+   * \returns True, if called from within a handler, false otherwise
+   */
+  bool isInLoopThread() const
+  {
+    return std::this_thread::get_id() == loop_thread_id_.load();
+  }
+
+  /*!
+   * \brief Getter for the CPU core the loop's thread is pinned to.
+   *
+   * \returns The CPU core or a negative value if the thread isn't pinned
+   */
+  int getCPU() const
+  {
+    return cpu_;
+  }
+
+private:
+  struct Registration
+  {
+    uint32_t generation;
+    // Shared, so a handler can safely remove its own registration while running
+    std::shared_ptr<Handler> handler;
+  };
+
+  void run();
+  void dispatch(const uint64_t data, const uint32_t events);
+  void wakeUp();
+
+  std::string name_;
+  int cpu_;
+  int epoll_fd_;
+  // Pipe for the self-pipe trick (https://cr.yp.to/docs/selfpipe.html)
+  int self_pipe_[2];
+
+  std::atomic<bool> keep_running_;
+  std::thread thread_;
+  std::atomic<std::thread::id> loop_thread_id_;
+
+  // Guards the registrations. It is held by the loop while handlers are called, so removing a
+  // registration from another thread waits for a running handler to finish.
+  std::recursive_mutex mutex_;
+  std::unordered_map<int, Registration> registrations_;
+  uint32_t next_generation_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_EVENT_LOOP_H_INCLUDED
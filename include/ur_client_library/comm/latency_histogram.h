@@ -0,0 +1,163 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_LATENCY_HISTOGRAM_H_INCLUDED
+#define UR_CLIENT_LIBRARY_LATENCY_HISTOGRAM_H_INCLUDED
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Summary of the values recorded in a LatencyHistogram.
+ */
+struct LatencySummary
+{
+  uint64_t count = 0;
+  std::chrono::nanoseconds min{ 0 };
+  std::chrono::nanoseconds mean{ 0 };
+  std::chrono::nanoseconds p50{ 0 };
+  std::chrono::nanoseconds p90{ 0 };
+  std::chrono::nanoseconds p99{ 0 };
+  std::chrono::nanoseconds p999{ 0 };
+  std::chrono::nanoseconds max{ 0 };
+};
+
+/*!
+ * \brief Lock-free histogram of durations with a bounded relative error.
+ *
+ * Similar to an HDR histogram, values are sorted into buckets whose width grows with the
+ * magnitude of the value. Every power of two is split into 32 linear sub-buckets, so reported
+ * percentiles are at most about 3% larger than the recorded values. Values below 32ns are recorded
+ * exactly, values above about 18 minutes are clamped.
+ *
+ * Recording only consists of a few relaxed atomic operations and never allocates, so it can be
+ * done from real-time threads. Values can be recorded and read concurrently from multiple threads.
+ * A summary taken while values are recorded might not contain the values recorded during that
+ * time.
+ */
+class LatencyHistogram
+{
+public:
+  LatencyHistogram();
+
+  /*!
+   * \brief Records a single duration. Negative durations are recorded as zero, durations above the
+   * histogram's range as its largest value.
+   *
+   * \param value The duration to record
+   */
+  void record(const std::chrono::nanoseconds value)
+  {
+    const uint64_t ns = value.count() > 0 ? std::min(static_cast<uint64_t>(value.count()), MAX_VALUE) : 0;
+    counts_[bucketIndex(ns)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(ns, std::memory_order_relaxed);
+
+    uint64_t min = min_.load(std::memory_order_relaxed);
+    while (ns < min && !min_.compare_exchange_weak(min, ns, std::memory_order_relaxed))
+    {
+    }
+    uint64_t max = max_.load(std::memory_order_relaxed);
+    while (ns > max && !max_.compare_exchange_weak(max, ns, std::memory_order_relaxed))
+    {
+    }
+  }
+
+  /*!
+   * \brief Getter for the number of recorded values.
+   *
+   * \returns The number of values recorded since construction or the last reset
+   */
+  uint64_t getCount() const
+  {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   * \brief Computes the value below which the given percentage of recorded values fall.
+   *
+   * \param percentile Percentage in the range [0, 100]
+   *
+   * \returns The highest value equivalent to the bucket containing the percentile, but not more
+   * than the largest recorded value. Zero if no values were recorded.
+   */
+  std::chrono::nanoseconds getValueAtPercentile(const double percentile) const;
+
+  /*!
+   * \brief Creates a summary of the recorded values.
+   *
+   * \returns Count, minimum, mean, some percentiles and maximum of the recorded values
+   */
+  LatencySummary getSummary() const;
+
+  /*!
+   * \brief Discards all recorded values. Values recorded concurrently with a reset might be lost
+   * partially.
+   */
+  void reset();
+
+private:
+  static constexpr unsigned SUB_BUCKET_BITS = 5;
+  static constexpr uint64_t SUB_BUCKET_COUNT = 1u << SUB_BUCKET_BITS;
+  static constexpr unsigned MAX_VALUE_BITS = 40;
+  static constexpr uint64_t MAX_VALUE = (uint64_t(1) << MAX_VALUE_BITS) - 1;
+  static constexpr size_t NUM_BUCKETS = (MAX_VALUE_BITS - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT;
+
+  static size_t bucketIndex(const uint64_t value)
+  {
+    if (value < SUB_BUCKET_COUNT)
+    {
+      return value;
+    }
+    const unsigned exponent = 63 - __builtin_clzll(value);
+    const unsigned shift = exponent - SUB_BUCKET_BITS;
+    return (shift + 1) * SUB_BUCKET_COUNT + ((value >> shift) - SUB_BUCKET_COUNT);
+  }
+
+  static uint64_t highestEquivalentValue(const size_t index);
+
+  std::array<std::atomic<uint64_t>, NUM_BUCKETS> counts_;
+  std::atomic<uint64_t> count_;
+  std::atomic<uint64_t> sum_;
+  std::atomic<uint64_t> min_;
+  std::atomic<uint64_t> max_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_LATENCY_HISTOGRAM_H_INCLUDED
@@ -28,12 +28,37 @@
 #ifndef UR_CLIENT_LIBRARY_PACKAGE_H_INCLUDED
 #define UR_CLIENT_LIBRARY_PACKAGE_H_INCLUDED
 
+#include <chrono>
+
 #include "ur_client_library/comm/bin_parser.h"
 
 namespace urcl
 {
 namespace comm
 {
+/*!
+ * \brief Points in time at which a package passed the stages of the receive path. Stages the
+ * package didn't pass, yet, keep their previous value.
+ */
+struct PackageTimestamps
+{
+  std::chrono::steady_clock::time_point received;  ///< The package's bytes were read from the socket
+  std::chrono::steady_clock::time_point parsed;    ///< The package was parsed
+  std::chrono::steady_clock::time_point enqueued;  ///< The package was handed to the pipeline's transport
+  std::chrono::steady_clock::time_point dequeued;  ///< The package was fetched from the pipeline
+
+  /*!
+   * \brief Point in time at which the kernel received the package's last bytes from the network.
+   * Only set if receive timestamps are enabled on the socket, see TCPSocket::setReceiveTimestamping().
+   */
+  std::chrono::system_clock::time_point kernel_received;
+  /*!
+   * \brief Point in time at which the network interface received the package's last bytes in the
+   * network interface's clock. Only set if the interface supports hardware timestamping.
+   */
+  std::chrono::nanoseconds hardware_received{ 0 };
+};
+
 /*!
  * \brief The URPackage a parent class. From that two implementations are inherited,
  * one for the primary, one for the rtde interface (primary_interface::primaryPackage;
@@ -67,10 +92,33 @@ public:
    */
   virtual std::string toString() const = 0;
 
+  /*!
+   * \brief Access to the points in time at which the package passed the stages of the receive
+   * path. They are filled by the URProducer and the Pipeline.
+   *
+   * \returns The package's timestamps
+   */
+  PackageTimestamps& getTimestamps()
+  {
+    return timestamps_;
+  }
+
+  /*!
+   * \brief Access to the points in time at which the package passed the stages of the receive
+   * path.
+   *
+   * \returns The package's timestamps
+   */
+  const PackageTimestamps& getTimestamps() const
+  {
+    return timestamps_;
+  }
+
   using HeaderType = HeaderT;
 
 private:
   HeaderT header_;
+  PackageTimestamps timestamps_;
 };
 }  // namespace comm
 }  // namespace urcl
@@ -30,6 +30,7 @@
 #define UR_CLIENT_LIBRARY_PACKAGE_SERIALIZER_H_INCLUDED
 
 #include <endian.h>
+#include <array>
 #include <cstring>
 
 namespace urcl
@@ -79,6 +80,26 @@ public:
     return size;
   }
 
+  /*!
+   * \brief A serialization method for arrays, e.g. vector6d_t. Each element is serialized on its
+   * own.
+   *
+   * \param buffer The buffer to write the serialization into.
+   * \param val The array to serialize.
+   *
+   * \returns Size in byte of the serialization.
+   */
+  template <typename T, size_t N>
+  static size_t serialize(uint8_t* buffer, const std::array<T, N>& val)
+  {
+    size_t size = 0;
+    for (const auto& item : val)
+    {
+      size += serialize(buffer + size, item);
+    }
+    return size;
+  }
+
   /*!
    * \brief A serialization method for strings.
    *
@@ -0,0 +1,204 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_PACKET_CAPTURE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_PACKET_CAPTURE_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/comm/recording.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Direction of captured traffic as seen from this host.
+ */
+enum class CaptureDirection : uint32_t
+{
+  INBOUND = 0,  ///< Bytes received from the peer
+  OUTBOUND = 1  ///< Bytes sent to the peer
+};
+
+/*!
+ * \brief Captures the raw bytes sent and received on sockets into a RecordingWriter file of type
+ * RecordingType::CAPTURE.
+ *
+ * Each captured chunk of bytes becomes one frame, timestamped with the steady clock when it was
+ * captured. The frame's flags hold the direction and a channel, which allows a single capture to
+ * be shared by multiple sockets, e.g. the client file descriptors of a TCPServer or a URStream and
+ * a TCPServer. Use getDirection() and getChannel() to decode them when reading the capture.
+ *
+ * Inbound and outbound bytes are copied into one preallocated ring buffer per direction by
+ * capture(), which doesn't allocate, lock or make any system call besides reading the clock. Any
+ * number of threads may capture at the same time. They reserve space in the ring buffer with an
+ * atomic compare-and-swap and mark their chunk as complete once it is copied. A background thread
+ * moves the complete chunks from the ring buffers into the file, merging both directions by their
+ * timestamps. Chunks of one direction are written in the order their space was reserved. If a ring
+ * buffer is full, chunks are dropped instead of waiting for the background thread.
+ */
+class PacketCapture
+{
+public:
+  PacketCapture() = delete;
+
+  /*!
+   * \brief Creates a capture file and starts the background thread writing it.
+   *
+   * \param filename Path of the capture file
+   * \param buffer_size Size of the ring buffer of each direction in bytes. It limits the size of
+   * a single captured chunk.
+   *
+   * \throws UrException if the file cannot be created
+   */
+  explicit PacketCapture(const std::string& filename, const size_t buffer_size = 1 << 20);
+
+  /*!
+   * \brief Writes all buffered chunks and closes the capture file.
+   */
+  ~PacketCapture();
+
+  PacketCapture(const PacketCapture&) = delete;
+  PacketCapture& operator=(const PacketCapture&) = delete;
+
+  /*!
+   * \brief Adds a chunk of bytes to the capture.
+   *
+   * \param direction Whether the bytes were received or sent
+   * \param data Captured bytes
+   * \param size Number of captured bytes
+   * \param channel Identifies the socket the bytes belong to, has to fit into 24 bits
+   *
+   * \returns True, if the chunk was buffered for writing, false if the buffer is full
+   */
+  bool capture(const CaptureDirection direction, const uint8_t* data, const size_t size, const uint32_t channel = 0);
+
+  /*!
+   * \brief Getter for the number of chunks written to the file.
+   *
+   * \returns The number of captured chunks
+   */
+  uint64_t getNumCaptured() const
+  {
+    return num_captured_;
+  }
+
+  /*!
+   * \brief Getter for the number of chunks that got dropped because the buffer was full or the
+   * file could not be written.
+   *
+   * \returns The number of dropped chunks
+   */
+  uint64_t getNumDropped() const
+  {
+    return num_dropped_;
+  }
+
+  /*!
+   * \brief Reads the direction of a frame read from a capture file.
+   *
+   * \param frame Captured frame
+   *
+   * \returns The direction of the captured bytes
+   */
+  static CaptureDirection getDirection(const RecordedFrame& frame)
+  {
+    return static_cast<CaptureDirection>(frame.flags & DIRECTION_MASK);
+  }
+
+  /*!
+   * \brief Reads the channel of a frame read from a capture file.
+   *
+   * \param frame Captured frame
+   *
+   * \returns The channel given when capturing the bytes
+   */
+  static uint32_t getChannel(const RecordedFrame& frame)
+  {
+    return frame.flags >> CHANNEL_SHIFT;
+  }
+
+private:
+  static const uint32_t DIRECTION_MASK = 0xff;
+  static const uint32_t CHANNEL_SHIFT = 8;
+
+  // Byte ring buffer holding the chunks of one direction, each preceded by a RecordingFrameHeader
+  // and padded to a multiple of 8 bytes. A chunk never wraps around the end of the buffer, the
+  // remaining space is skipped instead.
+  struct Ring
+  {
+    explicit Ring(const size_t size) : buffer(size), states(size / ALIGNMENT), head(0), tail(0)
+    {
+    }
+
+    std::vector<uint8_t> buffer;
+    // State of the chunk starting at each 8 byte unit of the buffer, see SlotState. A chunk is only
+    // handed to the background thread once its state is set.
+    std::vector<std::atomic<uint8_t>> states;
+    // Number of bytes reserved by capturing threads and number of bytes moved to the file
+    std::atomic<uint64_t> head;
+    std::atomic<uint64_t> tail;
+  };
+
+  enum SlotState : uint8_t
+  {
+    SLOT_EMPTY = 0,     // The chunk is still being copied or the space hasn't been used, yet
+    SLOT_COMPLETE = 1,  // The chunk is ready to be written to the file
+    SLOT_SKIP = 2       // The remaining space up to the end of the buffer is skipped
+  };
+
+  static const size_t ALIGNMENT = 8;
+
+  void runWriter();
+  // Moves all buffered chunks to the file, returns the number of chunks moved
+  size_t writeBuffered();
+  // Reads the oldest chunk in the ring, returns false if it is empty
+  bool front(Ring& ring, RecordingFrameHeader& header, const uint8_t*& data);
+  void pop(Ring& ring, const RecordingFrameHeader& header);
+
+  RecordingWriter writer_;
+  Ring rings_[2];
+
+  std::atomic<uint64_t> num_captured_;
+  std::atomic<uint64_t> num_dropped_;
+  std::atomic<bool> running_;
+  std::thread writer_thread_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_PACKET_CAPTURE_H_INCLUDED
@@ -48,6 +48,16 @@ public:
    */
   virtual bool parse(BinParser& bp, std::vector<std::unique_ptr<T>>& results) = 0;
 
+  /*!
+   * \brief Hands a product that is not used anymore back to the parser. Parsers may reuse the
+   * product's memory for packages parsed later on. By default the product is simply destroyed.
+   *
+   * \param product The product that is not used anymore
+   */
+  virtual void recycle(std::unique_ptr<T> product)
+  {
+  }
+
 private:
   typename T::HeaderType header_;
   // URProducer producer_;
@@ -21,11 +21,13 @@
 #pragma once
 
 #include "ur_client_library/comm/package.h"
+#include "ur_client_library/comm/triple_buffer.h"
 #include "ur_client_library/log.h"
 #include "ur_client_library/helpers.h"
 #include "ur_client_library/queue/readerwriterqueue.h"
 #include <atomic>
 #include <chrono>
+#include <functional>
 #include <thread>
 #include <vector>
 #include <fstream>
@@ -207,6 +209,16 @@ public:
    * \returns Success of the package production.
    */
   virtual bool tryGet(std::vector<std::unique_ptr<T>>& products) = 0;
+
+  /*!
+   * \brief Hands a product that is not used anymore back to the producer, so its memory can be
+   * reused for later products. By default the product is simply destroyed.
+   *
+   * \param product The product that is not used anymore
+   */
+  virtual void recycle(std::unique_ptr<T> product)
+  {
+  }
 };
 
 /*!
@@ -229,11 +241,35 @@ public:
   }
 };
 
+/*!
+ * \brief Possible ways of passing products from the producer to the consumer side of a pipeline
+ */
+enum class PipelineTransport
+{
+  QUEUE,        ///< Products are queued and handed out in order. Products are dropped if the queue is full.
+  LATEST_VALUE  ///< Only the latest product is kept. It is overwritten by the producer if it hasn't been fetched, yet.
+};
+
+/*!
+ * \brief Possible ways of handling a product when using PipelineTransport::LATEST_VALUE, see
+ * Pipeline::setProductRouter()
+ */
+enum class ProductRoute
+{
+  LATEST_VALUE,  ///< The product is passed through the latest-value buffer
+  QUEUE,         ///< The product is queued, so it can't be overwritten by later products
+  DISCARD        ///< The product is dropped, e.g. as it has been handled by the produced callback already
+};
+
 /*!
  * \brief The Pipepline manages the production and optionally consumption of packages. Cyclically
  * the producer is called and returned packages are saved in a queue. This queue is then either also
  * cyclically utilized by the registered consumer or can be externally used.
  *
+ * Instead of a queue, the pipeline can use a wait-free latest-value buffer to pass products to the
+ * consumer side, see PipelineTransport::LATEST_VALUE. This is useful if only the most recent product
+ * is of interest, e.g. for cyclic state updates.
+ *
  * @tparam T Type of the managed packages
  */
 template <typename T>
@@ -251,9 +287,10 @@ public:
    * \param name The pipeline's name
    * \param notifier The notifier to use
    * \param producer_fifo_scheduling Should the producer thread use FIFO scheduling?
+   * \param transport How products are passed from the producer to the consumer
    */
   Pipeline(IProducer<T>& producer, IConsumer<T>* consumer, std::string name, INotifier& notifier,
-           const bool producer_fifo_scheduling = false)
+           const bool producer_fifo_scheduling = false, const PipelineTransport transport = PipelineTransport::QUEUE)
     : producer_(producer)
     , consumer_(consumer)
     , name_(name)
@@ -261,6 +298,8 @@ public:
     , queue_{ 32 }
     , running_{ false }
     , producer_fifo_scheduling_(producer_fifo_scheduling)
+    , transport_(transport)
+    , num_dropped_products_(0)
   {
   }
   /*!
@@ -271,8 +310,10 @@ public:
    * \param name The pipeline's name
    * \param notifier The notifier to use
    * \param producer_fifo_scheduling Should the producer thread use FIFO scheduling?
+   * \param transport How products are passed from the producer to the consumer side
    */
-  Pipeline(IProducer<T>& producer, std::string name, INotifier& notifier, const bool producer_fifo_scheduling = false)
+  Pipeline(IProducer<T>& producer, std::string name, INotifier& notifier, const bool producer_fifo_scheduling = false,
+           const PipelineTransport transport = PipelineTransport::QUEUE)
     : producer_(producer)
     , consumer_(nullptr)
     , name_(name)
@@ -280,6 +321,8 @@ public:
     , queue_{ 32 }
     , running_{ false }
     , producer_fifo_scheduling_(producer_fifo_scheduling)
+    , transport_(transport)
+    , num_dropped_products_(0)
   {
   }
 
@@ -324,18 +367,18 @@ public:
   }
 
   /*!
-   * \brief Stops the pipeline and all running threads.
+   * \brief Stops the pipeline and all running threads. The threads are also joined if the pipeline
+   * ended on its own, e.g. because the producer reached the end of its data.
    */
   void stop()
   {
-    if (!running_)
-      return;
-
-    URCL_LOG_DEBUG("Stopping pipeline! <%s>", name_.c_str());
-
-    running_ = false;
+    const bool was_running = running_.exchange(false);
+    if (was_running)
+    {
+      URCL_LOG_DEBUG("Stopping pipeline! <%s>", name_.c_str());
+      producer_.stopProducer();
+    }
 
-    producer_.stopProducer();
     if (pThread_.joinable())
     {
       pThread_.join();
@@ -344,7 +387,10 @@ public:
     {
       cThread_.join();
     }
-    notifier_.stopped(name_);
+    if (was_running)
+    {
+      notifier_.stopped(name_);
+    }
   }
 
   /*!
@@ -352,22 +398,141 @@ public:
    * already contains one or more items, the queue will be flushed and the newest item will be returned. If there is no
    * item inside the queue, the function will wait for \p timeout for a new package
    *
+   * Packages flushed from the queue as well as the package previously held by \p product are handed back to the
+   * producer for reuse.
+   *
+   * When using PipelineTransport::LATEST_VALUE, the latest package is fetched without waiting if one is available.
+   *
    * \param product Unique pointer to be set to the package
    * \param timeout Time to wait if no package is in the queue before returning
    *
-   * \returns
+   * \returns True, if a new package was fetched, false otherwise
    */
   bool getLatestProduct(std::unique_ptr<T>& product, std::chrono::milliseconds timeout)
   {
+    if (transport_ == PipelineTransport::LATEST_VALUE)
+    {
+      // The previous product is handed back to the producer through the buffer
+      return stampDequeued(product, latest_.waitRead(product, timeout));
+    }
+
     // If the queue has more than one package, get the latest one.
     bool res = false;
-    while (queue_.tryDequeue(product))
+    std::unique_ptr<T> next;
+    while (queue_.tryDequeue(next))
     {
+      if (res)
+      {
+        num_dropped_products_++;
+      }
+      recycleProduct(std::move(product));
+      product = std::move(next);
       res = true;
     }
 
     // If the queue is empty, wait for a package.
-    return res || queue_.waitDequeTimed(product, timeout);
+    if (!res && queue_.waitDequeTimed(next, timeout))
+    {
+      recycleProduct(std::move(product));
+      product = std::move(next);
+      res = true;
+    }
+    return stampDequeued(product, res);
+  }
+
+  /*!
+   * \brief Returns the oldest queued package. In contrast to getLatestProduct(), no packages are skipped.
+   * If the queue is empty, the function will wait for \p timeout for a new package.
+   *
+   * When using PipelineTransport::LATEST_VALUE, only the products routed to ProductRoute::QUEUE by
+   * setProductRouter() are queued, all others can't be fetched by this function.
+   *
+   * \param product Unique pointer to be set to the package
+   * \param timeout Time to wait if no package is in the queue before returning
+   *
+   * \returns True, if a new package was fetched, false otherwise
+   */
+  bool getQueuedProduct(std::unique_ptr<T>& product, std::chrono::milliseconds timeout)
+  {
+    std::unique_ptr<T> next;
+    if (!queue_.waitDequeTimed(next, timeout))
+    {
+      return false;
+    }
+    recycleProduct(std::move(product));
+    product = std::move(next);
+    return stampDequeued(product, true);
+  }
+
+  /*!
+   * \brief Hands a product that is not used anymore back to the producer, so its memory can be reused
+   * for later products. This has to be called from the same thread that fetches products using
+   * getLatestProduct().
+   *
+   * When using PipelineTransport::LATEST_VALUE, products are handed back through the latest-value
+   * buffer when fetching a new one. Products passed to this function are destroyed in that case.
+   *
+   * \param product The product that is not used anymore
+   */
+  void recycleProduct(std::unique_ptr<T> product)
+  {
+    if (product != nullptr && transport_ == PipelineTransport::QUEUE)
+    {
+      producer_.recycle(std::move(product));
+    }
+  }
+
+  /*!
+   * \brief Returns the number of products that were dropped without being handed out. These are
+   * products that didn't fit into the queue, that were flushed from the queue in getLatestProduct()
+   * or that were overwritten in the latest-value buffer before being fetched.
+   *
+   * \returns The number of dropped products since the pipeline was created
+   */
+  uint64_t getNumDroppedProducts() const
+  {
+    return num_dropped_products_;
+  }
+
+  /*!
+   * \brief Getter for the transport used to pass products from the producer to the consumer side.
+   *
+   * \returns The pipeline's transport
+   */
+  PipelineTransport getTransport() const
+  {
+    return transport_;
+  }
+
+  /*!
+   * \brief Registers a function that is called from the producer thread for every product, right
+   * before it is passed to the consumer side. This allows reacting to new products without any
+   * additional thread handoff. The function should return quickly, as it delays the product.
+   *
+   * This has to be set before the pipeline is started.
+   *
+   * \param callback Function to call for every produced product
+   */
+  void setProducedCallback(std::function<void(const T&)> callback)
+  {
+    produced_callback_ = callback;
+  }
+
+  /*!
+   * \brief Registers a function deciding how each product is passed on when using
+   * PipelineTransport::LATEST_VALUE. Products that must not be overwritten, e.g. answers to
+   * requests, can be queued and fetched using getQueuedProduct(). Products nobody fetches while
+   * only the latest value is read, e.g. log messages, should be discarded, as they would fill up
+   * the queue otherwise. Without a router, all products are passed through the latest-value buffer.
+   * With PipelineTransport::QUEUE the router has no effect, as all products are queued.
+   *
+   * This has to be set before the pipeline is started.
+   *
+   * \param router Function returning the route of a product
+   */
+  void setProductRouter(std::function<ProductRoute(const T&)> router)
+  {
+    product_router_ = router;
   }
 
 private:
@@ -376,9 +541,14 @@ private:
   std::string name_;
   INotifier& notifier_;
   moodycamel::BlockingReaderWriterQueue<std::unique_ptr<T>> queue_;
+  TripleBuffer<std::unique_ptr<T>> latest_;
   std::atomic<bool> running_;
   std::thread pThread_, cThread_;
   bool producer_fifo_scheduling_;
+  PipelineTransport transport_;
+  std::atomic<uint64_t> num_dropped_products_;
+  std::function<void(const T&)> produced_callback_;
+  std::function<ProductRoute(const T&)> product_router_;
 
   void runProducer()
   {
@@ -401,8 +571,35 @@ private:
 
       for (auto& p : products)
       {
-        if (!queue_.tryEnqueue(std::move(p)))
+        if (produced_callback_)
+        {
+          produced_callback_(*p);
+        }
+        p->getTimestamps().enqueued = std::chrono::steady_clock::now();
+        ProductRoute route = ProductRoute::QUEUE;
+        if (transport_ == PipelineTransport::LATEST_VALUE)
+        {
+          route = product_router_ ? product_router_(*p) : ProductRoute::LATEST_VALUE;
+        }
+        if (route == ProductRoute::DISCARD)
+        {
+          producer_.recycle(std::move(p));
+        }
+        else if (route == ProductRoute::LATEST_VALUE)
         {
+          // p receives the product previously stored in the producer's slot, which can be reused.
+          if (latest_.write(p))
+          {
+            num_dropped_products_++;
+          }
+          if (p != nullptr)
+          {
+            producer_.recycle(std::move(p));
+          }
+        }
+        else if (!queue_.tryEnqueue(std::move(p)))
+        {
+          num_dropped_products_++;
           URCL_LOG_ERROR("Pipeline producer overflowed! <%s>", name_.c_str());
         }
       }
@@ -422,7 +619,7 @@ private:
       // at roughly 125hz (every 8ms) and have to update
       // the controllers (i.e. the consumer) with *at least* 125Hz
       // So we update the consumer more frequently via onTimeout
-      if (!queue_.waitDequeTimed(product, std::chrono::milliseconds(8)))
+      if (!dequeueForConsumer(product, std::chrono::milliseconds(8)))
       {
         consumer_->onTimeout();
         continue;
@@ -439,6 +636,24 @@ private:
     URCL_LOG_DEBUG("Pipeline consumer ended! <%s>", name_.c_str());
     notifier_.stopped(name_);
   }
+
+  bool dequeueForConsumer(std::unique_ptr<T>& product, std::chrono::milliseconds timeout)
+  {
+    if (transport_ == PipelineTransport::LATEST_VALUE)
+    {
+      return stampDequeued(product, latest_.waitRead(product, timeout));
+    }
+    return stampDequeued(product, queue_.waitDequeTimed(product, timeout));
+  }
+
+  static bool stampDequeued(std::unique_ptr<T>& product, const bool fetched)
+  {
+    if (fetched && product != nullptr)
+    {
+      product->getTimestamps().dequeued = std::chrono::steady_clock::now();
+    }
+    return fetched;
+  }
 };
 }  // namespace comm
 }  // namespace urcl
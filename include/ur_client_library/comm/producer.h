@@ -45,6 +45,37 @@ private:
   std::chrono::seconds timeout_;
 
   bool running_;
+  // A package of the last batch could not be parsed, which is reported on the next call of tryGet()
+  bool parse_failed_;
+
+  bool parsePackage(uint8_t* package, const size_t length, std::vector<std::unique_ptr<T>>& products)
+  {
+    // Packages of one batched read share the time at which the read happened
+    const auto received = stream_.getLastReadTime();
+    BinParser bp(package, length);
+    const size_t first_new = products.size();
+    const bool result = parser_.parse(bp, products);
+    if (!result)
+    {
+      // The parser might have appended a product before noticing the error
+      while (products.size() > first_new)
+      {
+        parser_.recycle(std::move(products.back()));
+        products.pop_back();
+      }
+      return false;
+    }
+    const auto parsed = std::chrono::steady_clock::now();
+    for (size_t i = first_new; i < products.size(); ++i)
+    {
+      PackageTimestamps& timestamps = products[i]->getTimestamps();
+      timestamps.received = received;
+      timestamps.parsed = parsed;
+      timestamps.kernel_received = stream_.getLastKernelReceiveTime();
+      timestamps.hardware_received = stream_.getLastHardwareReceiveTime();
+    }
+    return true;
+  }
 
 public:
   /*!
@@ -53,7 +84,8 @@ public:
    * \param stream The stream to read from
    * \param parser The parser to use to interpret received byte information
    */
-  URProducer(URStream<T>& stream, Parser<T>& parser) : stream_(stream), parser_(parser), timeout_(1), running_(false)
+  URProducer(URStream<T>& stream, Parser<T>& parser)
+    : stream_(stream), parser_(parser), timeout_(1), running_(false), parse_failed_(false)
   {
   }
 
@@ -97,28 +129,48 @@ public:
   }
 
   /*!
-   * \brief Attempts to read byte stream from the robot and parse it as a URPackage.
+   * \brief Attempts to read byte stream from the robot and parse it as a URPackage. Waits for at
+   * least one package. If multiple packages have been received already, e.g. after the producer
+   * wasn't scheduled for some time, all of them are parsed at once.
+   *
+   * If a package of such a batch cannot be parsed, the packages parsed before it are returned and
+   * the failure is reported by the next call.
    *
-   * \param products Unique pointer to hold the produced package
+   * \param products Vector to append the produced packages to
    *
-   * \returns Success of reading and parsing the package
+   * \returns Success of reading and parsing the packages
    */
   bool tryGet(std::vector<std::unique_ptr<T>>& products) override
   {
     // TODO This function has become really ugly! That should be refactored!
 
-    // 4KB should be enough to hold any packet received from UR
-    uint8_t buf[4096];
+    if (parse_failed_)
+    {
+      parse_failed_ = false;
+      return false;
+    }
+    const size_t num_products = products.size();
+
+    // The package is parsed directly inside the stream's receive buffer
+    uint8_t* package = nullptr;
     size_t read = 0;
     // expoential backoff reconnects
     while (true)
     {
-      if (stream_.read(buf, sizeof(buf), read))
+      if (stream_.readPackage(package, read))
       {
         // reset sleep amount
         timeout_ = std::chrono::seconds(1);
-        BinParser bp(buf, read);
-        return parser_.parse(bp, products);
+        do
+        {
+          if (!parsePackage(package, read, products))
+          {
+            // Hand out the packages parsed before the broken one, so they aren't lost
+            parse_failed_ = products.size() > num_products;
+            return parse_failed_;
+          }
+        } while (stream_.tryReadPackage(package, read));
+        return true;
       }
 
       if (!running_)
@@ -140,6 +192,16 @@ public:
 
     return false;
   }
+
+  /*!
+   * \brief Hands a product that is not used anymore to the parser for reuse.
+   *
+   * \param product The product that is not used anymore
+   */
+  void recycle(std::unique_ptr<T> product) override
+  {
+    parser_.recycle(std::move(product));
+  }
 };
 }  // namespace comm
 }  // namespace urcl
@@ -0,0 +1,301 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_RECORDING_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RECORDING_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Kind of packages stored in a recording.
+ */
+enum class RecordingType : uint32_t
+{
+  RTDE = 1,    ///< Serialized RTDE packages, the recording's metadata holds the output recipe
+  PRIMARY = 2,  ///< Packages of the primary interface
+  CAPTURE = 3   ///< Raw bytes sent and received on sockets, see PacketCapture
+};
+
+/*!
+ * \brief Header at the beginning of a recording file. It is followed by metadata_size bytes of
+ * metadata, e.g. the RTDE recipe with one field name per line. The first block starts at
+ * data_offset.
+ */
+struct RecordingHeader
+{
+  char magic[8];
+  uint32_t format_version;
+  RecordingType type;
+  uint32_t protocol_version;
+  uint32_t metadata_size;
+  uint64_t data_offset;
+  uint64_t block_size;
+};
+
+/*!
+ * \brief Header of a block of frames. All blocks of a recording have the same size, except the
+ * last one, so the block containing a certain frame or time can be found without reading the
+ * whole file.
+ */
+struct RecordingBlockHeader
+{
+  uint32_t magic;
+  uint32_t num_frames;
+  //! Number of bytes used by the block, including this header
+  uint64_t used_size;
+  //! Index of the block's first frame inside the recording
+  uint64_t first_frame;
+  //! Host receive time of the block's first frame in nanoseconds of the steady clock
+  int64_t first_time;
+  //! Host receive time of the block's last frame in nanoseconds of the steady clock
+  int64_t last_time;
+};
+
+/*!
+ * \brief Header preceding each frame inside a block. Frames are padded to a multiple of 8 bytes.
+ */
+struct RecordingFrameHeader
+{
+  //! Host receive time in nanoseconds of the steady clock
+  int64_t time;
+  uint32_t size;
+  //! Frame specific information, e.g. the direction of captured traffic. 0 for package recordings.
+  uint32_t flags;
+};
+
+/*!
+ * \brief A frame read from a recording.
+ */
+struct RecordedFrame
+{
+  //! Time the package was received at
+  std::chrono::steady_clock::time_point time;
+  //! Serialized package as received from the robot. Valid as long as the reader exists.
+  const uint8_t* data;
+  size_t size;
+  //! Flags stored with the frame
+  uint32_t flags;
+};
+
+/*!
+ * \brief Appends frames to a recording file.
+ *
+ * The file is written through a memory mapping of the current block, so appending a frame only
+ * copies it. When a block is full, the file is extended and the next block gets mapped. The block
+ * header is updated after every frame, so a recording stays readable if the process ends without
+ * closing it.
+ *
+ * All methods have to be called from the same thread.
+ */
+class RecordingWriter
+{
+public:
+  static const uint32_t FORMAT_VERSION = 1;
+
+  /*!
+   * \brief Creates a new recording file, replacing any existing file of the same name.
+   *
+   * \param filename Path of the file to create
+   * \param type Kind of packages that will be recorded
+   * \param protocol_version Protocol version of the recorded packages
+   * \param metadata Additional information needed to parse the packages, e.g. the RTDE recipe
+   * \param block_size Size of the blocks in bytes. It is rounded up to a multiple of the page size.
+   *
+   * \throws UrException if the file cannot be created
+   */
+  RecordingWriter(const std::string& filename, const RecordingType type, const uint32_t protocol_version,
+                  const std::string& metadata, const size_t block_size = 1 << 20);
+
+  /*!
+   * \brief Closes the recording.
+   */
+  ~RecordingWriter();
+
+  RecordingWriter(const RecordingWriter&) = delete;
+  RecordingWriter& operator=(const RecordingWriter&) = delete;
+
+  /*!
+   * \brief Appends a frame to the recording.
+   *
+   * \param time Time the package was received at
+   * \param data Serialized package
+   * \param size Size of the serialized package
+   * \param flags Frame specific information stored with the frame
+   *
+   * \returns True, if the frame was appended, false if it does not fit into a block or the file
+   * cannot be extended
+   */
+  bool append(const std::chrono::steady_clock::time_point time, const uint8_t* data, const size_t size,
+              const uint32_t flags = 0);
+
+  /*!
+   * \brief Unmaps the current block and truncates the file to the recorded data. Called by the
+   * destructor, further frames cannot be appended afterwards.
+   */
+  void close();
+
+  /*!
+   * \brief Getter for the number of frames appended.
+   *
+   * \returns The number of frames in the recording
+   */
+  uint64_t getNumFrames() const
+  {
+    return num_frames_;
+  }
+
+private:
+  bool mapNextBlock();
+  void unmapBlock();
+
+  int fd_;
+  size_t block_size_;
+  uint64_t data_offset_;
+  uint64_t num_blocks_;
+  uint64_t num_frames_;
+  uint8_t* block_;
+};
+
+/*!
+ * \brief Reads the frames of a recording created by a RecordingWriter.
+ *
+ * The whole file is mapped into memory, so frames are handed out without copying them.
+ */
+class RecordingReader
+{
+public:
+  /*!
+   * \brief Opens a recording.
+   *
+   * \param filename Path of the recording
+   *
+   * \throws UrException if the file cannot be opened or is not a valid recording
+   */
+  explicit RecordingReader(const std::string& filename);
+  ~RecordingReader();
+
+  RecordingReader(const RecordingReader&) = delete;
+  RecordingReader& operator=(const RecordingReader&) = delete;
+
+  /*!
+   * \brief Getter for the kind of packages stored in the recording.
+   *
+   * \returns The recording type
+   */
+  RecordingType getType() const
+  {
+    return header_.type;
+  }
+
+  /*!
+   * \brief Getter for the protocol version of the recorded packages.
+   *
+   * \returns The protocol version
+   */
+  uint32_t getProtocolVersion() const
+  {
+    return header_.protocol_version;
+  }
+
+  /*!
+   * \brief Getter for the metadata stored with the recording.
+   *
+   * \returns The metadata, e.g. the RTDE recipe with one field name per line
+   */
+  const std::string& getMetadata() const
+  {
+    return metadata_;
+  }
+
+  /*!
+   * \brief Getter for the total number of frames in the recording.
+   *
+   * \returns The number of frames
+   */
+  uint64_t getNumFrames() const;
+
+  /*!
+   * \brief Reads the next frame.
+   *
+   * \param frame The frame read
+   *
+   * \returns True, if a frame was read, false if the end of the recording is reached
+   */
+  bool next(RecordedFrame& frame);
+
+  /*!
+   * \brief Reads the next frame without advancing, so the following call of next() returns the
+   * same frame.
+   *
+   * \param frame The frame read
+   *
+   * \returns True, if a frame was read, false if the end of the recording is reached
+   */
+  bool peek(RecordedFrame& frame);
+
+  /*!
+   * \brief Continues reading with the first frame received at or after the given time.
+   *
+   * \param time Host receive time to seek to
+   */
+  void seek(const std::chrono::steady_clock::time_point time);
+
+  /*!
+   * \brief Continues reading with the first frame of the recording.
+   */
+  void rewind();
+
+private:
+  const RecordingBlockHeader* block(const uint64_t index) const;
+
+  int fd_;
+  uint8_t* data_;
+  size_t size_;
+  RecordingHeader header_;
+  std::string metadata_;
+  uint64_t num_blocks_;
+
+  uint64_t current_block_;
+  uint32_t current_frame_;
+  uint64_t current_offset_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_RECORDING_H_INCLUDED
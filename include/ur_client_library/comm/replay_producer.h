@@ -0,0 +1,255 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_REPLAY_PRODUCER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_REPLAY_PRODUCER_H_INCLUDED
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/comm/bin_parser.h"
+#include "ur_client_library/comm/parser.h"
+#include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/comm/recording.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Pace at which a ReplayProducer produces the recorded packages
+ */
+enum class ReplayTiming
+{
+  ORIGINAL,            ///< Packages are produced with the same spacing in time as they were received
+  AS_FAST_AS_POSSIBLE  ///< Packages are produced without any delay
+};
+
+/*!
+ * \brief Produces packages by parsing the frames of a recording instead of reading them from a
+ * robot. This allows running consumers offline on recorded traffic, e.g. for regression tests or
+ * for profiling.
+ *
+ * The producer can be used inside a Pipeline. It returns false from tryGet() at the end of the
+ * recording, which stops the pipeline. Alternatively, replay() hands all packages to a consumer
+ * directly from the calling thread, so no package gets dropped when replaying as fast as possible.
+ *
+ * The received timestamps of the produced packages are the ones from the recording, so a replay
+ * yields the same timestamps independent of its pace.
+ *
+ * @tparam T Type of the produced packages. The recording has to contain packages of this type.
+ */
+template <typename T>
+class ReplayProducer : public IProducer<T>
+{
+public:
+  /*!
+   * \brief Creates a ReplayProducer object.
+   *
+   * \param reader The recording to replay. Reading starts at the reader's current position.
+   * \param parser The parser to use to interpret the recorded frames
+   * \param timing Pace of the replay
+   */
+  ReplayProducer(RecordingReader& reader, Parser<T>& parser, const ReplayTiming timing = ReplayTiming::ORIGINAL)
+    : reader_(reader), parser_(parser), timing_(timing), running_(false), started_(false), finished_(false)
+  {
+  }
+
+  /*!
+   * \brief Prepares the replay. The timing of the replay starts with the first produced package.
+   *
+   * \param max_num_tries Not used
+   * \param reconnection_time Not used
+   */
+  void setupProducer(const size_t max_num_tries = 0,
+                     const std::chrono::milliseconds reconnection_time = std::chrono::seconds(10)) override
+  {
+    started_ = false;
+    finished_ = false;
+  }
+
+  /*!
+   * \brief Tears down the producer.
+   */
+  void teardownProducer() override
+  {
+    stopProducer();
+  }
+
+  /*!
+   * \brief Stops the producer. A replay waiting for the next package to become due returns.
+   */
+  void stopProducer() override
+  {
+    running_ = false;
+  }
+
+  void startProducer() override
+  {
+    running_ = true;
+  }
+
+  /*!
+   * \brief Parses the next frame of the recording. With ReplayTiming::ORIGINAL, waits until the frame
+   * is due.
+   *
+   * \param products Vector to append the produced packages to
+   *
+   * \returns True, if a frame was parsed or the producer was stopped, false at the end of the
+   * recording or if the frame could not be parsed. A frame that wasn't due when the producer got
+   * stopped is produced by the next call.
+   */
+  bool tryGet(std::vector<std::unique_ptr<T>>& products) override
+  {
+    RecordedFrame frame;
+    // The frame is only taken from the reader once it is due, so stopping doesn't lose it
+    if (!reader_.peek(frame))
+    {
+      finished_ = true;
+      return false;
+    }
+
+    if (timing_ == ReplayTiming::ORIGINAL && !waitUntilDue(frame.time))
+    {
+      return true;
+    }
+    reader_.next(frame);
+
+    // The parser needs a writable buffer, while the recording is mapped read-only
+    buffer_.assign(frame.data, frame.data + frame.size);
+    BinParser bp(buffer_.data(), buffer_.size());
+    const size_t first_new = products.size();
+    const bool result = parser_.parse(bp, products);
+    const auto parsed = std::chrono::steady_clock::now();
+    for (size_t i = first_new; i < products.size(); ++i)
+    {
+      PackageTimestamps& timestamps = products[i]->getTimestamps();
+      timestamps.received = frame.time;
+      timestamps.parsed = parsed;
+    }
+    return result;
+  }
+
+  /*!
+   * \brief Hands a product that is not used anymore to the parser for reuse.
+   *
+   * \param product The product that is not used anymore
+   */
+  void recycle(std::unique_ptr<T> product) override
+  {
+    parser_.recycle(std::move(product));
+  }
+
+  /*!
+   * \brief Produces all remaining packages of the recording and hands them to the given consumer
+   * from the calling thread. Returns early if stopProducer() is called from another thread.
+   *
+   * \param consumer Consumer to hand the packages to
+   *
+   * \returns The number of packages handed to the consumer
+   */
+  size_t replay(IConsumer<T>& consumer)
+  {
+    startProducer();
+    std::vector<std::unique_ptr<T>> products;
+    size_t num_products = 0;
+    while (running_ && tryGet(products))
+    {
+      for (auto& product : products)
+      {
+        consumer.consume(std::shared_ptr<T>(std::move(product)));
+        num_products++;
+      }
+      products.clear();
+    }
+    return num_products;
+  }
+
+  /*!
+   * \brief Checks whether the end of the recording has been reached.
+   *
+   * \returns True, if all frames have been replayed, false otherwise
+   */
+  bool finished() const
+  {
+    return finished_;
+  }
+
+private:
+  // Sleeps until a frame recorded at the given time is due. Returns false if the producer got
+  // stopped in the meantime.
+  bool waitUntilDue(const std::chrono::steady_clock::time_point recorded)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    if (!started_)
+    {
+      started_ = true;
+      replay_start_ = now;
+      recording_start_ = recorded;
+      return true;
+    }
+
+    const auto due = replay_start_ + (recorded - recording_start_);
+    // Sleep in slices, so that stopping the producer doesn't have to wait for long gaps in the
+    // recording
+    for (auto remaining = due - now; remaining.count() > 0; remaining = due - std::chrono::steady_clock::now())
+    {
+      if (!running_)
+      {
+        // The timing starts over with this frame when resuming
+        started_ = false;
+        return false;
+      }
+      std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(remaining, MAX_SLEEP));
+    }
+    return true;
+  }
+
+  static constexpr std::chrono::milliseconds MAX_SLEEP{ 100 };
+
+  RecordingReader& reader_;
+  Parser<T>& parser_;
+  ReplayTiming timing_;
+  std::atomic<bool> running_;
+  bool started_;
+  std::atomic<bool> finished_;
+  std::chrono::steady_clock::time_point replay_start_;
+  std::chrono::steady_clock::time_point recording_start_;
+  std::vector<uint8_t> buffer_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_REPLAY_PRODUCER_H_INCLUDED
@@ -24,9 +24,13 @@
 #include <sys/types.h>
 #include <atomic>
 #include <chrono>
+#include <memory>
 #include <mutex>
+#include <cstring>
 #include <string>
+#include <vector>
 #include "ur_client_library/log.h"
+#include "ur_client_library/comm/packet_capture.h"
 #include "ur_client_library/comm/tcp_socket.h"
 
 namespace urcl
@@ -38,6 +42,9 @@ namespace comm
  * out of the socket. This means, it has to have some knowledge about the package structure to
  * peek at the field defining the package length. This is why it is templated with the package
  * header type.
+ *
+ * Received data is buffered, so a single read from the socket provides as many packages as have
+ * arrived so far. Packages can be accessed directly inside this buffer using readPackage().
  */
 template <typename T>
 class URStream : public TCPSocket
@@ -50,7 +57,8 @@ public:
    * \param host IP address of the remote host
    * \param port Port on which the socket shall be connected
    */
-  URStream(const std::string& host, int port) : host_(host), port_(port)
+  URStream(const std::string& host, int port)
+    : host_(host), port_(port), receive_buffer_(RECEIVE_BUFFER_SIZE), buffer_begin_(0), buffer_end_(0)
   {
   }
 
@@ -66,6 +74,7 @@ public:
   bool connect(const size_t max_num_tries = 0,
                const std::chrono::milliseconds reconnection_time = std::chrono::seconds(10))
   {
+    clearReceiveBuffer();
     return TCPSocket::setup(host_, port_, max_num_tries, reconnection_time);
   }
 
@@ -76,6 +85,7 @@ public:
   {
     URCL_LOG_DEBUG("Disconnecting from %s:%d", host_.c_str(), port_);
     TCPSocket::close();
+    clearReceiveBuffer();
   }
 
   /*!
@@ -87,18 +97,61 @@ public:
   }
 
   /*!
-   * \brief Reads a full UR package out of a socket. For this, it looks into the package and reads
-   * the byte length from the socket directly. It returns as soon as all bytes for the package are
-   * read from the socket.
+   * \brief Reads a full UR package out of a socket and copies it into the given buffer. It returns
+   * as soon as all bytes for the package are received.
    *
    * \param[out] buf The byte buffer where the content shall be stored
    * \param[in] buf_len Number of bytes allocated for the buffer
-   * \param[out] read Number of bytes actually read from the socket
+   * \param[out] read Number of bytes of the package
    *
-   * \returns True on success, false on error, e.g. the buffer is smaller than the package size
+   * \returns True on success, false on error, e.g. the buffer is smaller than the package size. A
+   * package not fitting into the buffer is discarded.
    */
   bool read(uint8_t* buf, const size_t buf_len, size_t& read);
 
+  /*!
+   * \brief Reads a full UR package without copying it. Only if no complete package has been
+   * received already, data is read from the socket. A single read from the socket fetches as much
+   * data as available, so packages arriving in a burst are provided without reading from the
+   * socket again.
+   *
+   * The package is only valid until the next call of read() or readPackage(). Therefore, packages
+   * should only be read from one thread.
+   *
+   * \param[out] package Set to the beginning of the package inside the stream's receive buffer
+   * \param[out] length Number of bytes of the package
+   *
+   * \returns True on success, false on error, e.g. if the socket is closed or the receive timeout
+   * expired. Data of an incomplete package is kept in that case.
+   */
+  bool readPackage(uint8_t*& package, size_t& length);
+
+  /*!
+   * \brief Reads a full UR package without copying it, if one has been received already. In
+   * contrast to readPackage(), this never waits for data to arrive.
+   *
+   * The package is only valid until the next call of read(), readPackage() or tryReadPackage().
+   *
+   * \param[out] package Set to the beginning of the package inside the stream's receive buffer
+   * \param[out] length Number of bytes of the package
+   *
+   * \returns True, if a complete package was available, false otherwise
+   */
+  bool tryReadPackage(uint8_t*& package, size_t& length);
+
+  /*!
+   * \brief Returns the point in time at which the package most recently returned by readPackage()
+   * or tryReadPackage() was read from the socket. Packages that arrived in the same read share this
+   * time. The socket is only read again once all complete packages have been handed out, so a
+   * package's time isn't overwritten before it was returned.
+   *
+   * \returns The time of the last read from the socket
+   */
+  std::chrono::steady_clock::time_point getLastReadTime() const
+  {
+    return last_read_time_;
+  }
+
   /*!
    * \brief Writes directly to the underlying socket (with a mutex guard)
    *
@@ -120,17 +173,57 @@ public:
     return host_;
   }
 
+  /*!
+   * \brief Captures all bytes received and sent on this stream. Has to be called before
+   * connect(), as the capture is not synchronized with reading and writing.
+   *
+   * \param capture Capture to add the traffic to, nullptr disables capturing
+   * \param channel Channel the traffic is tagged with inside the capture
+   */
+  void setPacketCapture(std::shared_ptr<PacketCapture> capture, const uint32_t channel = 0)
+  {
+    capture_ = capture;
+    capture_channel_ = channel;
+  }
+
 private:
+  // Large enough to hold several packages of the primary interface
+  static constexpr size_t RECEIVE_BUFFER_SIZE = 65536;
+
+  bool readPackageUnlocked(uint8_t*& package, size_t& length, const bool blocking);
+  void clearReceiveBuffer()
+  {
+    std::lock_guard<std::mutex> lock(read_mutex_);
+    buffer_begin_ = 0;
+    buffer_end_ = 0;
+  }
+
   std::string host_;
   int port_;
   std::mutex write_mutex_, read_mutex_;
+
+  // Received data that has not been handed out, yet, is stored between buffer_begin_ and
+  // buffer_end_. It is moved to the front when there isn't enough space left for the next package.
+  std::vector<uint8_t> receive_buffer_;
+  size_t buffer_begin_;
+  size_t buffer_end_;
+  // Time at which the data between buffer_begin_ and buffer_end_ was last extended from the socket
+  std::chrono::steady_clock::time_point last_read_time_;
+
+  std::shared_ptr<PacketCapture> capture_;
+  uint32_t capture_channel_ = 0;
 };
 
 template <typename T>
 bool URStream<T>::write(const uint8_t* buf, const size_t buf_len, size_t& written)
 {
   std::lock_guard<std::mutex> lock(write_mutex_);
-  return TCPSocket::write(buf, buf_len, written);
+  const bool success = TCPSocket::write(buf, buf_len, written);
+  if (capture_ && written > 0)
+  {
+    capture_->capture(CaptureDirection::OUTBOUND, buf, written, capture_channel_);
+  }
+  return success;
 }
 
 template <typename T>
@@ -138,30 +231,93 @@ bool URStream<T>::read(uint8_t* buf, const size_t buf_len, size_t& total)
 {
   std::lock_guard<std::mutex> lock(read_mutex_);
 
-  bool initial = true;
-  uint8_t* buf_pos = buf;
-  size_t remainder = sizeof(typename T::HeaderType::_package_size_type);
-  size_t read = 0;
+  uint8_t* package;
+  size_t length;
+  total = 0;
+  if (!readPackageUnlocked(package, length, true))
+  {
+    return false;
+  }
+  if (length > buf_len)
+  {
+    URCL_LOG_ERROR("Packet size %zu is larger than buffer %zu, discarding.", length, buf_len);
+    return false;
+  }
+  std::memcpy(buf, package, length);
+  total = length;
+  return true;
+}
+
+template <typename T>
+bool URStream<T>::readPackage(uint8_t*& package, size_t& length)
+{
+  std::lock_guard<std::mutex> lock(read_mutex_);
+  return readPackageUnlocked(package, length, true);
+}
+
+template <typename T>
+bool URStream<T>::tryReadPackage(uint8_t*& package, size_t& length)
+{
+  std::lock_guard<std::mutex> lock(read_mutex_);
+  return readPackageUnlocked(package, length, false);
+}
 
-  while (remainder > 0 && TCPSocket::read(buf_pos, remainder, read))
+template <typename T>
+bool URStream<T>::readPackageUnlocked(uint8_t*& package, size_t& length, const bool blocking)
+{
+  const size_t size_field_length = sizeof(typename T::HeaderType::_package_size_type);
+  while (true)
   {
-    if (initial)
+    if (buffer_begin_ == buffer_end_)
+    {
+      buffer_begin_ = 0;
+      buffer_end_ = 0;
+    }
+
+    // Number of bytes needed to make progress: either the size field or the complete package
+    size_t needed = size_field_length;
+    const size_t available = buffer_end_ - buffer_begin_;
+    if (available >= size_field_length)
     {
-      remainder = T::HeaderType::getPackageLength(buf);
-      if (remainder >= (buf_len - sizeof(typename T::HeaderType::_package_size_type)))
+      needed = T::HeaderType::getPackageLength(receive_buffer_.data() + buffer_begin_);
+      if (needed < size_field_length || needed > receive_buffer_.size())
       {
-        URCL_LOG_ERROR("Packet size %zd is larger than buffer %zu, discarding.", remainder, buf_len);
+        URCL_LOG_ERROR("Received package with invalid size %zu, discarding received data.", needed);
+        buffer_begin_ = 0;
+        buffer_end_ = 0;
         return false;
       }
-      initial = false;
+      if (available >= needed)
+      {
+        package = receive_buffer_.data() + buffer_begin_;
+        length = needed;
+        buffer_begin_ += needed;
+        return true;
+      }
     }
 
-    total += read;
-    buf_pos += read;
-    remainder -= read;
-  }
+    if (buffer_begin_ + needed > receive_buffer_.size())
+    {
+      std::memmove(receive_buffer_.data(), receive_buffer_.data() + buffer_begin_, available);
+      buffer_begin_ = 0;
+      buffer_end_ = available;
+    }
 
-  return remainder == 0;
+    size_t read = 0;
+    uint8_t* free_space = receive_buffer_.data() + buffer_end_;
+    const size_t free_length = receive_buffer_.size() - buffer_end_;
+    if (blocking ? !TCPSocket::read(free_space, free_length, read) :
+                   !TCPSocket::readAvailable(free_space, free_length, read))
+    {
+      return false;
+    }
+    last_read_time_ = std::chrono::steady_clock::now();
+    if (capture_)
+    {
+      capture_->capture(CaptureDirection::INBOUND, free_space, read, capture_channel_);
+    }
+    buffer_end_ += read;
+  }
 }
 }  // namespace comm
 }  // namespace urcl
@@ -37,7 +37,12 @@
 #include <atomic>
 #include <chrono>
 #include <functional>
-#include <thread>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "ur_client_library/comm/event_loop.h"
+#include "ur_client_library/comm/packet_capture.h"
 
 namespace urcl
 {
@@ -56,6 +61,11 @@ namespace comm
  *
  *  While this server implementation supports multiple (number limited by system's socket
  *  implementation) clients by default, a maximum number of allowed clients can be configured.
+ *
+ *  Socket events are dispatched by an EventLoop using epoll. Client sockets are registered
+ *  edge-triggered, so only sockets with new activity are visited and each readable socket is
+ *  drained at once. By default, each server runs its own event loop in a separate thread. Multiple
+ *  servers can share one loop to serve all of their sockets from a single thread.
  */
 class TCPServer
 {
@@ -65,13 +75,16 @@ public:
    * \brief Create a TCPServer object
    *
    * \param port Port on which to operate. The port will be bound to the process creating the
-   * object.
+   * object. If 0 is given, the operating system chooses a free port, see getPort().
    * \param max_num_tries If binding the socket fails, it will be retried this many times. If 0 is
    * specified, binding the socket will be tried indefinitely.
    * \param reconnection_time Wait time in between binding attempts.
+   * \param event_loop Event loop handling the server's sockets. It has to be started separately.
+   * If none is given, the server creates its own loop and starts it in start().
    */
   explicit TCPServer(const int port, const size_t max_num_tries = 0,
-                     const std::chrono::milliseconds reconnection_time = std::chrono::seconds(1));
+                     const std::chrono::milliseconds reconnection_time = std::chrono::seconds(1),
+                     std::shared_ptr<EventLoop> event_loop = nullptr);
   virtual ~TCPServer();
 
   /*!
@@ -116,9 +129,9 @@ public:
   void start();
 
   /*!
-   * \brief Shut down the event listener thread. After calling this, no events will be handled
-   * anymore, but the socket will remain open and bound to the port. Call start() in order to
-   * restart event handling.
+   * \brief Shut down event handling. After calling this, no events will be handled anymore, but
+   * the socket will remain open and bound to the port. Call start() in order to restart event
+   * handling. If the server runs its own event loop, the loop's thread is stopped.
    */
   void shutdown();
 
@@ -135,6 +148,17 @@ public:
    */
   bool write(const int fd, const uint8_t* buf, const size_t buf_len, size_t& written);
 
+  /*!
+   * \brief Get the port the server is bound to
+   *
+   * \returns The port given on construction or, if that was 0, the port chosen by the operating
+   * system.
+   */
+  int getPort() const
+  {
+    return port_;
+  }
+
   /*!
    * \brief Get the maximum number of clients allowed to connect to this server
    *
@@ -156,6 +180,44 @@ public:
     max_clients_allowed_ = max_clients_allowed;
   }
 
+  /*!
+   * \brief Enables busy polling (SO_BUSY_POLL) on client sockets connecting after this call.
+   *
+   * With busy polling the kernel polls the network device for new data for the given time when
+   * reading from an empty socket instead of waiting for an interrupt. This reduces receive latency
+   * at the cost of CPU load. Values above the system's net.core.busy_read setting require the
+   * CAP_NET_ADMIN capability. If setting the option fails, a warning is printed and the socket is
+   * used without busy polling.
+   *
+   * \param busy_poll_time Time to busy poll when reading, 0 disables busy polling
+   */
+  void setBusyPollTime(const std::chrono::microseconds busy_poll_time)
+  {
+    busy_poll_time_ = busy_poll_time.count();
+  }
+
+  /*!
+   * \brief Get the time the kernel busy polls on client sockets.
+   *
+   * \returns The configured busy poll time. 0 means busy polling is disabled.
+   */
+  std::chrono::microseconds getBusyPollTime() const
+  {
+    return std::chrono::microseconds(busy_poll_time_);
+  }
+
+  /*!
+   * \brief Captures all bytes received from and sent to clients. The traffic is tagged with the
+   * client's file descriptor as channel. Has to be called before start(), as the capture is not
+   * synchronized with event handling.
+   *
+   * \param capture Capture to add the traffic to, nullptr disables capturing
+   */
+  void setPacketCapture(std::shared_ptr<PacketCapture> capture)
+  {
+    capture_ = capture;
+  }
+
 private:
   void init();
   void bind(const size_t max_num_tries, const std::chrono::milliseconds reconnection_time);
@@ -166,37 +228,32 @@ private:
 
   void handleDisconnect(const int fd);
 
-  //! read data from socket
+  //! Reads data from a socket until it is drained
   void readData(const int fd);
 
-  //! Event handler. Blocks until activity on any client or connection attempt
-  void spin();
-
-  //! Runs spin() as long as keep_running_ is set to true.
-  void worker();
+  //! Registers a client socket in the event loop
+  bool addClient(const int fd);
 
-  std::atomic<bool> keep_running_;
-  std::thread worker_thread_;
+  std::shared_ptr<EventLoop> event_loop_;
+  bool owns_event_loop_;
 
   std::atomic<int> listen_fd_;
   int port_;
 
-  int maxfd_;
-  fd_set masterfds_;
-  fd_set tempfds_;
-
   uint32_t max_clients_allowed_;
+  std::atomic<int> busy_poll_time_;
+  std::mutex clients_mutex_;
   std::vector<int> client_fds_;
 
-  // Pipe for the self-pipe trick (https://cr.yp.to/docs/selfpipe.html)
-  int self_pipe_[2];
-
   static const int INPUT_BUFFER_SIZE = 100;
-  char input_buffer_[INPUT_BUFFER_SIZE];
+  // One additional byte to terminate received data, so it can be used as a C string
+  char input_buffer_[INPUT_BUFFER_SIZE + 1];
 
   std::function<void(const int)> new_connection_callback_;
   std::function<void(const int)> disconnect_callback_;
   std::function<void(const int, char* buffer, int nbytesrecv)> message_callback_;
+
+  std::shared_ptr<PacketCapture> capture_;
 };
 
 }  // namespace comm
@@ -53,8 +53,14 @@ private:
   std::atomic<SocketState> state_;
   std::chrono::milliseconds reconnection_time_;
   bool reconnection_time_modified_deprecated_ = false;
+  std::atomic<bool> receive_timestamping_;
+  std::chrono::system_clock::time_point last_kernel_receive_time_;
+  std::chrono::nanoseconds last_hardware_receive_time_;
 
   void setupOptions();
+  void setupTimestamping();
+  void parseReceiveTimestamps(msghdr& msg);
+  bool receive(uint8_t* buf, const size_t buf_len, size_t& read, const int flags);
 
 protected:
   static bool open(int socket_fd, struct sockaddr* address, size_t address_len)
@@ -95,6 +101,48 @@ public:
     return socket_fd_;
   }
 
+  /*!
+   * \brief Enables or disables receive timestamps reported by the kernel. When enabled, the points
+   * in time at which data arrived at the network interface are available after each read. The
+   * setting is kept for later connections. This should be set before data is read from the socket.
+   *
+   * \param enabled Whether to request receive timestamps
+   */
+  void setReceiveTimestamping(const bool enabled);
+
+  /*!
+   * \brief Getter for whether receive timestamps are requested.
+   *
+   * \returns True, if receive timestamps are enabled, false otherwise
+   */
+  bool getReceiveTimestamping() const
+  {
+    return receive_timestamping_;
+  }
+
+  /*!
+   * \brief Point in time at which the kernel received the data returned by the last successful
+   * read. Only available if receive timestamps are enabled.
+   *
+   * \returns The kernel's receive timestamp or a zero time point if none is available
+   */
+  std::chrono::system_clock::time_point getLastKernelReceiveTime() const
+  {
+    return last_kernel_receive_time_;
+  }
+
+  /*!
+   * \brief Point in time at which the network interface received the data returned by the last
+   * successful read, given in the clock of the network interface. Only available if receive
+   * timestamps are enabled and the network interface supports hardware timestamping.
+   *
+   * \returns The hardware receive timestamp or zero if none is available
+   */
+  std::chrono::nanoseconds getLastHardwareReceiveTime() const
+  {
+    return last_hardware_receive_time_;
+  }
+
   /*!
    * \brief Determines the local IP address of the currently configured socket
    *
@@ -122,6 +170,18 @@ public:
    */
   bool read(uint8_t* buf, const size_t buf_len, size_t& read);
 
+  /*!
+   * \brief Reads data that is already available on the socket without waiting for new data to
+   * arrive
+   *
+   * \param[out] buf Buffer where the data shall be stored
+   * \param[in] buf_len Number of bytes allocated for the buffer
+   * \param[out] read Number of bytes actually read
+   *
+   * \returns True on success, false if no data is available or on error
+   */
+  bool readAvailable(uint8_t* buf, const size_t buf_len, size_t& read);
+
   /*!
    * \brief Writes to the socket
    *
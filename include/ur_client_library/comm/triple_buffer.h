@@ -0,0 +1,148 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_TRIPLE_BUFFER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_TRIPLE_BUFFER_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <utility>
+
+#include "ur_client_library/queue/atomicops.h"
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Wait-free single-producer single-consumer buffer that always holds the latest written
+ * value.
+ *
+ * The buffer consists of three slots. The writer owns one slot, the reader owns one slot and the
+ * third slot holds the most recently published value. Writing and reading exchange the owned slot
+ * with the published one, so neither side ever blocks the other and values are never copied.
+ * Values that get published but are overwritten before the reader picks them up are handed back to
+ * the writer.
+ *
+ * @tparam T Type of the stored values. Has to be default constructible and swappable.
+ */
+template <typename T>
+class TripleBuffer
+{
+public:
+  TripleBuffer() : state_(1), back_(0), front_(2)
+  {
+  }
+
+  /*!
+   * \brief Publishes a new value. Only one thread may write at a time.
+   *
+   * \param value The value to publish. After the call it contains the previous content of the slot
+   * that is now owned by the writer. This is either a value the reader has handed back or a value
+   * that was never read.
+   *
+   * \returns True, if a published value got overwritten before it was read, false otherwise
+   */
+  bool write(T& value)
+  {
+    std::swap(slots_[back_], value);
+    uint8_t old_state = state_.exchange(back_ | FRESH_BIT, std::memory_order_acq_rel);
+    back_ = old_state & INDEX_MASK;
+    bool overwritten = (old_state & FRESH_BIT) != 0;
+    if (!overwritten)
+    {
+      fresh_.signal();
+    }
+    return overwritten;
+  }
+
+  /*!
+   * \brief Fetches the latest published value, if it hasn't been read already. Only one thread may
+   * read at a time.
+   *
+   * \param value Target to store the value into. Its previous content is handed back to the writer.
+   *
+   * \returns True, if a new value was read, false otherwise
+   */
+  bool tryRead(T& value)
+  {
+    if ((state_.load(std::memory_order_acquire) & FRESH_BIT) == 0)
+    {
+      return false;
+    }
+    uint8_t old_state = state_.exchange(front_, std::memory_order_acq_rel);
+    front_ = old_state & INDEX_MASK;
+    std::swap(slots_[front_], value);
+    return true;
+  }
+
+  /*!
+   * \brief Fetches the latest published value. If no new value is available, waits for one to be
+   * published.
+   *
+   * \param value Target to store the value into. Its previous content is handed back to the writer.
+   * \param timeout Maximum time to wait for a new value
+   *
+   * \returns True, if a new value was read, false if the timeout expired
+   */
+  bool waitRead(T& value, std::chrono::microseconds timeout)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!tryRead(value))
+    {
+      auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(deadline - std::chrono::steady_clock::now());
+      if (remaining.count() <= 0 || !fresh_.wait(remaining.count()))
+      {
+        return tryRead(value);
+      }
+    }
+    // The signal belonging to this value might not have been consumed, yet. A remaining signal
+    // only results in an additional iteration of the loop above.
+    fresh_.tryWait();
+    return true;
+  }
+
+private:
+  static constexpr uint8_t INDEX_MASK = 0x3;
+  static constexpr uint8_t FRESH_BIT = 0x4;
+
+  T slots_[3];
+  // Index of the published slot and whether it has been read already
+  std::atomic<uint8_t> state_;
+  uint8_t back_;
+  uint8_t front_;
+  moodycamel::spsc_sema::LightweightSemaphore fresh_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_TRIPLE_BUFFER_H_INCLUDED
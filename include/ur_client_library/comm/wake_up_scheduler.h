@@ -0,0 +1,192 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_WAKE_UP_SCHEDULER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_WAKE_UP_SCHEDULER_H_INCLUDED
+
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+
+namespace urcl
+{
+namespace comm
+{
+/*!
+ * \brief Predicts when the next package of a periodic stream arrives, so that a control loop can
+ * sleep until shortly before that point in time instead of waiting to be woken up by the receiving
+ * thread.
+ *
+ * The period and the phase of the arrivals are tracked similar to a phase-locked loop: Each
+ * arrival is compared to the predicted one and the deviation is used to correct the phase and,
+ * to a smaller extent, the period. Missing arrivals are skipped and arrivals within the same
+ * period, e.g. multiple packages received at once, only count once. The mean absolute deviation
+ * from the prediction is tracked as jitter.
+ *
+ * Arrivals can be added and predictions can be read from different threads.
+ */
+class WakeUpScheduler
+{
+public:
+  /*!
+   * \brief Creates a new WakeUpScheduler.
+   *
+   * \param spin_duration Time to wake up before the predicted arrival in addition to the jitter.
+   * Until the package arrives, waitForNextArrival() polls for it.
+   */
+  explicit WakeUpScheduler(const std::chrono::nanoseconds spin_duration = std::chrono::microseconds(50));
+  virtual ~WakeUpScheduler() = default;
+
+  /*!
+   * \brief Forgets all previous arrivals.
+   *
+   * \param nominal_period Expected period of the arrivals. This only serves as the initial value
+   * and gets refined with each arrival. If zero, the period is learned from the first two arrivals.
+   */
+  void reset(const std::chrono::nanoseconds nominal_period = std::chrono::nanoseconds(0));
+
+  /*!
+   * \brief Adds the point in time at which a package arrived.
+   *
+   * \param arrival Arrival time of the package
+   */
+  void addArrival(const std::chrono::steady_clock::time_point arrival);
+
+  /*!
+   * \brief Checks whether enough arrivals have been seen to predict the next one.
+   *
+   * \returns True, if the period and phase of the arrivals are known
+   */
+  bool hasPrediction() const;
+
+  /*!
+   * \brief Predicts the arrival following the latest one.
+   *
+   * \returns The predicted arrival time or a default constructed time point, if no prediction is
+   * available.
+   */
+  std::chrono::steady_clock::time_point getNextArrival() const;
+
+  /*!
+   * \brief Getter for the estimated period of the arrivals.
+   *
+   * \returns The period or zero, if no period is known, yet.
+   */
+  std::chrono::nanoseconds getPeriod() const;
+
+  /*!
+   * \brief Getter for the mean absolute deviation of the arrivals from their prediction.
+   *
+   * \returns The jitter
+   */
+  std::chrono::nanoseconds getJitter() const;
+
+  /*!
+   * \brief Sleeps until shortly before the next predicted arrival and then polls for the package
+   * until it arrived or is overdue.
+   *
+   * \param try_fetch Callable returning true once the package has been fetched. It is called at
+   * least once, if a prediction is available.
+   *
+   * \returns True, if \p try_fetch succeeded, false if no prediction is available or the package
+   * didn't arrive in time
+   */
+  template <typename Predicate>
+  bool waitForNextArrival(Predicate try_fetch) const
+  {
+    std::chrono::steady_clock::time_point wake_up;
+    std::chrono::steady_clock::time_point deadline;
+    if (!getWaitWindow(wake_up, deadline))
+    {
+      return false;
+    }
+    sleep(wake_up);
+    do
+    {
+      if (try_fetch())
+      {
+        return true;
+      }
+    } while (now() < deadline);
+    return false;
+  }
+
+  /*!
+   * \brief Sleeps until the given point in time using an absolute timer, so that the wake-up time
+   * doesn't depend on when the call was made. This can e.g. be used to wait for the earliest of
+   * multiple schedulers' predictions.
+   *
+   * Threads without real-time priority might wake up later due to the kernel's timer slack, which
+   * is 50us by default.
+   *
+   * \param time_point Point in time to wake up at. If it lies in the past, the call returns
+   * immediately.
+   */
+  static void sleepUntil(const std::chrono::steady_clock::time_point time_point);
+
+protected:
+  /*!
+   * \brief Reads the clock used by waitForNextArrival(). Tests can override this together with
+   * sleep() to run the scheduler on a simulated clock.
+   *
+   * \returns The current time
+   */
+  virtual std::chrono::steady_clock::time_point now() const;
+
+  /*!
+   * \brief Sleeps until the given point in time on the clock read by now(), see sleepUntil().
+   *
+   * \param time_point Point in time to wake up at
+   */
+  virtual void sleep(const std::chrono::steady_clock::time_point time_point) const;
+
+private:
+  // Gains used to correct the phase and the period based on the deviation of an arrival from its
+  // prediction and to average the jitter.
+  static constexpr double PHASE_GAIN = 0.1;
+  static constexpr double PERIOD_GAIN = 0.01;
+  static constexpr double JITTER_GAIN = 0.05;
+
+  bool getWaitWindow(std::chrono::steady_clock::time_point& wake_up,
+                     std::chrono::steady_clock::time_point& deadline) const;
+
+  mutable std::mutex mutex_;
+  std::chrono::nanoseconds spin_duration_;
+  size_t num_arrivals_;
+  // Phase corrected time of the latest arrival in nanoseconds
+  double last_arrival_;
+  double period_;
+  double jitter_;
+};
+
+}  // namespace comm
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_WAKE_UP_SCHEDULER_H_INCLUDED
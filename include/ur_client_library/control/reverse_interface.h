@@ -78,9 +78,12 @@ public:
    * \param port Port the Server is started on
    * \param handle_program_state Function handle to a callback on program state changes.
    * \param step_time The robots step time
+   * \param event_loop Event loop to serve the server's sockets on. If none is given, the server
+   * runs its own loop.
    */
   ReverseInterface(uint32_t port, std::function<void(bool)> handle_program_state,
-                   std::chrono::milliseconds step_time = std::chrono::milliseconds(8));
+                   std::chrono::milliseconds step_time = std::chrono::milliseconds(8),
+                   std::shared_ptr<comm::EventLoop> event_loop = nullptr);
 
   /*!
    * \brief Disconnects possible clients so the reverse interface object can be safely destroyed.
@@ -141,6 +144,27 @@ public:
                "commands.")]] virtual void
   setKeepaliveCount(const uint32_t count);
 
+  /*!
+   * \brief Enables busy polling on the reverse socket to reduce receive latency, see
+   * comm::TCPServer::setBusyPollTime(). It takes effect when the robot connects the next time.
+   *
+   * \param busy_poll_time Time to busy poll when reading, 0 disables busy polling
+   */
+  void setBusyPollTime(const std::chrono::microseconds busy_poll_time)
+  {
+    server_.setBusyPollTime(busy_poll_time);
+  }
+
+  /*!
+   * \brief Get the port the robot connects to, see comm::TCPServer::getPort().
+   *
+   * \returns The port of the interface's server
+   */
+  int getPort() const
+  {
+    return server_.getPort();
+  }
+
 protected:
   virtual void connectionCallback(const int filedescriptor);
 
@@ -60,8 +60,10 @@ public:
    * \brief Creates a ScriptCommandInterface object, including a new TCPServer
    *
    * \param port Port to start the server on
+   * \param event_loop Event loop to serve the server's sockets on. If none is given, the server
+   * runs its own loop.
    */
-  ScriptCommandInterface(uint32_t port);
+  ScriptCommandInterface(uint32_t port, std::shared_ptr<comm::EventLoop> event_loop = nullptr);
 
   /*!
    * \brief Zero the force torque sensor
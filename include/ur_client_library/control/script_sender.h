@@ -53,8 +53,20 @@ public:
    *
    * \param port Port to start the server on
    * \param program Program to send to the robot upon request
+   * \param event_loop Event loop to serve the server's sockets on. If none is given, the server
+   * runs its own loop.
    */
-  ScriptSender(uint32_t port, const std::string& program);
+  ScriptSender(uint32_t port, const std::string& program, std::shared_ptr<comm::EventLoop> event_loop = nullptr);
+
+  /*!
+   * \brief Get the port the robot requests the program from, see comm::TCPServer::getPort().
+   *
+   * \returns The port of the sender's server
+   */
+  int getPort() const
+  {
+    return server_.getPort();
+  }
 
 private:
   comm::TCPServer server_;
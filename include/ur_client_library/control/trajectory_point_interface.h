@@ -82,8 +82,10 @@ public:
    * \brief Creates a TrajectoryPointInterface object including a TCPServer.
    *
    * \param port Port the Server is started on
+   * \param event_loop Event loop to serve the server's sockets on. If none is given, the server
+   * runs its own loop.
    */
-  TrajectoryPointInterface(uint32_t port);
+  TrajectoryPointInterface(uint32_t port, std::shared_ptr<comm::EventLoop> event_loop = nullptr);
 
   /*!
    * \brief Disconnects possible clients so the reverse interface object can be safely destroyed.
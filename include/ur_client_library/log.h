@@ -18,6 +18,7 @@
 
 #pragma once
 #include <inttypes.h>
+#include <cstddef>
 #include <memory>
 
 #define URCL_LOG_DEBUG(...) urcl::log(__FILE__, __LINE__, urcl::LogLevel::DEBUG, __VA_ARGS__)
@@ -78,6 +79,32 @@ void unregisterLogHandler();
  */
 void setLogLevel(LogLevel level);
 
+/*!
+ * \brief Switches to asynchronous logging.
+ *
+ * Instead of calling the log handler, logging formats the message into a preallocated ring buffer
+ * of the calling thread, which doesn't lock or allocate memory once the thread has logged its first
+ * message. A background thread with normal scheduling priority hands the messages to the log
+ * handler, so slow handlers don't block real-time threads. Messages longer than 1023 characters
+ * are truncated and messages of different threads may be reordered. If a thread's ring buffer is
+ * full, its messages are dropped.
+ *
+ * Consecutive identical messages are only passed to the log handler once, followed by the number
+ * of repetitions. Messages from one source location exceeding the rate limit are suppressed.
+ * Dropped and suppressed messages are reported once per second.
+ *
+ * \param messages_per_thread Number of messages each thread can buffer
+ * \param max_messages_per_second Maximum number of messages per second passed to the log handler
+ * from a single source location. 0 disables rate limiting.
+ */
+void startAsyncLogging(const size_t messages_per_thread = 128, const size_t max_messages_per_second = 20);
+
+/*!
+ * \brief Passes all buffered messages to the log handler and switches back to synchronous
+ * logging.
+ */
+void stopAsyncLogging();
+
 /*!
  * \brief Log a message, this is used internally by the macros to unpack the log message.
  * Use the macros instead of this function directly.
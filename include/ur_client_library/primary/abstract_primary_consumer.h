@@ -32,7 +32,15 @@
 #include "ur_client_library/log.h"
 #include "ur_client_library/comm/pipeline.h"
 #include "ur_client_library/primary/robot_message/version_message.h"
+#include "ur_client_library/primary/robot_state/additional_info.h"
+#include "ur_client_library/primary/robot_state/cartesian_info.h"
+#include "ur_client_library/primary/robot_state/force_mode_data.h"
+#include "ur_client_library/primary/robot_state/joint_data.h"
 #include "ur_client_library/primary/robot_state/kinematics_info.h"
+#include "ur_client_library/primary/robot_state/masterboard_data.h"
+#include "ur_client_library/primary/robot_state/robot_mode_data.h"
+#include "ur_client_library/primary/robot_state/tool_communication_info.h"
+#include "ur_client_library/primary/robot_state/tool_data.h"
 
 namespace urcl
 {
@@ -74,6 +82,41 @@ public:
   virtual bool consume(VersionMessage& pkg) = 0;
   virtual bool consume(KinematicsInfo& pkg) = 0;
 
+  // The following robot states are handled like any other robot state, unless a consumer is
+  // interested in them.
+  virtual bool consume(RobotModeData& pkg)
+  {
+    return consume(static_cast<RobotState&>(pkg));
+  }
+  virtual bool consume(JointData& pkg)
+  {
+    return consume(static_cast<RobotState&>(pkg));
+  }
+  virtual bool consume(ToolData& pkg)
+  {
+    return consume(static_cast<RobotState&>(pkg));
+  }
+  virtual bool consume(MasterboardData& pkg)
+  {
+    return consume(static_cast<RobotState&>(pkg));
+  }
+  virtual bool consume(CartesianInfo& pkg)
+  {
+    return consume(static_cast<RobotState&>(pkg));
+  }
+  virtual bool consume(ForceModeData& pkg)
+  {
+    return consume(static_cast<RobotState&>(pkg));
+  }
+  virtual bool consume(AdditionalInfo& pkg)
+  {
+    return consume(static_cast<RobotState&>(pkg));
+  }
+  virtual bool consume(ToolCommunicationInfo& pkg)
+  {
+    return consume(static_cast<RobotState&>(pkg));
+  }
+
 private:
   /* data */
 };
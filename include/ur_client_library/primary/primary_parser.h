@@ -19,6 +19,7 @@
  */
 
 #pragma once
+#include <bitset>
 #include <vector>
 #include "ur_client_library/comm/bin_parser.h"
 #include "ur_client_library/comm/pipeline.h"
@@ -26,7 +27,15 @@
 #include "ur_client_library/primary/package_header.h"
 #include "ur_client_library/primary/robot_state.h"
 #include "ur_client_library/primary/robot_message.h"
+#include "ur_client_library/primary/robot_state/additional_info.h"
+#include "ur_client_library/primary/robot_state/cartesian_info.h"
+#include "ur_client_library/primary/robot_state/force_mode_data.h"
+#include "ur_client_library/primary/robot_state/joint_data.h"
 #include "ur_client_library/primary/robot_state/kinematics_info.h"
+#include "ur_client_library/primary/robot_state/masterboard_data.h"
+#include "ur_client_library/primary/robot_state/robot_mode_data.h"
+#include "ur_client_library/primary/robot_state/tool_communication_info.h"
+#include "ur_client_library/primary/robot_state/tool_data.h"
 #include "ur_client_library/primary/robot_message/version_message.h"
 
 namespace urcl
@@ -40,9 +49,73 @@ namespace primary_interface
 class PrimaryParser : public comm::Parser<PrimaryPackage>
 {
 public:
-  PrimaryParser() = default;
+  PrimaryParser() : filtered_(false)
+  {
+  }
   virtual ~PrimaryParser() = default;
 
+  /*!
+   * \brief Registers interest in the given robot state and robot message types. Once any type got
+   * subscribed, only packages of subscribed types are created. All others are skipped by their
+   * length field without being allocated or copied. Multiple consumers can subscribe to the types
+   * they need one after another.
+   *
+   * This has to be called before the parser is used by a producer.
+   *
+   * \param robot_states Robot state sub-package types to create packages for
+   * \param robot_messages Robot message types to create packages for
+   */
+  void subscribe(const std::vector<RobotStateType>& robot_states,
+                 const std::vector<RobotMessagePackageType>& robot_messages = {})
+  {
+    filtered_ = true;
+    for (const auto type : robot_states)
+    {
+      subscribed_robot_states_.set(static_cast<uint8_t>(type));
+    }
+    for (const auto type : robot_messages)
+    {
+      subscribed_robot_messages_.set(static_cast<uint8_t>(type));
+    }
+  }
+
+  /*!
+   * \brief Removes all subscriptions, so that packages of all types are created again. This is the
+   * default.
+   *
+   * This has to be called before the parser is used by a producer.
+   */
+  void subscribeAll()
+  {
+    filtered_ = false;
+    subscribed_robot_states_.reset();
+    subscribed_robot_messages_.reset();
+  }
+
+  /*!
+   * \brief Checks whether packages of a robot state type are created.
+   *
+   * \param type Robot state type to check
+   *
+   * \returns True, if the type is subscribed or no subscriptions were made, false otherwise
+   */
+  bool isSubscribed(const RobotStateType type) const
+  {
+    return !filtered_ || subscribed_robot_states_.test(static_cast<uint8_t>(type));
+  }
+
+  /*!
+   * \brief Checks whether packages of a robot message type are created.
+   *
+   * \param type Robot message type to check
+   *
+   * \returns True, if the type is subscribed or no subscriptions were made, false otherwise
+   */
+  bool isSubscribed(const RobotMessagePackageType type) const
+  {
+    return !filtered_ || subscribed_robot_messages_.test(static_cast<uint8_t>(type));
+  }
+
   /*!
    * \brief Uses the given BinParser to create package objects from the contained serialization.
    *
@@ -63,6 +136,12 @@ public:
     {
       case RobotPackageType::ROBOT_STATE:
       {
+        if (filtered_ && subscribed_robot_states_.none())
+        {
+          bp.consume();
+          return true;
+        }
+
         while (!bp.empty())
         {
           if (!bp.checkSize(sizeof(uint32_t)))
@@ -83,6 +162,12 @@ public:
           RobotStateType type;
           sbp.parse(type);
 
+          if (!isSubscribed(type))
+          {
+            sbp.consume();
+            continue;
+          }
+
           std::unique_ptr<PrimaryPackage> packet(stateFromType(type));
 
           if (packet == nullptr)
@@ -122,6 +207,12 @@ public:
         bp.parse(source);
         bp.parse(message_type);
 
+        if (!isSubscribed(message_type))
+        {
+          bp.consume();
+          return true;
+        }
+
         std::unique_ptr<PrimaryPackage> packet(messageFromType(message_type, timestamp, source));
         if (!packet->parseWith(bp))
         {
@@ -149,19 +240,33 @@ private:
   {
     switch (type)
     {
-      /*case robot_state_type::ROBOT_MODE_DATA:
-        // SharedRobotModeData* rmd = new SharedRobotModeData();
-
-        //return new rmd;
-      case robot_state_type::MASTERBOARD_DATA:
-        return new MBD;*/
+      case RobotStateType::ROBOT_MODE_DATA:
+        return new RobotModeData(type);
+      case RobotStateType::JOINT_DATA:
+        return new JointData(type);
+      case RobotStateType::TOOL_DATA:
+        return new ToolData(type);
+      case RobotStateType::MASTERBOARD_DATA:
+        return new MasterboardData(type);
+      case RobotStateType::CARTESIAN_INFO:
+        return new CartesianInfo(type);
       case RobotStateType::KINEMATICS_INFO:
         return new KinematicsInfo(type);
+      case RobotStateType::FORCE_MODE_DATA:
+        return new ForceModeData(type);
+      case RobotStateType::ADDITIONAL_INFO:
+        return new AdditionalInfo(type);
+      case RobotStateType::TOOL_COMM_INFO:
+        return new ToolCommunicationInfo(type);
       default:
         return new RobotState(type);
     }
   }
 
+  bool filtered_;
+  std::bitset<256> subscribed_robot_states_;
+  std::bitset<256> subscribed_robot_messages_;
+
   RobotMessage* messageFromType(RobotMessagePackageType type, uint64_t timestamp, uint8_t source)
   {
     switch (type)
@@ -50,7 +50,10 @@ enum class RobotStateType : uint8_t
   CONFIGURATION_DATA = 6,
   FORCE_MODE_DATA = 7,
   ADDITIONAL_INFO = 8,
-  CALIBRATION_DATA = 9
+  CALIBRATION_DATA = 9,
+  SAFETY_DATA = 10,
+  TOOL_COMM_INFO = 11,
+  TOOL_MODE_INFO = 12
 };
 
 /*!
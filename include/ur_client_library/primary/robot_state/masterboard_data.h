@@ -0,0 +1,119 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_MASTERBOARD_DATA_H_INCLUDED
+#define UR_CLIENT_LIBRARY_MASTERBOARD_DATA_H_INCLUDED
+
+#include "ur_client_library/primary/robot_state.h"
+
+namespace urcl
+{
+namespace primary_interface
+{
+/*!
+ * \brief This message contains the state of the control box's I/Os, its power supply and the
+ * robot's safety mode.
+ */
+class MasterboardData : public RobotState
+{
+public:
+  MasterboardData() = delete;
+  /*!
+   * \brief Creates a new MasterboardData object.
+   *
+   * \param type The type of RobotState message received
+   */
+  MasterboardData(const RobotStateType type) : RobotState(type)
+  {
+  }
+  virtual ~MasterboardData() = default;
+
+  /*!
+   * \brief Sets the attributes of the package by parsing a serialized representation of the
+   * package.
+   *
+   * \param bp A parser containing a serialized version of the package
+   *
+   * \returns True, if the package was parsed successfully, false otherwise
+   */
+  virtual bool parseWith(comm::BinParser& bp);
+
+  /*!
+   * \brief Consume this specific package with a specific consumer.
+   *
+   * \param consumer Placeholder for the consumer calling this
+   *
+   * \returns true on success
+   */
+  virtual bool consumeWith(AbstractPrimaryConsumer& consumer);
+
+  /*!
+   * \brief Produces a human readable representation of the package object.
+   *
+   * \returns A string representing the object
+   */
+  virtual std::string toString() const;
+
+  uint32_t digital_input_bits_;
+  uint32_t digital_output_bits_;
+  uint8_t analog_input_range0_;
+  uint8_t analog_input_range1_;
+  double analog_input0_;
+  double analog_input1_;
+  uint8_t analog_output_domain0_;
+  uint8_t analog_output_domain1_;
+  double analog_output0_;
+  double analog_output1_;
+  float masterboard_temperature_;
+  float robot_voltage_48v_;
+  float robot_current_;
+  float master_io_current_;
+  //! One of the values of urcl::SafetyMode
+  uint8_t safety_mode_;
+  bool in_reduced_mode_;
+  bool euromap67_interface_installed_;
+  //! Only set if a Euromap67 interface is installed
+  uint32_t euromap_input_bits_ = 0;
+  //! Only set if a Euromap67 interface is installed
+  uint32_t euromap_output_bits_ = 0;
+  //! Only set if a Euromap67 interface is installed
+  float euromap_voltage_24v_ = 0.0f;
+  //! Only set if a Euromap67 interface is installed
+  float euromap_current_ = 0.0f;
+  //! Only sent by controllers supporting an operational mode selector
+  uint8_t operational_mode_selector_input_ = 0;
+  //! Only sent by controllers supporting a three position enabling device
+  uint8_t three_position_enabling_device_input_ = 0;
+};
+
+}  // namespace primary_interface
+}  // namespace urcl
+
+#endif  // ifndef UR_CLIENT_LIBRARY_MASTERBOARD_DATA_H_INCLUDED
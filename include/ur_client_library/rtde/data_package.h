@@ -29,10 +29,14 @@
 #ifndef UR_CLIENT_LIBRARY_DATA_PACKAGE_H_INCLUDED
 #define UR_CLIENT_LIBRARY_DATA_PACKAGE_H_INCLUDED
 
+#include <cstring>
+#include <memory>
 #include <unordered_map>
 #include <variant>
 #include <vector>
 
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
 #include "ur_client_library/types.h"
 #include "ur_client_library/rtde/rtde_package.h"
 
@@ -53,9 +57,22 @@ enum class RUNTIME_STATE : uint32_t
   RESUMING = 5
 };
 
+template <typename T>
+class FieldHandle;
+
+template <typename... Fields>
+class Recipe;
+
+class StateHistory;
+
 /*!
  * \brief The DataPackage class handles communication in the form of RTDE data packages both to and
  * from the robot. It contains functionality to parse and serialize packages for arbitrary recipes.
+ *
+ * All fields of a package are stored in one contiguous buffer. The position of each field inside
+ * that buffer is given by a RecipeLayout, which is computed once per recipe and shared between all
+ * packages using that recipe. Fields can either be accessed by name or, without any lookup, by a
+ * FieldHandle obtained from the layout.
  */
 class DataPackage : public RTDEPackage
 {
@@ -63,12 +80,195 @@ public:
   using _rtde_type_variant = std::variant<bool, uint8_t, uint32_t, uint64_t, int32_t, double, vector3d_t, vector6d_t,
                                           vector6int32_t, vector6uint32_t, std::string>;
 
+  /*!
+   * \brief A recipe resolved into a flat memory layout. Each field of the recipe gets a fixed
+   * offset inside the data buffer of a DataPackage.
+   */
+  class RecipeLayout
+  {
+  public:
+    /*!
+     * \brief Description of a single field inside the layout.
+     */
+    struct Field
+    {
+      std::string name;
+      size_t offset;
+      // Prototype from the global type list, nullptr if the field is unknown
+      const _rtde_type_variant* type;
+    };
+
+    /*!
+     * \brief A sequence of consecutive fields consisting of values of the same size, e.g. a double
+     * followed by two vector6d_t. Such a sequence is converted from network encoding in one go.
+     */
+    struct Run
+    {
+      size_t offset;
+      size_t value_size;
+      size_t count;
+      bool is_bool;
+    };
+
+    /*!
+     * \brief Function parsing all fields of a recipe from a serialized package into the flat data
+     * buffer.
+     */
+    using ParseFunction = void (*)(comm::BinParser& bp, uint8_t* data);
+
+    /*!
+     * \brief Function serializing all fields of a recipe from the flat data buffer. Returns the
+     * number of bytes written.
+     */
+    using SerializeFunction = size_t (*)(const uint8_t* data, uint8_t* buffer);
+
+    RecipeLayout() = delete;
+
+    /*!
+     * \brief Resolves the given recipe into a flat memory layout.
+     *
+     * \param recipe The recipe to resolve
+     */
+    explicit RecipeLayout(const std::vector<std::string>& recipe);
+
+    /*!
+     * \brief Resolves the given recipe into a flat memory layout, that is parsed and serialized
+     * using the given functions instead of looking at the type of each field. This is used by
+     * recipes that are known at compile time, see Recipe.
+     *
+     * \param recipe The recipe to resolve
+     * \param parse_function Function parsing all fields of the recipe
+     * \param serialize_function Function serializing all fields of the recipe
+     */
+    RecipeLayout(const std::vector<std::string>& recipe, ParseFunction parse_function,
+                 SerializeFunction serialize_function);
+
+    /*!
+     * \brief Creates a handle for direct access to a field of all packages using this layout.
+     *
+     * \param name The string identifier for the data field as used in the documentation.
+     *
+     * \throws UrException if the field is not part of the recipe or is not of type T.
+     *
+     * \returns A handle to the requested field
+     */
+    template <typename T>
+    FieldHandle<T> getFieldHandle(const std::string& name) const;
+
+    /*!
+     * \brief Searches the layout for a field with the given name.
+     *
+     * \param name The string identifier for the data field as used in the documentation.
+     *
+     * \returns Pointer to the field description, nullptr if the field is not part of the recipe
+     */
+    const Field* findField(const std::string& name) const
+    {
+      auto it = indices_.find(name);
+      if (it == indices_.end())
+      {
+        return nullptr;
+      }
+      return &fields_[it->second];
+    }
+
+    /*!
+     * \brief Getter for the recipe this layout was created from.
+     *
+     * \returns The field names in recipe order
+     */
+    std::vector<std::string> getRecipe() const
+    {
+      std::vector<std::string> recipe;
+      recipe.reserve(fields_.size());
+      for (auto& field : fields_)
+      {
+        recipe.push_back(field.name);
+      }
+      return recipe;
+    }
+
+    /*!
+     * \brief Getter for the descriptions of all fields in recipe order.
+     *
+     * \returns The fields of the layout
+     */
+    const std::vector<Field>& getFields() const
+    {
+      return fields_;
+    }
+
+    /*!
+     * \brief Getter for the sequences of same sized values making up the layout. Only fields that
+     * could be resolved are part of a run.
+     *
+     * \returns The runs in recipe order
+     */
+    const std::vector<Run>& getRuns() const
+    {
+      return runs_;
+    }
+
+    /*!
+     * \brief Getter for the number of bytes needed to store all fields of the recipe.
+     *
+     * \returns The storage size
+     */
+    size_t getStorageSize() const
+    {
+      return storage_size_;
+    }
+
+    /*!
+     * \brief Checks whether all fields of the recipe are known.
+     *
+     * \returns True, if every field of the recipe could be resolved, false otherwise
+     */
+    bool isComplete() const
+    {
+      return complete_;
+    }
+
+    /*!
+     * \brief Getter for the function parsing all fields of the recipe at once.
+     *
+     * \returns The parse function, nullptr if fields are parsed one by one based on their type
+     */
+    ParseFunction getParseFunction() const
+    {
+      return parse_function_;
+    }
+
+    /*!
+     * \brief Getter for the function serializing all fields of the recipe at once.
+     *
+     * \returns The serialize function, nullptr if fields are serialized one by one based on their
+     * type
+     */
+    SerializeFunction getSerializeFunction() const
+    {
+      return serialize_function_;
+    }
+
+  private:
+    std::vector<Field> fields_;
+    std::vector<Run> runs_;
+    std::unordered_map<std::string, size_t> indices_;
+    size_t storage_size_;
+    bool complete_;
+    ParseFunction parse_function_;
+    SerializeFunction serialize_function_;
+  };
+
   DataPackage() = delete;
 
-  DataPackage(const DataPackage& other) : DataPackage(other.recipe_)
+  DataPackage(const DataPackage& other)
+    : RTDEPackage(PackageType::RTDE_DATA_PACKAGE)
+    , recipe_id_(other.recipe_id_)
+    , layout_(other.layout_)
+    , data_(other.data_)
+    , protocol_version_(other.protocol_version_)
   {
-    this->data_ = other.data_;
-    this->protocol_version_ = other.protocol_version_;
   }
 
   /*!
@@ -79,11 +279,44 @@ public:
    * \param protocol_version Protocol version used for the RTDE communication
    */
   DataPackage(const std::vector<std::string>& recipe, const uint16_t& protocol_version = 2)
-    : RTDEPackage(PackageType::RTDE_DATA_PACKAGE), recipe_(recipe), protocol_version_(protocol_version)
+    : DataPackage(std::make_shared<const RecipeLayout>(recipe), protocol_version)
+  {
+  }
+
+  /*!
+   * \brief Creates a new DataPackage object, based on an already resolved recipe layout.
+   *
+   * \param layout The layout of the used recipe
+   *
+   * \param protocol_version Protocol version used for the RTDE communication
+   */
+  DataPackage(std::shared_ptr<const RecipeLayout> layout, const uint16_t& protocol_version = 2)
+    : RTDEPackage(PackageType::RTDE_DATA_PACKAGE)
+    , recipe_id_(0)
+    , layout_(layout)
+    , data_(layout_->getStorageSize(), 0)
+    , protocol_version_(protocol_version)
   {
   }
   virtual ~DataPackage() = default;
 
+  /*!
+   * \brief Copies the recipe and all field values of another package into this package. For packages
+   * sharing the same recipe layout this reuses the existing storage and does not allocate.
+   *
+   * \param other The package to copy from
+   *
+   * \returns A reference to this package
+   */
+  DataPackage& operator=(const DataPackage& other)
+  {
+    recipe_id_ = other.recipe_id_;
+    layout_ = other.layout_;
+    data_ = other.data_;
+    protocol_version_ = other.protocol_version_;
+    return *this;
+  }
+
   /*!
    * \brief Initializes to contained list with empty values based on the recipe.
    */
@@ -112,7 +345,7 @@ public:
    *
    * \returns The total size of the serialized package
    */
-  size_t serializePackage(uint8_t* buffer);
+  size_t serializePackage(uint8_t* buffer) const;
 
   /*!
    * \brief Get a data field from the DataPackage.
@@ -122,19 +355,23 @@ public:
    * \param name The string identifier for the data field as used in the documentation.
    * \param val Target variable. Make sure, it's the correct type.
    *
+   * \throws std::bad_variant_access if the field is not of type T.
+   *
    * \returns True on success, false if the field cannot be found inside the package.
    */
   template <typename T>
   bool getData(const std::string& name, T& val)
   {
-    if (data_.find(name) != data_.end())
+    const RecipeLayout::Field* field = layout_->findField(name);
+    if (field == nullptr || field->type == nullptr)
     {
-      val = std::get<T>(data_[name]);
+      return false;
     }
-    else
+    if (!std::holds_alternative<T>(*field->type))
     {
-      return false;
+      throw std::bad_variant_access();
     }
+    std::memcpy(&val, data_.data() + field->offset, sizeof(T));
     return true;
   }
 
@@ -153,14 +390,33 @@ public:
   {
     static_assert(sizeof(T) * 8 >= N, "Bitset is too large for underlying variable");
 
-    if (data_.find(name) != data_.end())
+    T inner;
+    if (!getData(name, inner))
     {
-      val = std::bitset<N>(std::get<T>(data_[name]));
+      return false;
     }
-    else
+    val = std::bitset<N>(inner);
+    return true;
+  }
+
+  /*!
+   * \brief Get a data field from the DataPackage using a handle obtained from the package's recipe
+   * layout. This does not involve any lookup.
+   *
+   * \param handle Handle to the requested field
+   * \param val Target variable
+   *
+   * \returns True on success, false if the handle is invalid or was created from a different
+   * layout.
+   */
+  template <typename T>
+  bool getData(const FieldHandle<T>& handle, T& val) const
+  {
+    if (!handle.isValid() || handle.layout_ != layout_.get())
     {
       return false;
     }
+    std::memcpy(&val, data_.data() + handle.offset_, sizeof(T));
     return true;
   }
 
@@ -172,19 +428,44 @@ public:
    * \param name The string identifier for the data field as used in the documentation.
    * \param val Value to set. Make sure, it's the correct type.
    *
-   * \returns True on success, false if the field cannot be found inside the package.
+   * \returns True on success, false if the field cannot be found inside the package or is of a
+   * different type.
    */
   template <typename T>
   bool setData(const std::string& name, T& val)
   {
-    if (data_.find(name) != data_.end())
+    const RecipeLayout::Field* field = layout_->findField(name);
+    if (field == nullptr || field->type == nullptr)
+    {
+      return false;
+    }
+    if (!std::holds_alternative<T>(*field->type))
     {
-      data_[name] = val;
+      URCL_LOG_ERROR("Data field '%s' cannot be set from a value of a different type", name.c_str());
+      return false;
     }
-    else
+    std::memcpy(data_.data() + field->offset, &val, sizeof(T));
+    return true;
+  }
+
+  /*!
+   * \brief Set a data field in the DataPackage using a handle obtained from the package's recipe
+   * layout. This does not involve any lookup.
+   *
+   * \param handle Handle to the field that should be set
+   * \param val Value to set
+   *
+   * \returns True on success, false if the handle is invalid or was created from a different
+   * layout.
+   */
+  template <typename T>
+  bool setData(const FieldHandle<T>& handle, const T& val)
+  {
+    if (!handle.isValid() || handle.layout_ != layout_.get())
     {
       return false;
     }
+    std::memcpy(data_.data() + handle.offset_, &val, sizeof(T));
     return true;
   }
 
@@ -198,15 +479,100 @@ public:
     recipe_id_ = recipe_id;
   }
 
+  /*!
+   * \brief Setter of the protocol version used for parsing the package.
+   *
+   * \param protocol_version Protocol version used for the RTDE communication
+   */
+  void setProtocolVersion(const uint16_t& protocol_version)
+  {
+    protocol_version_ = protocol_version;
+  }
+
+  /*!
+   * \brief Getter for the recipe layout used by this package.
+   *
+   * \returns The recipe layout
+   */
+  const std::shared_ptr<const RecipeLayout>& getRecipeLayout() const
+  {
+    return layout_;
+  }
+
 private:
+  friend class StateHistory;
+
   // Const would be better here
   static std::unordered_map<std::string, _rtde_type_variant> g_type_list;
   uint8_t recipe_id_;
-  std::unordered_map<std::string, _rtde_type_variant> data_;
-  std::vector<std::string> recipe_;
+  std::shared_ptr<const RecipeLayout> layout_;
+  std::vector<uint8_t> data_;
   uint16_t protocol_version_;
 };
 
+/*!
+ * \brief Typed handle to a field of a DataPackage. A handle is created once from the package's
+ * RecipeLayout and can then be used to access the field of every package using that layout with
+ * plain pointer arithmetic.
+ *
+ * The handle refers to its layout without owning it, so it must not outlive the layout. Packages
+ * keep their layout alive, so a handle is safe to use as long as a package or a shared pointer of
+ * the layout it was created from exists.
+ *
+ * @tparam T Type of the field
+ */
+template <typename T>
+class FieldHandle
+{
+  static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable fields can be accessed by handle");
+
+public:
+  /*!
+   * \brief Creates an invalid handle.
+   */
+  FieldHandle() : offset_(0), layout_(nullptr)
+  {
+  }
+
+  /*!
+   * \brief Checks whether this handle refers to a field.
+   *
+   * \returns True, if the handle can be used to access a field, false otherwise
+   */
+  bool isValid() const
+  {
+    return layout_ != nullptr;
+  }
+
+private:
+  friend class DataPackage;
+  template <typename... Fields>
+  friend class Recipe;
+  friend class StateHistory;
+
+  FieldHandle(const size_t offset, const DataPackage::RecipeLayout* layout) : offset_(offset), layout_(layout)
+  {
+  }
+
+  size_t offset_;
+  const DataPackage::RecipeLayout* layout_;
+};
+
+template <typename T>
+FieldHandle<T> DataPackage::RecipeLayout::getFieldHandle(const std::string& name) const
+{
+  const Field* field = findField(name);
+  if (field == nullptr || field->type == nullptr)
+  {
+    throw UrException("Data field '" + name + "' is not part of the recipe");
+  }
+  if (!std::holds_alternative<T>(*field->type))
+  {
+    throw UrException("Data field '" + name + "' is not of the requested type");
+  }
+  return FieldHandle<T>(field->offset, this);
+}
+
 }  // namespace rtde_interface
 }  // namespace urcl
 
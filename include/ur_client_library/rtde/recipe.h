@@ -0,0 +1,219 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#ifndef UR_CLIENT_LIBRARY_RTDE_RECIPE_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RTDE_RECIPE_H_INCLUDED
+
+#include <cstring>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ur_client_library/comm/bin_parser.h"
+#include "ur_client_library/comm/package_serializer.h"
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/rtde/rtde_fields.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief An RTDE recipe that is known at compile time. The recipe is given as a list of field
+ * descriptors, e.g. <tt>Recipe<fields::Timestamp, fields::ActualQ, fields::SpeedScaling></tt>.
+ *
+ * Since all field types and offsets are known at compile time, parsing and serializing a package
+ * of this recipe is a fixed sequence of loads and stores without looking at the type of each field.
+ * Packages of the recipe are regular DataPackage objects using the recipe's layout, see
+ * getLayout(). The layout can be passed to the RTDEClient instead of a string based recipe, fields
+ * can be accessed without any name lookup using get() or getFieldHandle().
+ *
+ * @tparam Fields Descriptors of the recipe's fields in recipe order, see URCL_RTDE_FIELD
+ */
+template <typename... Fields>
+class Recipe
+{
+  static_assert(sizeof...(Fields) > 0, "A recipe needs at least one field");
+  static_assert((std::is_trivially_copyable<typename Fields::type>::value && ...),
+                "Only trivially copyable fields can be used inside a recipe");
+
+public:
+  //! Number of bytes needed to store all fields of the recipe
+  static constexpr size_t STORAGE_SIZE = (sizeof(typename Fields::type) + ...);
+
+  Recipe() = delete;
+
+  /*!
+   * \brief Getter for the string identifiers of the recipe's fields as used for negotiating the
+   * recipe with the robot.
+   *
+   * \returns The recipe as list of field names
+   */
+  static std::vector<std::string> getNames()
+  {
+    return { Fields::NAME... };
+  }
+
+  /*!
+   * \brief Getter for the layout shared by all packages of this recipe. The layout is created and
+   * checked against the field types known to the DataPackage on first use.
+   *
+   * \throws UrException if a field is unknown or its type differs from the known field type
+   *
+   * \returns The recipe layout
+   */
+  static std::shared_ptr<const DataPackage::RecipeLayout> getLayout()
+  {
+    static const std::shared_ptr<const DataPackage::RecipeLayout> layout = createLayout();
+    return layout;
+  }
+
+  /*!
+   * \brief Computes the offset of a field inside the data buffer of a package.
+   *
+   * @tparam Field Descriptor of the field
+   *
+   * \returns The offset of the field in bytes
+   */
+  template <typename Field>
+  static constexpr size_t offsetOf()
+  {
+    static_assert((std::is_same<Field, Fields>::value || ...), "Field is not part of the recipe");
+    constexpr bool is_field[] = { std::is_same<Field, Fields>::value... };
+    constexpr size_t sizes[] = { sizeof(typename Fields::type)... };
+    size_t offset = 0;
+    for (size_t i = 0; !is_field[i]; ++i)
+    {
+      offset += sizes[i];
+    }
+    return offset;
+  }
+
+  /*!
+   * \brief Creates a handle for direct access to a field of packages using this recipe's layout.
+   *
+   * @tparam Field Descriptor of the field
+   *
+   * \returns A handle to the requested field
+   */
+  template <typename Field>
+  static FieldHandle<typename Field::type> getFieldHandle()
+  {
+    return FieldHandle<typename Field::type>(offsetOf<Field>(), getLayout().get());
+  }
+
+  /*!
+   * \brief Gets a field from a package using this recipe's layout.
+   *
+   * @tparam Field Descriptor of the field
+   * \param package The package to read from
+   *
+   * \returns The value of the field
+   */
+  template <typename Field>
+  static typename Field::type get(const DataPackage& package)
+  {
+    typename Field::type val{};
+    package.getData(getFieldHandle<Field>(), val);
+    return val;
+  }
+
+  /*!
+   * \brief Sets a field of a package using this recipe's layout.
+   *
+   * @tparam Field Descriptor of the field
+   * \param package The package to modify
+   * \param val Value to set
+   */
+  template <typename Field>
+  static void set(DataPackage& package, const typename Field::type& val)
+  {
+    package.setData(getFieldHandle<Field>(), val);
+  }
+
+  /*!
+   * \brief Parses all fields of the recipe from a serialized package into a flat data buffer.
+   *
+   * \param bp A parser positioned at the first field of the package
+   * \param data Buffer of at least STORAGE_SIZE bytes
+   */
+  static void parse(comm::BinParser& bp, uint8_t* data)
+  {
+    (parseField<Fields>(bp, data), ...);
+  }
+
+  /*!
+   * \brief Serializes all fields of the recipe from a flat data buffer.
+   *
+   * \param data Buffer of at least STORAGE_SIZE bytes
+   * \param buffer Buffer to fill with the serialization
+   *
+   * \returns The number of bytes written
+   */
+  static size_t serialize(const uint8_t* data, uint8_t* buffer)
+  {
+    size_t size = 0;
+    ((size += serializeField<Fields>(data, buffer + size)), ...);
+    return size;
+  }
+
+private:
+  static std::shared_ptr<const DataPackage::RecipeLayout> createLayout()
+  {
+    auto layout = std::make_shared<const DataPackage::RecipeLayout>(getNames(), &parse, &serialize);
+    // Throws if a field's descriptor doesn't match the known field
+    (layout->template getFieldHandle<typename Fields::type>(Fields::NAME), ...);
+    return layout;
+  }
+
+  template <typename Field>
+  static void parseField(comm::BinParser& bp, uint8_t* data)
+  {
+    typename Field::type val;
+    bp.parse(val);
+    std::memcpy(data + offsetOf<Field>(), &val, sizeof(val));
+  }
+
+  template <typename Field>
+  static size_t serializeField(const uint8_t* data, uint8_t* buffer)
+  {
+    typename Field::type val;
+    std::memcpy(&val, data + offsetOf<Field>(), sizeof(val));
+    return comm::PackageSerializer::serialize(buffer, val);
+  }
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_RTDE_RECIPE_H_INCLUDED
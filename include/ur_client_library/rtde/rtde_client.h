@@ -29,18 +29,23 @@
 #ifndef UR_CLIENT_LIBRARY_RTDE_CLIENT_H_INCLUDED
 #define UR_CLIENT_LIBRARY_RTDE_CLIENT_H_INCLUDED
 
+#include "ur_client_library/comm/clock_offset_estimator.h"
 #include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/comm/wake_up_scheduler.h"
 #include "ur_client_library/rtde/package_header.h"
 #include "ur_client_library/rtde/rtde_package.h"
 #include "ur_client_library/comm/stream.h"
 #include "ur_client_library/rtde/rtde_parser.h"
 #include "ur_client_library/comm/producer.h"
 #include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/rtde/recipe.h"
 #include "ur_client_library/rtde/request_protocol_version.h"
 #include "ur_client_library/rtde/control_package_setup_outputs.h"
 #include "ur_client_library/rtde/control_package_start.h"
 #include "ur_client_library/log.h"
+#include "ur_client_library/rtde/rtde_recorder.h"
 #include "ur_client_library/rtde/rtde_writer.h"
+#include "ur_client_library/rtde/state_history.h"
 
 static const int UR_RTDE_PORT = 30004;
 static const std::string PIPELINE_NAME = "RTDE Data Pipeline";
@@ -102,9 +107,14 @@ public:
    * \param output_recipe_file Path to the file containing the output recipe
    * \param input_recipe_file Path to the file containing the input recipe
    * \param target_frequency Frequency to run at. Defaults to 0.0 which means maximum frequency.
+   * \param transport How received data packages are passed to getDataPackage(). With
+   * comm::PipelineTransport::LATEST_VALUE only the newest data package is kept.
+   * \param port Port of the robot's RTDE server
    */
   RTDEClient(std::string robot_ip, comm::INotifier& notifier, const std::string& output_recipe_file,
-             const std::string& input_recipe_file, double target_frequency = 0.0);
+             const std::string& input_recipe_file, double target_frequency = 0.0,
+             const comm::PipelineTransport transport = comm::PipelineTransport::QUEUE,
+             const int port = UR_RTDE_PORT);
 
   /*!
    * \brief Creates a new RTDEClient object, including a used URStream and Pipeline to handle the
@@ -115,9 +125,39 @@ public:
    * \param output_recipe Vector containing the output recipe
    * \param input_recipe Vector containing the input recipe
    * \param target_frequency Frequency to run at. Defaults to 0.0 which means maximum frequency.
+   * \param transport How received data packages are passed to getDataPackage(). With
+   * comm::PipelineTransport::LATEST_VALUE only the newest data package is kept.
+   * \param port Port of the robot's RTDE server
    */
   RTDEClient(std::string robot_ip, comm::INotifier& notifier, const std::vector<std::string>& output_recipe,
-             const std::vector<std::string>& input_recipe, double target_frequency = 0.0);
+             const std::vector<std::string>& input_recipe, double target_frequency = 0.0,
+             const comm::PipelineTransport transport = comm::PipelineTransport::QUEUE,
+             const int port = UR_RTDE_PORT);
+
+  /*!
+   * \brief Creates a new RTDEClient object using recipes that are known at compile time, including a
+   * used URStream and Pipeline to handle the communication with the robot.
+   *
+   * Received and sent data packages are parsed and serialized by the recipes' fixed field sequence.
+   * The layouts are usually obtained from a Recipe, e.g.
+   * <tt>Recipe<fields::Timestamp, fields::ActualQ>::getLayout()</tt>.
+   *
+   * \param robot_ip The IP of the robot
+   * \param notifier The notifier to use in the pipeline
+   * \param output_layout Layout of the output recipe. Has to contain the timestamp field.
+   * \param input_layout Layout of the input recipe
+   * \param target_frequency Frequency to run at. Defaults to 0.0 which means maximum frequency.
+   * \param transport How received data packages are passed to getDataPackage(). With
+   * comm::PipelineTransport::LATEST_VALUE only the newest data package is kept.
+   * \param port Port of the robot's RTDE server
+   *
+   * \throws UrException if the output recipe doesn't contain the timestamp field
+   */
+  RTDEClient(std::string robot_ip, comm::INotifier& notifier,
+             std::shared_ptr<const DataPackage::RecipeLayout> output_layout,
+             std::shared_ptr<const DataPackage::RecipeLayout> input_layout, double target_frequency = 0.0,
+             const comm::PipelineTransport transport = comm::PipelineTransport::QUEUE,
+             const int port = UR_RTDE_PORT);
   ~RTDEClient();
   /*!
    * \brief Sets up RTDE communication with the robot. The handshake includes negotiation of the
@@ -152,6 +192,40 @@ public:
    */
   std::unique_ptr<rtde_interface::DataPackage> getDataPackage(std::chrono::milliseconds timeout);
 
+  /*!
+   * \brief Reads the pipeline to fetch the next data package. In contrast to the other overload, the
+   * package previously held by \p data_package is handed back to the parser and reused for later
+   * packages. When passing the same pointer in every cycle, no memory is allocated in steady state.
+   *
+   * This has to be called from one thread only.
+   *
+   * \param data_package Unique ptr to be set to the fetched package. Left untouched if no new package
+   * arrived before the timeout.
+   * \param timeout Time to wait if no data package is currently in the queue
+   *
+   * \returns True, if a package was fetched successfully, false otherwise
+   */
+  bool getDataPackage(std::unique_ptr<rtde_interface::DataPackage>& data_package, std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Fetches the next data package like getDataPackage(), but sleeps until shortly before
+   * the package is expected to arrive and polls for it from then on, see getWakeUpScheduler().
+   *
+   * Compared to waiting for the receiving thread to signal a new package, this avoids the latency
+   * of being woken up. If no prediction is available, yet, or the package doesn't arrive in the
+   * predicted time window, this waits for the package to be signaled.
+   *
+   * This has to be called from one thread only.
+   *
+   * \param data_package Unique ptr to be set to the fetched package. Left untouched if no new package
+   * arrived before the timeout.
+   * \param timeout Time to wait for the package to be signaled if it doesn't arrive as predicted
+   *
+   * \returns True, if a package was fetched successfully, false otherwise
+   */
+  bool waitForDataPackage(std::unique_ptr<rtde_interface::DataPackage>& data_package,
+                          std::chrono::milliseconds timeout);
+
   /*!
    * \brief Getter for the maximum frequency the robot can publish RTDE data packages with.
    *
@@ -172,6 +246,96 @@ public:
     return target_frequency_;
   }
 
+  /*!
+   * \brief Getter for the number of received packages that were skipped or overwritten by a newer
+   * package before being fetched using getDataPackage().
+   *
+   * \returns The number of dropped packages since the client was created
+   */
+  uint64_t getNumDroppedPackages() const
+  {
+    return pipeline_.getNumDroppedProducts();
+  }
+
+  /*!
+   * \brief Enables or disables receive timestamps reported by the kernel for the RTDE connection.
+   * When enabled, each received package carries the point in time at which it arrived at the
+   * network interface, see comm::PackageTimestamps::kernel_received. This should be set before
+   * calling init().
+   *
+   * \param enabled Whether to request receive timestamps
+   */
+  void setReceiveTimestamping(const bool enabled)
+  {
+    stream_.setReceiveTimestamping(enabled);
+  }
+
+  /*!
+   * \brief Getter for the estimator relating the robot's clock to the host's monotonic clock.
+   *
+   * The estimator gets fed with the timestamp of each received data package and the time it was
+   * received at. It can be used to convert robot timestamps to host time, e.g. for fusing the
+   * robot's state with other sensors, and to predict when the next control cycle will start.
+   *
+   * \returns The clock offset estimator of this client
+   */
+  const comm::ClockOffsetEstimator& getClockOffsetEstimator() const
+  {
+    return clock_offset_estimator_;
+  }
+
+  /*!
+   * \brief Getter for the scheduler predicting when the next data package arrives.
+   *
+   * The scheduler learns the period and phase of the received data packages. When multiple robots
+   * are handled in one thread, the thread can sleep until the earliest of their predicted arrivals
+   * with comm::WakeUpScheduler::sleepUntil().
+   *
+   * \returns The wake-up scheduler of this client
+   */
+  const comm::WakeUpScheduler& getWakeUpScheduler() const
+  {
+    return wake_up_scheduler_;
+  }
+
+  /*!
+   * \brief Keeps the received data packages of the given duration in a StateHistory. This allows
+   * looking up the robot's state at the time another sensor took a measurement.
+   *
+   * This has to be called after init() and before the client is started for the first time.
+   *
+   * \param duration Time span of packages to keep. The history holds as many packages as are
+   * received within this time at the target frequency.
+   *
+   * \returns True, if the history was created, false if the client is in the wrong state
+   */
+  bool enableStateHistory(const std::chrono::duration<double> duration);
+
+  /*!
+   * \brief Getter for the history of received data packages, see enableStateHistory().
+   *
+   * \returns The state history, nullptr if it is not enabled
+   */
+  std::shared_ptr<const StateHistory> getStateHistory() const
+  {
+    return state_history_;
+  }
+
+  /*!
+   * \brief Starts recording all received data packages into a file, see RTDERecorder. A running
+   * recording is stopped before. The recording can be read using comm::RecordingReader.
+   *
+   * \param filename Path of the recording file
+   *
+   * \returns True, if the recording was started, false if the file could not be created
+   */
+  bool startRecording(const std::string& filename);
+
+  /*!
+   * \brief Stops a running recording and writes all packages received until now to the file.
+   */
+  void stopRecording();
+
   /*!
    * \brief Getter for the UR control version received from the robot.
    *
@@ -191,7 +355,8 @@ public:
 
   /*!
    * \brief Getter for the RTDE writer, which is used to send data via the RTDE interface to the
-   * robot.
+   * robot. If the writer is set to synchronous mode, its pending changes are sent whenever a data
+   * package is received.
    *
    * \returns A reference to the used RTDEWriter
    */
@@ -207,6 +372,22 @@ public:
     return output_recipe_;
   }
 
+  /*!
+   * \brief Creates a handle for direct access to a field of the output recipe. The handle can be
+   * used with every data package returned by getDataPackage() and avoids a name lookup on each access.
+   *
+   * \param name The string identifier for the data field as used in the documentation.
+   *
+   * \throws UrException if the field is not part of the output recipe or is not of type T.
+   *
+   * \returns A handle to the requested field
+   */
+  template <typename T>
+  FieldHandle<T> getFieldHandle(const std::string& name) const
+  {
+    return parser_.getRecipeLayout()->getFieldHandle<T>(name);
+  }
+
 private:
   comm::URStream<RTDEPackage> stream_;
   std::vector<std::string> output_recipe_;
@@ -214,7 +395,17 @@ private:
   RTDEParser parser_;
   comm::URProducer<RTDEPackage> prod_;
   comm::Pipeline<RTDEPackage> pipeline_;
+  // Handed back to the pipeline by the next call of getDataPackage(), so the caller's package can be
+  // kept if something else than a data package is fetched
+  std::unique_ptr<RTDEPackage> spare_package_;
   RTDEWriter writer_;
+  comm::ClockOffsetEstimator clock_offset_estimator_;
+  comm::WakeUpScheduler wake_up_scheduler_;
+  FieldHandle<double> timestamp_handle_;
+  std::shared_ptr<StateHistory> state_history_;
+  // The recorder is used by the producer thread while recording_busy_ is set
+  std::atomic<RTDERecorder*> recorder_{ nullptr };
+  std::atomic<bool> recording_busy_{ false };
 
   VersionInformation urcontrol_version_;
 
@@ -255,6 +446,18 @@ private:
   bool sendStart();
   bool sendPause();
 
+  // Fetches the next answer to a request, skipping data packages and text messages. Answers are
+  // always queued, so they can't be overwritten by data packages arriving right after them.
+  bool getControlPackage(std::unique_ptr<RTDEPackage>& package, std::chrono::milliseconds timeout);
+
+  // Looks up the timestamp field and registers handleProducedPackage() and the routing of packages
+  // with the pipeline
+  void setupPackageHandling();
+
+  // Feeds the clock offset estimator, the wake-up scheduler, the state history and the recorder and sends the inputs collected by the writer in synchronous
+  // mode after each received data package. Text messages are logged.
+  void handleProducedPackage(const RTDEPackage& package);
+
   /*!
    * \brief Splits a variable_types string as reported from the robot into single variable type
    * strings
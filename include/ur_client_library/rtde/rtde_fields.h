@@ -0,0 +1,603 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#ifndef UR_CLIENT_LIBRARY_RTDE_FIELDS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RTDE_FIELDS_H_INCLUDED
+
+#include <cstdint>
+
+#include "ur_client_library/types.h"
+
+/*!
+ * \brief Declares a descriptor type for an RTDE data field that can be used inside a Recipe.
+ *
+ * \param field_type Name of the descriptor type
+ * \param identifier The string identifier of the field as used in the RTDE documentation
+ * \param data_type The type used to represent the field's value
+ */
+#define URCL_RTDE_FIELD(field_type, identifier, data_type)                                                             \
+  struct field_type                                                                                                    \
+  {                                                                                                                    \
+    using type = data_type;                                                                                            \
+    static constexpr const char* NAME = identifier;                                                                    \
+  }
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Descriptor types for all RTDE data fields known to the DataPackage. Field names and types
+ * are identical to the ones used for string based recipes.
+ *
+ * The descriptor types are named after the field identifier in camel case, e.g. ActualQ for
+ * "actual_q". The identifiers "standard_analog_output_0" and "standard_analog_output_1" would clash
+ * with "standard_analog_output0" and "standard_analog_output1", so their descriptors keep the
+ * underscore.
+ */
+namespace fields
+{
+URCL_RTDE_FIELD(Timestamp, "timestamp", double);
+URCL_RTDE_FIELD(TargetQ, "target_q", vector6d_t);
+URCL_RTDE_FIELD(TargetQd, "target_qd", vector6d_t);
+URCL_RTDE_FIELD(TargetQdd, "target_qdd", vector6d_t);
+URCL_RTDE_FIELD(TargetCurrent, "target_current", vector6d_t);
+URCL_RTDE_FIELD(TargetMoment, "target_moment", vector6d_t);
+URCL_RTDE_FIELD(ActualQ, "actual_q", vector6d_t);
+URCL_RTDE_FIELD(ActualQd, "actual_qd", vector6d_t);
+URCL_RTDE_FIELD(ActualCurrent, "actual_current", vector6d_t);
+URCL_RTDE_FIELD(ActualCurrentWindow, "actual_current_window", vector6d_t);
+URCL_RTDE_FIELD(JointControlOutput, "joint_control_output", vector6d_t);
+URCL_RTDE_FIELD(ActualTCPPose, "actual_TCP_pose", vector6d_t);
+URCL_RTDE_FIELD(ActualTCPSpeed, "actual_TCP_speed", vector6d_t);
+URCL_RTDE_FIELD(ActualTCPForce, "actual_TCP_force", vector6d_t);
+URCL_RTDE_FIELD(TargetTCPPose, "target_TCP_pose", vector6d_t);
+URCL_RTDE_FIELD(TargetTCPSpeed, "target_TCP_speed", vector6d_t);
+URCL_RTDE_FIELD(ActualDigitalInputBits, "actual_digital_input_bits", uint64_t);
+URCL_RTDE_FIELD(JointTemperatures, "joint_temperatures", vector6d_t);
+URCL_RTDE_FIELD(ActualExecutionTime, "actual_execution_time", double);
+URCL_RTDE_FIELD(RobotMode, "robot_mode", int32_t);
+URCL_RTDE_FIELD(JointMode, "joint_mode", vector6int32_t);
+URCL_RTDE_FIELD(SafetyMode, "safety_mode", int32_t);
+URCL_RTDE_FIELD(SafetyStatus, "safety_status", int32_t);
+URCL_RTDE_FIELD(ActualToolAccelerometer, "actual_tool_accelerometer", vector3d_t);
+URCL_RTDE_FIELD(SpeedScaling, "speed_scaling", double);
+URCL_RTDE_FIELD(TargetSpeedFraction, "target_speed_fraction", double);
+URCL_RTDE_FIELD(ActualMomentum, "actual_momentum", double);
+URCL_RTDE_FIELD(ActualMainVoltage, "actual_main_voltage", double);
+URCL_RTDE_FIELD(ActualRobotVoltage, "actual_robot_voltage", double);
+URCL_RTDE_FIELD(ActualRobotCurrent, "actual_robot_current", double);
+URCL_RTDE_FIELD(ActualJointVoltage, "actual_joint_voltage", vector6d_t);
+URCL_RTDE_FIELD(ActualDigitalOutputBits, "actual_digital_output_bits", uint64_t);
+URCL_RTDE_FIELD(RuntimeState, "runtime_state", uint32_t);
+URCL_RTDE_FIELD(ElbowPosition, "elbow_position", vector3d_t);
+URCL_RTDE_FIELD(ElbowVelocity, "elbow_velocity", vector3d_t);
+URCL_RTDE_FIELD(RobotStatusBits, "robot_status_bits", uint32_t);
+URCL_RTDE_FIELD(SafetyStatusBits, "safety_status_bits", uint32_t);
+URCL_RTDE_FIELD(AnalogIoTypes, "analog_io_types", uint32_t);
+URCL_RTDE_FIELD(StandardAnalogInput0, "standard_analog_input0", double);
+URCL_RTDE_FIELD(StandardAnalogInput1, "standard_analog_input1", double);
+URCL_RTDE_FIELD(StandardAnalogOutput0, "standard_analog_output0", double);
+URCL_RTDE_FIELD(StandardAnalogOutput1, "standard_analog_output1", double);
+URCL_RTDE_FIELD(IoCurrent, "io_current", double);
+URCL_RTDE_FIELD(Euromap67InputBits, "euromap67_input_bits", uint32_t);
+URCL_RTDE_FIELD(Euromap67OutputBits, "euromap67_output_bits", uint32_t);
+URCL_RTDE_FIELD(Euromap6724VVoltage, "euromap67_24V_voltage", double);
+URCL_RTDE_FIELD(Euromap6724VCurrent, "euromap67_24V_current", double);
+URCL_RTDE_FIELD(ToolMode, "tool_mode", uint32_t);
+URCL_RTDE_FIELD(ToolAnalogInputTypes, "tool_analog_input_types", uint32_t);
+URCL_RTDE_FIELD(ToolAnalogInput0, "tool_analog_input0", double);
+URCL_RTDE_FIELD(ToolAnalogInput1, "tool_analog_input1", double);
+URCL_RTDE_FIELD(ToolOutputVoltage, "tool_output_voltage", int32_t);
+URCL_RTDE_FIELD(ToolOutputCurrent, "tool_output_current", double);
+URCL_RTDE_FIELD(ToolTemperature, "tool_temperature", double);
+URCL_RTDE_FIELD(TcpForceScalar, "tcp_force_scalar", double);
+URCL_RTDE_FIELD(OutputBitRegisters0To31, "output_bit_registers0_to_31", uint32_t);
+URCL_RTDE_FIELD(OutputBitRegisters32To63, "output_bit_registers32_to_63", uint32_t);
+URCL_RTDE_FIELD(OutputBitRegister0, "output_bit_register_0", bool);
+URCL_RTDE_FIELD(OutputBitRegister1, "output_bit_register_1", bool);
+URCL_RTDE_FIELD(OutputBitRegister2, "output_bit_register_2", bool);
+URCL_RTDE_FIELD(OutputBitRegister3, "output_bit_register_3", bool);
+URCL_RTDE_FIELD(OutputBitRegister4, "output_bit_register_4", bool);
+URCL_RTDE_FIELD(OutputBitRegister5, "output_bit_register_5", bool);
+URCL_RTDE_FIELD(OutputBitRegister6, "output_bit_register_6", bool);
+URCL_RTDE_FIELD(OutputBitRegister7, "output_bit_register_7", bool);
+URCL_RTDE_FIELD(OutputBitRegister8, "output_bit_register_8", bool);
+URCL_RTDE_FIELD(OutputBitRegister9, "output_bit_register_9", bool);
+URCL_RTDE_FIELD(OutputBitRegister10, "output_bit_register_10", bool);
+URCL_RTDE_FIELD(OutputBitRegister11, "output_bit_register_11", bool);
+URCL_RTDE_FIELD(OutputBitRegister12, "output_bit_register_12", bool);
+URCL_RTDE_FIELD(OutputBitRegister13, "output_bit_register_13", bool);
+URCL_RTDE_FIELD(OutputBitRegister14, "output_bit_register_14", bool);
+URCL_RTDE_FIELD(OutputBitRegister15, "output_bit_register_15", bool);
+URCL_RTDE_FIELD(OutputBitRegister16, "output_bit_register_16", bool);
+URCL_RTDE_FIELD(OutputBitRegister17, "output_bit_register_17", bool);
+URCL_RTDE_FIELD(OutputBitRegister18, "output_bit_register_18", bool);
+URCL_RTDE_FIELD(OutputBitRegister19, "output_bit_register_19", bool);
+URCL_RTDE_FIELD(OutputBitRegister20, "output_bit_register_20", bool);
+URCL_RTDE_FIELD(OutputBitRegister21, "output_bit_register_21", bool);
+URCL_RTDE_FIELD(OutputBitRegister22, "output_bit_register_22", bool);
+URCL_RTDE_FIELD(OutputBitRegister23, "output_bit_register_23", bool);
+URCL_RTDE_FIELD(OutputBitRegister24, "output_bit_register_24", bool);
+URCL_RTDE_FIELD(OutputBitRegister25, "output_bit_register_25", bool);
+URCL_RTDE_FIELD(OutputBitRegister26, "output_bit_register_26", bool);
+URCL_RTDE_FIELD(OutputBitRegister27, "output_bit_register_27", bool);
+URCL_RTDE_FIELD(OutputBitRegister28, "output_bit_register_28", bool);
+URCL_RTDE_FIELD(OutputBitRegister29, "output_bit_register_29", bool);
+URCL_RTDE_FIELD(OutputBitRegister30, "output_bit_register_30", bool);
+URCL_RTDE_FIELD(OutputBitRegister31, "output_bit_register_31", bool);
+URCL_RTDE_FIELD(OutputBitRegister32, "output_bit_register_32", bool);
+URCL_RTDE_FIELD(OutputBitRegister33, "output_bit_register_33", bool);
+URCL_RTDE_FIELD(OutputBitRegister34, "output_bit_register_34", bool);
+URCL_RTDE_FIELD(OutputBitRegister35, "output_bit_register_35", bool);
+URCL_RTDE_FIELD(OutputBitRegister36, "output_bit_register_36", bool);
+URCL_RTDE_FIELD(OutputBitRegister37, "output_bit_register_37", bool);
+URCL_RTDE_FIELD(OutputBitRegister38, "output_bit_register_38", bool);
+URCL_RTDE_FIELD(OutputBitRegister39, "output_bit_register_39", bool);
+URCL_RTDE_FIELD(OutputBitRegister40, "output_bit_register_40", bool);
+URCL_RTDE_FIELD(OutputBitRegister41, "output_bit_register_41", bool);
+URCL_RTDE_FIELD(OutputBitRegister42, "output_bit_register_42", bool);
+URCL_RTDE_FIELD(OutputBitRegister43, "output_bit_register_43", bool);
+URCL_RTDE_FIELD(OutputBitRegister44, "output_bit_register_44", bool);
+URCL_RTDE_FIELD(OutputBitRegister45, "output_bit_register_45", bool);
+URCL_RTDE_FIELD(OutputBitRegister46, "output_bit_register_46", bool);
+URCL_RTDE_FIELD(OutputBitRegister47, "output_bit_register_47", bool);
+URCL_RTDE_FIELD(OutputBitRegister48, "output_bit_register_48", bool);
+URCL_RTDE_FIELD(OutputBitRegister49, "output_bit_register_49", bool);
+URCL_RTDE_FIELD(OutputBitRegister50, "output_bit_register_50", bool);
+URCL_RTDE_FIELD(OutputBitRegister51, "output_bit_register_51", bool);
+URCL_RTDE_FIELD(OutputBitRegister52, "output_bit_register_52", bool);
+URCL_RTDE_FIELD(OutputBitRegister53, "output_bit_register_53", bool);
+URCL_RTDE_FIELD(OutputBitRegister54, "output_bit_register_54", bool);
+URCL_RTDE_FIELD(OutputBitRegister55, "output_bit_register_55", bool);
+URCL_RTDE_FIELD(OutputBitRegister56, "output_bit_register_56", bool);
+URCL_RTDE_FIELD(OutputBitRegister57, "output_bit_register_57", bool);
+URCL_RTDE_FIELD(OutputBitRegister58, "output_bit_register_58", bool);
+URCL_RTDE_FIELD(OutputBitRegister59, "output_bit_register_59", bool);
+URCL_RTDE_FIELD(OutputBitRegister60, "output_bit_register_60", bool);
+URCL_RTDE_FIELD(OutputBitRegister61, "output_bit_register_61", bool);
+URCL_RTDE_FIELD(OutputBitRegister62, "output_bit_register_62", bool);
+URCL_RTDE_FIELD(OutputBitRegister63, "output_bit_register_63", bool);
+URCL_RTDE_FIELD(OutputBitRegister64, "output_bit_register_64", bool);
+URCL_RTDE_FIELD(OutputBitRegister65, "output_bit_register_65", bool);
+URCL_RTDE_FIELD(OutputBitRegister66, "output_bit_register_66", bool);
+URCL_RTDE_FIELD(OutputBitRegister67, "output_bit_register_67", bool);
+URCL_RTDE_FIELD(OutputBitRegister68, "output_bit_register_68", bool);
+URCL_RTDE_FIELD(OutputBitRegister69, "output_bit_register_69", bool);
+URCL_RTDE_FIELD(OutputBitRegister70, "output_bit_register_70", bool);
+URCL_RTDE_FIELD(OutputBitRegister71, "output_bit_register_71", bool);
+URCL_RTDE_FIELD(OutputBitRegister72, "output_bit_register_72", bool);
+URCL_RTDE_FIELD(OutputBitRegister73, "output_bit_register_73", bool);
+URCL_RTDE_FIELD(OutputBitRegister74, "output_bit_register_74", bool);
+URCL_RTDE_FIELD(OutputBitRegister75, "output_bit_register_75", bool);
+URCL_RTDE_FIELD(OutputBitRegister76, "output_bit_register_76", bool);
+URCL_RTDE_FIELD(OutputBitRegister77, "output_bit_register_77", bool);
+URCL_RTDE_FIELD(OutputBitRegister78, "output_bit_register_78", bool);
+URCL_RTDE_FIELD(OutputBitRegister79, "output_bit_register_79", bool);
+URCL_RTDE_FIELD(OutputBitRegister80, "output_bit_register_80", bool);
+URCL_RTDE_FIELD(OutputBitRegister81, "output_bit_register_81", bool);
+URCL_RTDE_FIELD(OutputBitRegister82, "output_bit_register_82", bool);
+URCL_RTDE_FIELD(OutputBitRegister83, "output_bit_register_83", bool);
+URCL_RTDE_FIELD(OutputBitRegister84, "output_bit_register_84", bool);
+URCL_RTDE_FIELD(OutputBitRegister85, "output_bit_register_85", bool);
+URCL_RTDE_FIELD(OutputBitRegister86, "output_bit_register_86", bool);
+URCL_RTDE_FIELD(OutputBitRegister87, "output_bit_register_87", bool);
+URCL_RTDE_FIELD(OutputBitRegister88, "output_bit_register_88", bool);
+URCL_RTDE_FIELD(OutputBitRegister89, "output_bit_register_89", bool);
+URCL_RTDE_FIELD(OutputBitRegister90, "output_bit_register_90", bool);
+URCL_RTDE_FIELD(OutputBitRegister91, "output_bit_register_91", bool);
+URCL_RTDE_FIELD(OutputBitRegister92, "output_bit_register_92", bool);
+URCL_RTDE_FIELD(OutputBitRegister93, "output_bit_register_93", bool);
+URCL_RTDE_FIELD(OutputBitRegister94, "output_bit_register_94", bool);
+URCL_RTDE_FIELD(OutputBitRegister95, "output_bit_register_95", bool);
+URCL_RTDE_FIELD(OutputBitRegister96, "output_bit_register_96", bool);
+URCL_RTDE_FIELD(OutputBitRegister97, "output_bit_register_97", bool);
+URCL_RTDE_FIELD(OutputBitRegister98, "output_bit_register_98", bool);
+URCL_RTDE_FIELD(OutputBitRegister99, "output_bit_register_99", bool);
+URCL_RTDE_FIELD(OutputBitRegister100, "output_bit_register_100", bool);
+URCL_RTDE_FIELD(OutputBitRegister101, "output_bit_register_101", bool);
+URCL_RTDE_FIELD(OutputBitRegister102, "output_bit_register_102", bool);
+URCL_RTDE_FIELD(OutputBitRegister103, "output_bit_register_103", bool);
+URCL_RTDE_FIELD(OutputBitRegister104, "output_bit_register_104", bool);
+URCL_RTDE_FIELD(OutputBitRegister105, "output_bit_register_105", bool);
+URCL_RTDE_FIELD(OutputBitRegister106, "output_bit_register_106", bool);
+URCL_RTDE_FIELD(OutputBitRegister107, "output_bit_register_107", bool);
+URCL_RTDE_FIELD(OutputBitRegister108, "output_bit_register_108", bool);
+URCL_RTDE_FIELD(OutputBitRegister109, "output_bit_register_109", bool);
+URCL_RTDE_FIELD(OutputBitRegister110, "output_bit_register_110", bool);
+URCL_RTDE_FIELD(OutputBitRegister111, "output_bit_register_111", bool);
+URCL_RTDE_FIELD(OutputBitRegister112, "output_bit_register_112", bool);
+URCL_RTDE_FIELD(OutputBitRegister113, "output_bit_register_113", bool);
+URCL_RTDE_FIELD(OutputBitRegister114, "output_bit_register_114", bool);
+URCL_RTDE_FIELD(OutputBitRegister115, "output_bit_register_115", bool);
+URCL_RTDE_FIELD(OutputBitRegister116, "output_bit_register_116", bool);
+URCL_RTDE_FIELD(OutputBitRegister117, "output_bit_register_117", bool);
+URCL_RTDE_FIELD(OutputBitRegister118, "output_bit_register_118", bool);
+URCL_RTDE_FIELD(OutputBitRegister119, "output_bit_register_119", bool);
+URCL_RTDE_FIELD(OutputBitRegister120, "output_bit_register_120", bool);
+URCL_RTDE_FIELD(OutputBitRegister121, "output_bit_register_121", bool);
+URCL_RTDE_FIELD(OutputBitRegister122, "output_bit_register_122", bool);
+URCL_RTDE_FIELD(OutputBitRegister123, "output_bit_register_123", bool);
+URCL_RTDE_FIELD(OutputBitRegister124, "output_bit_register_124", bool);
+URCL_RTDE_FIELD(OutputBitRegister125, "output_bit_register_125", bool);
+URCL_RTDE_FIELD(OutputBitRegister126, "output_bit_register_126", bool);
+URCL_RTDE_FIELD(OutputBitRegister127, "output_bit_register_127", bool);
+URCL_RTDE_FIELD(OutputIntRegister0, "output_int_register_0", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister1, "output_int_register_1", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister2, "output_int_register_2", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister3, "output_int_register_3", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister4, "output_int_register_4", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister5, "output_int_register_5", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister6, "output_int_register_6", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister7, "output_int_register_7", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister8, "output_int_register_8", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister9, "output_int_register_9", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister10, "output_int_register_10", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister11, "output_int_register_11", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister12, "output_int_register_12", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister13, "output_int_register_13", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister14, "output_int_register_14", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister15, "output_int_register_15", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister16, "output_int_register_16", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister17, "output_int_register_17", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister18, "output_int_register_18", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister19, "output_int_register_19", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister20, "output_int_register_20", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister21, "output_int_register_21", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister22, "output_int_register_22", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister23, "output_int_register_23", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister24, "output_int_register_24", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister25, "output_int_register_25", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister26, "output_int_register_26", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister27, "output_int_register_27", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister28, "output_int_register_28", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister29, "output_int_register_29", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister30, "output_int_register_30", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister31, "output_int_register_31", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister32, "output_int_register_32", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister33, "output_int_register_33", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister34, "output_int_register_34", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister35, "output_int_register_35", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister36, "output_int_register_36", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister37, "output_int_register_37", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister38, "output_int_register_38", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister39, "output_int_register_39", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister40, "output_int_register_40", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister41, "output_int_register_41", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister42, "output_int_register_42", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister43, "output_int_register_43", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister44, "output_int_register_44", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister45, "output_int_register_45", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister46, "output_int_register_46", int32_t);
+URCL_RTDE_FIELD(OutputIntRegister47, "output_int_register_47", int32_t);
+URCL_RTDE_FIELD(OutputDoubleRegister0, "output_double_register_0", double);
+URCL_RTDE_FIELD(OutputDoubleRegister1, "output_double_register_1", double);
+URCL_RTDE_FIELD(OutputDoubleRegister2, "output_double_register_2", double);
+URCL_RTDE_FIELD(OutputDoubleRegister3, "output_double_register_3", double);
+URCL_RTDE_FIELD(OutputDoubleRegister4, "output_double_register_4", double);
+URCL_RTDE_FIELD(OutputDoubleRegister5, "output_double_register_5", double);
+URCL_RTDE_FIELD(OutputDoubleRegister6, "output_double_register_6", double);
+URCL_RTDE_FIELD(OutputDoubleRegister7, "output_double_register_7", double);
+URCL_RTDE_FIELD(OutputDoubleRegister8, "output_double_register_8", double);
+URCL_RTDE_FIELD(OutputDoubleRegister9, "output_double_register_9", double);
+URCL_RTDE_FIELD(OutputDoubleRegister10, "output_double_register_10", double);
+URCL_RTDE_FIELD(OutputDoubleRegister11, "output_double_register_11", double);
+URCL_RTDE_FIELD(OutputDoubleRegister12, "output_double_register_12", double);
+URCL_RTDE_FIELD(OutputDoubleRegister13, "output_double_register_13", double);
+URCL_RTDE_FIELD(OutputDoubleRegister14, "output_double_register_14", double);
+URCL_RTDE_FIELD(OutputDoubleRegister15, "output_double_register_15", double);
+URCL_RTDE_FIELD(OutputDoubleRegister16, "output_double_register_16", double);
+URCL_RTDE_FIELD(OutputDoubleRegister17, "output_double_register_17", double);
+URCL_RTDE_FIELD(OutputDoubleRegister18, "output_double_register_18", double);
+URCL_RTDE_FIELD(OutputDoubleRegister19, "output_double_register_19", double);
+URCL_RTDE_FIELD(OutputDoubleRegister20, "output_double_register_20", double);
+URCL_RTDE_FIELD(OutputDoubleRegister21, "output_double_register_21", double);
+URCL_RTDE_FIELD(OutputDoubleRegister22, "output_double_register_22", double);
+URCL_RTDE_FIELD(OutputDoubleRegister23, "output_double_register_23", double);
+URCL_RTDE_FIELD(OutputDoubleRegister24, "output_double_register_24", double);
+URCL_RTDE_FIELD(OutputDoubleRegister25, "output_double_register_25", double);
+URCL_RTDE_FIELD(OutputDoubleRegister26, "output_double_register_26", double);
+URCL_RTDE_FIELD(OutputDoubleRegister27, "output_double_register_27", double);
+URCL_RTDE_FIELD(OutputDoubleRegister28, "output_double_register_28", double);
+URCL_RTDE_FIELD(OutputDoubleRegister29, "output_double_register_29", double);
+URCL_RTDE_FIELD(OutputDoubleRegister30, "output_double_register_30", double);
+URCL_RTDE_FIELD(OutputDoubleRegister31, "output_double_register_31", double);
+URCL_RTDE_FIELD(OutputDoubleRegister32, "output_double_register_32", double);
+URCL_RTDE_FIELD(OutputDoubleRegister33, "output_double_register_33", double);
+URCL_RTDE_FIELD(OutputDoubleRegister34, "output_double_register_34", double);
+URCL_RTDE_FIELD(OutputDoubleRegister35, "output_double_register_35", double);
+URCL_RTDE_FIELD(OutputDoubleRegister36, "output_double_register_36", double);
+URCL_RTDE_FIELD(OutputDoubleRegister37, "output_double_register_37", double);
+URCL_RTDE_FIELD(OutputDoubleRegister38, "output_double_register_38", double);
+URCL_RTDE_FIELD(OutputDoubleRegister39, "output_double_register_39", double);
+URCL_RTDE_FIELD(OutputDoubleRegister40, "output_double_register_40", double);
+URCL_RTDE_FIELD(OutputDoubleRegister41, "output_double_register_41", double);
+URCL_RTDE_FIELD(OutputDoubleRegister42, "output_double_register_42", double);
+URCL_RTDE_FIELD(OutputDoubleRegister43, "output_double_register_43", double);
+URCL_RTDE_FIELD(OutputDoubleRegister44, "output_double_register_44", double);
+URCL_RTDE_FIELD(OutputDoubleRegister45, "output_double_register_45", double);
+URCL_RTDE_FIELD(OutputDoubleRegister46, "output_double_register_46", double);
+URCL_RTDE_FIELD(OutputDoubleRegister47, "output_double_register_47", double);
+URCL_RTDE_FIELD(InputBitRegisters0To31, "input_bit_registers0_to_31", uint32_t);
+URCL_RTDE_FIELD(InputBitRegisters32To63, "input_bit_registers32_to_63", uint32_t);
+URCL_RTDE_FIELD(InputBitRegister0, "input_bit_register_0", bool);
+URCL_RTDE_FIELD(InputBitRegister1, "input_bit_register_1", bool);
+URCL_RTDE_FIELD(InputBitRegister2, "input_bit_register_2", bool);
+URCL_RTDE_FIELD(InputBitRegister3, "input_bit_register_3", bool);
+URCL_RTDE_FIELD(InputBitRegister4, "input_bit_register_4", bool);
+URCL_RTDE_FIELD(InputBitRegister5, "input_bit_register_5", bool);
+URCL_RTDE_FIELD(InputBitRegister6, "input_bit_register_6", bool);
+URCL_RTDE_FIELD(InputBitRegister7, "input_bit_register_7", bool);
+URCL_RTDE_FIELD(InputBitRegister8, "input_bit_register_8", bool);
+URCL_RTDE_FIELD(InputBitRegister9, "input_bit_register_9", bool);
+URCL_RTDE_FIELD(InputBitRegister10, "input_bit_register_10", bool);
+URCL_RTDE_FIELD(InputBitRegister11, "input_bit_register_11", bool);
+URCL_RTDE_FIELD(InputBitRegister12, "input_bit_register_12", bool);
+URCL_RTDE_FIELD(InputBitRegister13, "input_bit_register_13", bool);
+URCL_RTDE_FIELD(InputBitRegister14, "input_bit_register_14", bool);
+URCL_RTDE_FIELD(InputBitRegister15, "input_bit_register_15", bool);
+URCL_RTDE_FIELD(InputBitRegister16, "input_bit_register_16", bool);
+URCL_RTDE_FIELD(InputBitRegister17, "input_bit_register_17", bool);
+URCL_RTDE_FIELD(InputBitRegister18, "input_bit_register_18", bool);
+URCL_RTDE_FIELD(InputBitRegister19, "input_bit_register_19", bool);
+URCL_RTDE_FIELD(InputBitRegister20, "input_bit_register_20", bool);
+URCL_RTDE_FIELD(InputBitRegister21, "input_bit_register_21", bool);
+URCL_RTDE_FIELD(InputBitRegister22, "input_bit_register_22", bool);
+URCL_RTDE_FIELD(InputBitRegister23, "input_bit_register_23", bool);
+URCL_RTDE_FIELD(InputBitRegister24, "input_bit_register_24", bool);
+URCL_RTDE_FIELD(InputBitRegister25, "input_bit_register_25", bool);
+URCL_RTDE_FIELD(InputBitRegister26, "input_bit_register_26", bool);
+URCL_RTDE_FIELD(InputBitRegister27, "input_bit_register_27", bool);
+URCL_RTDE_FIELD(InputBitRegister28, "input_bit_register_28", bool);
+URCL_RTDE_FIELD(InputBitRegister29, "input_bit_register_29", bool);
+URCL_RTDE_FIELD(InputBitRegister30, "input_bit_register_30", bool);
+URCL_RTDE_FIELD(InputBitRegister31, "input_bit_register_31", bool);
+URCL_RTDE_FIELD(InputBitRegister32, "input_bit_register_32", bool);
+URCL_RTDE_FIELD(InputBitRegister33, "input_bit_register_33", bool);
+URCL_RTDE_FIELD(InputBitRegister34, "input_bit_register_34", bool);
+URCL_RTDE_FIELD(InputBitRegister35, "input_bit_register_35", bool);
+URCL_RTDE_FIELD(InputBitRegister36, "input_bit_register_36", bool);
+URCL_RTDE_FIELD(InputBitRegister37, "input_bit_register_37", bool);
+URCL_RTDE_FIELD(InputBitRegister38, "input_bit_register_38", bool);
+URCL_RTDE_FIELD(InputBitRegister39, "input_bit_register_39", bool);
+URCL_RTDE_FIELD(InputBitRegister40, "input_bit_register_40", bool);
+URCL_RTDE_FIELD(InputBitRegister41, "input_bit_register_41", bool);
+URCL_RTDE_FIELD(InputBitRegister42, "input_bit_register_42", bool);
+URCL_RTDE_FIELD(InputBitRegister43, "input_bit_register_43", bool);
+URCL_RTDE_FIELD(InputBitRegister44, "input_bit_register_44", bool);
+URCL_RTDE_FIELD(InputBitRegister45, "input_bit_register_45", bool);
+URCL_RTDE_FIELD(InputBitRegister46, "input_bit_register_46", bool);
+URCL_RTDE_FIELD(InputBitRegister47, "input_bit_register_47", bool);
+URCL_RTDE_FIELD(InputBitRegister48, "input_bit_register_48", bool);
+URCL_RTDE_FIELD(InputBitRegister49, "input_bit_register_49", bool);
+URCL_RTDE_FIELD(InputBitRegister50, "input_bit_register_50", bool);
+URCL_RTDE_FIELD(InputBitRegister51, "input_bit_register_51", bool);
+URCL_RTDE_FIELD(InputBitRegister52, "input_bit_register_52", bool);
+URCL_RTDE_FIELD(InputBitRegister53, "input_bit_register_53", bool);
+URCL_RTDE_FIELD(InputBitRegister54, "input_bit_register_54", bool);
+URCL_RTDE_FIELD(InputBitRegister55, "input_bit_register_55", bool);
+URCL_RTDE_FIELD(InputBitRegister56, "input_bit_register_56", bool);
+URCL_RTDE_FIELD(InputBitRegister57, "input_bit_register_57", bool);
+URCL_RTDE_FIELD(InputBitRegister58, "input_bit_register_58", bool);
+URCL_RTDE_FIELD(InputBitRegister59, "input_bit_register_59", bool);
+URCL_RTDE_FIELD(InputBitRegister60, "input_bit_register_60", bool);
+URCL_RTDE_FIELD(InputBitRegister61, "input_bit_register_61", bool);
+URCL_RTDE_FIELD(InputBitRegister62, "input_bit_register_62", bool);
+URCL_RTDE_FIELD(InputBitRegister63, "input_bit_register_63", bool);
+URCL_RTDE_FIELD(InputBitRegister64, "input_bit_register_64", bool);
+URCL_RTDE_FIELD(InputBitRegister65, "input_bit_register_65", bool);
+URCL_RTDE_FIELD(InputBitRegister66, "input_bit_register_66", bool);
+URCL_RTDE_FIELD(InputBitRegister67, "input_bit_register_67", bool);
+URCL_RTDE_FIELD(InputBitRegister68, "input_bit_register_68", bool);
+URCL_RTDE_FIELD(InputBitRegister69, "input_bit_register_69", bool);
+URCL_RTDE_FIELD(InputBitRegister70, "input_bit_register_70", bool);
+URCL_RTDE_FIELD(InputBitRegister71, "input_bit_register_71", bool);
+URCL_RTDE_FIELD(InputBitRegister72, "input_bit_register_72", bool);
+URCL_RTDE_FIELD(InputBitRegister73, "input_bit_register_73", bool);
+URCL_RTDE_FIELD(InputBitRegister74, "input_bit_register_74", bool);
+URCL_RTDE_FIELD(InputBitRegister75, "input_bit_register_75", bool);
+URCL_RTDE_FIELD(InputBitRegister76, "input_bit_register_76", bool);
+URCL_RTDE_FIELD(InputBitRegister77, "input_bit_register_77", bool);
+URCL_RTDE_FIELD(InputBitRegister78, "input_bit_register_78", bool);
+URCL_RTDE_FIELD(InputBitRegister79, "input_bit_register_79", bool);
+URCL_RTDE_FIELD(InputBitRegister80, "input_bit_register_80", bool);
+URCL_RTDE_FIELD(InputBitRegister81, "input_bit_register_81", bool);
+URCL_RTDE_FIELD(InputBitRegister82, "input_bit_register_82", bool);
+URCL_RTDE_FIELD(InputBitRegister83, "input_bit_register_83", bool);
+URCL_RTDE_FIELD(InputBitRegister84, "input_bit_register_84", bool);
+URCL_RTDE_FIELD(InputBitRegister85, "input_bit_register_85", bool);
+URCL_RTDE_FIELD(InputBitRegister86, "input_bit_register_86", bool);
+URCL_RTDE_FIELD(InputBitRegister87, "input_bit_register_87", bool);
+URCL_RTDE_FIELD(InputBitRegister88, "input_bit_register_88", bool);
+URCL_RTDE_FIELD(InputBitRegister89, "input_bit_register_89", bool);
+URCL_RTDE_FIELD(InputBitRegister90, "input_bit_register_90", bool);
+URCL_RTDE_FIELD(InputBitRegister91, "input_bit_register_91", bool);
+URCL_RTDE_FIELD(InputBitRegister92, "input_bit_register_92", bool);
+URCL_RTDE_FIELD(InputBitRegister93, "input_bit_register_93", bool);
+URCL_RTDE_FIELD(InputBitRegister94, "input_bit_register_94", bool);
+URCL_RTDE_FIELD(InputBitRegister95, "input_bit_register_95", bool);
+URCL_RTDE_FIELD(InputBitRegister96, "input_bit_register_96", bool);
+URCL_RTDE_FIELD(InputBitRegister97, "input_bit_register_97", bool);
+URCL_RTDE_FIELD(InputBitRegister98, "input_bit_register_98", bool);
+URCL_RTDE_FIELD(InputBitRegister99, "input_bit_register_99", bool);
+URCL_RTDE_FIELD(InputBitRegister100, "input_bit_register_100", bool);
+URCL_RTDE_FIELD(InputBitRegister101, "input_bit_register_101", bool);
+URCL_RTDE_FIELD(InputBitRegister102, "input_bit_register_102", bool);
+URCL_RTDE_FIELD(InputBitRegister103, "input_bit_register_103", bool);
+URCL_RTDE_FIELD(InputBitRegister104, "input_bit_register_104", bool);
+URCL_RTDE_FIELD(InputBitRegister105, "input_bit_register_105", bool);
+URCL_RTDE_FIELD(InputBitRegister106, "input_bit_register_106", bool);
+URCL_RTDE_FIELD(InputBitRegister107, "input_bit_register_107", bool);
+URCL_RTDE_FIELD(InputBitRegister108, "input_bit_register_108", bool);
+URCL_RTDE_FIELD(InputBitRegister109, "input_bit_register_109", bool);
+URCL_RTDE_FIELD(InputBitRegister110, "input_bit_register_110", bool);
+URCL_RTDE_FIELD(InputBitRegister111, "input_bit_register_111", bool);
+URCL_RTDE_FIELD(InputBitRegister112, "input_bit_register_112", bool);
+URCL_RTDE_FIELD(InputBitRegister113, "input_bit_register_113", bool);
+URCL_RTDE_FIELD(InputBitRegister114, "input_bit_register_114", bool);
+URCL_RTDE_FIELD(InputBitRegister115, "input_bit_register_115", bool);
+URCL_RTDE_FIELD(InputBitRegister116, "input_bit_register_116", bool);
+URCL_RTDE_FIELD(InputBitRegister117, "input_bit_register_117", bool);
+URCL_RTDE_FIELD(InputBitRegister118, "input_bit_register_118", bool);
+URCL_RTDE_FIELD(InputBitRegister119, "input_bit_register_119", bool);
+URCL_RTDE_FIELD(InputBitRegister120, "input_bit_register_120", bool);
+URCL_RTDE_FIELD(InputBitRegister121, "input_bit_register_121", bool);
+URCL_RTDE_FIELD(InputBitRegister122, "input_bit_register_122", bool);
+URCL_RTDE_FIELD(InputBitRegister123, "input_bit_register_123", bool);
+URCL_RTDE_FIELD(InputBitRegister124, "input_bit_register_124", bool);
+URCL_RTDE_FIELD(InputBitRegister125, "input_bit_register_125", bool);
+URCL_RTDE_FIELD(InputBitRegister126, "input_bit_register_126", bool);
+URCL_RTDE_FIELD(InputBitRegister127, "input_bit_register_127", bool);
+URCL_RTDE_FIELD(InputIntRegister0, "input_int_register_0", int32_t);
+URCL_RTDE_FIELD(InputIntRegister1, "input_int_register_1", int32_t);
+URCL_RTDE_FIELD(InputIntRegister2, "input_int_register_2", int32_t);
+URCL_RTDE_FIELD(InputIntRegister3, "input_int_register_3", int32_t);
+URCL_RTDE_FIELD(InputIntRegister4, "input_int_register_4", int32_t);
+URCL_RTDE_FIELD(InputIntRegister5, "input_int_register_5", int32_t);
+URCL_RTDE_FIELD(InputIntRegister6, "input_int_register_6", int32_t);
+URCL_RTDE_FIELD(InputIntRegister7, "input_int_register_7", int32_t);
+URCL_RTDE_FIELD(InputIntRegister8, "input_int_register_8", int32_t);
+URCL_RTDE_FIELD(InputIntRegister9, "input_int_register_9", int32_t);
+URCL_RTDE_FIELD(InputIntRegister10, "input_int_register_10", int32_t);
+URCL_RTDE_FIELD(InputIntRegister11, "input_int_register_11", int32_t);
+URCL_RTDE_FIELD(InputIntRegister12, "input_int_register_12", int32_t);
+URCL_RTDE_FIELD(InputIntRegister13, "input_int_register_13", int32_t);
+URCL_RTDE_FIELD(InputIntRegister14, "input_int_register_14", int32_t);
+URCL_RTDE_FIELD(InputIntRegister15, "input_int_register_15", int32_t);
+URCL_RTDE_FIELD(InputIntRegister16, "input_int_register_16", int32_t);
+URCL_RTDE_FIELD(InputIntRegister17, "input_int_register_17", int32_t);
+URCL_RTDE_FIELD(InputIntRegister18, "input_int_register_18", int32_t);
+URCL_RTDE_FIELD(InputIntRegister19, "input_int_register_19", int32_t);
+URCL_RTDE_FIELD(InputIntRegister20, "input_int_register_20", int32_t);
+URCL_RTDE_FIELD(InputIntRegister21, "input_int_register_21", int32_t);
+URCL_RTDE_FIELD(InputIntRegister22, "input_int_register_22", int32_t);
+URCL_RTDE_FIELD(InputIntRegister23, "input_int_register_23", int32_t);
+URCL_RTDE_FIELD(InputIntRegister24, "input_int_register_24", int32_t);
+URCL_RTDE_FIELD(InputIntRegister25, "input_int_register_25", int32_t);
+URCL_RTDE_FIELD(InputIntRegister26, "input_int_register_26", int32_t);
+URCL_RTDE_FIELD(InputIntRegister27, "input_int_register_27", int32_t);
+URCL_RTDE_FIELD(InputIntRegister28, "input_int_register_28", int32_t);
+URCL_RTDE_FIELD(InputIntRegister29, "input_int_register_29", int32_t);
+URCL_RTDE_FIELD(InputIntRegister30, "input_int_register_30", int32_t);
+URCL_RTDE_FIELD(InputIntRegister31, "input_int_register_31", int32_t);
+URCL_RTDE_FIELD(InputIntRegister32, "input_int_register_32", int32_t);
+URCL_RTDE_FIELD(InputIntRegister33, "input_int_register_33", int32_t);
+URCL_RTDE_FIELD(InputIntRegister34, "input_int_register_34", int32_t);
+URCL_RTDE_FIELD(InputIntRegister35, "input_int_register_35", int32_t);
+URCL_RTDE_FIELD(InputIntRegister36, "input_int_register_36", int32_t);
+URCL_RTDE_FIELD(InputIntRegister37, "input_int_register_37", int32_t);
+URCL_RTDE_FIELD(InputIntRegister38, "input_int_register_38", int32_t);
+URCL_RTDE_FIELD(InputIntRegister39, "input_int_register_39", int32_t);
+URCL_RTDE_FIELD(InputIntRegister40, "input_int_register_40", int32_t);
+URCL_RTDE_FIELD(InputIntRegister41, "input_int_register_41", int32_t);
+URCL_RTDE_FIELD(InputIntRegister42, "input_int_register_42", int32_t);
+URCL_RTDE_FIELD(InputIntRegister43, "input_int_register_43", int32_t);
+URCL_RTDE_FIELD(InputIntRegister44, "input_int_register_44", int32_t);
+URCL_RTDE_FIELD(InputIntRegister45, "input_int_register_45", int32_t);
+URCL_RTDE_FIELD(InputIntRegister46, "input_int_register_46", int32_t);
+URCL_RTDE_FIELD(InputIntRegister47, "input_int_register_47", int32_t);
+URCL_RTDE_FIELD(InputDoubleRegister0, "input_double_register_0", double);
+URCL_RTDE_FIELD(InputDoubleRegister1, "input_double_register_1", double);
+URCL_RTDE_FIELD(InputDoubleRegister2, "input_double_register_2", double);
+URCL_RTDE_FIELD(InputDoubleRegister3, "input_double_register_3", double);
+URCL_RTDE_FIELD(InputDoubleRegister4, "input_double_register_4", double);
+URCL_RTDE_FIELD(InputDoubleRegister5, "input_double_register_5", double);
+URCL_RTDE_FIELD(InputDoubleRegister6, "input_double_register_6", double);
+URCL_RTDE_FIELD(InputDoubleRegister7, "input_double_register_7", double);
+URCL_RTDE_FIELD(InputDoubleRegister8, "input_double_register_8", double);
+URCL_RTDE_FIELD(InputDoubleRegister9, "input_double_register_9", double);
+URCL_RTDE_FIELD(InputDoubleRegister10, "input_double_register_10", double);
+URCL_RTDE_FIELD(InputDoubleRegister11, "input_double_register_11", double);
+URCL_RTDE_FIELD(InputDoubleRegister12, "input_double_register_12", double);
+URCL_RTDE_FIELD(InputDoubleRegister13, "input_double_register_13", double);
+URCL_RTDE_FIELD(InputDoubleRegister14, "input_double_register_14", double);
+URCL_RTDE_FIELD(InputDoubleRegister15, "input_double_register_15", double);
+URCL_RTDE_FIELD(InputDoubleRegister16, "input_double_register_16", double);
+URCL_RTDE_FIELD(InputDoubleRegister17, "input_double_register_17", double);
+URCL_RTDE_FIELD(InputDoubleRegister18, "input_double_register_18", double);
+URCL_RTDE_FIELD(InputDoubleRegister19, "input_double_register_19", double);
+URCL_RTDE_FIELD(InputDoubleRegister20, "input_double_register_20", double);
+URCL_RTDE_FIELD(InputDoubleRegister21, "input_double_register_21", double);
+URCL_RTDE_FIELD(InputDoubleRegister22, "input_double_register_22", double);
+URCL_RTDE_FIELD(InputDoubleRegister23, "input_double_register_23", double);
+URCL_RTDE_FIELD(InputDoubleRegister24, "input_double_register_24", double);
+URCL_RTDE_FIELD(InputDoubleRegister25, "input_double_register_25", double);
+URCL_RTDE_FIELD(InputDoubleRegister26, "input_double_register_26", double);
+URCL_RTDE_FIELD(InputDoubleRegister27, "input_double_register_27", double);
+URCL_RTDE_FIELD(InputDoubleRegister28, "input_double_register_28", double);
+URCL_RTDE_FIELD(InputDoubleRegister29, "input_double_register_29", double);
+URCL_RTDE_FIELD(InputDoubleRegister30, "input_double_register_30", double);
+URCL_RTDE_FIELD(InputDoubleRegister31, "input_double_register_31", double);
+URCL_RTDE_FIELD(InputDoubleRegister32, "input_double_register_32", double);
+URCL_RTDE_FIELD(InputDoubleRegister33, "input_double_register_33", double);
+URCL_RTDE_FIELD(InputDoubleRegister34, "input_double_register_34", double);
+URCL_RTDE_FIELD(InputDoubleRegister35, "input_double_register_35", double);
+URCL_RTDE_FIELD(InputDoubleRegister36, "input_double_register_36", double);
+URCL_RTDE_FIELD(InputDoubleRegister37, "input_double_register_37", double);
+URCL_RTDE_FIELD(InputDoubleRegister38, "input_double_register_38", double);
+URCL_RTDE_FIELD(InputDoubleRegister39, "input_double_register_39", double);
+URCL_RTDE_FIELD(InputDoubleRegister40, "input_double_register_40", double);
+URCL_RTDE_FIELD(InputDoubleRegister41, "input_double_register_41", double);
+URCL_RTDE_FIELD(InputDoubleRegister42, "input_double_register_42", double);
+URCL_RTDE_FIELD(InputDoubleRegister43, "input_double_register_43", double);
+URCL_RTDE_FIELD(InputDoubleRegister44, "input_double_register_44", double);
+URCL_RTDE_FIELD(InputDoubleRegister45, "input_double_register_45", double);
+URCL_RTDE_FIELD(InputDoubleRegister46, "input_double_register_46", double);
+URCL_RTDE_FIELD(InputDoubleRegister47, "input_double_register_47", double);
+URCL_RTDE_FIELD(SpeedSliderMask, "speed_slider_mask", uint32_t);
+URCL_RTDE_FIELD(SpeedSliderFraction, "speed_slider_fraction", double);
+URCL_RTDE_FIELD(StandardDigitalOutputMask, "standard_digital_output_mask", uint8_t);
+URCL_RTDE_FIELD(StandardDigitalOutput, "standard_digital_output", uint8_t);
+URCL_RTDE_FIELD(ConfigurableDigitalOutputMask, "configurable_digital_output_mask", uint8_t);
+URCL_RTDE_FIELD(ConfigurableDigitalOutput, "configurable_digital_output", uint8_t);
+URCL_RTDE_FIELD(ToolDigitalOutputMask, "tool_digital_output_mask", uint8_t);
+URCL_RTDE_FIELD(ToolOutputMode, "tool_output_mode", uint8_t);
+URCL_RTDE_FIELD(ToolDigitalOutput0Mode, "tool_digital_output0_mode", uint8_t);
+URCL_RTDE_FIELD(ToolDigitalOutput1Mode, "tool_digital_output1_mode", uint8_t);
+URCL_RTDE_FIELD(ToolDigitalOutput, "tool_digital_output", uint8_t);
+URCL_RTDE_FIELD(Payload, "payload", double);
+URCL_RTDE_FIELD(PayloadCog, "payload_cog", vector3d_t);
+URCL_RTDE_FIELD(PayloadInertia, "payload_inertia", vector6d_t);
+URCL_RTDE_FIELD(ScriptControlLine, "script_control_line", uint32_t);
+URCL_RTDE_FIELD(FtRawWrench, "ft_raw_wrench", vector6d_t);
+URCL_RTDE_FIELD(JointPositionDeviationRatio, "joint_position_deviation_ratio", double);
+URCL_RTDE_FIELD(CollisionDetectionRatio, "collision_detection_ratio", double);
+URCL_RTDE_FIELD(TimeScaleSource, "time_scale_source", int32_t);
+URCL_RTDE_FIELD(StandardAnalogOutputMask, "standard_analog_output_mask", uint8_t);
+URCL_RTDE_FIELD(StandardAnalogOutputType, "standard_analog_output_type", uint8_t);
+URCL_RTDE_FIELD(StandardAnalogOutput_0, "standard_analog_output_0", double);
+URCL_RTDE_FIELD(StandardAnalogOutput_1, "standard_analog_output_1", double);
+URCL_RTDE_FIELD(TcpOffset, "tcp_offset", vector6d_t);
+}  // namespace fields
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_RTDE_FIELDS_H_INCLUDED
@@ -23,6 +23,7 @@
 #include "ur_client_library/comm/parser.h"
 #include "ur_client_library/comm/bin_parser.h"
 #include "ur_client_library/comm/pipeline.h"
+#include "ur_client_library/queue/readerwriterqueue.h"
 
 #include "ur_client_library/rtde/control_package_pause.h"
 #include "ur_client_library/rtde/control_package_setup_inputs.h"
@@ -51,7 +52,22 @@ public:
    *
    * \param recipe The recipe used in RTDE data communication
    */
-  RTDEParser(const std::vector<std::string>& recipe) : recipe_(recipe), protocol_version_(1)
+  RTDEParser(const std::vector<std::string>& recipe)
+    : recipe_(recipe)
+    , layout_(std::make_shared<const DataPackage::RecipeLayout>(recipe))
+    , free_packages_{ MAX_POOLED_PACKAGES }
+    , protocol_version_(1)
+  {
+  }
+
+  /*!
+   * \brief Creates a new RTDEParser object for an already resolved recipe layout, e.g. the layout of
+   * a Recipe known at compile time.
+   *
+   * \param layout The layout of the recipe used in RTDE data communication
+   */
+  RTDEParser(std::shared_ptr<const DataPackage::RecipeLayout> layout)
+    : recipe_(layout->getRecipe()), layout_(layout), free_packages_{ MAX_POOLED_PACKAGES }, protocol_version_(1)
   {
   }
   virtual ~RTDEParser() = default;
@@ -83,7 +99,16 @@ public:
     {
       case PackageType::RTDE_DATA_PACKAGE:
       {
-        std::unique_ptr<RTDEPackage> package(new DataPackage(recipe_, protocol_version_));
+        // Reuse a recycled package if possible, so no memory has to be allocated in steady state.
+        std::unique_ptr<DataPackage> package;
+        if (free_packages_.tryDequeue(package))
+        {
+          package->setProtocolVersion(protocol_version_);
+        }
+        else
+        {
+          package.reset(new DataPackage(layout_, protocol_version_));
+        }
 
         if (!package->parseWith(bp))
         {
@@ -121,8 +146,42 @@ public:
     protocol_version_ = protocol_version;
   }
 
+  /*!
+   * \brief Puts a data package that is not used anymore into the parser's package pool. Packages
+   * from the pool are reused for parsing subsequent data packages. Other package types as well as
+   * data packages with a different recipe are destroyed.
+   *
+   * Packages may be recycled from one thread while another thread is parsing.
+   *
+   * \param product The package that is not used anymore
+   */
+  void recycle(std::unique_ptr<RTDEPackage> product) override
+  {
+    DataPackage* data_package = dynamic_cast<DataPackage*>(product.get());
+    if (data_package == nullptr || data_package->getRecipeLayout() != layout_)
+    {
+      return;
+    }
+    product.release();
+    // If the pool is already full, the package is destroyed
+    free_packages_.tryEnqueue(std::unique_ptr<DataPackage>(data_package));
+  }
+
+  /*!
+   * \brief Getter for the layout of the recipe, shared by all parsed data packages.
+   *
+   * \returns The recipe layout
+   */
+  const std::shared_ptr<const DataPackage::RecipeLayout>& getRecipeLayout() const
+  {
+    return layout_;
+  }
+
 private:
   std::vector<std::string> recipe_;
+  std::shared_ptr<const DataPackage::RecipeLayout> layout_;
+  static const size_t MAX_POOLED_PACKAGES = 32;
+  moodycamel::ReaderWriterQueue<std::unique_ptr<DataPackage>> free_packages_;
   RTDEPackage* packageFromType(PackageType type)
   {
     switch (type)
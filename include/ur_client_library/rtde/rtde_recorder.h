@@ -0,0 +1,163 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_RTDE_RECORDER_H_INCLUDED
+#define UR_CLIENT_LIBRARY_RTDE_RECORDER_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/comm/recording.h"
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Records RTDE data packages into a comm::RecordingWriter file.
+ *
+ * Packages are stored as serialized by DataPackage::serializePackage(), which is the format of RTDE
+ * protocol version 2, regardless of the protocol version used for the communication.
+ *
+ * Packages are serialized into a preallocated ring buffer by record(), which doesn't allocate, lock
+ * or make any system call. This way it can be called from the RTDE producer thread. A background
+ * thread moves the packages from the ring buffer into the file. If the ring buffer is full, packages
+ * are dropped instead of waiting for the background thread.
+ */
+class RTDERecorder
+{
+public:
+  RTDERecorder() = delete;
+
+  /*!
+   * \brief Creates a recording and starts the background thread writing it.
+   *
+   * \param filename Path of the recording file
+   * \param layout Recipe layout of the recorded packages
+   * \param buffer_size Number of packages the ring buffer can hold
+   *
+   * \throws UrException if the file cannot be created
+   */
+  RTDERecorder(const std::string& filename, std::shared_ptr<const DataPackage::RecipeLayout> layout,
+               const size_t buffer_size = 1024);
+
+  /*!
+   * \brief Writes all buffered packages and closes the recording.
+   */
+  ~RTDERecorder();
+
+  /*!
+   * \brief Adds a package to the recording. Only one thread may record packages.
+   *
+   * \param package Package to record. It has to use the recipe layout of the recorder.
+   *
+   * \returns True, if the package was buffered for writing, false if it uses a different recipe
+   * layout or the buffer is full
+   */
+  bool record(const DataPackage& package);
+
+  /*!
+   * \brief Getter for the number of packages written to the file.
+   *
+   * \returns The number of recorded packages
+   */
+  uint64_t getNumRecorded() const
+  {
+    return num_recorded_;
+  }
+
+  /*!
+   * \brief Getter for the number of packages that got dropped because the buffer was full or the
+   * file could not be written.
+   *
+   * \returns The number of dropped packages
+   */
+  uint64_t getNumDropped() const
+  {
+    return num_dropped_;
+  }
+
+  /*!
+   * \brief Creates the metadata stored in RTDE recordings, which is the recipe with one field name
+   * per line.
+   *
+   * \param recipe The output recipe
+   *
+   * \returns The recording metadata
+   */
+  static std::string recipeToMetadata(const std::vector<std::string>& recipe);
+
+  /*!
+   * \brief Reads the recipe from the metadata of an RTDE recording.
+   *
+   * \param metadata The recording metadata
+   *
+   * \returns The output recipe
+   */
+  static std::vector<std::string> metadataToRecipe(const std::string& metadata);
+
+private:
+  void runWriter();
+  // Moves all buffered packages to the file, returns the number of packages moved
+  size_t writeBuffered();
+
+  // Position and size of a package inside the ring buffer
+  struct Slot
+  {
+    std::chrono::steady_clock::time_point received;
+    size_t size;
+  };
+
+  std::shared_ptr<const DataPackage::RecipeLayout> layout_;
+  comm::RecordingWriter writer_;
+  size_t slot_size_;
+  std::vector<Slot> slots_;
+  std::vector<uint8_t> buffer_;
+
+  // Number of packages buffered and number of packages moved to the file. Each is only written by
+  // one side.
+  std::atomic<uint64_t> head_;
+  std::atomic<uint64_t> tail_;
+
+  std::atomic<uint64_t> num_recorded_;
+  std::atomic<uint64_t> num_dropped_;
+  std::atomic<bool> running_;
+  std::thread writer_thread_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_RTDE_RECORDER_H_INCLUDED
@@ -35,6 +35,8 @@
 #include "ur_client_library/comm/stream.h"
 #include "ur_client_library/queue/readerwriterqueue.h"
 #include "ur_client_library/ur/datatypes.h"
+#include <atomic>
+#include <memory>
 #include <thread>
 #include <mutex>
 
@@ -46,6 +48,16 @@ namespace rtde_interface
  * \brief The RTDEWriter class offers an abstraction layer to send data to the robot via the RTDE
  * interface. Several simple to use functions to create data packages to send exist, which are
  * then sent to the robot in an additional thread.
+ *
+ * By default every call to one of the send-methods results in a separate package being sent. To
+ * update multiple fields at once, e.g. once per control cycle, changes can be grouped using
+ * beginBatch() and commit(). All changes made in between are merged into one package.
+ *
+ * In synchronous mode (see setSynchronous()) changes are not sent right away, but collected until
+ * flush() is called. The RTDEClient calls flush() whenever it receives a data package, so inputs are
+ * sent aligned with the robot's control cycle. Each change publishes a copy of the collected changes,
+ * which flush() takes with an atomic exchange. Hence, flushing never waits for a thread making
+ * changes.
  */
 class RTDEWriter
 {
@@ -59,6 +71,15 @@ public:
    */
   RTDEWriter(comm::URStream<RTDEPackage>* stream, const std::vector<std::string>& recipe);
 
+  /*!
+   * \brief Creates a new RTDEWriter object using a given URStream and an already resolved recipe
+   * layout, e.g. the layout of a Recipe known at compile time.
+   *
+   * \param stream The URStream to use for communication with the robot
+   * \param layout The layout of the recipe to use for communication
+   */
+  RTDEWriter(comm::URStream<RTDEPackage>* stream, std::shared_ptr<const DataPackage::RecipeLayout> layout);
+
   ~RTDEWriter()
   {
     running_ = false;
@@ -66,6 +87,7 @@ public:
     {
       writer_thread_.join();
     }
+    delete pending_.exchange(nullptr);
   }
   /*!
    * \brief Starts the writer thread, which periodically clears the queue to write packages to the
@@ -79,6 +101,54 @@ public:
    */
   void run();
 
+  /*!
+   * \brief Starts a batch of changes. Until commit() is called, the send-methods only record their
+   * changes instead of sending a package each. This applies to calls from all threads.
+   */
+  void beginBatch();
+
+  /*!
+   * \brief Ends the current batch and sends all changes recorded since beginBatch() in one package.
+   * Changes to the same field are merged, e.g. setting two standard digital output pins results in
+   * one package with both pins set in the mask.
+   *
+   * \returns False, if no batch was active or the package could not be queued for sending. In the
+   * latter case the changes are kept and sent with the next package.
+   */
+  bool commit();
+
+  /*!
+   * \brief Enables or disables the synchronous mode. In synchronous mode the send-methods and
+   * commit() only record their changes. All changes recorded until the next call of flush() are
+   * sent in one package, where later changes to a field overwrite earlier ones. Changes still pending
+   * when disabling the synchronous mode are sent right away.
+   *
+   * \param synchronous Whether to use the synchronous mode
+   */
+  void setSynchronous(const bool synchronous);
+
+  /*!
+   * \brief Getter for the synchronous mode.
+   *
+   * \returns True, if the writer is in synchronous mode, false otherwise
+   */
+  bool isSynchronous() const
+  {
+    return synchronous_;
+  }
+
+  /*!
+   * \brief Sends all changes recorded since the last flush in one package. Does nothing if there are
+   * no pending changes or a batch is active.
+   *
+   * Flushing doesn't lock or allocate memory, so it can be called from a real-time thread. Changes
+   * made while flushing are sent with the next flush. Only one thread may flush at a time.
+   *
+   * \returns False, if the package could not be queued for sending. The changes are kept and sent
+   * with the next flush in that case.
+   */
+  bool flush();
+
   /*!
    * \brief Creates a package to request setting a new value for the speed slider.
    *
@@ -159,15 +229,54 @@ public:
   bool sendInputDoubleRegister(uint32_t register_id, double value);
 
 private:
+  static constexpr size_t QUEUE_SIZE = 32;
+
+  // Locks package_ for making changes. In synchronous mode, the published copy of package_ is taken
+  // back while locked, so package_ holds exactly the changes flush() hasn't picked up, yet. The copy
+  // is published again, including the new changes, when the lock is released.
+  class PackageLock
+  {
+  public:
+    explicit PackageLock(RTDEWriter& writer);
+    ~PackageLock();
+
+  private:
+    RTDEWriter& writer_;
+    std::lock_guard<std::mutex> guard_;
+  };
+
   uint8_t pinToMask(uint8_t pin);
+  bool setMaskedBits(const std::string& mask_name, const std::string& value_name, const uint8_t bits,
+                     const bool value);
+  void clearMasks();
+  bool publishPackage();
+  bool queuePackage();
+  void takeBackSnapshot();
+  void publishSnapshot();
+
   comm::URStream<RTDEPackage>* stream_;
   std::vector<std::string> recipe_;
   uint8_t recipe_id_;
   moodycamel::BlockingReaderWriterQueue<std::unique_ptr<DataPackage>> queue_;
+  // Preallocated packages that can be filled and queued without allocating memory
+  moodycamel::ReaderWriterQueue<std::unique_ptr<DataPackage>> free_packages_;
   std::thread writer_thread_;
   bool running_;
   DataPackage package_;
   std::mutex package_mutex_;
+  bool batch_active_;
+  std::atomic<bool> synchronous_;
+  bool changes_pending_;
+
+  // Copy of package_ published for flush() in synchronous mode
+  std::atomic<DataPackage*> pending_;
+  // Whether a copy was published since the last time it was taken back
+  bool snapshot_published_;
+  // Package taken back from pending_, reused for the next copy
+  std::unique_ptr<DataPackage> spare_;
+  // Copy taken by flush() that couldn't be queued, yet. Only used by the flushing thread.
+  std::unique_ptr<DataPackage> unsent_;
+  std::atomic<bool> flushing_;
 };
 
 }  // namespace rtde_interface
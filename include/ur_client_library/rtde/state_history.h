@@ -0,0 +1,265 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_STATE_HISTORY_H_INCLUDED
+#define UR_CLIENT_LIBRARY_STATE_HISTORY_H_INCLUDED
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+#include "ur_client_library/rtde/data_package.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+/*!
+ * \brief Fixed-capacity history of the most recent RTDE data packages that can be queried by the
+ * robot's timestamp.
+ *
+ * The values are stored column-wise, i.e. all values of one field of the recipe are stored next to
+ * each other. Looking up a timestamp therefore only touches the timestamp column and reading a field
+ * only touches the column of this field.
+ *
+ * Samples are added by a single thread, usually the producer thread of the RTDEClient. Any number of
+ * threads may query the history concurrently without locking. A query that got overtaken by the
+ * writer overwriting the samples it read is repeated.
+ */
+class StateHistory
+{
+public:
+  StateHistory() = delete;
+
+  /*!
+   * \brief Creates an empty history.
+   *
+   * \param layout Recipe layout of the packages stored in the history. It has to contain the
+   * timestamp field.
+   * \param capacity Maximum number of samples stored. Older samples get overwritten.
+   *
+   * \throws UrException if the layout does not contain the timestamp or the capacity is smaller
+   * than 2.
+   */
+  StateHistory(std::shared_ptr<const DataPackage::RecipeLayout> layout, const size_t capacity);
+
+  /*!
+   * \brief Adds a sample to the history. Only one thread may add samples.
+   *
+   * If the timestamp of the package is not newer than the newest sample, e.g. because the robot
+   * controller got restarted, all older samples are discarded.
+   *
+   * \param package Package to add. It has to use the recipe layout of the history.
+   *
+   * \returns True, if the sample was added, false if the package uses a different recipe layout
+   */
+  bool add(const DataPackage& package);
+
+  /*!
+   * \brief Discards all samples. This has to be called from the thread adding samples.
+   */
+  void clear();
+
+  /*!
+   * \brief Getter for the maximum number of samples stored.
+   *
+   * \returns The capacity of the history
+   */
+  size_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /*!
+   * \brief Getter for the number of samples that can currently be queried.
+   *
+   * \returns The number of samples in the history
+   */
+  size_t size() const;
+
+  /*!
+   * \brief Getter for the recipe layout of the stored samples. Field handles for querying the
+   * history are created from this layout.
+   *
+   * \returns The recipe layout
+   */
+  const std::shared_ptr<const DataPackage::RecipeLayout>& getRecipeLayout() const
+  {
+    return layout_;
+  }
+
+  /*!
+   * \brief Getter for the robot timestamps of the oldest and the newest sample.
+   *
+   * \param oldest Timestamp of the oldest sample in seconds
+   * \param newest Timestamp of the newest sample in seconds
+   *
+   * \returns True, if the history contains samples, false otherwise
+   */
+  bool getTimeRange(double& oldest, double& newest) const;
+
+  /*!
+   * \brief Gets the value a field had at the given robot time, i.e. the value of the newest sample
+   * that is not newer than the given timestamp.
+   *
+   * \param handle Handle to the requested field, created from the layout of this history
+   * \param timestamp Robot time in seconds
+   * \param val Target variable
+   *
+   * \returns True on success, false if the handle is invalid, was created from a different layout
+   * or the timestamp is outside of the history
+   */
+  template <typename T>
+  bool getData(const FieldHandle<T>& handle, const double timestamp, T& val) const
+  {
+    if (!handle.isValid() || handle.layout_ != layout_.get())
+    {
+      return false;
+    }
+    Samples samples;
+    return readSamples(timestamp, handle.offset_, sizeof(T), reinterpret_cast<uint8_t*>(&val), nullptr, samples);
+  }
+
+  /*!
+   * \brief Gets the value of a field at the given robot time by linearly interpolating between the
+   * samples before and after that time.
+   *
+   * \param handle Handle to the requested field, created from the layout of this history. Only
+   * fields consisting of doubles can be interpolated.
+   * \param timestamp Robot time in seconds
+   * \param val Target variable
+   *
+   * \returns True on success, false if the handle is invalid, was created from a different layout
+   * or the timestamp is outside of the history
+   */
+  template <typename T>
+  bool getInterpolated(const FieldHandle<T>& handle, const double timestamp, T& val) const
+  {
+    static_assert(std::is_same<T, double>::value || std::is_same<T, vector3d_t>::value ||
+                      std::is_same<T, vector6d_t>::value,
+                  "Only fields consisting of doubles can be interpolated");
+    if (!handle.isValid() || handle.layout_ != layout_.get())
+    {
+      return false;
+    }
+    T after;
+    Samples samples;
+    if (!readSamples(timestamp, handle.offset_, sizeof(T), reinterpret_cast<uint8_t*>(&val),
+                     reinterpret_cast<uint8_t*>(&after), samples))
+    {
+      return false;
+    }
+    interpolate(reinterpret_cast<double*>(&val), reinterpret_cast<const double*>(&after), sizeof(T) / sizeof(double),
+                samples.fraction);
+    return true;
+  }
+
+  /*!
+   * \brief Reconstructs the complete state at the given robot time. Fields consisting of doubles
+   * are interpolated linearly between the samples before and after that time, all other fields
+   * hold the value of the sample before. The timestamp field contains the requested time.
+   *
+   * \param timestamp Robot time in seconds
+   * \param package Target package. It has to use the recipe layout of the history.
+   *
+   * \returns True on success, false if the package uses a different recipe layout or the timestamp
+   * is outside of the history
+   */
+  bool stateAt(const double timestamp, DataPackage& package) const;
+
+private:
+  // Position of a query inside the history
+  struct Samples
+  {
+    uint64_t before;
+    uint64_t after;
+    double fraction;
+  };
+
+  // Size and interpolation type of a field
+  struct Column
+  {
+    size_t offset;
+    size_t size;
+    bool interpolate;
+  };
+
+  // The column of the field stored at offset o of the package's data buffer starts at o * slots_ and
+  // holds slots_ values of the field's size. Thereby the offset of a FieldHandle directly addresses
+  // the field's column.
+  const uint8_t* value(const size_t offset, const size_t size, const uint64_t index) const
+  {
+    return columns_.data() + offset * slots_ + (index % slots_) * size;
+  }
+
+  double timestampOf(const uint64_t index) const;
+
+  // Index of the oldest sample that is neither discarded nor overwritten by the next write, when end
+  // samples have been written
+  uint64_t firstAvailable(const uint64_t end) const;
+
+  // Searches the samples around the timestamp and copies the values of one field of these samples
+  // into before and after (if not nullptr). Repeats the search, if the writer overwrote any of the
+  // samples in the meantime.
+  bool readSamples(const double timestamp, const size_t offset, const size_t size, uint8_t* before, uint8_t* after,
+                   Samples& samples) const;
+
+  // Finds the samples around the timestamp among the samples [first, end)
+  bool findSamples(const double timestamp, const uint64_t first, const uint64_t end, Samples& samples) const;
+
+  // Checks whether all samples starting at first are still unchanged
+  bool isValid(const uint64_t first) const;
+
+  static void interpolate(double* before, const double* after, const size_t count, const double fraction);
+
+  std::shared_ptr<const DataPackage::RecipeLayout> layout_;
+  size_t capacity_;
+  // One slot more than the capacity, so the slot being written never holds a queryable sample
+  size_t slots_;
+  std::vector<Column> fields_;
+  size_t timestamp_offset_;
+  std::vector<uint8_t> columns_;
+
+  // Number of samples whose writing has been started
+  std::atomic<uint64_t> writing_;
+  // Number of samples written completely
+  std::atomic<uint64_t> written_;
+  // Index of the oldest sample not discarded by clear()
+  std::atomic<uint64_t> first_;
+  // Only accessed by the writer
+  double newest_timestamp_;
+};
+
+}  // namespace rtde_interface
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_STATE_HISTORY_H_INCLUDED
@@ -50,8 +50,9 @@ public:
    * \brief Constructor that shall be used by default
    *
    * \param host IP address of the robot
+   * \param port Port of the robot's dashboard server
    */
-  DashboardClient(const std::string& host);
+  DashboardClient(const std::string& host, const int port = DASHBOARD_SERVER_PORT);
   DashboardClient() = delete;
   virtual ~DashboardClient() = default;
 
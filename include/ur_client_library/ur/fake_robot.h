@@ -0,0 +1,372 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_FAKE_ROBOT_H_INCLUDED
+#define UR_CLIENT_LIBRARY_FAKE_ROBOT_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "ur_client_library/comm/control_mode.h"
+#include "ur_client_library/comm/tcp_server.h"
+#include "ur_client_library/comm/tcp_socket.h"
+#include "ur_client_library/primary/package_header.h"
+#include "ur_client_library/rtde/data_package.h"
+#include "ur_client_library/rtde/rtde_client.h"
+#include "ur_client_library/types.h"
+#include "ur_client_library/ur/dashboard_client.h"
+#include "ur_client_library/ur/version_information.h"
+
+namespace urcl
+{
+/*!
+ * \brief Ports a FakeRobot serves its interfaces on. Ports given as 0 are chosen by the operating
+ * system, which allows running multiple FakeRobots on one machine at the same time.
+ */
+struct FakeRobotPorts
+{
+  int rtde = UR_RTDE_PORT;                                 ///< Port of the RTDE interface
+  int primary = primary_interface::UR_PRIMARY_PORT;        ///< Port of the primary interface
+  int secondary = primary_interface::UR_SECONDARY_PORT;    ///< Port of the secondary interface
+  int dashboard = DashboardClient::DASHBOARD_SERVER_PORT;  ///< Port of the dashboard server
+};
+
+/*!
+ * \brief In-process stand-in for a robot controller, e.g. for testing applications and measuring
+ * latencies without a robot or URSim.
+ *
+ * The FakeRobot serves the RTDE, primary, secondary and dashboard interfaces on the local machine,
+ * by default on the ports of a real robot. Once RTDE output streaming is started by a client, it sends data packages at
+ * a fixed frequency. Programs sent to the primary or secondary interface are "executed" by
+ * connecting back to the sockets opened with ``socket_open`` in the program, the same way the
+ * ``external_control.urscript`` does on a real robot. In non-headless mode, a program is requested
+ * from the ScriptSender once the program gets started through the dashboard server.
+ *
+ * Commands received through the reverse interface are applied to the fake joint state immediately,
+ * i.e. a servoj target is reached within one cycle and trajectory points are reached as soon as they
+ * are received. No dynamics, limits or safety functions are simulated.
+ *
+ * With the default ports, only one FakeRobot can exist on a machine at a time. To run several of
+ * them, e.g. in parallel tests, let the operating system choose the ports, see FakeRobotPorts, and
+ * pass the chosen ports to the clients.
+ */
+class FakeRobot
+{
+public:
+  /*!
+   * \brief A command received through the reverse interface
+   */
+  struct Command
+  {
+    comm::ControlMode control_mode;
+    vector6d_t values;
+    //! Read timeout for the next command as sent by the client, 0 means no timeout
+    std::chrono::milliseconds read_timeout;
+    //! Number of the last RTDE data package sent before this command was received
+    uint64_t cycle;
+    //! Time from sending the last RTDE data package until this command was received
+    std::chrono::nanoseconds round_trip_time;
+  };
+
+  FakeRobot() = delete;
+
+  /*!
+   * \brief Creates a FakeRobot and starts serving all interfaces.
+   *
+   * \param frequency Frequency in Hz at which RTDE data packages are sent, e.g. 125 for a CB3
+   * controller or 500 for an e-Series controller. The frequency requested by the RTDE client is
+   * ignored.
+   * \param version Software version reported by the controller
+   * \param script_sender_port Port of the ScriptSender a program is requested from when the
+   * program gets started using the dashboard server
+   * \param ports Ports to serve the interfaces on
+   */
+  explicit FakeRobot(const double frequency = 500.0,
+                     const VersionInformation& version = VersionInformation::fromString("5.9.4.1031232"),
+                     const uint32_t script_sender_port = 50002, const FakeRobotPorts& ports = FakeRobotPorts());
+  ~FakeRobot();
+
+  /*!
+   * \brief Getter for the port of the RTDE interface.
+   *
+   * \returns The port given on construction or the one chosen by the operating system
+   */
+  int getRTDEPort() const
+  {
+    return rtde_server_.getPort();
+  }
+
+  /*!
+   * \brief Getter for the port of the primary interface.
+   *
+   * \returns The port given on construction or the one chosen by the operating system
+   */
+  int getPrimaryPort() const
+  {
+    return primary_server_.getPort();
+  }
+
+  /*!
+   * \brief Getter for the port of the secondary interface.
+   *
+   * \returns The port given on construction or the one chosen by the operating system
+   */
+  int getSecondaryPort() const
+  {
+    return secondary_server_.getPort();
+  }
+
+  /*!
+   * \brief Getter for the port of the dashboard server.
+   *
+   * \returns The port given on construction or the one chosen by the operating system
+   */
+  int getDashboardPort() const
+  {
+    return dashboard_server_.getPort();
+  }
+
+  /*!
+   * \brief Sets the port of the ScriptSender a program is requested from when the program gets
+   * started using the dashboard server, e.g. if the driver's port is chosen by the operating system.
+   *
+   * \param port Port of the ScriptSender
+   */
+  void setScriptSenderPort(const uint32_t port)
+  {
+    script_sender_port_ = port;
+  }
+
+  /*!
+   * \brief Stops the currently running program, as if it was stopped on the teach pendant. All
+   * sockets opened by the program are closed.
+   */
+  void stopProgram();
+
+  /*!
+   * \brief Checks whether a program is currently running.
+   *
+   * \returns True, if a program is running, false otherwise
+   */
+  bool isProgramRunning() const
+  {
+    return program_running_;
+  }
+
+  /*!
+   * \brief Getter for the program that was started last.
+   *
+   * \returns The program's source code
+   */
+  std::string getProgram() const;
+
+  /*!
+   * \brief Getter for the current joint positions of the fake robot.
+   *
+   * \returns The joint positions
+   */
+  vector6d_t getJointPositions() const;
+
+  /*!
+   * \brief Sets the joint positions of the fake robot, e.g. to define a start configuration.
+   *
+   * \param positions New joint positions
+   */
+  void setJointPositions(const vector6d_t& positions);
+
+  /*!
+   * \brief Getter for the control mode that was requested last through the reverse interface.
+   *
+   * \returns The current control mode
+   */
+  comm::ControlMode getControlMode() const
+  {
+    return control_mode_;
+  }
+
+  /*!
+   * \brief Getter for the number of RTDE data packages sent to clients since streaming was started.
+   *
+   * \returns The number of sent data packages
+   */
+  uint64_t getNumCycles() const
+  {
+    return cycle_;
+  }
+
+  /*!
+   * \brief Reads a field of the last data package received on the RTDE input interface.
+   *
+   * \param name Name of the input field
+   * \param val Target variable. Make sure, it's the correct type.
+   *
+   * \returns True, if the field was received and could be read, false otherwise
+   */
+  template <typename T>
+  bool getInputData(const std::string& name, T& val)
+  {
+    std::lock_guard<std::mutex> lk(rtde_mutex_);
+    if (input_package_ == nullptr)
+    {
+      return false;
+    }
+    return input_package_->getData(name, val);
+  }
+
+  /*!
+   * \brief Registers a callback that is called for every command received through the reverse
+   * interface. The callback is executed on the thread running the program, so it should return
+   * quickly.
+   *
+   * \param callback Function handling the command
+   */
+  void setCommandCallback(std::function<void(const Command&)> callback);
+
+  /*!
+   * \brief Registers a callback that is called before each RTDE data package is sent. It can be
+   * used to fill in additional output fields. The callback is executed on the RTDE thread, so it
+   * should return quickly.
+   *
+   * \param callback Function modifying the package before it is sent
+   */
+  void setOutputCallback(std::function<void(rtde_interface::DataPackage&)> callback);
+
+  /*!
+   * \brief Sends a text message to all clients connected to the RTDE interface, as the controller
+   * does e.g. for warnings about the client's requests.
+   *
+   * \param message The message's text, at most 255 characters
+   * \param source Name of the message's source, at most 255 characters
+   */
+  void sendTextMessage(const std::string& message, const std::string& source = "FakeRobot");
+
+private:
+  // Socket opened by a program, connecting back to the machine running the driver
+  class ProgramSocket : public comm::TCPSocket
+  {
+  public:
+    bool connect(const std::string& host, const int port);
+
+    bool readAll(uint8_t* buf, const size_t buf_len);
+  };
+
+  // State of a connection to the RTDE interface
+  struct RTDESession
+  {
+    std::vector<uint8_t> buffer;
+    uint16_t protocol_version = 1;
+    std::shared_ptr<const rtde_interface::DataPackage::RecipeLayout> output_layout;
+    std::unique_ptr<rtde_interface::DataPackage> output_package;
+    std::shared_ptr<rtde_interface::DataPackage> input_package;
+    bool streaming = false;
+  };
+
+  // State of a connection to the primary or secondary interface
+  struct ScriptConnection
+  {
+    // Received text that doesn't form a complete line, yet
+    std::string pending;
+    // Lines of a program definition that hasn't been finished, yet
+    std::string program;
+  };
+
+  void rtdeMessageCallback(const int fd, char* buffer, int nbytesrecv);
+  void handleRTDEPackage(const int fd, RTDESession& session, uint8_t* package, size_t size);
+  void writeRTDE(const int fd, const uint8_t* buffer, size_t size);
+  void rtdeLoop();
+  void updateJointState(const double dt);
+  void fillOutputPackage(RTDESession& session, const double timestamp);
+
+  void primaryConnectCallback(comm::TCPServer& server, const int fd);
+  void primaryMessageCallback(const int fd, char* buffer, int nbytesrecv);
+  void handleScriptLine(ScriptConnection& connection, const std::string& line);
+
+  void dashboardConnectCallback(const int fd);
+  void dashboardMessageCallback(const int fd, char* buffer, int nbytesrecv);
+  std::string handleDashboardCommand(const int fd, const std::string& command);
+
+  // Starts the given program. If the program is empty, it is requested from the ScriptSender on the
+  // given host, first.
+  void startProgram(const std::string& program, const std::string& script_sender_host = "");
+  std::string requestProgram(const std::string& host);
+  void runProgram(std::string program, const std::string& script_sender_host);
+  void handleReverseCommand(const int32_t* message, const std::chrono::steady_clock::time_point received,
+                            ProgramSocket* trajectory_socket, int32_t& points_left);
+  void sendTrajectoryResult(ProgramSocket* trajectory_socket, const int32_t result);
+
+  double frequency_;
+  VersionInformation version_;
+  std::atomic<uint32_t> script_sender_port_;
+
+  comm::TCPServer rtde_server_;
+  comm::TCPServer primary_server_;
+  comm::TCPServer secondary_server_;
+  comm::TCPServer dashboard_server_;
+
+  std::mutex rtde_mutex_;
+  std::map<int, RTDESession> rtde_sessions_;
+  std::shared_ptr<rtde_interface::DataPackage> input_package_;
+  std::function<void(rtde_interface::DataPackage&)> output_callback_;
+  std::thread rtde_thread_;
+  std::atomic<bool> running_;
+  std::atomic<uint64_t> cycle_;
+  std::atomic<int64_t> last_sent_ns_;
+
+  mutable std::mutex state_mutex_;
+  std::string program_;
+  vector6d_t q_;
+  vector6d_t qd_;
+  vector6d_t target_q_;
+  std::atomic<comm::ControlMode> control_mode_;
+
+  std::mutex script_mutex_;
+  std::map<int, ScriptConnection> script_connections_;
+  std::map<int, std::string> dashboard_buffers_;
+  std::string loaded_program_;
+  std::atomic<int32_t> robot_mode_;
+
+  std::mutex program_mutex_;
+  std::thread program_thread_;
+  std::atomic<bool> program_running_;
+  std::atomic<bool> stop_program_;
+
+  std::mutex callback_mutex_;
+  std::function<void(const Command&)> command_callback_;
+};
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_FAKE_ROBOT_H_INCLUDED
@@ -0,0 +1,140 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_LATENCY_STATISTICS_H_INCLUDED
+#define UR_CLIENT_LIBRARY_LATENCY_STATISTICS_H_INCLUDED
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "ur_client_library/comm/latency_histogram.h"
+#include "ur_client_library/comm/package.h"
+
+namespace urcl
+{
+/*!
+ * \brief Snapshot of the latencies measured between receiving an RTDE package and answering it
+ * with a command.
+ */
+struct LatencyStatistics
+{
+  comm::LatencySummary receive_to_parse;    ///< Socket read until the package was parsed
+  comm::LatencySummary parse_to_enqueue;    ///< Parsing until the package was handed to the pipeline
+  comm::LatencySummary enqueue_to_dequeue;  ///< Pipeline transport until the application fetched the package
+  comm::LatencySummary dequeue_to_write;    ///< Fetching the package until the command was written
+  comm::LatencySummary round_trip;          ///< Socket read until the command was written
+  comm::LatencySummary cycle_jitter;        ///< Deviation of the time between fetched packages from the step time
+
+  uint64_t num_cycles = 0;     ///< Number of packages fetched by the application
+  uint64_t missed_cycles = 0;  ///< Number of robot cycles whose package was never fetched
+  uint64_t late_commands = 0;  ///< Number of commands written more than one step time after their package was read
+};
+
+/*!
+ * \brief Collects the latencies of the control loop, i.e. from reading an RTDE package from the
+ * socket until the command answering it is written to the reverse interface.
+ *
+ * The stages of the receive path are taken from the timestamps the pipeline attaches to each
+ * package. The monitor has to be notified whenever the application fetches a package and whenever
+ * it writes a command. Only the first command written after fetching a package is considered an
+ * answer to it.
+ */
+class LatencyMonitor
+{
+public:
+  /*!
+   * \brief Creates a new LatencyMonitor object.
+   *
+   * \param step_time The robot's control cycle time
+   */
+  explicit LatencyMonitor(const std::chrono::nanoseconds step_time = std::chrono::milliseconds(8));
+
+  /*!
+   * \brief Sets the robot's control cycle time used to detect missed cycles and late commands.
+   *
+   * \param step_time The robot's control cycle time
+   */
+  void setStepTime(const std::chrono::nanoseconds step_time);
+
+  /*!
+   * \brief Records the receive path stages of a package that was fetched by the application.
+   *
+   * \param timestamps The timestamps of the fetched package
+   */
+  void packageFetched(const comm::PackageTimestamps& timestamps);
+
+  /*!
+   * \brief Records that a command was written. If it is the first command after fetching a
+   * package, its latency with respect to that package is recorded.
+   *
+   * \param written Point in time at which the command was written
+   */
+  void commandWritten(const std::chrono::steady_clock::time_point written = std::chrono::steady_clock::now());
+
+  /*!
+   * \brief Creates a snapshot of all statistics.
+   *
+   * \returns The current statistics
+   */
+  LatencyStatistics getStatistics() const;
+
+  /*!
+   * \brief Discards all recorded statistics.
+   */
+  void reset();
+
+private:
+  static int64_t toNs(const std::chrono::steady_clock::time_point time)
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+  }
+
+  std::atomic<int64_t> step_time_ns_;
+
+  comm::LatencyHistogram receive_to_parse_;
+  comm::LatencyHistogram parse_to_enqueue_;
+  comm::LatencyHistogram enqueue_to_dequeue_;
+  comm::LatencyHistogram dequeue_to_write_;
+  comm::LatencyHistogram round_trip_;
+  comm::LatencyHistogram cycle_jitter_;
+
+  std::atomic<uint64_t> num_cycles_;
+  std::atomic<uint64_t> missed_cycles_;
+  std::atomic<uint64_t> late_commands_;
+
+  // Receive path of the package fetched last, an answer to it is pending while the flag is set
+  std::atomic<int64_t> last_received_ns_;
+  std::atomic<int64_t> last_dequeued_ns_;
+  std::atomic<bool> answer_pending_;
+};
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_LATENCY_STATISTICS_H_INCLUDED
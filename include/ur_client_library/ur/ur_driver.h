@@ -38,11 +38,89 @@
 #include "ur_client_library/ur/tool_communication.h"
 #include "ur_client_library/ur/version_information.h"
 #include "ur_client_library/ur/robot_receive_timeout.h"
+#include "ur_client_library/ur/latency_statistics.h"
+#include "ur_client_library/primary/package_header.h"
 #include "ur_client_library/primary/robot_message/version_message.h"
 #include "ur_client_library/rtde/rtde_writer.h"
 
 namespace urcl
 {
+/*!
+ * \brief Configuration of a UrDriver. Apart from the event loop settings and the robot's ports, the
+ * members correspond to the parameters of the UrDriver's constructors, see there for details.
+ *
+ * The ports of the driver's servers can be set to 0 to let the operating system choose free ports.
+ * The chosen ports can be queried from the driver, e.g. with UrDriver::getScriptSenderPort().
+ */
+struct UrDriverConfiguration
+{
+  std::string robot_ip;            ///< IP-address under which the robot is reachable
+  std::string script_file;         ///< URScript file that should be sent to the robot
+  std::string output_recipe_file;  ///< Filename where the output recipe is stored in
+  std::string input_recipe_file;   ///< Filename where the input recipe is stored in
+  std::function<void(bool)> handle_program_state = [](bool) {};  ///< Callback on program state changes
+  bool headless_mode = false;                                      ///< Send the program through the primary interface
+  std::unique_ptr<ToolCommSetup> tool_comm_setup;  ///< Configuration for using the tool communication, if any
+  uint32_t reverse_port = 50001;                   ///< Port of the reverse interface
+  uint32_t script_sender_port = 50002;             ///< Port the program can be requested on
+  int servoj_gain = 2000;                          ///< Gain for servoj commands, range [100,2000]
+  double servoj_lookahead_time = 0.03;             ///< Lookahead time for servoj commands, range [0.03,0.2]
+  bool non_blocking_read = false;                  ///< Don't wait for new data packages
+  std::string reverse_ip;                          ///< IP the robot connects back to, determined if empty
+  uint32_t trajectory_port = 50003;                ///< Port used for trajectory forwarding
+  uint32_t script_command_port = 50004;            ///< Port used for forwarding script commands
+  double force_mode_damping = 0.025;               ///< Damping in force mode, range [0,1]
+  double force_mode_gain_scaling = 0.5;            ///< Gain scaling in force mode, range [0,2] (only e-series)
+
+  /*!
+   * \brief Serve the sockets of the reverse interface, trajectory interface, script command
+   * interface and script sender from a single thread instead of one thread each.
+   */
+  bool shared_event_loop = false;
+
+  /*!
+   * \brief CPU core the shared event loop's thread gets pinned to. A negative value doesn't pin the
+   * thread. Only used together with shared_event_loop.
+   */
+  int event_loop_cpu = -1;
+
+  /*!
+   * \brief Already running event loop to serve the sockets from, e.g. to share one thread between
+   * multiple drivers. If set, shared_event_loop and event_loop_cpu are ignored.
+   */
+  std::shared_ptr<comm::EventLoop> event_loop;
+
+  /*!
+   * \brief Request receive timestamps from the kernel for RTDE data packages. They can be found in
+   * the package's timestamps, see comm::PackageTimestamps::kernel_received.
+   */
+  bool rtde_receive_timestamping = false;
+
+  /*!
+   * \brief Sleep until shortly before the next data package is expected in getDataPackage()
+   * instead of waiting to be woken up when it arrives, see
+   * rtde_interface::RTDEClient::waitForDataPackage(). Not used together with non_blocking_read.
+   */
+  bool predictive_read = false;
+
+  /*!
+   * \brief Time span in seconds of RTDE data packages kept in a history that can be queried by the
+   * robot's timestamp, see getRTDEStateHistory(). The history is disabled if this is 0.
+   */
+  double rtde_state_history_duration = 0.0;
+
+  /*!
+   * \brief How received RTDE data packages are passed to getDataPackage(). With
+   * comm::PipelineTransport::LATEST_VALUE only the newest data package is kept, see
+   * rtde_interface::RTDEClient.
+   */
+  comm::PipelineTransport rtde_transport = comm::PipelineTransport::QUEUE;
+
+  int rtde_port = UR_RTDE_PORT;                               ///< Port of the robot's RTDE interface
+  int primary_port = primary_interface::UR_PRIMARY_PORT;      ///< Port of the robot's primary interface
+  int secondary_port = primary_interface::UR_SECONDARY_PORT;  ///< Port of the robot's secondary interface
+};
+
 /*!
  * \brief This is the main class for interfacing the driver.
  *
@@ -103,6 +181,14 @@ public:
            const uint32_t script_command_port = 50004, double force_mode_damping = 0.025,
            double force_mode_gain_scaling = 0.5);
 
+  /*!
+   * \brief Constructs a new UrDriver object from a configuration. See the constructor above for
+   * details about the setup.
+   *
+   * \param config Configuration of the driver
+   */
+  explicit UrDriver(const UrDriverConfiguration& config);
+
   /*!
    * \brief Constructs a new UrDriver object.
    * \param robot_ip IP-address under which the robot is reachable.
@@ -193,6 +279,53 @@ public:
    */
   std::unique_ptr<rtde_interface::DataPackage> getDataPackage();
 
+  /*!
+   * \brief Access function to receive the latest data package sent from the robot through RTDE
+   * interface. The package previously held by \p data_package is reused, so that no memory is
+   * allocated in steady state, see rtde_interface::RTDEClient::getDataPackage().
+   *
+   * \param data_package Unique ptr to be set to the latest data package
+   *
+   * \returns True on success, false if no package can be found inside a preconfigured time window.
+   */
+  bool getDataPackage(std::unique_ptr<rtde_interface::DataPackage>& data_package);
+
+  /*!
+   * \brief Access function to receive the latest data package sent from the robot through RTDE
+   * interface, waiting at most for the given time instead of the preconfigured one.
+   *
+   * \param data_package Unique ptr to be set to the latest data package
+   * \param timeout Time to wait if no new data package is available
+   *
+   * \returns True on success, false if no package arrived before the timeout.
+   */
+  bool getDataPackage(std::unique_ptr<rtde_interface::DataPackage>& data_package,
+                      const std::chrono::milliseconds timeout);
+
+  /*!
+   * \brief Returns the latencies measured in the control loop.
+   *
+   * Every package fetched with getDataPackage() carries the points in time at which it was read
+   * from the socket, parsed, handed to the pipeline and fetched. The first call to
+   * writeJointCommand() after fetching a package is considered the answer to that package and
+   * completes its round trip. Packages the application didn't fetch are counted as missed cycles,
+   * answers written more than one control cycle after their package was read as late commands.
+   *
+   * \returns A snapshot of the latency statistics since startup or the last reset
+   */
+  LatencyStatistics getLatencyStatistics() const
+  {
+    return latency_monitor_.getStatistics();
+  }
+
+  /*!
+   * \brief Discards the latency statistics collected so far.
+   */
+  void resetLatencyStatistics()
+  {
+    latency_monitor_.reset();
+  }
+
   uint32_t getControlFrequency() const
   {
     return rtde_frequency_;
@@ -409,6 +542,38 @@ public:
    */
   bool checkCalibration(const std::string& checksum);
 
+  /*!
+   * \brief Getter for the port of the reverse interface. If it was configured as 0, this is the port
+   * chosen by the operating system.
+   *
+   * \returns The port the robot program connects to for receiving control commands
+   */
+  int getReversePort() const;
+
+  /*!
+   * \brief Getter for the port the program can be requested on. If it was configured as 0, this is
+   * the port chosen by the operating system.
+   *
+   * \returns The script sender's port or 0 in headless mode, where no script sender is created
+   */
+  int getScriptSenderPort() const;
+
+  /*!
+   * \brief Getter for the port used for trajectory forwarding. If it was configured as 0, this is
+   * the port chosen by the operating system.
+   *
+   * \returns The port of the trajectory interface
+   */
+  int getTrajectoryPort() const;
+
+  /*!
+   * \brief Getter for the port used for forwarding script commands. If it was configured as 0, this
+   * is the port chosen by the operating system.
+   *
+   * \returns The port of the script command interface
+   */
+  int getScriptCommandPort() const;
+
   /*!
    * \brief Getter for the RTDE writer used to write to the robot's RTDE interface.
    *
@@ -451,6 +616,74 @@ public:
    */
   std::vector<std::string> getRTDEOutputRecipe();
 
+  /*!
+   * \brief Creates a handle for direct access to a field of the RTDE output recipe, see
+   * rtde_interface::RTDEClient::getFieldHandle().
+   *
+   * \param name The string identifier for the data field as used in the documentation.
+   *
+   * \returns A handle to the requested field
+   */
+  template <typename T>
+  rtde_interface::FieldHandle<T> getRTDEFieldHandle(const std::string& name) const
+  {
+    return rtde_client_->getFieldHandle<T>(name);
+  }
+
+  /*!
+   * \brief Getter for the estimator relating the robot's clock to the host's monotonic clock, see
+   * rtde_interface::RTDEClient::getClockOffsetEstimator().
+   *
+   * \returns The clock offset estimator of the RTDE client
+   */
+  const comm::ClockOffsetEstimator& getClockOffsetEstimator() const
+  {
+    return rtde_client_->getClockOffsetEstimator();
+  }
+
+  /*!
+   * \brief Getter for the scheduler predicting when the next RTDE data package arrives, see
+   * rtde_interface::RTDEClient::getWakeUpScheduler().
+   *
+   * \returns The wake-up scheduler of the RTDE client
+   */
+  const comm::WakeUpScheduler& getWakeUpScheduler() const
+  {
+    return rtde_client_->getWakeUpScheduler();
+  }
+
+  /*!
+   * \brief Getter for the history of received RTDE data packages, see
+   * UrDriverConfiguration::rtde_state_history_duration.
+   *
+   * \returns The state history of the RTDE client, nullptr if it is not enabled
+   */
+  std::shared_ptr<const rtde_interface::StateHistory> getRTDEStateHistory() const
+  {
+    return rtde_client_->getStateHistory();
+  }
+
+  /*!
+   * \brief Starts recording all received RTDE data packages into a file, see
+   * rtde_interface::RTDEClient::startRecording().
+   *
+   * \param filename Path of the recording file
+   *
+   * \returns True, if the recording was started, false if the file could not be created
+   */
+  bool startRTDERecording(const std::string& filename)
+  {
+    return rtde_client_->startRecording(filename);
+  }
+
+  /*!
+   * \brief Stops a running recording of RTDE data packages.
+   */
+  void stopRTDERecording()
+  {
+    rtde_client_->stopRecording();
+  }
+
   /*!
    * \brief Set the Keepalive count. This will set the number of allowed timeout reads on the robot.
    *
@@ -460,6 +693,18 @@ public:
                "commands.")]] void
   setKeepaliveCount(const uint32_t count);
 
+  /*!
+   * \brief Enables busy polling (SO_BUSY_POLL) on the reverse interface socket. It takes effect
+   * when the robot connects to the reverse interface the next time, e.g. when the program is
+   * restarted.
+   *
+   * \param busy_poll_time Time to busy poll when reading, 0 disables busy polling
+   */
+  void setReverseInterfaceBusyPollTime(const std::chrono::microseconds busy_poll_time)
+  {
+    reverse_interface_->setBusyPollTime(busy_poll_time);
+  }
+
   /*!
    * \brief Register a callback for the robot-based trajectory execution completion.
    *
@@ -488,6 +733,8 @@ public:
   }
 
 private:
+  void init(const UrDriverConfiguration& config);
+
   static std::string readScriptFile(const std::string& filename);
   /*!
    * \brief Reconnects the secondary stream used to send program to the robot.
@@ -500,6 +747,7 @@ private:
 
   int rtde_frequency_;
   comm::INotifier notifier_;
+  std::shared_ptr<comm::EventLoop> event_loop_;
   std::unique_ptr<rtde_interface::RTDEClient> rtde_client_;
   std::unique_ptr<control::ReverseInterface> reverse_interface_;
   std::unique_ptr<control::TrajectoryPointInterface> trajectory_interface_;
@@ -511,6 +759,7 @@ private:
   uint32_t servoj_gain_;
   double servoj_lookahead_time_;
   std::chrono::milliseconds step_time_;
+  LatencyMonitor latency_monitor_;
 
   std::function<void(bool)> handle_program_state_;
 
@@ -520,6 +769,7 @@ private:
 
   int get_packet_timeout_;
   bool non_blocking_read_;
+  bool predictive_read_;
 
   VersionInformation robot_version_;
 };
@@ -0,0 +1,158 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#ifndef UR_CLIENT_LIBRARY_UR_DRIVER_GROUP_H_INCLUDED
+#define UR_CLIENT_LIBRARY_UR_DRIVER_GROUP_H_INCLUDED
+
+#include <chrono>
+#include <memory>
+#include <vector>
+
+#include "ur_client_library/comm/event_loop.h"
+#include "ur_client_library/ur/ur_driver.h"
+
+namespace urcl
+{
+/*!
+ * \brief Manages the UrDriver instances of multiple robots, e.g. of a multi-arm cell.
+ *
+ * The sockets of the reverse interface, trajectory interface, script command interface and script
+ * sender of all robots are served by a fixed pool of EventLoop threads instead of one thread per
+ * server. Robots are assigned to the pool's threads in turn. Each robot keeps its own RTDE
+ * threads, so that receiving data of one robot isn't delayed by another one.
+ *
+ * Ports are assigned automatically: The robot with index i uses the PORTS_PER_ROBOT consecutive
+ * ports starting at first_port + i * PORTS_PER_ROBOT for its reverse interface, script sender,
+ * trajectory interface and script command interface, in this order. When using the External
+ * Control URCap, the script sender port has to be configured accordingly on each robot. If
+ * first_port is 0, all ports are chosen by the operating system instead, see
+ * UrDriver::getScriptSenderPort().
+ */
+class UrDriverGroup
+{
+public:
+  //! Number of ports used by each robot
+  static constexpr uint32_t PORTS_PER_ROBOT = 4;
+
+  UrDriverGroup() = delete;
+
+  /*!
+   * \brief Creates a new UrDriverGroup and starts its event loop threads.
+   *
+   * \param num_io_threads Number of event loop threads serving the sockets of all robots
+   * \param first_port First port of the range assigned to the robots, 0 for ports chosen by the
+   * operating system
+   * \param io_thread_cpus CPU cores to pin the event loop threads to, one per thread. If empty, the
+   * threads aren't pinned.
+   *
+   * \throws UrException if no thread is requested or the number of CPU cores doesn't match.
+   */
+  explicit UrDriverGroup(const size_t num_io_threads = 1, const uint32_t first_port = 50001,
+                         const std::vector<int>& io_thread_cpus = {});
+  ~UrDriverGroup();
+
+  UrDriverGroup(const UrDriverGroup&) = delete;
+  UrDriverGroup& operator=(const UrDriverGroup&) = delete;
+
+  /*!
+   * \brief Creates the driver for another robot. The ports and event loop given in \p config are
+   * replaced by the ones assigned by the group.
+   *
+   * \param config Configuration of the robot's driver
+   *
+   * \returns The created driver
+   */
+  UrDriver& addRobot(UrDriverConfiguration config);
+
+  /*!
+   * \brief Getter for the number of robots in the group.
+   *
+   * \returns The number of robots
+   */
+  size_t size() const
+  {
+    return drivers_.size();
+  }
+
+  /*!
+   * \brief Getter for the driver of a robot.
+   *
+   * \param index Index of the robot in the order the robots were added
+   *
+   * \throws std::out_of_range if there is no robot with the given index.
+   *
+   * \returns The robot's driver
+   */
+  UrDriver& getDriver(const size_t index)
+  {
+    return *drivers_.at(index);
+  }
+
+  /*!
+   * \brief Starts the RTDE communication of all robots, see UrDriver::startRTDECommunication().
+   */
+  void startRTDECommunication();
+
+  /*!
+   * \brief Waits until every robot has sent a new data package and returns the latest package of
+   * each robot.
+   *
+   * Packages of robots that answered early are replaced by newer ones before returning, so the
+   * snapshot holds the packages that were the latest ones at the same point in time. If a robot's
+   * package still lags behind the newest one by more than one and a half control cycles, e.g. as
+   * its RTDE thread got delayed, newer packages of that robot are waited for. The send times of the
+   * packages are compared on the host's clock using each robot's
+   * rtde_interface::RTDEClient::getClockOffsetEstimator(). As with UrDriver::getDataPackage(), the
+   * packages passed in are reused, so that no memory is allocated in steady state.
+   *
+   * \param packages Latest package of every robot, in the order the robots were added. Resized to
+   * the number of robots.
+   * \param timeout Maximum time to wait for all robots
+   *
+   * \returns True, if every robot sent a new package and the packages were aligned before the
+   * timeout, false otherwise. In the latter case, robots that did send a package have their entry
+   * updated.
+   */
+  bool waitForAll(std::vector<std::unique_ptr<rtde_interface::DataPackage>>& packages,
+                  const std::chrono::milliseconds timeout);
+
+private:
+  // Estimated point in time at which the robot with the given index sent the package
+  std::chrono::steady_clock::time_point getSendTime(const size_t index,
+                                                    const rtde_interface::DataPackage& package) const;
+
+  std::vector<std::shared_ptr<comm::EventLoop>> event_loops_;
+  std::vector<std::unique_ptr<UrDriver>> drivers_;
+  std::vector<rtde_interface::FieldHandle<double>> timestamp_handles_;
+  uint32_t first_port_;
+};
+}  // namespace urcl
+
+#endif  // UR_CLIENT_LIBRARY_UR_DRIVER_GROUP_H_INCLUDED
@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+
+# Copyright 2024 Universal Robots A/S
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are met:
+#
+#    * Redistributions of source code must retain the above copyright
+#      notice, this list of conditions and the following disclaimer.
+#
+#    * Redistributions in binary form must reproduce the above copyright
+#      notice, this list of conditions and the following disclaimer in the
+#      documentation and/or other materials provided with the distribution.
+#
+#    * Neither the name of the {copyright_holder} nor the names of its
+#      contributors may be used to endorse or promote products derived from
+#      this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+# AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+# IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+# ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+# LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+# CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+# SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+# INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+# CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+# ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+# POSSIBILITY OF SUCH DAMAGE.
+
+"""Compares the JSON output of urcl_benchmarks against a baseline.
+
+Fails if a benchmark exceeds the control cycle budget, got slower than the baseline by more than
+the threshold or allocates more often than in the baseline. Without a baseline, only the budget is
+checked.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+NANOSECONDS = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+
+
+def load(filename):
+    """Returns the time in ns and allocations per iteration of each benchmark in the file.
+
+    If the benchmarks were repeated, the median of the repetitions is used.
+    """
+    with open(filename) as f:
+        benchmarks = json.load(f)["benchmarks"]
+    has_medians = any(b.get("aggregate_name") == "median" for b in benchmarks)
+
+    results = {}
+    for b in benchmarks:
+        if has_medians:
+            if b.get("aggregate_name") != "median":
+                continue
+            name = b["run_name"]
+        elif b.get("run_type", "iteration") == "iteration":
+            name = b["name"]
+        else:
+            continue
+        results[name] = (b["real_time"] * NANOSECONDS[b.get("time_unit", "ns")], b.get("allocs/op"))
+    return results
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__)
+    parser.add_argument("current", help="benchmark results to check")
+    parser.add_argument("--baseline", help="benchmark results to compare against, ignored if missing")
+    parser.add_argument("--threshold", type=float, default=0.25,
+                        help="allowed relative slowdown compared to the baseline (default: %(default)s)")
+    parser.add_argument("--budget-ms", type=float, default=2.0,
+                        help="maximum time of a single iteration in ms (default: %(default)s)")
+    args = parser.parse_args()
+
+    current = load(args.current)
+    baseline = load(args.baseline) if args.baseline and os.path.exists(args.baseline) else {}
+    if not baseline:
+        print("No baseline found, only checking the budget of {} ms".format(args.budget_ms))
+
+    failures = []
+    print("{:<50} {:>14} {:>14} {:>8}".format("Benchmark", "Baseline [ns]", "Current [ns]", "Change"))
+    for name, (time, allocs) in sorted(current.items()):
+        if time > args.budget_ms * 1e6:
+            failures.append("{} takes {:.0f} ns, exceeding the budget of {} ms".format(name, time, args.budget_ms))
+
+        if name not in baseline:
+            print("{:<50} {:>14} {:>14.1f} {:>8}".format(name, "-", time, "new"))
+            continue
+        base_time, base_allocs = baseline[name]
+        change = time / base_time - 1.0
+        print("{:<50} {:>14.1f} {:>14.1f} {:>+7.1f}%".format(name, base_time, time, change * 100))
+        if change > args.threshold:
+            failures.append("{} got {:.1f}% slower".format(name, change * 100))
+        # The counter includes the benchmark framework's allocations spread over all iterations
+        if allocs is not None and base_allocs is not None and round(allocs) > round(base_allocs):
+            failures.append("{} allocates {:.0f} instead of {:.0f} times per iteration".format(
+                name, allocs, base_allocs))
+
+    for failure in failures:
+        print("FAILED: " + failure)
+    return 1 if failures else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,187 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include "ur_client_library/comm/byte_swap.h"
+
+#include <endian.h>
+#include <cstring>
+
+#if defined(__x86_64__) && defined(__GNUC__) && __BYTE_ORDER == __LITTLE_ENDIAN
+#  define URCL_BYTE_SWAP_X86
+#  include <immintrin.h>
+#endif
+
+namespace urcl
+{
+namespace comm
+{
+namespace
+{
+using SwapFunction = void (*)(const uint8_t* src, uint8_t* dst, size_t count);
+
+struct SwapKernel
+{
+  const char* name;
+  SwapFunction swap_64;
+  SwapFunction swap_32;
+};
+
+inline void swapBytes64Scalar(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint64_t val;
+    std::memcpy(&val, src + i * sizeof(val), sizeof(val));
+    val = be64toh(val);
+    std::memcpy(dst + i * sizeof(val), &val, sizeof(val));
+  }
+}
+
+inline void swapBytes32Scalar(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    uint32_t val;
+    std::memcpy(&val, src + i * sizeof(val), sizeof(val));
+    val = be32toh(val);
+    std::memcpy(dst + i * sizeof(val), &val, sizeof(val));
+  }
+}
+
+#ifdef URCL_BYTE_SWAP_X86
+// Shuffle masks reversing the bytes of each 64 bit respectively 32 bit value inside a 16 byte lane
+#  define URCL_SWAP_64_MASK 7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8
+#  define URCL_SWAP_32_MASK 3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12
+
+// Reverses the bytes of each value inside every 16 byte block according to the given shuffle mask.
+// Returns the number of converted bytes, remaining bytes that don't fill a whole block are left
+// untouched.
+__attribute__((target("ssse3"))) inline size_t swapBlocksSsse3(const uint8_t* src, uint8_t* dst, size_t num_bytes,
+                                                              const __m128i mask)
+{
+  size_t i = 0;
+  for (; i + 16 <= num_bytes; i += 16)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(block, mask));
+  }
+  return i;
+}
+
+// Same as swapBlocksSsse3 using 32 byte blocks. A remaining 16 byte block is converted as well.
+// Everything is done inside the AVX2 code, as switching to legacy SSE code afterwards would be
+// expensive on some CPUs.
+__attribute__((target("avx2"))) inline size_t swapBlocksAvx2(const uint8_t* src, uint8_t* dst, size_t num_bytes,
+                                                            const __m256i mask)
+{
+  size_t i = 0;
+  for (; i + 32 <= num_bytes; i += 32)
+  {
+    __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_shuffle_epi8(block, mask));
+  }
+  if (i + 16 <= num_bytes)
+  {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), _mm_shuffle_epi8(block, _mm256_castsi256_si128(mask)));
+    i += 16;
+  }
+  return i;
+}
+
+__attribute__((target("ssse3"))) void swapBytes64Ssse3(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  const size_t done = swapBlocksSsse3(src, dst, count * 8, _mm_setr_epi8(URCL_SWAP_64_MASK));
+  swapBytes64Scalar(src + done, dst + done, count - done / 8);
+}
+
+__attribute__((target("ssse3"))) void swapBytes32Ssse3(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  const size_t done = swapBlocksSsse3(src, dst, count * 4, _mm_setr_epi8(URCL_SWAP_32_MASK));
+  swapBytes32Scalar(src + done, dst + done, count - done / 4);
+}
+
+__attribute__((target("avx2"))) void swapBytes64Avx2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  // Shuffles operate on each 16 byte lane separately, so both lanes use the same pattern.
+  const size_t done =
+      swapBlocksAvx2(src, dst, count * 8, _mm256_setr_epi8(URCL_SWAP_64_MASK, URCL_SWAP_64_MASK));
+  swapBytes64Scalar(src + done, dst + done, count - done / 8);
+}
+
+__attribute__((target("avx2"))) void swapBytes32Avx2(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  const size_t done =
+      swapBlocksAvx2(src, dst, count * 4, _mm256_setr_epi8(URCL_SWAP_32_MASK, URCL_SWAP_32_MASK));
+  swapBytes32Scalar(src + done, dst + done, count - done / 4);
+}
+#endif
+
+SwapKernel selectKernel()
+{
+#ifdef URCL_BYTE_SWAP_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return SwapKernel{ "avx2", &swapBytes64Avx2, &swapBytes32Avx2 };
+  }
+  if (__builtin_cpu_supports("ssse3"))
+  {
+    return SwapKernel{ "ssse3", &swapBytes64Ssse3, &swapBytes32Ssse3 };
+  }
+#endif
+  return SwapKernel{ "scalar", &swapBytes64Scalar, &swapBytes32Scalar };
+}
+
+const SwapKernel& getKernel()
+{
+  static const SwapKernel kernel = selectKernel();
+  return kernel;
+}
+}  // namespace
+
+void swapBytes64(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  getKernel().swap_64(src, dst, count);
+}
+
+void swapBytes32(const uint8_t* src, uint8_t* dst, size_t count)
+{
+  getKernel().swap_32(src, dst, count);
+}
+
+const char* getByteSwapKernel()
+{
+  return getKernel().name;
+}
+
+}  // namespace comm
+}  // namespace urcl
@@ -0,0 +1,243 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/clock_offset_estimator.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace urcl
+{
+namespace comm
+{
+namespace
+{
+double toSeconds(const std::chrono::steady_clock::time_point time_point)
+{
+  return std::chrono::duration<double>(time_point.time_since_epoch()).count();
+}
+
+std::chrono::steady_clock::time_point toTimePoint(const double seconds)
+{
+  return std::chrono::steady_clock::time_point(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(seconds)));
+}
+
+std::chrono::nanoseconds toNanoseconds(const double seconds)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds));
+}
+}  // namespace
+
+ClockOffsetEstimator::ClockOffsetEstimator(const size_t window_size)
+  : num_slots_(std::min(std::max<size_t>(window_size, 2), NUM_SEGMENTS))
+  , segment_size_((std::max<size_t>(window_size, 2) + num_slots_ - 1) / num_slots_)
+  , current_(0)
+  , num_segments_(0)
+{
+}
+
+void ClockOffsetEstimator::addSample(const double robot_time, const std::chrono::steady_clock::time_point host_time)
+{
+  const double difference = toSeconds(host_time) - robot_time;
+
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (num_segments_ > 0 && robot_time <= segments_[current_].latest_robot_time)
+  {
+    // The robot's clock has been reset, so previous samples don't relate to the new ones.
+    num_segments_ = 0;
+  }
+  if (num_segments_ == 0)
+  {
+    current_ = 0;
+    segments_[current_] = Segment();
+    num_segments_ = 1;
+  }
+  else if (segments_[current_].num_samples == segment_size_)
+  {
+    // Starting a new segment discards the oldest one once all slots are in use
+    current_ = (current_ + 1) % num_slots_;
+    segments_[current_] = Segment();
+    num_segments_ = std::min(num_segments_ + 1, num_slots_);
+  }
+
+  Segment& segment = segments_[current_];
+  segment.num_samples++;
+  if (segment.num_samples == 1 || difference < segment.min_difference)
+  {
+    segment.min_robot_time = robot_time;
+    segment.min_difference = difference;
+  }
+  segment.latest_robot_time = robot_time;
+
+  const double n = static_cast<double>(segment.num_samples);
+  const double delta_robot_time = robot_time - segment.mean_robot_time;
+  const double delta_difference = difference - segment.mean_difference;
+  segment.mean_robot_time += delta_robot_time / n;
+  segment.mean_difference += delta_difference / n;
+  segment.m2_robot_time += delta_robot_time * (robot_time - segment.mean_robot_time);
+  segment.m2_difference += delta_difference * (difference - segment.mean_difference);
+  segment.co_moment += delta_robot_time * (difference - segment.mean_difference);
+}
+
+void ClockOffsetEstimator::reset()
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  num_segments_ = 0;
+}
+
+ClockOffsetEstimate ClockOffsetEstimator::getEstimate() const
+{
+  double estimated_difference;
+  return calculateEstimate(estimated_difference);
+}
+
+std::chrono::steady_clock::time_point ClockOffsetEstimator::toHostTime(const double robot_time) const
+{
+  double estimated_difference;
+  const ClockOffsetEstimate estimate = calculateEstimate(estimated_difference);
+  if (estimate.num_samples < 2)
+  {
+    return std::chrono::steady_clock::time_point();
+  }
+  const double difference = estimated_difference + estimate.drift * (robot_time - estimate.robot_time);
+  return toTimePoint(robot_time + difference);
+}
+
+double ClockOffsetEstimator::toRobotTime(const std::chrono::steady_clock::time_point host_time) const
+{
+  double estimated_difference;
+  const ClockOffsetEstimate estimate = calculateEstimate(estimated_difference);
+  if (estimate.num_samples < 2)
+  {
+    return 0.0;
+  }
+  // Solves host_time = robot_time + difference + drift * (robot_time - estimate.robot_time) for
+  // robot_time. The host time is made relative to the estimate to keep the precision.
+  const double elapsed_host_time = toSeconds(host_time) - (estimate.robot_time + estimated_difference);
+  return estimate.robot_time + elapsed_host_time / (1.0 + estimate.drift);
+}
+
+ClockOffsetEstimate ClockOffsetEstimator::calculateEstimate(double& estimated_difference) const
+{
+  // The segments are copied, so the receiving thread adding samples is only blocked for the copy.
+  std::array<Segment, NUM_SEGMENTS> segments;
+  size_t num_segments;
+  size_t first;
+  {
+    std::lock_guard<std::mutex> lk(mutex_);
+    num_segments = num_segments_;
+    first = (current_ + num_slots_ + 1 - num_segments_) % num_slots_;
+    for (size_t i = 0; i < num_segments; ++i)
+    {
+      segments[i] = segments_[(first + i) % num_slots_];
+    }
+  }
+
+  ClockOffsetEstimate estimate;
+  estimated_difference = 0.0;
+  size_t num_samples = 0;
+  for (size_t i = 0; i < num_segments; ++i)
+  {
+    num_samples += segments[i].num_samples;
+  }
+  estimate.num_samples = num_samples;
+  if (num_samples < 2)
+  {
+    return estimate;
+  }
+
+  // Line fit over the sample with the smallest delay of each segment. Values are taken relative to
+  // the oldest segment, so the sums don't lose precision.
+  const Segment& reference = segments[0];
+  double mean_x = 0.0;
+  double mean_y = 0.0;
+  for (size_t i = 0; i < num_segments; ++i)
+  {
+    mean_x += segments[i].min_robot_time - reference.min_robot_time;
+    mean_y += segments[i].min_difference - reference.min_difference;
+  }
+  mean_x /= num_segments;
+  mean_y /= num_segments;
+
+  double sxx = 0.0;
+  double sxy = 0.0;
+  for (size_t i = 0; i < num_segments; ++i)
+  {
+    const double dx = segments[i].min_robot_time - reference.min_robot_time - mean_x;
+    const double dy = segments[i].min_difference - reference.min_difference - mean_y;
+    sxx += dx * dx;
+    sxy += dx * dy;
+  }
+  // A single segment doesn't tell anything about the drift
+  const double drift = sxx > 0.0 ? sxy / sxx : 0.0;
+
+  // The spread of all samples around the fitted line is calculated from the segments' moments,
+  // which are combined using the parallel variant of Welford's algorithm.
+  double n = 0.0;
+  double mean_robot_time = 0.0;
+  double mean_difference = 0.0;
+  double m2_robot_time = 0.0;
+  double m2_difference = 0.0;
+  double co_moment = 0.0;
+  for (size_t i = 0; i < num_segments; ++i)
+  {
+    const Segment& segment = segments[i];
+    const double segment_n = static_cast<double>(segment.num_samples);
+    const double combined_n = n + segment_n;
+    const double delta_robot_time = segment.mean_robot_time - mean_robot_time;
+    const double delta_difference = segment.mean_difference - mean_difference;
+    const double weight = n * segment_n / combined_n;
+    mean_robot_time += delta_robot_time * segment_n / combined_n;
+    mean_difference += delta_difference * segment_n / combined_n;
+    m2_robot_time += segment.m2_robot_time + delta_robot_time * delta_robot_time * weight;
+    m2_difference += segment.m2_difference + delta_difference * delta_difference * weight;
+    co_moment += segment.co_moment + delta_robot_time * delta_difference * weight;
+    n = combined_n;
+  }
+  const double squared_residuals =
+      std::max(0.0, m2_difference - 2.0 * drift * co_moment + drift * drift * m2_robot_time);
+  // Two degrees of freedom are used by the fitted line.
+  const double jitter = num_samples > 2 ? std::sqrt(squared_residuals / (num_samples - 2)) : 0.0;
+
+  const double latest_robot_time = segments[num_segments - 1].latest_robot_time;
+  const double latest_x = latest_robot_time - reference.min_robot_time;
+  estimated_difference = reference.min_difference + mean_y + drift * (latest_x - mean_x);
+
+  estimate.robot_time = latest_robot_time;
+  estimate.host_time = toTimePoint(latest_robot_time + estimated_difference);
+  estimate.offset = toNanoseconds(estimated_difference);
+  estimate.drift = drift;
+  estimate.jitter = toNanoseconds(jitter);
+  return estimate;
+}
+
+}  // namespace comm
+}  // namespace urcl
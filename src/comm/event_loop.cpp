@@ -0,0 +1,229 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/event_loop.h"
+#include "ur_client_library/log.h"
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+#include <cstring>
+#include <system_error>
+
+namespace urcl
+{
+namespace comm
+{
+namespace
+{
+const int MAX_EVENTS = 16;
+const uint64_t SELF_PIPE_DATA = UINT64_MAX;
+
+uint64_t packEventData(const int fd, const uint32_t generation)
+{
+  return (static_cast<uint64_t>(generation) << 32) | static_cast<uint32_t>(fd);
+}
+
+void setNonBlocking(const int fd)
+{
+  int flags = fcntl(fd, F_GETFL);
+  if (flags == -1)
+  {
+    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_GETFL");
+  }
+  if (fcntl(fd, F_SETFL, flags | O_NONBLOCK) == -1)
+  {
+    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_SETFL");
+  }
+}
+}  // namespace
+
+EventLoop::EventLoop(const std::string& name, const int cpu)
+  : name_(name), cpu_(cpu), keep_running_(false), next_generation_(0)
+{
+  epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+  if (epoll_fd_ == -1)
+  {
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Failed to create epoll instance");
+  }
+
+  // Create self-pipe for interrupting the loop
+  if (pipe(self_pipe_) == -1)
+  {
+    close(epoll_fd_);
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Error creating self-pipe");
+  }
+  setNonBlocking(self_pipe_[0]);
+  setNonBlocking(self_pipe_[1]);
+
+  struct epoll_event event = {};
+  event.events = EPOLLIN;
+  event.data.u64 = SELF_PIPE_DATA;
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, self_pipe_[0], &event) == -1)
+  {
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Failed to register self-pipe");
+  }
+}
+
+EventLoop::~EventLoop()
+{
+  stop();
+  close(epoll_fd_);
+  close(self_pipe_[0]);
+  close(self_pipe_[1]);
+}
+
+void EventLoop::start()
+{
+  if (thread_.joinable())
+  {
+    return;
+  }
+  URCL_LOG_DEBUG("Starting event loop <%s>", name_.c_str());
+  keep_running_ = true;
+  thread_ = std::thread(&EventLoop::run, this);
+}
+
+void EventLoop::stop()
+{
+  keep_running_ = false;
+  wakeUp();
+  if (thread_.joinable())
+  {
+    thread_.join();
+    URCL_LOG_DEBUG("Event loop <%s> stopped", name_.c_str());
+  }
+}
+
+bool EventLoop::add(const int fd, const uint32_t events, Handler handler)
+{
+  std::lock_guard<std::recursive_mutex> lk(mutex_);
+  const uint32_t generation = next_generation_++;
+
+  struct epoll_event event = {};
+  event.events = events;
+  event.data.u64 = packEventData(fd, generation);
+  // The file descriptor might still be registered from an earlier use
+  if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) == -1 &&
+      (errno != EEXIST || epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, fd, &event) == -1))
+  {
+    URCL_LOG_ERROR("Failed to register FD %d in event loop <%s>: %s", fd, name_.c_str(), strerror(errno));
+    return false;
+  }
+  registrations_[fd] = Registration{ generation, std::make_shared<Handler>(std::move(handler)) };
+  return true;
+}
+
+void EventLoop::remove(const int fd)
+{
+  std::lock_guard<std::recursive_mutex> lk(mutex_);
+  auto it = registrations_.find(fd);
+  if (it == registrations_.end())
+  {
+    return;
+  }
+  epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+  registrations_.erase(it);
+}
+
+void EventLoop::wakeUp()
+{
+  if (::write(self_pipe_[1], "x", 1) == -1 && errno != EAGAIN)
+  {
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Writing to self-pipe failed.");
+  }
+}
+
+void EventLoop::dispatch(const uint64_t data, const uint32_t events)
+{
+  const int fd = static_cast<int>(data & 0xFFFFFFFF);
+  const uint32_t generation = static_cast<uint32_t>(data >> 32);
+  auto it = registrations_.find(fd);
+  // The registration might have been removed or replaced by an earlier handler of the same batch
+  if (it == registrations_.end() || it->second.generation != generation)
+  {
+    return;
+  }
+  std::shared_ptr<Handler> handler = it->second.handler;
+  (*handler)(events);
+}
+
+void EventLoop::run()
+{
+  loop_thread_id_ = std::this_thread::get_id();
+  if (cpu_ >= 0)
+  {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    CPU_SET(cpu_, &cpuset);
+    const int err = pthread_setaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    if (err != 0)
+    {
+      URCL_LOG_WARN("Failed to pin event loop <%s> to CPU %d: %s", name_.c_str(), cpu_, strerror(err));
+    }
+  }
+
+  struct epoll_event events[MAX_EVENTS];
+  while (keep_running_)
+  {
+    // blocks until activity on any registered file descriptor
+    const int num_events = epoll_wait(epoll_fd_, events, MAX_EVENTS, -1);
+    if (num_events < 0)
+    {
+      if (errno == EINTR)
+      {
+        continue;
+      }
+      URCL_LOG_ERROR("epoll_wait() failed in event loop <%s>. Stopping it.", name_.c_str());
+      break;
+    }
+
+    std::lock_guard<std::recursive_mutex> lk(mutex_);
+    for (int i = 0; i < num_events; ++i)
+    {
+      if (events[i].data.u64 == SELF_PIPE_DATA)
+      {
+        // Read part of pipe-trick. This will help interrupting the loop.
+        char buffer[16];
+        while (read(self_pipe_[0], buffer, sizeof(buffer)) > 0)
+        {
+        }
+        continue;
+      }
+      dispatch(events[i].data.u64, events[i].events);
+    }
+  }
+  loop_thread_id_ = std::thread::id();
+  URCL_LOG_DEBUG("Finished event loop <%s>", name_.c_str());
+}
+
+}  // namespace comm
+}  // namespace urcl
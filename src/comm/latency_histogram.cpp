@@ -0,0 +1,110 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/latency_histogram.h"
+
+#include <cmath>
+#include <limits>
+
+namespace urcl
+{
+namespace comm
+{
+LatencyHistogram::LatencyHistogram()
+{
+  reset();
+}
+
+uint64_t LatencyHistogram::highestEquivalentValue(const size_t index)
+{
+  if (index < SUB_BUCKET_COUNT)
+  {
+    return index;
+  }
+  const unsigned shift = index / SUB_BUCKET_COUNT - 1;
+  const uint64_t lowest = (SUB_BUCKET_COUNT + index % SUB_BUCKET_COUNT) << shift;
+  return lowest + (uint64_t(1) << shift) - 1;
+}
+
+std::chrono::nanoseconds LatencyHistogram::getValueAtPercentile(const double percentile) const
+{
+  const uint64_t count = getCount();
+  if (count == 0)
+  {
+    return std::chrono::nanoseconds(0);
+  }
+
+  const double clamped = std::min(std::max(percentile, 0.0), 100.0);
+  const uint64_t target = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * count)));
+  const uint64_t max = max_.load(std::memory_order_relaxed);
+  uint64_t accumulated = 0;
+  for (size_t i = 0; i < NUM_BUCKETS; ++i)
+  {
+    accumulated += counts_[i].load(std::memory_order_relaxed);
+    if (accumulated >= target)
+    {
+      return std::chrono::nanoseconds(std::min(highestEquivalentValue(i), max));
+    }
+  }
+  return std::chrono::nanoseconds(max);
+}
+
+LatencySummary LatencyHistogram::getSummary() const
+{
+  LatencySummary summary;
+  summary.count = getCount();
+  if (summary.count == 0)
+  {
+    return summary;
+  }
+  summary.min = std::chrono::nanoseconds(min_.load(std::memory_order_relaxed));
+  summary.mean = std::chrono::nanoseconds(sum_.load(std::memory_order_relaxed) / summary.count);
+  summary.p50 = getValueAtPercentile(50.0);
+  summary.p90 = getValueAtPercentile(90.0);
+  summary.p99 = getValueAtPercentile(99.0);
+  summary.p999 = getValueAtPercentile(99.9);
+  summary.max = std::chrono::nanoseconds(max_.load(std::memory_order_relaxed));
+  return summary;
+}
+
+void LatencyHistogram::reset()
+{
+  for (auto& bucket : counts_)
+  {
+    bucket.store(0, std::memory_order_relaxed);
+  }
+  count_.store(0, std::memory_order_relaxed);
+  sum_.store(0, std::memory_order_relaxed);
+  min_.store(std::numeric_limits<uint64_t>::max(), std::memory_order_relaxed);
+  max_.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace comm
+}  // namespace urcl
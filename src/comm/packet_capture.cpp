@@ -0,0 +1,188 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/packet_capture.h"
+
+#include <cstring>
+
+namespace urcl
+{
+namespace comm
+{
+namespace
+{
+// How long the background thread waits before looking for new chunks, if there were none
+const std::chrono::milliseconds WRITE_INTERVAL(10);
+
+size_t roundUp(const size_t value, const size_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+}  // namespace
+
+PacketCapture::PacketCapture(const std::string& filename, const size_t buffer_size)
+  : writer_(filename, RecordingType::CAPTURE, 0, "")
+  , rings_{ Ring(roundUp(buffer_size, ALIGNMENT)), Ring(roundUp(buffer_size, ALIGNMENT)) }
+  , num_captured_(0)
+  , num_dropped_(0)
+  , running_(true)
+{
+  writer_thread_ = std::thread(&PacketCapture::runWriter, this);
+}
+
+PacketCapture::~PacketCapture()
+{
+  running_ = false;
+  if (writer_thread_.joinable())
+  {
+    writer_thread_.join();
+  }
+}
+
+bool PacketCapture::capture(const CaptureDirection direction, const uint8_t* data, const size_t size,
+                            const uint32_t channel)
+{
+  Ring& ring = rings_[static_cast<uint32_t>(direction) & 1];
+  const size_t capacity = ring.buffer.size();
+  const size_t frame_size = sizeof(RecordingFrameHeader) + roundUp(size, ALIGNMENT);
+
+  // Reserve space for the chunk. Other threads capturing at the same time reserve the following
+  // space, so the reservation has to be retried if one of them was faster.
+  uint64_t head = ring.head.load(std::memory_order_relaxed);
+  size_t offset;
+  size_t contiguous;
+  size_t needed;
+  do
+  {
+    offset = head % capacity;
+    contiguous = capacity - offset;
+    needed = contiguous < frame_size ? contiguous + frame_size : frame_size;
+    if (frame_size > capacity || head + needed - ring.tail.load(std::memory_order_acquire) > capacity)
+    {
+      num_dropped_++;
+      return false;
+    }
+  } while (!ring.head.compare_exchange_weak(head, head + needed, std::memory_order_relaxed));
+
+  if (contiguous < frame_size)
+  {
+    ring.states[offset / ALIGNMENT].store(SLOT_SKIP, std::memory_order_release);
+    offset = 0;
+  }
+
+  const auto now = std::chrono::steady_clock::now().time_since_epoch();
+  RecordingFrameHeader header{ std::chrono::duration_cast<std::chrono::nanoseconds>(now).count(),
+                               static_cast<uint32_t>(size),
+                               static_cast<uint32_t>(direction) | (channel << CHANNEL_SHIFT) };
+  std::memcpy(ring.buffer.data() + offset, &header, sizeof(header));
+  std::memcpy(ring.buffer.data() + offset + sizeof(header), data, size);
+  ring.states[offset / ALIGNMENT].store(SLOT_COMPLETE, std::memory_order_release);
+  return true;
+}
+
+bool PacketCapture::front(Ring& ring, RecordingFrameHeader& header, const uint8_t*& data)
+{
+  const size_t capacity = ring.buffer.size();
+  const uint64_t head = ring.head.load(std::memory_order_acquire);
+  uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+  while (tail < head)
+  {
+    const size_t offset = tail % capacity;
+    std::atomic<uint8_t>& state = ring.states[offset / ALIGNMENT];
+    switch (state.load(std::memory_order_acquire))
+    {
+      case SLOT_COMPLETE:
+        std::memcpy(&header, ring.buffer.data() + offset, sizeof(header));
+        data = ring.buffer.data() + offset + sizeof(header);
+        return true;
+      case SLOT_SKIP:
+        state.store(SLOT_EMPTY, std::memory_order_relaxed);
+        tail += capacity - offset;
+        ring.tail.store(tail, std::memory_order_release);
+        break;
+      default:
+        // The oldest chunk is still being copied. Later chunks have to wait for it to keep the order.
+        return false;
+    }
+  }
+  return false;
+}
+
+void PacketCapture::pop(Ring& ring, const RecordingFrameHeader& header)
+{
+  const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+  ring.states[(tail % ring.buffer.size()) / ALIGNMENT].store(SLOT_EMPTY, std::memory_order_relaxed);
+  ring.tail.store(tail + sizeof(header) + roundUp(header.size, ALIGNMENT), std::memory_order_release);
+}
+
+void PacketCapture::runWriter()
+{
+  while (running_)
+  {
+    if (writeBuffered() == 0)
+    {
+      std::this_thread::sleep_for(WRITE_INTERVAL);
+    }
+  }
+  writeBuffered();
+}
+
+size_t PacketCapture::writeBuffered()
+{
+  size_t written = 0;
+  RecordingFrameHeader headers[2];
+  const uint8_t* data[2];
+  while (true)
+  {
+    const bool available[2] = { front(rings_[0], headers[0], data[0]), front(rings_[1], headers[1], data[1]) };
+    if (!available[0] && !available[1])
+    {
+      return written;
+    }
+
+    // Merge both directions by their capture time
+    const size_t i = (available[0] && (!available[1] || headers[0].time <= headers[1].time)) ? 0 : 1;
+    const std::chrono::steady_clock::time_point time(
+        std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(headers[i].time)));
+    if (writer_.append(time, data[i], headers[i].size, headers[i].flags))
+    {
+      num_captured_++;
+    }
+    else
+    {
+      num_dropped_++;
+    }
+    pop(rings_[i], headers[i]);
+    written++;
+  }
+}
+
+}  // namespace comm
+}  // namespace urcl
@@ -0,0 +1,368 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/recording.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cinttypes>
+#include <cstring>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/log.h"
+
+namespace urcl
+{
+namespace comm
+{
+namespace
+{
+const char RECORDING_MAGIC[8] = { 'U', 'R', 'C', 'L', 'R', 'E', 'C', '\0' };
+const uint32_t BLOCK_MAGIC = 0x4b4c4255;  // "UBLK"
+
+uint64_t roundUp(const uint64_t value, const uint64_t multiple)
+{
+  return (value + multiple - 1) / multiple * multiple;
+}
+
+int64_t toNanoseconds(const std::chrono::steady_clock::time_point time)
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(time.time_since_epoch()).count();
+}
+
+std::chrono::steady_clock::time_point fromNanoseconds(const int64_t nanoseconds)
+{
+  return std::chrono::steady_clock::time_point(
+      std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::nanoseconds(nanoseconds)));
+}
+}  // namespace
+
+RecordingWriter::RecordingWriter(const std::string& filename, const RecordingType type,
+                                 const uint32_t protocol_version, const std::string& metadata, const size_t block_size)
+  : fd_(-1), block_size_(0), data_offset_(0), num_blocks_(0), num_frames_(0), block_(nullptr)
+{
+  const uint64_t page_size = static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+  block_size_ = roundUp(std::max<size_t>(block_size, sizeof(RecordingBlockHeader) + 1), page_size);
+  data_offset_ = roundUp(sizeof(RecordingHeader) + metadata.size(), page_size);
+
+  fd_ = ::open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd_ < 0)
+  {
+    throw UrException("Could not create recording '" + filename + "': " + std::strerror(errno));
+  }
+
+  RecordingHeader header;
+  std::memcpy(header.magic, RECORDING_MAGIC, sizeof(header.magic));
+  header.format_version = FORMAT_VERSION;
+  header.type = type;
+  header.protocol_version = protocol_version;
+  header.metadata_size = static_cast<uint32_t>(metadata.size());
+  header.data_offset = data_offset_;
+  header.block_size = block_size_;
+
+  if (::pwrite(fd_, &header, sizeof(header), 0) != static_cast<ssize_t>(sizeof(header)) ||
+      ::pwrite(fd_, metadata.data(), metadata.size(), sizeof(header)) != static_cast<ssize_t>(metadata.size()) ||
+      ::ftruncate(fd_, data_offset_) != 0)
+  {
+    const std::string error = std::strerror(errno);
+    ::close(fd_);
+    throw UrException("Could not write header of recording '" + filename + "': " + error);
+  }
+}
+
+RecordingWriter::~RecordingWriter()
+{
+  close();
+}
+
+bool RecordingWriter::append(const std::chrono::steady_clock::time_point time, const uint8_t* data, const size_t size,
+                             const uint32_t flags)
+{
+  const uint64_t frame_size = sizeof(RecordingFrameHeader) + roundUp(size, 8);
+  if (fd_ < 0 || sizeof(RecordingBlockHeader) + frame_size > block_size_)
+  {
+    return false;
+  }
+
+  RecordingBlockHeader* header = reinterpret_cast<RecordingBlockHeader*>(block_);
+  if (block_ == nullptr || header->used_size + frame_size > block_size_)
+  {
+    if (!mapNextBlock())
+    {
+      return false;
+    }
+    header = reinterpret_cast<RecordingBlockHeader*>(block_);
+  }
+
+  RecordingFrameHeader frame_header{ toNanoseconds(time), static_cast<uint32_t>(size), flags };
+  std::memcpy(block_ + header->used_size, &frame_header, sizeof(frame_header));
+  std::memcpy(block_ + header->used_size + sizeof(frame_header), data, size);
+
+  if (header->num_frames == 0)
+  {
+    header->first_time = frame_header.time;
+  }
+  header->last_time = frame_header.time;
+  header->used_size += frame_size;
+  header->num_frames++;
+  num_frames_++;
+  return true;
+}
+
+void RecordingWriter::close()
+{
+  if (fd_ < 0)
+  {
+    return;
+  }
+
+  uint64_t end = data_offset_;
+  if (block_ != nullptr)
+  {
+    end += (num_blocks_ - 1) * block_size_ + reinterpret_cast<RecordingBlockHeader*>(block_)->used_size;
+    unmapBlock();
+  }
+  if (::ftruncate(fd_, end) != 0)
+  {
+    URCL_LOG_WARN("Could not truncate recording: %s", std::strerror(errno));
+  }
+  ::close(fd_);
+  fd_ = -1;
+}
+
+bool RecordingWriter::mapNextBlock()
+{
+  unmapBlock();
+
+  const uint64_t offset = data_offset_ + num_blocks_ * block_size_;
+  if (::ftruncate(fd_, offset + block_size_) != 0)
+  {
+    URCL_LOG_ERROR("Could not extend recording: %s", std::strerror(errno));
+    return false;
+  }
+  void* block = ::mmap(nullptr, block_size_, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, offset);
+  if (block == MAP_FAILED)
+  {
+    URCL_LOG_ERROR("Could not map block of recording: %s", std::strerror(errno));
+    return false;
+  }
+
+  block_ = static_cast<uint8_t*>(block);
+  RecordingBlockHeader header{ BLOCK_MAGIC, 0, sizeof(RecordingBlockHeader), num_frames_, 0, 0 };
+  std::memcpy(block_, &header, sizeof(header));
+  num_blocks_++;
+  return true;
+}
+
+void RecordingWriter::unmapBlock()
+{
+  if (block_ != nullptr)
+  {
+    ::munmap(block_, block_size_);
+    block_ = nullptr;
+  }
+}
+
+RecordingReader::RecordingReader(const std::string& filename)
+  : fd_(-1), data_(nullptr), size_(0), num_blocks_(0), current_block_(0), current_frame_(0), current_offset_(0)
+{
+  fd_ = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd_ < 0)
+  {
+    throw UrException("Could not open recording '" + filename + "': " + std::strerror(errno));
+  }
+
+  struct stat file_stat;
+  if (::fstat(fd_, &file_stat) != 0 || static_cast<size_t>(file_stat.st_size) < sizeof(RecordingHeader))
+  {
+    ::close(fd_);
+    throw UrException("'" + filename + "' is not a recording");
+  }
+  size_ = static_cast<size_t>(file_stat.st_size);
+
+  void* data = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd_, 0);
+  if (data == MAP_FAILED)
+  {
+    const std::string error = std::strerror(errno);
+    ::close(fd_);
+    throw UrException("Could not map recording '" + filename + "': " + error);
+  }
+  data_ = static_cast<uint8_t*>(data);
+
+  std::memcpy(&header_, data_, sizeof(header_));
+  if (std::memcmp(header_.magic, RECORDING_MAGIC, sizeof(header_.magic)) != 0 ||
+      header_.format_version != RecordingWriter::FORMAT_VERSION || header_.block_size < sizeof(RecordingBlockHeader) ||
+      sizeof(RecordingHeader) + header_.metadata_size > header_.data_offset || header_.data_offset > size_)
+  {
+    ::munmap(data_, size_);
+    ::close(fd_);
+    throw UrException("'" + filename + "' is not a recording of a supported format");
+  }
+  metadata_.assign(reinterpret_cast<const char*>(data_ + sizeof(RecordingHeader)), header_.metadata_size);
+  num_blocks_ = (size_ - header_.data_offset + header_.block_size - 1) / header_.block_size;
+  rewind();
+}
+
+RecordingReader::~RecordingReader()
+{
+  ::munmap(data_, size_);
+  ::close(fd_);
+}
+
+uint64_t RecordingReader::getNumFrames() const
+{
+  for (uint64_t i = num_blocks_; i > 0; --i)
+  {
+    if (const RecordingBlockHeader* header = block(i - 1))
+    {
+      return header->first_frame + header->num_frames;
+    }
+  }
+  return 0;
+}
+
+bool RecordingReader::next(RecordedFrame& frame)
+{
+  while (const RecordingBlockHeader* header = block(current_block_))
+  {
+    if (current_frame_ >= header->num_frames)
+    {
+      current_block_++;
+      current_frame_ = 0;
+      current_offset_ = sizeof(RecordingBlockHeader);
+      continue;
+    }
+
+    const uint8_t* base = reinterpret_cast<const uint8_t*>(header);
+    RecordingFrameHeader frame_header;
+    std::memcpy(&frame_header, base + current_offset_, sizeof(frame_header));
+    if (current_offset_ + sizeof(frame_header) + frame_header.size > header->used_size)
+    {
+      URCL_LOG_ERROR("Recording contains an invalid frame in block %" PRIu64, current_block_);
+      return false;
+    }
+
+    frame.time = fromNanoseconds(frame_header.time);
+    frame.data = base + current_offset_ + sizeof(frame_header);
+    frame.size = frame_header.size;
+    frame.flags = frame_header.flags;
+    current_offset_ += sizeof(frame_header) + roundUp(frame_header.size, 8);
+    current_frame_++;
+    return true;
+  }
+  return false;
+}
+
+bool RecordingReader::peek(RecordedFrame& frame)
+{
+  const uint64_t block = current_block_;
+  const uint32_t frame_index = current_frame_;
+  const uint64_t offset = current_offset_;
+  const bool result = next(frame);
+  current_block_ = block;
+  current_frame_ = frame_index;
+  current_offset_ = offset;
+  return result;
+}
+
+void RecordingReader::seek(const std::chrono::steady_clock::time_point time)
+{
+  const int64_t nanoseconds = toNanoseconds(time);
+
+  // Find the first block containing frames received at or after the given time
+  uint64_t lower = 0;
+  uint64_t upper = num_blocks_;
+  while (lower < upper)
+  {
+    const uint64_t middle = lower + (upper - lower) / 2;
+    const RecordingBlockHeader* header = block(middle);
+    if (header != nullptr && header->last_time < nanoseconds)
+    {
+      lower = middle + 1;
+    }
+    else
+    {
+      upper = middle;
+    }
+  }
+
+  current_block_ = lower;
+  current_frame_ = 0;
+  current_offset_ = sizeof(RecordingBlockHeader);
+
+  RecordedFrame frame;
+  while (true)
+  {
+    const uint64_t block_index = current_block_;
+    const uint32_t frame_index = current_frame_;
+    const uint64_t offset = current_offset_;
+    if (!next(frame) || toNanoseconds(frame.time) >= nanoseconds)
+    {
+      current_block_ = block_index;
+      current_frame_ = frame_index;
+      current_offset_ = offset;
+      return;
+    }
+  }
+}
+
+void RecordingReader::rewind()
+{
+  current_block_ = 0;
+  current_frame_ = 0;
+  current_offset_ = sizeof(RecordingBlockHeader);
+}
+
+const RecordingBlockHeader* RecordingReader::block(const uint64_t index) const
+{
+  if (index >= num_blocks_)
+  {
+    return nullptr;
+  }
+  const uint64_t offset = header_.data_offset + index * header_.block_size;
+  if (offset + sizeof(RecordingBlockHeader) > size_)
+  {
+    return nullptr;
+  }
+  const RecordingBlockHeader* header = reinterpret_cast<const RecordingBlockHeader*>(data_ + offset);
+  if (header->magic != BLOCK_MAGIC || header->used_size > header_.block_size || offset + header->used_size > size_)
+  {
+    return nullptr;
+  }
+  return header;
+}
+
+}  // namespace comm
+}  // namespace urcl
@@ -32,19 +32,28 @@
 #include <iostream>
 
 #include <sstream>
-#include <strings.h>
 #include <cstring>
-#include <fcntl.h>
+#include <sys/epoll.h>
 #include <algorithm>
 #include <system_error>
+#include <thread>
 
 namespace urcl
 {
 namespace comm
 {
-TCPServer::TCPServer(const int port, const size_t max_num_tries, const std::chrono::milliseconds reconnection_time)
-  : port_(port), maxfd_(0), max_clients_allowed_(0)
+TCPServer::TCPServer(const int port, const size_t max_num_tries, const std::chrono::milliseconds reconnection_time,
+                     std::shared_ptr<EventLoop> event_loop)
+  : event_loop_(event_loop)
+  , owns_event_loop_(event_loop == nullptr)
+  , port_(port)
+  , max_clients_allowed_(0)
+  , busy_poll_time_(0)
 {
+  if (owns_event_loop_)
+  {
+    event_loop_ = std::make_shared<EventLoop>("TCPServer:" + std::to_string(port));
+  }
   init();
   bind(max_num_tries, reconnection_time);
   startListen();
@@ -69,59 +78,25 @@ void TCPServer::init()
   setsockopt(listen_fd_, SOL_SOCKET, SO_KEEPALIVE, &flag, sizeof(int));
 
   URCL_LOG_DEBUG("Created socket with FD %d", (int)listen_fd_);
-
-  FD_ZERO(&masterfds_);
-  FD_ZERO(&tempfds_);
-
-  // Create self-pipe for interrupting the worker loop
-  if (pipe(self_pipe_) == -1)
-  {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "Error creating self-pipe");
-  }
-  URCL_LOG_DEBUG("Created read pipe at FD %d", self_pipe_[0]);
-  FD_SET(self_pipe_[0], &masterfds_);
-
-  // Make read and write ends of pipe nonblocking
-  int flags;
-  flags = fcntl(self_pipe_[0], F_GETFL);
-  if (flags == -1)
-  {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_GETFL");
-  }
-  flags |= O_NONBLOCK;  // Make read end nonblocking
-  if (fcntl(self_pipe_[0], F_SETFL, flags) == -1)
-  {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_SETFL");
-  }
-
-  flags = fcntl(self_pipe_[1], F_GETFL);
-  if (flags == -1)
-  {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_GETFL");
-  }
-  flags |= O_NONBLOCK;  // Make write end nonblocking
-  if (fcntl(self_pipe_[1], F_SETFL, flags) == -1)
-  {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "fcntl-F_SETFL");
-  }
 }
 
 void TCPServer::shutdown()
 {
-  keep_running_ = false;
-
-  // This is basically the self-pipe trick. Writing to the pipe will trigger an event for the event
-  // handler which will stop the select() call from blocking.
-  if (::write(self_pipe_[1], "x", 1) == -1 && errno != EAGAIN)
+  // After removing the registrations, none of the handlers is running anymore.
+  event_loop_->remove(listen_fd_);
+  std::vector<int> client_fds;
   {
-    throw std::system_error(std::error_code(errno, std::generic_category()), "Writing to self-pipe failed.");
+    std::lock_guard<std::mutex> lk(clients_mutex_);
+    client_fds = client_fds_;
+  }
+  for (const int fd : client_fds)
+  {
+    event_loop_->remove(fd);
   }
 
-  // After the event loop has finished the thread will be joinable.
-  if (worker_thread_.joinable())
+  if (owns_event_loop_)
   {
-    worker_thread_.join();
-    URCL_LOG_DEBUG("Worker thread joined.");
+    event_loop_->stop();
   }
 }
 
@@ -157,10 +132,17 @@ void TCPServer::bind(const size_t max_num_tries, const std::chrono::milliseconds
     }
   } while (err == -1 && (connection_counter <= max_num_tries || max_num_tries == 0));
 
-  URCL_LOG_DEBUG("Bound %d:%d to FD %d", server_addr.sin_addr.s_addr, port_, (int)listen_fd_);
+  if (port_ == 0)
+  {
+    socklen_t addr_len = sizeof(server_addr);
+    if (getsockname(listen_fd_, (struct sockaddr*)&server_addr, &addr_len) == -1)
+    {
+      throw std::system_error(std::error_code(errno, std::generic_category()), "Failed to get the bound port");
+    }
+    port_ = ntohs(server_addr.sin_port);
+  }
 
-  FD_SET(listen_fd_, &masterfds_);
-  maxfd_ = std::max((int)listen_fd_, self_pipe_[0]);
+  URCL_LOG_DEBUG("Bound %d:%d to FD %d", server_addr.sin_addr.s_addr, port_, (int)listen_fd_);
 }
 
 void TCPServer::startListen()
@@ -187,13 +169,30 @@ void TCPServer::handleConnect()
     throw std::system_error(std::error_code(errno, std::generic_category()), ss.str());
   }
 
-  if (client_fds_.size() < max_clients_allowed_ || max_clients_allowed_ == 0)
+  size_t num_clients;
   {
-    client_fds_.push_back(client_fd);
-    FD_SET(client_fd, &masterfds_);
-    if (client_fd > maxfd_)
+    std::lock_guard<std::mutex> lk(clients_mutex_);
+    num_clients = client_fds_.size();
+  }
+  if (num_clients < max_clients_allowed_ || max_clients_allowed_ == 0)
+  {
+    const int busy_poll_time = busy_poll_time_;
+    if (busy_poll_time > 0 &&
+        setsockopt(client_fd, SOL_SOCKET, SO_BUSY_POLL, &busy_poll_time, sizeof(busy_poll_time)) == -1)
+    {
+      URCL_LOG_WARN("Failed to enable busy polling on port %d: %s. Continuing without busy polling.", port_,
+                    strerror(errno));
+    }
+
+    if (!addClient(client_fd))
+    {
+      URCL_LOG_ERROR("Failed to register client FD %d for events. Closing connection.", client_fd);
+      close(client_fd);
+      return;
+    }
     {
-      maxfd_ = std::max(client_fd, self_pipe_[0]);
+      std::lock_guard<std::mutex> lk(clients_mutex_);
+      client_fds_.push_back(client_fd);
     }
     if (new_connection_callback_)
     {
@@ -209,70 +208,22 @@ void TCPServer::handleConnect()
   }
 }
 
-void TCPServer::spin()
+bool TCPServer::addClient(const int fd)
 {
-  tempfds_ = masterfds_;
-
-  // blocks until activity on any socket from tempfds
-  int sel = select(maxfd_ + 1, &tempfds_, NULL, NULL, NULL);
-  if (sel < 0)
-  {
-    URCL_LOG_ERROR("select() failed. Shutting down socket event handler.");
-    keep_running_ = false;
-    return;
-  }
-
-  // Read part if pipe-trick. This will help interrupting the event handler thread.
-  if (FD_ISSET(self_pipe_[0], &masterfds_))
-  {
-    URCL_LOG_DEBUG("Activity on self-pipe");
-    char buffer;
-    if (read(self_pipe_[0], &buffer, 1) == -1)
-    {
-      while (true)
-      {
-        if (errno == EAGAIN)
-          break;
-        else
-          URCL_LOG_ERROR("read failed");
-      }
-    }
-    else
-    {
-      URCL_LOG_DEBUG("Self-pipe triggered");
-      return;
-    }
-  }
-
-  // Check which fd has an activity
-  for (int i = 0; i <= maxfd_; i++)
-  {
-    if (FD_ISSET(i, &tempfds_))
-    {
-      URCL_LOG_DEBUG("Activity on FD %d", i);
-      if (listen_fd_ == i)
-      {
-        // Activity on the listen_fd means we have a new connection
-        handleConnect();
-      }
-      else
-      {
-        readData(i);
-      }
-    }
-  }
+  return event_loop_->add(fd, EPOLLIN | EPOLLET, [this, fd](const uint32_t events) { readData(fd); });
 }
 
 void TCPServer::handleDisconnect(const int fd)
 {
   URCL_LOG_DEBUG("%d disconnected.", fd);
+  event_loop_->remove(fd);
   close(fd);
   if (disconnect_callback_)
   {
     disconnect_callback_(fd);
   }
-  FD_CLR(fd, &masterfds_);
 
+  std::lock_guard<std::mutex> lk(clients_mutex_);
   for (size_t i = 0; i < client_fds_.size(); ++i)
   {
     if (client_fds_[i] == fd)
@@ -285,19 +236,38 @@ void TCPServer::handleDisconnect(const int fd)
 
 void TCPServer::readData(const int fd)
 {
-  bzero(&input_buffer_, INPUT_BUFFER_SIZE);  // clear input buffer
-  int nbytesrecv = recv(fd, input_buffer_, INPUT_BUFFER_SIZE, 0);
-  if (nbytesrecv > 0)
+  while (true)
   {
-    if (message_callback_)
+    int nbytesrecv = recv(fd, input_buffer_, INPUT_BUFFER_SIZE, MSG_DONTWAIT);
+    if (nbytesrecv > 0)
     {
-      message_callback_(fd, input_buffer_, nbytesrecv);
+      input_buffer_[nbytesrecv] = '\0';
+      if (capture_)
+      {
+        capture_->capture(CaptureDirection::INBOUND, reinterpret_cast<uint8_t*>(input_buffer_), nbytesrecv, fd);
+      }
+      if (message_callback_)
+      {
+        message_callback_(fd, input_buffer_, nbytesrecv);
+      }
+      if (nbytesrecv < INPUT_BUFFER_SIZE)
+      {
+        // A short read means the socket is drained. New data will trigger a new event.
+        return;
+      }
+      continue;
     }
-  }
-  else
-  {
+
     if (nbytesrecv < 0)
     {
+      if (errno == EAGAIN || errno == EWOULDBLOCK)
+      {
+        return;
+      }
+      if (errno == EINTR)
+      {
+        continue;
+      }
       if (errno == ECONNRESET)  // if connection gets reset by client, we want to suppress this output
       {
         URCL_LOG_DEBUG("client from FD %d sent a connection reset package.", fd);
@@ -312,23 +282,34 @@ void TCPServer::readData(const int fd)
       // normal disconnect
     }
     handleDisconnect(fd);
+    return;
   }
 }
 
-void TCPServer::worker()
+void TCPServer::start()
 {
-  while (keep_running_)
+  URCL_LOG_DEBUG("Starting event handling on port %d", port_);
+  // The listen socket is level-triggered, so pending connections are accepted one at a time.
+  if (!event_loop_->add(listen_fd_, EPOLLIN, [this](const uint32_t events) { handleConnect(); }))
   {
-    spin();
+    throw std::system_error(std::error_code(errno, std::generic_category()), "Failed to register listen socket");
   }
-  URCL_LOG_DEBUG("Finished worker thread of TCPServer");
-}
 
-void TCPServer::start()
-{
-  URCL_LOG_DEBUG("Starting worker thread");
-  keep_running_ = true;
-  worker_thread_ = std::thread(&TCPServer::worker, this);
+  // Clients that connected before a shutdown() are served again
+  std::vector<int> client_fds;
+  {
+    std::lock_guard<std::mutex> lk(clients_mutex_);
+    client_fds = client_fds_;
+  }
+  for (const int fd : client_fds)
+  {
+    addClient(fd);
+  }
+
+  if (owns_event_loop_)
+  {
+    event_loop_->start();
+  }
 }
 
 bool TCPServer::write(const int fd, const uint8_t* buf, const size_t buf_len, size_t& written)
@@ -345,14 +326,19 @@ bool TCPServer::write(const int fd, const uint8_t* buf, const size_t buf_len, si
     if (sent <= 0)
     {
       URCL_LOG_ERROR("Sending data through socket failed.");
-      return false;
+      break;
     }
 
     written += sent;
     remaining -= sent;
   }
 
-  return true;
+  if (capture_ && written > 0)
+  {
+    capture_->capture(CaptureDirection::OUTBOUND, buf, written, fd);
+  }
+
+  return written == buf_len;
 }
 
 }  // namespace comm
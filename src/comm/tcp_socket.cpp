@@ -22,6 +22,8 @@
 
 #include <arpa/inet.h>
 #include <endian.h>
+#include <linux/errqueue.h>
+#include <linux/net_tstamp.h>
 #include <netinet/tcp.h>
 #include <unistd.h>
 #include <chrono>
@@ -36,7 +38,13 @@ namespace urcl
 {
 namespace comm
 {
-TCPSocket::TCPSocket() : socket_fd_(-1), state_(SocketState::Invalid), reconnection_time_(std::chrono::seconds(10))
+TCPSocket::TCPSocket()
+  : socket_fd_(-1)
+  , state_(SocketState::Invalid)
+  , reconnection_time_(std::chrono::seconds(10))
+  , receive_timestamping_(false)
+  , last_kernel_receive_time_()
+  , last_hardware_receive_time_(0)
 {
 }
 TCPSocket::~TCPSocket()
@@ -54,6 +62,41 @@ void TCPSocket::setupOptions()
   {
     setsockopt(socket_fd_, SOL_SOCKET, SO_RCVTIMEO, recv_timeout_.get(), sizeof(timeval));
   }
+
+  if (receive_timestamping_)
+  {
+    setupTimestamping();
+  }
+}
+
+void TCPSocket::setupTimestamping()
+{
+  // Software timestamps are requested in any case, hardware timestamps are only delivered if the
+  // network interface has been configured to create them.
+  int flags = 0;
+  if (receive_timestamping_)
+  {
+    flags = SOF_TIMESTAMPING_RX_SOFTWARE | SOF_TIMESTAMPING_SOFTWARE | SOF_TIMESTAMPING_RX_HARDWARE |
+            SOF_TIMESTAMPING_RAW_HARDWARE;
+  }
+  if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMPING, &flags, sizeof(flags)) != 0)
+  {
+    // Fall back to software timestamps only
+    int enable = receive_timestamping_ ? 1 : 0;
+    if (setsockopt(socket_fd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) != 0)
+    {
+      URCL_LOG_WARN("Failed to configure receive timestamps: %s", strerror(errno));
+    }
+  }
+}
+
+void TCPSocket::setReceiveTimestamping(const bool enabled)
+{
+  receive_timestamping_ = enabled;
+  if (socket_fd_ >= 0)
+  {
+    setupTimestamping();
+  }
 }
 
 bool TCPSocket::setup(const std::string& host, const int port, const size_t max_num_tries,
@@ -173,13 +216,45 @@ bool TCPSocket::read(char* character)
 }
 
 bool TCPSocket::read(uint8_t* buf, const size_t buf_len, size_t& read)
+{
+  return receive(buf, buf_len, read, 0);
+}
+
+bool TCPSocket::readAvailable(uint8_t* buf, const size_t buf_len, size_t& read)
+{
+  return receive(buf, buf_len, read, MSG_DONTWAIT);
+}
+
+bool TCPSocket::receive(uint8_t* buf, const size_t buf_len, size_t& read, const int flags)
 {
   read = 0;
 
   if (state_ != SocketState::Connected)
     return false;
 
-  ssize_t res = ::recv(socket_fd_, buf, buf_len, 0);
+  ssize_t res;
+  if (!receive_timestamping_)
+  {
+    res = ::recv(socket_fd_, buf, buf_len, flags);
+  }
+  else
+  {
+    iovec iov;
+    iov.iov_base = buf;
+    iov.iov_len = buf_len;
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(scm_timestamping)) + CMSG_SPACE(sizeof(timespec))];
+    msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = &iov;
+    msg.msg_iovlen = 1;
+    msg.msg_control = control;
+    msg.msg_controllen = sizeof(control);
+    res = ::recvmsg(socket_fd_, &msg, flags);
+    if (res > 0)
+    {
+      parseReceiveTimestamps(msg);
+    }
+  }
 
   if (res == 0)
   {
@@ -200,6 +275,41 @@ bool TCPSocket::read(uint8_t* buf, const size_t buf_len, size_t& read)
   return true;
 }
 
+void TCPSocket::parseReceiveTimestamps(msghdr& msg)
+{
+  auto to_nanoseconds = [](const timespec& ts) {
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+  };
+
+  for (cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg))
+  {
+    if (cmsg->cmsg_level != SOL_SOCKET)
+    {
+      continue;
+    }
+    if (cmsg->cmsg_type == SCM_TIMESTAMPING)
+    {
+      scm_timestamping timestamps;
+      std::memcpy(&timestamps, CMSG_DATA(cmsg), sizeof(timestamps));
+      // The first entry holds the software timestamp, the third one the raw hardware timestamp
+      const auto software = to_nanoseconds(timestamps.ts[0]);
+      if (software.count() != 0)
+      {
+        last_kernel_receive_time_ = std::chrono::system_clock::time_point(
+            std::chrono::duration_cast<std::chrono::system_clock::duration>(software));
+      }
+      last_hardware_receive_time_ = to_nanoseconds(timestamps.ts[2]);
+    }
+    else if (cmsg->cmsg_type == SCM_TIMESTAMPNS)
+    {
+      timespec timestamp;
+      std::memcpy(&timestamp, CMSG_DATA(cmsg), sizeof(timestamp));
+      last_kernel_receive_time_ = std::chrono::system_clock::time_point(
+          std::chrono::duration_cast<std::chrono::system_clock::duration>(to_nanoseconds(timestamp)));
+    }
+  }
+}
+
 bool TCPSocket::write(const uint8_t* buf, const size_t buf_len, size_t& written)
 {
   written = 0;
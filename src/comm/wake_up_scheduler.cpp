@@ -0,0 +1,178 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/comm/wake_up_scheduler.h"
+
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <ctime>
+
+namespace urcl
+{
+namespace comm
+{
+namespace
+{
+double toNanoseconds(const std::chrono::steady_clock::time_point time_point)
+{
+  return std::chrono::duration<double, std::nano>(time_point.time_since_epoch()).count();
+}
+
+std::chrono::steady_clock::time_point toTimePoint(const double nanoseconds)
+{
+  return std::chrono::steady_clock::time_point(std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+      std::chrono::duration<double, std::nano>(nanoseconds)));
+}
+}  // namespace
+
+WakeUpScheduler::WakeUpScheduler(const std::chrono::nanoseconds spin_duration) : spin_duration_(spin_duration)
+{
+  reset();
+}
+
+void WakeUpScheduler::reset(const std::chrono::nanoseconds nominal_period)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  num_arrivals_ = 0;
+  last_arrival_ = 0.0;
+  period_ = static_cast<double>(nominal_period.count());
+  jitter_ = 0.0;
+}
+
+void WakeUpScheduler::addArrival(const std::chrono::steady_clock::time_point arrival)
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  const double arrival_ns = toNanoseconds(arrival);
+  if (num_arrivals_ == 0)
+  {
+    last_arrival_ = arrival_ns;
+    num_arrivals_ = 1;
+    return;
+  }
+
+  const double elapsed = arrival_ns - last_arrival_;
+  if (period_ <= 0.0)
+  {
+    if (elapsed > 0.0)
+    {
+      period_ = elapsed;
+      last_arrival_ = arrival_ns;
+      ++num_arrivals_;
+    }
+    return;
+  }
+
+  // Number of periods since the latest arrival. Arrivals belonging to the latest period, e.g.
+  // packages received together with it, don't carry any new information.
+  const double periods = std::round(elapsed / period_);
+  if (periods < 1.0)
+  {
+    return;
+  }
+  const double deviation = elapsed - periods * period_;
+  last_arrival_ += periods * period_ + PHASE_GAIN * deviation;
+  period_ += PERIOD_GAIN * deviation / periods;
+  jitter_ += JITTER_GAIN * (std::abs(deviation) - jitter_);
+  ++num_arrivals_;
+}
+
+bool WakeUpScheduler::hasPrediction() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return num_arrivals_ > 0 && period_ > 0.0;
+}
+
+std::chrono::steady_clock::time_point WakeUpScheduler::getNextArrival() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (num_arrivals_ == 0 || period_ <= 0.0)
+  {
+    return std::chrono::steady_clock::time_point();
+  }
+  return toTimePoint(last_arrival_ + period_);
+}
+
+std::chrono::nanoseconds WakeUpScheduler::getPeriod() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return std::chrono::nanoseconds(static_cast<int64_t>(period_));
+}
+
+std::chrono::nanoseconds WakeUpScheduler::getJitter() const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  return std::chrono::nanoseconds(static_cast<int64_t>(jitter_));
+}
+
+void WakeUpScheduler::sleepUntil(const std::chrono::steady_clock::time_point time_point)
+{
+  // std::chrono::steady_clock is based on CLOCK_MONOTONIC.
+  const auto since_epoch = std::chrono::duration_cast<std::chrono::nanoseconds>(time_point.time_since_epoch());
+  if (since_epoch.count() <= 0)
+  {
+    return;
+  }
+  timespec wake_up;
+  wake_up.tv_sec = static_cast<time_t>(since_epoch.count() / 1000000000);
+  wake_up.tv_nsec = static_cast<long>(since_epoch.count() % 1000000000);
+  while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &wake_up, nullptr) == EINTR)
+  {
+  }
+}
+
+std::chrono::steady_clock::time_point WakeUpScheduler::now() const
+{
+  return std::chrono::steady_clock::now();
+}
+
+void WakeUpScheduler::sleep(const std::chrono::steady_clock::time_point time_point) const
+{
+  sleepUntil(time_point);
+}
+
+bool WakeUpScheduler::getWaitWindow(std::chrono::steady_clock::time_point& wake_up,
+                                    std::chrono::steady_clock::time_point& deadline) const
+{
+  std::lock_guard<std::mutex> lk(mutex_);
+  if (num_arrivals_ == 0 || period_ <= 0.0)
+  {
+    return false;
+  }
+  // Arrivals deviating by a few times the mean absolute deviation are still caught by polling.
+  const double margin = static_cast<double>(spin_duration_.count()) + 3.0 * jitter_;
+  const double next_arrival = last_arrival_ + period_;
+  wake_up = toTimePoint(next_arrival - margin);
+  deadline = toTimePoint(next_arrival + margin);
+  return true;
+}
+
+}  // namespace comm
+}  // namespace urcl
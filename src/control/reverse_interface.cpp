@@ -34,9 +34,9 @@ namespace urcl
 namespace control
 {
 ReverseInterface::ReverseInterface(uint32_t port, std::function<void(bool)> handle_program_state,
-                                   std::chrono::milliseconds step_time)
+                                   std::chrono::milliseconds step_time, std::shared_ptr<comm::EventLoop> event_loop)
   : client_fd_(-1)
-  , server_(port)
+  , server_(port, 0, std::chrono::seconds(1), event_loop)
   , handle_program_state_(handle_program_state)
   , step_time_(step_time)
   , keep_alive_count_modified_deprecated_(false)
@@ -33,7 +33,8 @@ namespace urcl
 {
 namespace control
 {
-ScriptCommandInterface::ScriptCommandInterface(uint32_t port) : ReverseInterface(port, [](bool foo) { return foo; })
+ScriptCommandInterface::ScriptCommandInterface(uint32_t port, std::shared_ptr<comm::EventLoop> event_loop)
+  : ReverseInterface(port, [](bool foo) { return foo; }, std::chrono::milliseconds(8), event_loop)
 {
   client_connected_ = false;
 }
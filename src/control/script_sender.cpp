@@ -31,8 +31,8 @@ namespace urcl
 {
 namespace control
 {
-ScriptSender::ScriptSender(uint32_t port, const std::string& program)
-  : server_(port), script_thread_(), program_(program)
+ScriptSender::ScriptSender(uint32_t port, const std::string& program, std::shared_ptr<comm::EventLoop> event_loop)
+  : server_(port, 0, std::chrono::seconds(1), event_loop), script_thread_(), program_(program)
 {
   server_.setMessageCallback(
       std::bind(&ScriptSender::messageCallback, this, std::placeholders::_1, std::placeholders::_2));
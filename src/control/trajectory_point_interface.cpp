@@ -34,7 +34,8 @@ namespace urcl
 {
 namespace control
 {
-TrajectoryPointInterface::TrajectoryPointInterface(uint32_t port) : ReverseInterface(port, [](bool foo) { return foo; })
+TrajectoryPointInterface::TrajectoryPointInterface(uint32_t port, std::shared_ptr<comm::EventLoop> event_loop)
+  : ReverseInterface(port, [](bool foo) { return foo; }, std::chrono::milliseconds(8), event_loop)
 {
 }
 
@@ -30,15 +30,68 @@
 
 #include "ur_client_library/log.h"
 #include "ur_client_library/default_log_handler.h"
+#include <pthread.h>
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdarg>
 #include <cstdio>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 namespace urcl
 {
+namespace
+{
+// Size of the buffer messages are formatted into. Longer messages are allocated in synchronous mode
+// and truncated in asynchronous mode.
+const size_t MESSAGE_BUFFER_SIZE = 1024;
+
+// How long the logging thread waits before looking for new messages, if there were none
+const std::chrono::milliseconds ASYNC_POLL_INTERVAL(10);
+
+// Interval in which repeated, suppressed and dropped messages are reported
+const std::chrono::seconds ASYNC_REPORT_INTERVAL(1);
+
+// Niceness of the logging thread
+const int ASYNC_NICE_VALUE = 10;
+
+struct LogEntry
+{
+  const char* file;
+  int line;
+  LogLevel level;
+  char text[MESSAGE_BUFFER_SIZE];
+};
+
+// Single-producer single-consumer ring buffer of messages logged by one thread
+struct LogRing
+{
+  LogRing(const size_t size, const uint64_t generation)
+    : entries(size), head(0), tail(0), dropped(0), generation(generation)
+  {
+  }
+
+  std::vector<LogEntry> entries;
+  std::atomic<uint64_t> head;
+  std::atomic<uint64_t> tail;
+  std::atomic<uint64_t> dropped;
+  // Asynchronous logging session the ring belongs to
+  const uint64_t generation;
+};
+}  // namespace
+
 class Logger
 {
 public:
-  Logger()
+  Logger() : async_(false), generation_(0), ring_size_(0), max_messages_per_second_(0)
   {
     log_level_ = LogLevel::INFO;
     log_handler_.reset(new DefaultLogHandler());
@@ -46,6 +99,7 @@ public:
 
   ~Logger()
   {
+    stopAsync();
     if (log_handler_)
     {
       log_handler_.reset();
@@ -54,11 +108,13 @@ public:
 
   void registerLogHandler(std::unique_ptr<LogHandler> loghandler)
   {
+    std::lock_guard<std::mutex> lock(handler_mutex_);
     log_handler_ = std::move(loghandler);
   }
 
   void unregisterLogHandler()
   {
+    std::lock_guard<std::mutex> lock(handler_mutex_);
     log_handler_.reset(new DefaultLogHandler());
   }
 
@@ -82,9 +138,282 @@ public:
     return log_level_;
   }
 
+  void startAsync(const size_t messages_per_thread, const size_t max_messages_per_second)
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    stopAsyncUnlocked();
+    {
+      std::lock_guard<std::mutex> rings_lock(rings_mutex_);
+      ring_size_ = std::max<size_t>(messages_per_thread, 1);
+    }
+    max_messages_per_second_ = max_messages_per_second;
+    async_ = true;
+    async_thread_ = std::thread(&Logger::runAsync, this);
+    generation_++;
+  }
+
+  void stopAsync()
+  {
+    std::lock_guard<std::mutex> lock(async_mutex_);
+    stopAsyncUnlocked();
+  }
+
+  // Returns false without using the arguments if logging is synchronous
+  bool logAsync(const char* file, int line, LogLevel level, const char* fmt, va_list args)
+  {
+    const uint64_t generation = generation_.load(std::memory_order_acquire);
+    if (generation % 2 == 0)
+    {
+      return false;
+    }
+
+    // Each thread registers its ring buffer with the first message of an asynchronous logging
+    // session. Afterwards logging doesn't lock or allocate.
+    thread_local std::shared_ptr<LogRing> ring;
+    if (!ring || ring->generation != generation)
+    {
+      ring = registerRing(generation);
+    }
+
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= ring->entries.size())
+    {
+      ring->dropped.fetch_add(1, std::memory_order_relaxed);
+      return true;
+    }
+
+    LogEntry& entry = ring->entries[head % ring->entries.size()];
+    entry.file = file;
+    entry.line = line;
+    entry.level = level;
+    std::vsnprintf(entry.text, MESSAGE_BUFFER_SIZE, fmt, args);
+    ring->head.store(head + 1, std::memory_order_release);
+
+    // If the session was stopped meanwhile, its final drain might have missed the message. Pairs
+    // with the fence in stopAsyncUnlocked(): either the drain sees the message or this thread sees
+    // the new generation.
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (generation_.load(std::memory_order_relaxed) != generation)
+    {
+      drainStopped(*ring);
+    }
+    return true;
+  }
+
 private:
+  // Rate limit state of a single source location
+  struct Site
+  {
+    double tokens;
+    std::chrono::steady_clock::time_point last_refill;
+    LogLevel level;
+    size_t suppressed;
+  };
+
+  std::shared_ptr<LogRing> registerRing(const uint64_t generation)
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    auto ring = std::make_shared<LogRing>(ring_size_, generation);
+    rings_.push_back(ring);
+    return ring;
+  }
+
+  void stopAsyncUnlocked()
+  {
+    if (generation_.load(std::memory_order_relaxed) % 2 == 0)
+    {
+      return;
+    }
+
+    // Switch back to synchronous logging first, so threads logging from now on don't use their ring
+    generation_++;
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    async_ = false;
+    async_thread_.join();
+
+    // Threads which decided to log asynchronously before the switch may still have written into
+    // their rings after the logging thread's last pass
+    processBuffered();
+    report();
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    rings_.clear();
+    sites_.clear();
+  }
+
+  // Passes the messages a thread wrote into its ring after the session stopped directly to the log
+  // handler. Deduplication and rate limiting belong to the session, so they are skipped.
+  void drainStopped(LogRing& ring)
+  {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    const uint64_t head = ring.head.load(std::memory_order_acquire);
+    for (uint64_t i = ring.tail.load(std::memory_order_relaxed); i < head; ++i)
+    {
+      const LogEntry& entry = ring.entries[i % ring.entries.size()];
+      emit(entry.file, entry.line, entry.level, entry.text);
+      ring.tail.store(i + 1, std::memory_order_release);
+    }
+  }
+
+  void runAsync()
+  {
+    // The thread inherits the scheduling of the thread starting it, which might be a real-time one
+    sched_param params = {};
+    pthread_setschedparam(pthread_self(), SCHED_OTHER, &params);
+    setpriority(PRIO_PROCESS, static_cast<id_t>(syscall(SYS_gettid)), ASYNC_NICE_VALUE);
+
+    auto last_report = std::chrono::steady_clock::now();
+    while (async_)
+    {
+      const size_t processed = processBuffered();
+      const auto now = std::chrono::steady_clock::now();
+      if (now - last_report >= ASYNC_REPORT_INTERVAL)
+      {
+        report();
+        last_report = now;
+      }
+      if (processed == 0)
+      {
+        std::this_thread::sleep_for(ASYNC_POLL_INTERVAL);
+      }
+    }
+    processBuffered();
+    report();
+  }
+
+  // Processes the messages of all rings, returns the number of messages processed
+  size_t processBuffered()
+  {
+    size_t processed = 0;
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    for (auto it = rings_.begin(); it != rings_.end();)
+    {
+      LogRing& ring = **it;
+      const uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+      const uint64_t head = ring.head.load(std::memory_order_acquire);
+      for (uint64_t i = tail; i < head; ++i)
+      {
+        process(ring.entries[i % ring.entries.size()]);
+        ring.tail.store(i + 1, std::memory_order_release);
+      }
+      processed += head - tail;
+      dropped_ += ring.dropped.exchange(0, std::memory_order_relaxed);
+
+      // Rings of threads that ended are removed once they are empty
+      if (it->use_count() == 1 && ring.head.load(std::memory_order_acquire) == head)
+      {
+        it = rings_.erase(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+    return processed;
+  }
+
+  void process(const LogEntry& entry)
+  {
+    if (has_last_ && entry.file == last_file_ && entry.line == last_line_ && entry.level == last_level_ &&
+        last_text_ == entry.text)
+    {
+      num_repeated_++;
+      return;
+    }
+    reportRepeated();
+
+    if (max_messages_per_second_ > 0)
+    {
+      const auto now = std::chrono::steady_clock::now();
+      auto inserted = sites_.emplace(std::make_pair(entry.file, entry.line),
+                                     Site{ static_cast<double>(max_messages_per_second_), now, entry.level, 0 });
+      Site& site = inserted.first->second;
+      const double elapsed = std::chrono::duration<double>(now - site.last_refill).count();
+      site.tokens = std::min(static_cast<double>(max_messages_per_second_),
+                             site.tokens + elapsed * static_cast<double>(max_messages_per_second_));
+      site.last_refill = now;
+      if (site.tokens < 1.0)
+      {
+        site.suppressed++;
+        return;
+      }
+      site.tokens -= 1.0;
+    }
+
+    emit(entry.file, entry.line, entry.level, entry.text);
+    has_last_ = true;
+    last_file_ = entry.file;
+    last_line_ = entry.line;
+    last_level_ = entry.level;
+    last_text_ = entry.text;
+  }
+
+  void reportRepeated()
+  {
+    if (num_repeated_ > 0)
+    {
+      char buffer[128];
+      std::snprintf(buffer, sizeof(buffer), "Last message repeated %zu times", num_repeated_);
+      emit(last_file_, last_line_, last_level_, buffer);
+      num_repeated_ = 0;
+    }
+  }
+
+  void report()
+  {
+    reportRepeated();
+    has_last_ = false;
+
+    char buffer[128];
+    for (auto& site : sites_)
+    {
+      if (site.second.suppressed > 0)
+      {
+        std::snprintf(buffer, sizeof(buffer), "Suppressed %zu messages exceeding the rate limit", site.second.suppressed);
+        emit(site.first.first, site.first.second, site.second.level, buffer);
+        site.second.suppressed = 0;
+      }
+    }
+    if (dropped_ > 0)
+    {
+      std::snprintf(buffer, sizeof(buffer), "Dropped %zu log messages, as the log buffer was full", dropped_);
+      emit(__FILE__, __LINE__, LogLevel::WARN, buffer);
+      dropped_ = 0;
+    }
+  }
+
+  void emit(const char* file, int line, LogLevel level, const char* txt)
+  {
+    std::lock_guard<std::mutex> lock(handler_mutex_);
+    log(file, line, level, txt);
+  }
+
   std::unique_ptr<LogHandler> log_handler_;
+  std::mutex handler_mutex_;
   LogLevel log_level_;
+
+  // Whether the logging thread keeps running
+  std::atomic<bool> async_;
+  // Counts starts and stops of asynchronous logging, odd while it is active. Threads register a
+  // new ring for each asynchronous logging session.
+  std::atomic<uint64_t> generation_;
+  // Guarded by rings_mutex_
+  size_t ring_size_;
+  size_t max_messages_per_second_;
+  std::mutex async_mutex_;
+  std::thread async_thread_;
+
+  std::mutex rings_mutex_;
+  std::vector<std::shared_ptr<LogRing>> rings_;
+
+  // State of the logging thread for deduplication and rate limiting
+  bool has_last_ = false;
+  const char* last_file_ = nullptr;
+  int last_line_ = 0;
+  LogLevel last_level_ = LogLevel::INFO;
+  std::string last_text_;
+  size_t num_repeated_ = 0;
+  std::map<std::pair<const char*, int>, Site> sites_;
+  size_t dropped_ = 0;
 };
 Logger g_logger;
 
@@ -103,32 +432,50 @@ void setLogLevel(LogLevel level)
   g_logger.setLogLevel(level);
 }
 
+void startAsyncLogging(const size_t messages_per_thread, const size_t max_messages_per_second)
+{
+  g_logger.startAsync(messages_per_thread, max_messages_per_second);
+}
+
+void stopAsyncLogging()
+{
+  g_logger.stopAsync();
+}
+
 void log(const char* file, int line, LogLevel level, const char* fmt, ...)
 {
   if (level >= g_logger.getLogLevel())
   {
-    size_t buffer_size = 1024;
-    std::unique_ptr<char[]> buffer;
-    buffer.reset(new char[buffer_size]);
-
     va_list args;
     va_start(args, fmt);
+
+    if (g_logger.logAsync(file, line, level, fmt, args))
+    {
+      va_end(args);
+      return;
+    }
+
     va_list args_copy;
     va_copy(args_copy, args);
 
-    size_t characters = 1 + std::vsnprintf(buffer.get(), buffer_size, fmt, args);
+    // Most messages fit into the buffer on the stack, so only long messages allocate memory
+    char stack_buffer[MESSAGE_BUFFER_SIZE];
+    std::unique_ptr<char[]> heap_buffer;
+    char* buffer = stack_buffer;
+
+    size_t characters = 1 + std::vsnprintf(buffer, MESSAGE_BUFFER_SIZE, fmt, args);
 
-    if (characters >= buffer_size)
+    if (characters >= MESSAGE_BUFFER_SIZE)
     {
-      buffer_size = characters + 1;
-      buffer.reset(new char[buffer_size]);
-      std::vsnprintf(buffer.get(), buffer_size, fmt, args_copy);
+      heap_buffer.reset(new char[characters + 1]);
+      buffer = heap_buffer.get();
+      std::vsnprintf(buffer, characters + 1, fmt, args_copy);
     }
 
     va_end(args);
     va_end(args_copy);
 
-    g_logger.log(file, line, level, buffer.get());
+    g_logger.log(file, line, level, buffer);
   }
 }
 
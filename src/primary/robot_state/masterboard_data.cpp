@@ -0,0 +1,117 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/primary/robot_state/masterboard_data.h"
+#include "ur_client_library/primary/abstract_primary_consumer.h"
+
+#include <sstream>
+
+namespace urcl
+{
+namespace primary_interface
+{
+bool MasterboardData::parseWith(comm::BinParser& bp)
+{
+  bp.parse(digital_input_bits_);
+  bp.parse(digital_output_bits_);
+  bp.parse(analog_input_range0_);
+  bp.parse(analog_input_range1_);
+  bp.parse(analog_input0_);
+  bp.parse(analog_input1_);
+  bp.parse(analog_output_domain0_);
+  bp.parse(analog_output_domain1_);
+  bp.parse(analog_output0_);
+  bp.parse(analog_output1_);
+  bp.parse(masterboard_temperature_);
+  bp.parse(robot_voltage_48v_);
+  bp.parse(robot_current_);
+  bp.parse(master_io_current_);
+  bp.parse(safety_mode_);
+  bp.parse(in_reduced_mode_);
+  bp.parse(euromap67_interface_installed_);
+  if (euromap67_interface_installed_)
+  {
+    bp.parse(euromap_input_bits_);
+    bp.parse(euromap_output_bits_);
+    bp.parse(euromap_voltage_24v_);
+    bp.parse(euromap_current_);
+  }
+
+  // The following fields were added in later software versions and are preceded by a field for
+  // internal use.
+  if (bp.checkSize(sizeof(uint32_t) + 2 * sizeof(uint8_t)))
+  {
+    bp.consume(sizeof(uint32_t));
+    bp.parse(operational_mode_selector_input_);
+    bp.parse(three_position_enabling_device_input_);
+  }
+  bp.consume();
+  return true;
+}
+
+bool MasterboardData::consumeWith(AbstractPrimaryConsumer& consumer)
+{
+  return consumer.consume(*this);
+}
+
+std::string MasterboardData::toString() const
+{
+  std::stringstream os;
+  os << "digital_input_bits: " << digital_input_bits_ << std::endl;
+  os << "digital_output_bits: " << digital_output_bits_ << std::endl;
+  os << "analog_input_range0: " << static_cast<int>(analog_input_range0_) << std::endl;
+  os << "analog_input_range1: " << static_cast<int>(analog_input_range1_) << std::endl;
+  os << "analog_input0: " << analog_input0_ << std::endl;
+  os << "analog_input1: " << analog_input1_ << std::endl;
+  os << "analog_output_domain0: " << static_cast<int>(analog_output_domain0_) << std::endl;
+  os << "analog_output_domain1: " << static_cast<int>(analog_output_domain1_) << std::endl;
+  os << "analog_output0: " << analog_output0_ << std::endl;
+  os << "analog_output1: " << analog_output1_ << std::endl;
+  os << "masterboard_temperature: " << masterboard_temperature_ << std::endl;
+  os << "robot_voltage_48v: " << robot_voltage_48v_ << std::endl;
+  os << "robot_current: " << robot_current_ << std::endl;
+  os << "master_io_current: " << master_io_current_ << std::endl;
+  os << "safety_mode: " << static_cast<int>(safety_mode_) << std::endl;
+  os << "in_reduced_mode: " << in_reduced_mode_ << std::endl;
+  os << "euromap67_interface_installed: " << euromap67_interface_installed_ << std::endl;
+  if (euromap67_interface_installed_)
+  {
+    os << "euromap_input_bits: " << euromap_input_bits_ << std::endl;
+    os << "euromap_output_bits: " << euromap_output_bits_ << std::endl;
+    os << "euromap_voltage_24v: " << euromap_voltage_24v_ << std::endl;
+    os << "euromap_current: " << euromap_current_ << std::endl;
+  }
+  os << "operational_mode_selector_input: " << static_cast<int>(operational_mode_selector_input_) << std::endl;
+  os << "three_position_enabling_device_input: " << static_cast<int>(three_position_enabling_device_input_)
+     << std::endl;
+  return os.str();
+}
+}  // namespace primary_interface
+}  // namespace urcl
@@ -0,0 +1,84 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/primary/robot_state/robot_mode_data.h"
+#include "ur_client_library/primary/abstract_primary_consumer.h"
+
+#include <sstream>
+
+namespace urcl
+{
+namespace primary_interface
+{
+bool RobotModeData::parseWith(comm::BinParser& bp)
+{
+  bp.parse(timestamp_);
+  bp.parse(is_real_robot_connected_);
+  bp.parse(is_real_robot_enabled_);
+  bp.parse(is_robot_power_on_);
+  bp.parse(is_emergency_stopped_);
+  bp.parse(is_protective_stopped_);
+  bp.parse(is_program_running_);
+  bp.parse(is_program_paused_);
+  bp.parse(robot_mode_);
+  bp.parse(control_mode_);
+  bp.parse(target_speed_fraction_);
+  bp.parse(speed_scaling_);
+  bp.parse(target_speed_fraction_limit_);
+  // Newer software versions append fields for internal use.
+  bp.consume();
+  return true;
+}
+
+bool RobotModeData::consumeWith(AbstractPrimaryConsumer& consumer)
+{
+  return consumer.consume(*this);
+}
+
+std::string RobotModeData::toString() const
+{
+  std::stringstream os;
+  os << "timestamp: " << timestamp_ << std::endl;
+  os << "is_real_robot_connected: " << is_real_robot_connected_ << std::endl;
+  os << "is_real_robot_enabled: " << is_real_robot_enabled_ << std::endl;
+  os << "is_robot_power_on: " << is_robot_power_on_ << std::endl;
+  os << "is_emergency_stopped: " << is_emergency_stopped_ << std::endl;
+  os << "is_protective_stopped: " << is_protective_stopped_ << std::endl;
+  os << "is_program_running: " << is_program_running_ << std::endl;
+  os << "is_program_paused: " << is_program_paused_ << std::endl;
+  os << "robot_mode: " << static_cast<int>(robot_mode_) << std::endl;
+  os << "control_mode: " << static_cast<int>(control_mode_) << std::endl;
+  os << "target_speed_fraction: " << target_speed_fraction_ << std::endl;
+  os << "speed_scaling: " << speed_scaling_ << std::endl;
+  os << "target_speed_fraction_limit: " << target_speed_fraction_limit_ << std::endl;
+  return os.str();
+}
+}  // namespace primary_interface
+}  // namespace urcl
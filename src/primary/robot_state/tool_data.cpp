@@ -0,0 +1,74 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/primary/robot_state/tool_data.h"
+#include "ur_client_library/primary/abstract_primary_consumer.h"
+
+#include <sstream>
+
+namespace urcl
+{
+namespace primary_interface
+{
+bool ToolData::parseWith(comm::BinParser& bp)
+{
+  bp.parse(analog_input_range2_);
+  bp.parse(analog_input_range3_);
+  bp.parse(analog_input2_);
+  bp.parse(analog_input3_);
+  bp.parse(tool_voltage_48v_);
+  bp.parse(tool_output_voltage_);
+  bp.parse(tool_current_);
+  bp.parse(tool_temperature_);
+  bp.parse(tool_mode_);
+  return true;
+}
+
+bool ToolData::consumeWith(AbstractPrimaryConsumer& consumer)
+{
+  return consumer.consume(*this);
+}
+
+std::string ToolData::toString() const
+{
+  std::stringstream os;
+  os << "analog_input_range2: " << static_cast<int>(analog_input_range2_) << std::endl;
+  os << "analog_input_range3: " << static_cast<int>(analog_input_range3_) << std::endl;
+  os << "analog_input2: " << analog_input2_ << std::endl;
+  os << "analog_input3: " << analog_input3_ << std::endl;
+  os << "tool_voltage_48v: " << tool_voltage_48v_ << std::endl;
+  os << "tool_output_voltage: " << static_cast<int>(tool_output_voltage_) << std::endl;
+  os << "tool_current: " << tool_current_ << std::endl;
+  os << "tool_temperature: " << tool_temperature_ << std::endl;
+  os << "tool_mode: " << static_cast<int>(tool_mode_) << std::endl;
+  return os.str();
+}
+}  // namespace primary_interface
+}  // namespace urcl
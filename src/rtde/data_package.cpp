@@ -28,11 +28,28 @@
 
 #include "ur_client_library/rtde/data_package.h"
 
+#include <algorithm>
 #include <functional>
 namespace urcl
 {
 namespace rtde_interface
 {
+namespace
+{
+// Size of the single values making up a field's type
+template <typename T>
+struct ValueSize
+{
+  static constexpr size_t value = sizeof(T);
+};
+
+template <typename T, size_t N>
+struct ValueSize<std::array<T, N>>
+{
+  static constexpr size_t value = sizeof(T);
+};
+}  // namespace
+
 std::unordered_map<std::string, DataPackage::_rtde_type_variant> DataPackage::g_type_list{
   { "timestamp", double() },
   { "target_q", vector6d_t() },
@@ -567,35 +584,88 @@ std::unordered_map<std::string, DataPackage::_rtde_type_variant> DataPackage::g_
   { "tcp_offset", vector6d_t() },
 };
 
-void rtde_interface::DataPackage::initEmpty()
+DataPackage::RecipeLayout::RecipeLayout(const std::vector<std::string>& recipe)
+  : RecipeLayout(recipe, nullptr, nullptr)
 {
-  for (auto& item : recipe_)
+}
+
+DataPackage::RecipeLayout::RecipeLayout(const std::vector<std::string>& recipe, ParseFunction parse_function,
+                                        SerializeFunction serialize_function)
+  : storage_size_(0), complete_(true), parse_function_(parse_function), serialize_function_(serialize_function)
+{
+  fields_.reserve(recipe.size());
+  for (auto& item : recipe)
   {
-    if (g_type_list.find(item) != g_type_list.end())
+    Field field{ item, storage_size_, nullptr };
+    auto it = g_type_list.find(item);
+    // Only trivially copyable types can be stored inside the flat data buffer
+    const bool storable =
+        it != g_type_list.end() &&
+        std::visit([](auto&& arg) -> bool { return std::is_trivially_copyable<std::decay_t<decltype(arg)>>::value; },
+                   it->second);
+    if (storable)
+    {
+      field.type = &it->second;
+      const size_t size = std::visit([](auto&& arg) -> size_t { return sizeof(arg); }, it->second);
+      const size_t value_size = std::visit(
+          [](auto&& arg) -> size_t { return ValueSize<std::decay_t<decltype(arg)>>::value; }, it->second);
+      const bool is_bool = std::holds_alternative<bool>(it->second);
+      if (!runs_.empty() && runs_.back().value_size == value_size && runs_.back().is_bool == is_bool)
+      {
+        runs_.back().count += size / value_size;
+      }
+      else
+      {
+        runs_.push_back(Run{ storage_size_, value_size, size / value_size, is_bool });
+      }
+      storage_size_ += size;
+    }
+    else
     {
-      _rtde_type_variant entry = g_type_list[item];
-      data_[item] = entry;
+      complete_ = false;
     }
+    indices_[item] = fields_.size();
+    fields_.push_back(field);
   }
 }
 
+void rtde_interface::DataPackage::initEmpty()
+{
+  std::fill(data_.begin(), data_.end(), 0);
+}
+
 bool rtde_interface::DataPackage::parseWith(comm::BinParser& bp)
 {
   if (protocol_version_ == 2)
   {
     bp.parse(recipe_id_);
   }
-  for (auto& item : recipe_)
+  if (layout_->getParseFunction() != nullptr)
+  {
+    layout_->getParseFunction()(bp, data_.data());
+    return true;
+  }
+  if (!layout_->isComplete())
   {
-    if (g_type_list.find(item) != g_type_list.end())
+    return false;
+  }
+  // Fields are stored in the same order and with the same sizes as they are transmitted, so each
+  // run of same sized values only needs to be converted from network encoding.
+  for (auto& run : layout_->getRuns())
+  {
+    uint8_t* target = data_.data() + run.offset;
+    if (run.is_bool)
     {
-      _rtde_type_variant entry = g_type_list[item];
-      std::visit([&bp](auto&& arg) { bp.parse(arg); }, entry);
-      data_[item] = entry;
+      for (size_t i = 0; i < run.count; ++i)
+      {
+        bool val;
+        bp.parse(val);
+        std::memcpy(target + i, &val, sizeof(val));
+      }
     }
     else
     {
-      return false;
+      bp.parseArray(target, run.value_size, run.count);
     }
   }
   return true;
@@ -604,31 +674,59 @@ bool rtde_interface::DataPackage::parseWith(comm::BinParser& bp)
 std::string rtde_interface::DataPackage::toString() const
 {
   std::stringstream ss;
-  for (auto& item : data_)
+  for (auto& field : layout_->getFields())
   {
-    ss << item.first << ": ";
-    std::visit([&ss](auto&& arg) { ss << arg; }, item.second);
+    if (field.type == nullptr)
+    {
+      continue;
+    }
+    const uint8_t* source = data_.data() + field.offset;
+    ss << field.name << ": ";
+    std::visit(
+        [&ss, source](auto&& arg) {
+          using T = std::decay_t<decltype(arg)>;
+          if constexpr (std::is_trivially_copyable<T>::value)
+          {
+            T val;
+            std::memcpy(&val, source, sizeof(T));
+            ss << val;
+          }
+        },
+        *field.type);
     ss << std::endl;
   }
   return ss.str();
 }
 
-size_t rtde_interface::DataPackage::serializePackage(uint8_t* buffer)
+size_t rtde_interface::DataPackage::serializePackage(uint8_t* buffer) const
 {
-  uint16_t payload_size = sizeof(recipe_id_);
-
-  for (auto& item : data_)
-  {
-    payload_size += std::visit([](auto&& arg) -> uint16_t { return sizeof(arg); }, item.second);
-  }
+  uint16_t payload_size = sizeof(recipe_id_) + layout_->getStorageSize();
   size_t size = 0;
   size += PackageHeader::serializeHeader(buffer, PackageType::RTDE_DATA_PACKAGE, payload_size);
   size += comm::PackageSerializer::serialize(buffer + size, recipe_id_);
-  for (auto& item : recipe_)
+  if (layout_->getSerializeFunction() != nullptr)
   {
+    return size + layout_->getSerializeFunction()(data_.data(), buffer + size);
+  }
+  for (auto& field : layout_->getFields())
+  {
+    if (field.type == nullptr)
+    {
+      continue;
+    }
+    const uint8_t* source = data_.data() + field.offset;
     size += std::visit(
-        [&buffer, &size](auto&& arg) -> size_t { return comm::PackageSerializer::serialize(buffer + size, arg); },
-        data_[item]);
+        [&buffer, &size, source](auto&& arg) -> size_t {
+          using T = std::decay_t<decltype(arg)>;
+          if constexpr (std::is_trivially_copyable<T>::value)
+          {
+            T val;
+            std::memcpy(&val, source, sizeof(T));
+            return comm::PackageSerializer::serialize(buffer + size, val);
+          }
+          return 0;
+        },
+        *field.type);
   }
 
   return size;
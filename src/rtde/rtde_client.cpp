@@ -29,44 +29,73 @@
 #include "ur_client_library/rtde/rtde_client.h"
 #include "ur_client_library/exceptions.h"
 #include <algorithm>
+#include <cmath>
 
 namespace urcl
 {
 namespace rtde_interface
 {
 RTDEClient::RTDEClient(std::string robot_ip, comm::INotifier& notifier, const std::string& output_recipe_file,
-                       const std::string& input_recipe_file, double target_frequency)
-  : stream_(robot_ip, UR_RTDE_PORT)
+                       const std::string& input_recipe_file, double target_frequency,
+                       const comm::PipelineTransport transport, const int port)
+  : stream_(robot_ip, port)
   , output_recipe_(ensureTimestampIsPresent(readRecipe(output_recipe_file)))
   , input_recipe_(readRecipe(input_recipe_file))
   , parser_(output_recipe_)
   , prod_(stream_, parser_)
-  , pipeline_(prod_, PIPELINE_NAME, notifier, true)
+  , pipeline_(prod_, PIPELINE_NAME, notifier, true, transport)
   , writer_(&stream_, input_recipe_)
   , max_frequency_(URE_MAX_FREQUENCY)
   , target_frequency_(target_frequency)
   , client_state_(ClientState::UNINITIALIZED)
 {
+  setupPackageHandling();
 }
 
 RTDEClient::RTDEClient(std::string robot_ip, comm::INotifier& notifier, const std::vector<std::string>& output_recipe,
-                       const std::vector<std::string>& input_recipe, double target_frequency)
-  : stream_(robot_ip, UR_RTDE_PORT)
+                       const std::vector<std::string>& input_recipe, double target_frequency,
+                       const comm::PipelineTransport transport, const int port)
+  : stream_(robot_ip, port)
   , output_recipe_(ensureTimestampIsPresent(output_recipe))
   , input_recipe_(input_recipe)
   , parser_(output_recipe_)
   , prod_(stream_, parser_)
-  , pipeline_(prod_, PIPELINE_NAME, notifier, true)
+  , pipeline_(prod_, PIPELINE_NAME, notifier, true, transport)
   , writer_(&stream_, input_recipe_)
   , max_frequency_(URE_MAX_FREQUENCY)
   , target_frequency_(target_frequency)
   , client_state_(ClientState::UNINITIALIZED)
 {
+  setupPackageHandling();
+}
+
+RTDEClient::RTDEClient(std::string robot_ip, comm::INotifier& notifier,
+                       std::shared_ptr<const DataPackage::RecipeLayout> output_layout,
+                       std::shared_ptr<const DataPackage::RecipeLayout> input_layout, double target_frequency,
+                       const comm::PipelineTransport transport, const int port)
+  : stream_(robot_ip, port)
+  , output_recipe_(output_layout->getRecipe())
+  , input_recipe_(input_layout->getRecipe())
+  , parser_(output_layout)
+  , prod_(stream_, parser_)
+  , pipeline_(prod_, PIPELINE_NAME, notifier, true, transport)
+  , writer_(&stream_, input_layout)
+  , max_frequency_(URE_MAX_FREQUENCY)
+  , target_frequency_(target_frequency)
+  , client_state_(ClientState::UNINITIALIZED)
+{
+  // The layout cannot be extended, as its fields are fixed at compile time.
+  if (output_layout->findField("timestamp") == nullptr)
+  {
+    throw UrException("The output recipe has to contain the timestamp field.");
+  }
+  setupPackageHandling();
 }
 
 RTDEClient::~RTDEClient()
 {
   disconnect();
+  stopRecording();
 }
 
 bool RTDEClient::init(const size_t max_num_tries, const std::chrono::milliseconds reconnection_time)
@@ -174,7 +203,7 @@ bool RTDEClient::negotiateProtocolVersion(const uint16_t protocol_version)
   while (num_retries < MAX_REQUEST_RETRIES)
   {
     std::unique_ptr<RTDEPackage> package;
-    if (!pipeline_.getLatestProduct(package, std::chrono::milliseconds(1000)))
+    if (!getControlPackage(package, std::chrono::milliseconds(1000)))
     {
       URCL_LOG_ERROR("failed to get package from rtde interface, disconnecting");
       disconnect();
@@ -220,7 +249,7 @@ void RTDEClient::queryURControlVersion()
   std::unique_ptr<RTDEPackage> package;
   while (num_retries < MAX_REQUEST_RETRIES)
   {
-    if (!pipeline_.getLatestProduct(package, std::chrono::milliseconds(1000)))
+    if (!getControlPackage(package, std::chrono::milliseconds(1000)))
     {
       URCL_LOG_ERROR("No answer to urcontrol version query was received from robot, disconnecting");
       disconnect();
@@ -281,7 +310,7 @@ void RTDEClient::setupOutputs(const uint16_t protocol_version)
   while (num_retries < MAX_REQUEST_RETRIES)
   {
     std::unique_ptr<RTDEPackage> package;
-    if (!pipeline_.getLatestProduct(package, std::chrono::milliseconds(1000)))
+    if (!getControlPackage(package, std::chrono::milliseconds(1000)))
     {
       URCL_LOG_ERROR("Did not receive confirmation on RTDE output recipe, disconnecting");
       disconnect();
@@ -339,7 +368,7 @@ void RTDEClient::setupInputs()
   while (num_retries < MAX_REQUEST_RETRIES)
   {
     std::unique_ptr<RTDEPackage> package;
-    if (!pipeline_.getLatestProduct(package, std::chrono::milliseconds(1000)))
+    if (!getControlPackage(package, std::chrono::milliseconds(1000)))
     {
       URCL_LOG_ERROR("Did not receive confirmation on RTDE input recipe, disconnecting");
       disconnect();
@@ -451,6 +480,8 @@ bool RTDEClient::start()
     return false;
   }
 
+  wake_up_scheduler_.reset(std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::duration<double>(1.0 / target_frequency_)));
   pipeline_.run();
 
   if (sendStart())
@@ -464,6 +495,50 @@ bool RTDEClient::start()
   }
 }
 
+bool RTDEClient::enableStateHistory(const std::chrono::duration<double> duration)
+{
+  // The history is filled by the producer thread, which must not be running while it is replaced
+  if (client_state_ != ClientState::INITIALIZED)
+  {
+    URCL_LOG_ERROR("The state history can only be enabled after initializing and before starting the client");
+    return false;
+  }
+
+  const size_t capacity = std::max<size_t>(2, static_cast<size_t>(std::ceil(duration.count() * target_frequency_)));
+  state_history_ = std::make_shared<StateHistory>(parser_.getRecipeLayout(), capacity);
+  return true;
+}
+
+bool RTDEClient::startRecording(const std::string& filename)
+{
+  stopRecording();
+  try
+  {
+    recorder_ = new RTDERecorder(filename, parser_.getRecipeLayout());
+  }
+  catch (const UrException& e)
+  {
+    URCL_LOG_ERROR("Could not start RTDE recording: %s", e.what());
+    return false;
+  }
+  return true;
+}
+
+void RTDEClient::stopRecording()
+{
+  RTDERecorder* recorder = recorder_.exchange(nullptr);
+  if (recorder == nullptr)
+  {
+    return;
+  }
+  // The producer thread might still be recording a package it got the recorder for before
+  while (recording_busy_)
+  {
+    std::this_thread::yield();
+  }
+  delete recorder;
+}
+
 bool RTDEClient::pause()
 {
   if (client_state_ == ClientState::PAUSED)
@@ -501,7 +576,7 @@ bool RTDEClient::sendStart()
   unsigned int num_retries = 0;
   while (num_retries < MAX_REQUEST_RETRIES)
   {
-    if (!pipeline_.getLatestProduct(package, std::chrono::milliseconds(1000)))
+    if (!getControlPackage(package, std::chrono::milliseconds(1000)))
     {
       URCL_LOG_ERROR("Could not get response to RTDE communication start request from robot");
       return false;
@@ -543,7 +618,7 @@ bool RTDEClient::sendPause()
   int seconds = 5;
   while (std::chrono::steady_clock::now() - start < std::chrono::seconds(seconds))
   {
-    if (!pipeline_.getLatestProduct(package, std::chrono::milliseconds(1000)))
+    if (!getControlPackage(package, std::chrono::milliseconds(1000)))
     {
       URCL_LOG_ERROR("Could not get response to RTDE communication pause request from robot");
       return false;
@@ -617,11 +692,126 @@ std::unique_ptr<rtde_interface::DataPackage> RTDEClient::getDataPackage(std::chr
   return std::unique_ptr<rtde_interface::DataPackage>(nullptr);
 }
 
+bool RTDEClient::getDataPackage(std::unique_ptr<rtde_interface::DataPackage>& data_package,
+                                std::chrono::milliseconds timeout)
+{
+  // The spare package is handed back to the pipeline when fetching the new one
+  if (!pipeline_.getLatestProduct(spare_package_, timeout))
+  {
+    return false;
+  }
+
+  rtde_interface::DataPackage* tmp = dynamic_cast<rtde_interface::DataPackage*>(spare_package_.get());
+  if (tmp == nullptr)
+  {
+    // The caller keeps its package, the fetched one is handed back with the next fetch
+    return false;
+  }
+
+  // The caller's previous package becomes the spare one
+  spare_package_.release();
+  spare_package_ = std::move(data_package);
+  data_package.reset(tmp);
+  return true;
+}
+
+bool RTDEClient::waitForDataPackage(std::unique_ptr<rtde_interface::DataPackage>& data_package,
+                                    std::chrono::milliseconds timeout)
+{
+  // A package that arrived while the caller was busy is returned right away.
+  if (getDataPackage(data_package, std::chrono::milliseconds(0)))
+  {
+    return true;
+  }
+  if (wake_up_scheduler_.waitForNextArrival(
+          [&]() { return getDataPackage(data_package, std::chrono::milliseconds(0)); }))
+  {
+    return true;
+  }
+  return getDataPackage(data_package, timeout);
+}
+
 std::string RTDEClient::getIP() const
 {
   return stream_.getIP();
 }
 
+bool RTDEClient::getControlPackage(std::unique_ptr<RTDEPackage>& package, std::chrono::milliseconds timeout)
+{
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  while (true)
+  {
+    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    if (!pipeline_.getQueuedProduct(package, std::max(remaining, std::chrono::milliseconds(0))))
+    {
+      return false;
+    }
+    // When all packages are queued, data packages and text messages received before the answer are
+    // skipped. Text messages have been logged when they were received.
+    if (dynamic_cast<rtde_interface::DataPackage*>(package.get()) == nullptr &&
+        dynamic_cast<rtde_interface::TextMessage*>(package.get()) == nullptr)
+    {
+      return true;
+    }
+  }
+}
+
+void RTDEClient::setupPackageHandling()
+{
+  timestamp_handle_ = parser_.getRecipeLayout()->getFieldHandle<double>("timestamp");
+  pipeline_.setProducedCallback(std::bind(&RTDEClient::handleProducedPackage, this, std::placeholders::_1));
+  // Answers to requests must not be overwritten by data packages when only the latest value is kept.
+  // Text messages are only logged, as nobody fetches them from the queue while data packages are
+  // streamed. Otherwise, they would fill up the queue and answers arriving later would be dropped.
+  pipeline_.setProductRouter([](const RTDEPackage& package) {
+    if (dynamic_cast<const DataPackage*>(&package) != nullptr)
+    {
+      return comm::ProductRoute::LATEST_VALUE;
+    }
+    if (dynamic_cast<const TextMessage*>(&package) != nullptr)
+    {
+      return comm::ProductRoute::DISCARD;
+    }
+    return comm::ProductRoute::QUEUE;
+  });
+}
+
+void RTDEClient::handleProducedPackage(const RTDEPackage& package)
+{
+  const DataPackage* data_package = dynamic_cast<const DataPackage*>(&package);
+  if (data_package == nullptr)
+  {
+    if (const TextMessage* text_message = dynamic_cast<const TextMessage*>(&package))
+    {
+      URCL_LOG_INFO("Text message received from the robot's RTDE interface: %s", text_message->message_.c_str());
+    }
+    return;
+  }
+
+  double timestamp;
+  if (data_package->getData(timestamp_handle_, timestamp))
+  {
+    clock_offset_estimator_.addSample(timestamp, package.getTimestamps().received);
+  }
+  wake_up_scheduler_.addArrival(package.getTimestamps().received);
+  if (state_history_ != nullptr)
+  {
+    state_history_->add(*data_package);
+  }
+  recording_busy_ = true;
+  if (RTDERecorder* recorder = recorder_.load())
+  {
+    recorder->record(*data_package);
+  }
+  recording_busy_.store(false, std::memory_order_release);
+
+  // A data package marks the beginning of a new control cycle on the robot
+  if (writer_.isSynchronous())
+  {
+    writer_.flush();
+  }
+}
+
 RTDEWriter& RTDEClient::getWriter()
 {
   return writer_;
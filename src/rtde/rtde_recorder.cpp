@@ -0,0 +1,153 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/rtde_recorder.h"
+
+#include <sstream>
+
+#include "ur_client_library/rtde/package_header.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+namespace
+{
+// How long the background thread waits before looking for new packages, if there were none
+const std::chrono::milliseconds WRITE_INTERVAL(10);
+}  // namespace
+
+RTDERecorder::RTDERecorder(const std::string& filename, std::shared_ptr<const DataPackage::RecipeLayout> layout,
+                           const size_t buffer_size)
+  : layout_(layout)
+  , writer_(filename, comm::RecordingType::RTDE, 2, recipeToMetadata(layout->getRecipe()))
+  // Package header, recipe id and all fields in their wire format
+  , slot_size_(sizeof(PackageHeader::_package_size_type) + sizeof(PackageType) + sizeof(uint8_t) +
+               layout->getStorageSize())
+  , slots_(buffer_size)
+  , buffer_(buffer_size * slot_size_)
+  , head_(0)
+  , tail_(0)
+  , num_recorded_(0)
+  , num_dropped_(0)
+  , running_(true)
+{
+  writer_thread_ = std::thread(&RTDERecorder::runWriter, this);
+}
+
+RTDERecorder::~RTDERecorder()
+{
+  running_ = false;
+  if (writer_thread_.joinable())
+  {
+    writer_thread_.join();
+  }
+}
+
+bool RTDERecorder::record(const DataPackage& package)
+{
+  if (package.getRecipeLayout().get() != layout_.get())
+  {
+    return false;
+  }
+
+  const uint64_t head = head_.load(std::memory_order_relaxed);
+  if (head - tail_.load(std::memory_order_acquire) >= slots_.size())
+  {
+    num_dropped_++;
+    return false;
+  }
+
+  const size_t index = head % slots_.size();
+  slots_[index].received = package.getTimestamps().received;
+  slots_[index].size = package.serializePackage(buffer_.data() + index * slot_size_);
+  head_.store(head + 1, std::memory_order_release);
+  return true;
+}
+
+std::string RTDERecorder::recipeToMetadata(const std::vector<std::string>& recipe)
+{
+  std::string metadata;
+  for (auto& field : recipe)
+  {
+    metadata += field + "\n";
+  }
+  return metadata;
+}
+
+std::vector<std::string> RTDERecorder::metadataToRecipe(const std::string& metadata)
+{
+  std::vector<std::string> recipe;
+  std::istringstream stream(metadata);
+  std::string field;
+  while (std::getline(stream, field))
+  {
+    if (!field.empty())
+    {
+      recipe.push_back(field);
+    }
+  }
+  return recipe;
+}
+
+void RTDERecorder::runWriter()
+{
+  while (running_)
+  {
+    if (writeBuffered() == 0)
+    {
+      std::this_thread::sleep_for(WRITE_INTERVAL);
+    }
+  }
+  writeBuffered();
+}
+
+size_t RTDERecorder::writeBuffered()
+{
+  const uint64_t tail = tail_.load(std::memory_order_relaxed);
+  const uint64_t head = head_.load(std::memory_order_acquire);
+  for (uint64_t i = tail; i < head; ++i)
+  {
+    const size_t index = i % slots_.size();
+    if (writer_.append(slots_[index].received, buffer_.data() + index * slot_size_, slots_[index].size))
+    {
+      num_recorded_++;
+    }
+    else
+    {
+      num_dropped_++;
+    }
+    tail_.store(i + 1, std::memory_order_release);
+  }
+  return static_cast<size_t>(head - tail);
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
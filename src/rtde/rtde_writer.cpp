@@ -25,7 +25,6 @@
  *
  */
 //----------------------------------------------------------------------
-
 #include "ur_client_library/rtde/rtde_writer.h"
 
 namespace urcl
@@ -33,14 +32,63 @@ namespace urcl
 namespace rtde_interface
 {
 RTDEWriter::RTDEWriter(comm::URStream<RTDEPackage>* stream, const std::vector<std::string>& recipe)
-  : stream_(stream), recipe_(recipe), queue_{ 32 }, running_(false), package_(recipe_)
+  : stream_(stream)
+  , recipe_(recipe)
+  , queue_{ QUEUE_SIZE }
+  , free_packages_{ QUEUE_SIZE }
+  , running_(false)
+  , package_(recipe_)
+  , batch_active_(false)
+  , synchronous_(false)
+  , changes_pending_(false)
+  , pending_(nullptr)
+  , snapshot_published_(false)
+  , flushing_(false)
+{
+}
+
+RTDEWriter::RTDEWriter(comm::URStream<RTDEPackage>* stream, std::shared_ptr<const DataPackage::RecipeLayout> layout)
+  : stream_(stream)
+  , recipe_(layout->getRecipe())
+  , queue_{ QUEUE_SIZE }
+  , free_packages_{ QUEUE_SIZE }
+  , running_(false)
+  , package_(layout)
+  , batch_active_(false)
+  , synchronous_(false)
+  , changes_pending_(false)
+  , pending_(nullptr)
+  , snapshot_published_(false)
+  , flushing_(false)
+{
+}
+
+RTDEWriter::PackageLock::PackageLock(RTDEWriter& writer) : writer_(writer), guard_(writer.package_mutex_)
+{
+  writer_.takeBackSnapshot();
+}
+
+RTDEWriter::PackageLock::~PackageLock()
 {
+  writer_.publishSnapshot();
 }
 
 void RTDEWriter::init(uint8_t recipe_id)
 {
   recipe_id_ = recipe_id;
   package_.initEmpty();
+  delete pending_.exchange(nullptr);
+  snapshot_published_ = false;
+  spare_.reset();
+  unsent_.reset();
+  std::unique_ptr<DataPackage> package;
+  while (free_packages_.tryDequeue(package))
+  {
+  }
+  for (size_t i = 0; i < QUEUE_SIZE; ++i)
+  {
+    free_packages_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_)));
+  }
   running_ = true;
   writer_thread_ = std::thread(&RTDEWriter::run, this);
 }
@@ -58,11 +106,180 @@ void RTDEWriter::run()
       package->setRecipeID(recipe_id_);
       size = package->serializePackage(buffer);
       stream_->write(buffer, size, written);
+      free_packages_.tryEnqueue(std::move(package));
     }
   }
   URCL_LOG_DEBUG("Write thread ended.");
 }
 
+void RTDEWriter::beginBatch()
+{
+  PackageLock lock(*this);
+  batch_active_ = true;
+}
+
+bool RTDEWriter::commit()
+{
+  PackageLock lock(*this);
+  if (!batch_active_)
+  {
+    URCL_LOG_ERROR("Cannot commit RTDE input changes, as no batch has been started.");
+    return false;
+  }
+  batch_active_ = false;
+  return publishPackage();
+}
+
+void RTDEWriter::setSynchronous(const bool synchronous)
+{
+  PackageLock lock(*this);
+  synchronous_ = synchronous;
+  if (synchronous)
+  {
+    return;
+  }
+
+  // From now on only this thread queues packages, once a flush that is still running is done
+  while (flushing_)
+  {
+    std::this_thread::yield();
+  }
+  if (unsent_ && !queue_.tryEnqueue(std::move(unsent_)))
+  {
+    unsent_.reset();
+  }
+  if (changes_pending_ && !batch_active_)
+  {
+    queuePackage();
+  }
+}
+
+bool RTDEWriter::flush()
+{
+  // Pairs with setSynchronous(), which waits for a running flush before queueing packages itself
+  flushing_ = true;
+  bool success = true;
+  while (synchronous_)
+  {
+    if (!unsent_)
+    {
+      unsent_.reset(pending_.exchange(nullptr, std::memory_order_acq_rel));
+      if (!unsent_)
+      {
+        break;
+      }
+    }
+    if (!queue_.tryEnqueue(std::move(unsent_)))
+    {
+      success = false;
+      break;
+    }
+  }
+  flushing_ = false;
+  return success;
+}
+
+bool RTDEWriter::publishPackage()
+{
+  changes_pending_ = true;
+  if (batch_active_ || synchronous_)
+  {
+    // In synchronous mode the changes get published when the PackageLock is released
+    return true;
+  }
+  return queuePackage();
+}
+
+void RTDEWriter::takeBackSnapshot()
+{
+  std::unique_ptr<DataPackage> snapshot(pending_.exchange(nullptr, std::memory_order_acq_rel));
+  if (snapshot)
+  {
+    spare_ = std::move(snapshot);
+  }
+  else if (snapshot_published_)
+  {
+    // flush() took the last copy, so its changes are on their way
+    clearMasks();
+    changes_pending_ = false;
+  }
+  snapshot_published_ = false;
+}
+
+void RTDEWriter::publishSnapshot()
+{
+  if (!synchronous_ || batch_active_ || !changes_pending_)
+  {
+    return;
+  }
+  std::unique_ptr<DataPackage> snapshot = std::move(spare_);
+  if (!snapshot && !free_packages_.tryDequeue(snapshot))
+  {
+    // The changes stay pending and are published with the next change
+    return;
+  }
+  *snapshot = package_;
+  pending_.store(snapshot.release(), std::memory_order_release);
+  snapshot_published_ = true;
+}
+
+bool RTDEWriter::queuePackage()
+{
+  std::unique_ptr<DataPackage> package;
+  if (!free_packages_.tryDequeue(package))
+  {
+    return false;
+  }
+  *package = package_;
+  if (!queue_.tryEnqueue(std::move(package)))
+  {
+    free_packages_.tryEnqueue(std::move(package));
+    return false;
+  }
+  clearMasks();
+  changes_pending_ = false;
+  return true;
+}
+
+void RTDEWriter::clearMasks()
+{
+  uint32_t speed_slider_mask = 0;
+  uint8_t mask = 0;
+  package_.setData("speed_slider_mask", speed_slider_mask);
+  package_.setData("standard_digital_output_mask", mask);
+  package_.setData("configurable_digital_output_mask", mask);
+  package_.setData("tool_digital_output_mask", mask);
+  package_.setData("standard_analog_output_mask", mask);
+}
+
+bool RTDEWriter::setMaskedBits(const std::string& mask_name, const std::string& value_name, const uint8_t bits,
+                               const bool value)
+{
+  uint8_t mask;
+  uint8_t output;
+  if (!package_.getData(mask_name, mask) || !package_.getData(value_name, output))
+  {
+    return false;
+  }
+
+  // Bits outside of the mask are ignored by the robot. Only if other bits are pending already, they
+  // have to be preserved.
+  if (mask == 0)
+  {
+    output = value ? 255 : 0;
+  }
+  else if (value)
+  {
+    output |= bits;
+  }
+  else
+  {
+    output &= ~bits;
+  }
+  mask |= bits;
+  return package_.setData(mask_name, mask) && package_.setData(value_name, output);
+}
+
 bool RTDEWriter::sendSpeedSlider(double speed_slider_fraction)
 {
   if (speed_slider_fraction > 1.0 || speed_slider_fraction < 0.0)
@@ -74,22 +291,13 @@ bool RTDEWriter::sendSpeedSlider(double speed_slider_fraction)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
+  PackageLock lock(*this);
   uint32_t mask = 1;
   bool success = true;
   success = package_.setData("speed_slider_mask", mask);
   success = success && package_.setData("speed_slider_fraction", speed_slider_fraction);
 
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
-  }
-  mask = 0;
-  success = package_.setData("speed_slider_mask", mask);
-  return success;
+  return success && publishPackage();
 }
 
 bool RTDEWriter::sendStandardDigitalOutput(uint8_t output_pin, bool value)
@@ -102,31 +310,10 @@ bool RTDEWriter::sendStandardDigitalOutput(uint8_t output_pin, bool value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint8_t mask = pinToMask(output_pin);
-  bool success = true;
-  uint8_t digital_output;
-  if (value)
-  {
-    digital_output = 255;
-  }
-  else
-  {
-    digital_output = 0;
-  }
-  success = package_.setData("standard_digital_output_mask", mask);
-  success = success && package_.setData("standard_digital_output", digital_output);
+  PackageLock lock(*this);
+  bool success = setMaskedBits("standard_digital_output_mask", "standard_digital_output", pinToMask(output_pin), value);
 
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
-  }
-  mask = 0;
-  success = package_.setData("standard_digital_output_mask", mask);
-  return success;
+  return success && publishPackage();
 }
 
 bool RTDEWriter::sendConfigurableDigitalOutput(uint8_t output_pin, bool value)
@@ -140,31 +327,11 @@ bool RTDEWriter::sendConfigurableDigitalOutput(uint8_t output_pin, bool value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint8_t mask = pinToMask(output_pin);
-  bool success = true;
-  uint8_t digital_output;
-  if (value)
-  {
-    digital_output = 255;
-  }
-  else
-  {
-    digital_output = 0;
-  }
-  success = package_.setData("configurable_digital_output_mask", mask);
-  success = success && package_.setData("configurable_digital_output", digital_output);
+  PackageLock lock(*this);
+  bool success =
+      setMaskedBits("configurable_digital_output_mask", "configurable_digital_output", pinToMask(output_pin), value);
 
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
-  }
-  mask = 0;
-  success = package_.setData("configurable_digital_output_mask", mask);
-  return success;
+  return success && publishPackage();
 }
 
 bool RTDEWriter::sendToolDigitalOutput(uint8_t output_pin, bool value)
@@ -177,31 +344,10 @@ bool RTDEWriter::sendToolDigitalOutput(uint8_t output_pin, bool value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint8_t mask = pinToMask(output_pin);
-  bool success = true;
-  uint8_t digital_output;
-  if (value)
-  {
-    digital_output = 255;
-  }
-  else
-  {
-    digital_output = 0;
-  }
-  success = package_.setData("tool_digital_output_mask", mask);
-  success = success && package_.setData("tool_digital_output", digital_output);
+  PackageLock lock(*this);
+  bool success = setMaskedBits("tool_digital_output_mask", "tool_digital_output", pinToMask(output_pin), value);
 
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
-  }
-  mask = 0;
-  success = package_.setData("tool_digital_output_mask", mask);
-  return success;
+  return success && publishPackage();
 }
 
 bool RTDEWriter::sendStandardAnalogOutput(uint8_t output_pin, double value, const AnalogOutputType type)
@@ -221,30 +367,32 @@ bool RTDEWriter::sendStandardAnalogOutput(uint8_t output_pin, double value, cons
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
-  uint8_t mask = pinToMask(output_pin);
-
-  bool success = true;
-  success = package_.setData("standard_analog_output_mask", mask);
-  if (type != AnalogOutputType::SET_ON_TEACH_PENDANT)
+  PackageLock lock(*this);
+  uint8_t mask;
+  if (!package_.getData("standard_analog_output_mask", mask))
   {
-    auto output_type_bits = [](const uint8_t pin, const uint8_t type) { return type << pin; };
-    uint8_t output_type = output_type_bits(output_pin, toUnderlying(type));
-    success = success && package_.setData("standard_analog_output_type", output_type);
+    return false;
   }
-  success = success && package_.setData("standard_analog_output_0", value);
-  success = success && package_.setData("standard_analog_output_1", value);
+  const uint8_t pin_mask = pinToMask(output_pin);
 
-  if (success)
+  bool success = true;
+  if (type != AnalogOutputType::SET_ON_TEACH_PENDANT)
   {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
+    // Keep the domain of the other pin, if it is part of the current batch
+    uint8_t output_type = 0;
+    if (mask != 0)
     {
-      return false;
+      success = package_.getData("standard_analog_output_type", output_type);
+      output_type &= ~pin_mask;
     }
+    output_type |= toUnderlying(type) << output_pin;
+    success = success && package_.setData("standard_analog_output_type", output_type);
   }
-  mask = 0;
-  success = package_.setData("standard_analog_output_mask", mask);
-  return success;
+  success = success && package_.setData("standard_analog_output_" + std::to_string(output_pin), value);
+  mask |= pin_mask;
+  success = success && package_.setData("standard_analog_output_mask", mask);
+
+  return success && publishPackage();
 }
 
 uint8_t RTDEWriter::pinToMask(uint8_t pin)
@@ -267,20 +415,13 @@ bool RTDEWriter::sendInputBitRegister(uint32_t register_id, bool value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
+  PackageLock lock(*this);
   std::stringstream ss;
   ss << "input_bit_register_" << register_id;
 
   bool success = package_.setData(ss.str(), value);
 
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
-  }
-  return success;
+  return success && publishPackage();
 }
 
 bool RTDEWriter::sendInputIntRegister(uint32_t register_id, int32_t value)
@@ -293,20 +434,13 @@ bool RTDEWriter::sendInputIntRegister(uint32_t register_id, int32_t value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
+  PackageLock lock(*this);
   std::stringstream ss;
   ss << "input_int_register_" << register_id;
 
   bool success = package_.setData(ss.str(), value);
 
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
-  }
-  return success;
+  return success && publishPackage();
 }
 
 bool RTDEWriter::sendInputDoubleRegister(uint32_t register_id, double value)
@@ -319,20 +453,13 @@ bool RTDEWriter::sendInputDoubleRegister(uint32_t register_id, double value)
     return false;
   }
 
-  std::lock_guard<std::mutex> guard(package_mutex_);
+  PackageLock lock(*this);
   std::stringstream ss;
   ss << "input_double_register_" << register_id;
 
   bool success = package_.setData(ss.str(), value);
 
-  if (success)
-  {
-    if (!queue_.tryEnqueue(std::unique_ptr<DataPackage>(new DataPackage(package_))))
-    {
-      return false;
-    }
-  }
-  return success;
+  return success && publishPackage();
 }
 
 }  // namespace rtde_interface
@@ -0,0 +1,289 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/rtde/state_history.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+namespace rtde_interface
+{
+StateHistory::StateHistory(std::shared_ptr<const DataPackage::RecipeLayout> layout, const size_t capacity)
+  : layout_(layout)
+  , capacity_(capacity)
+  , slots_(capacity + 1)
+  , timestamp_offset_(0)
+  , columns_(layout->getStorageSize() * slots_, 0)
+  , writing_(0)
+  , written_(0)
+  , first_(0)
+  , newest_timestamp_(0.0)
+{
+  if (capacity_ < 2)
+  {
+    throw UrException("The state history has to hold at least 2 samples");
+  }
+
+  const DataPackage::RecipeLayout::Field* timestamp = layout_->findField("timestamp");
+  if (timestamp == nullptr || timestamp->type == nullptr || !std::holds_alternative<double>(*timestamp->type))
+  {
+    throw UrException("The state history requires the timestamp to be part of the recipe");
+  }
+  timestamp_offset_ = timestamp->offset;
+
+  for (auto& field : layout_->getFields())
+  {
+    if (field.type == nullptr)
+    {
+      continue;
+    }
+    const size_t size = std::visit([](auto&& arg) -> size_t { return sizeof(arg); }, *field.type);
+    const bool interpolate = std::holds_alternative<double>(*field.type) ||
+                             std::holds_alternative<vector3d_t>(*field.type) ||
+                             std::holds_alternative<vector6d_t>(*field.type);
+    fields_.push_back(Column{ field.offset, size, interpolate });
+  }
+}
+
+bool StateHistory::add(const DataPackage& package)
+{
+  if (package.layout_.get() != layout_.get())
+  {
+    return false;
+  }
+
+  double timestamp;
+  std::memcpy(&timestamp, package.data_.data() + timestamp_offset_, sizeof(timestamp));
+
+  const uint64_t index = written_.load(std::memory_order_relaxed);
+  if (index > first_.load(std::memory_order_relaxed) && !(timestamp > newest_timestamp_))
+  {
+    first_.store(index, std::memory_order_release);
+  }
+
+  // Readers check this counter after copying values to find out whether the slot they copied from
+  // got overwritten in the meantime.
+  writing_.store(index + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  const size_t slot = index % slots_;
+  for (auto& field : fields_)
+  {
+    std::memcpy(columns_.data() + field.offset * slots_ + slot * field.size, package.data_.data() + field.offset,
+                field.size);
+  }
+
+  written_.store(index + 1, std::memory_order_release);
+  newest_timestamp_ = timestamp;
+  return true;
+}
+
+void StateHistory::clear()
+{
+  first_.store(written_.load(std::memory_order_relaxed), std::memory_order_release);
+}
+
+size_t StateHistory::size() const
+{
+  const uint64_t end = written_.load(std::memory_order_acquire);
+  return static_cast<size_t>(end - firstAvailable(end));
+}
+
+bool StateHistory::getTimeRange(double& oldest, double& newest) const
+{
+  while (true)
+  {
+    const uint64_t end = written_.load(std::memory_order_acquire);
+    const uint64_t first = firstAvailable(end);
+    if (first >= end)
+    {
+      return false;
+    }
+    oldest = timestampOf(first);
+    newest = timestampOf(end - 1);
+    if (isValid(first))
+    {
+      return true;
+    }
+  }
+}
+
+bool StateHistory::stateAt(const double timestamp, DataPackage& package) const
+{
+  if (package.layout_.get() != layout_.get())
+  {
+    return false;
+  }
+
+  uint8_t* data = package.data_.data();
+  while (true)
+  {
+    const uint64_t end = written_.load(std::memory_order_acquire);
+    const uint64_t first = firstAvailable(end);
+    Samples samples;
+    if (!findSamples(timestamp, first, end, samples))
+    {
+      if (isValid(first))
+      {
+        return false;
+      }
+      continue;
+    }
+
+    for (auto& field : fields_)
+    {
+      if (field.interpolate && samples.after != samples.before)
+      {
+        double before[6];
+        double after[6];
+        std::memcpy(before, value(field.offset, field.size, samples.before), field.size);
+        std::memcpy(after, value(field.offset, field.size, samples.after), field.size);
+        interpolate(before, after, field.size / sizeof(double), samples.fraction);
+        std::memcpy(data + field.offset, before, field.size);
+      }
+      else
+      {
+        std::memcpy(data + field.offset, value(field.offset, field.size, samples.before), field.size);
+      }
+    }
+
+    if (isValid(first))
+    {
+      break;
+    }
+  }
+
+  std::memcpy(data + timestamp_offset_, &timestamp, sizeof(timestamp));
+  return true;
+}
+
+double StateHistory::timestampOf(const uint64_t index) const
+{
+  double timestamp;
+  std::memcpy(&timestamp, value(timestamp_offset_, sizeof(timestamp), index), sizeof(timestamp));
+  return timestamp;
+}
+
+uint64_t StateHistory::firstAvailable(const uint64_t end) const
+{
+  const uint64_t oldest = end > capacity_ ? end - capacity_ : 0;
+  return std::max(first_.load(std::memory_order_acquire), oldest);
+}
+
+bool StateHistory::readSamples(const double timestamp, const size_t offset, const size_t size, uint8_t* before,
+                               uint8_t* after, Samples& samples) const
+{
+  while (true)
+  {
+    const uint64_t end = written_.load(std::memory_order_acquire);
+    const uint64_t first = firstAvailable(end);
+    if (!findSamples(timestamp, first, end, samples))
+    {
+      if (isValid(first))
+      {
+        return false;
+      }
+      continue;
+    }
+
+    std::memcpy(before, value(offset, size, samples.before), size);
+    if (after != nullptr)
+    {
+      std::memcpy(after, value(offset, size, samples.after), size);
+    }
+    if (isValid(first))
+    {
+      return true;
+    }
+  }
+}
+
+bool StateHistory::findSamples(const double timestamp, const uint64_t first, const uint64_t end,
+                               Samples& samples) const
+{
+  if (first >= end || timestamp < timestampOf(first))
+  {
+    return false;
+  }
+
+  const double newest = timestampOf(end - 1);
+  if (timestamp >= newest)
+  {
+    if (timestamp > newest)
+    {
+      return false;
+    }
+    samples = Samples{ end - 1, end - 1, 0.0 };
+    return true;
+  }
+
+  // The timestamps are strictly increasing, so the samples can be searched by bisection. Invariant:
+  // timestamp of lower <= timestamp < timestamp of upper
+  uint64_t lower = first;
+  uint64_t upper = end - 1;
+  while (upper - lower > 1)
+  {
+    const uint64_t middle = lower + (upper - lower) / 2;
+    if (timestampOf(middle) <= timestamp)
+    {
+      lower = middle;
+    }
+    else
+    {
+      upper = middle;
+    }
+  }
+
+  const double lower_timestamp = timestampOf(lower);
+  samples = Samples{ lower, upper, (timestamp - lower_timestamp) / (timestampOf(upper) - lower_timestamp) };
+  return true;
+}
+
+bool StateHistory::isValid(const uint64_t first) const
+{
+  std::atomic_thread_fence(std::memory_order_acquire);
+  // The sample being written last replaced the sample one full round of slots before it
+  return writing_.load(std::memory_order_relaxed) <= first + slots_;
+}
+
+void StateHistory::interpolate(double* before, const double* after, const size_t count, const double fraction)
+{
+  for (size_t i = 0; i < count; ++i)
+  {
+    before[i] += fraction * (after[i] - before[i]);
+  }
+}
+
+}  // namespace rtde_interface
+}  // namespace urcl
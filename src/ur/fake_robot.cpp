@@ -0,0 +1,1093 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/ur/fake_robot.h"
+
+#include <arpa/inet.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+
+#include <cmath>
+#include <regex>
+#include <sstream>
+
+#include "ur_client_library/comm/bin_parser.h"
+#include "ur_client_library/comm/package_serializer.h"
+#include "ur_client_library/control/reverse_interface.h"
+#include "ur_client_library/control/trajectory_point_interface.h"
+#include "ur_client_library/log.h"
+#include "ur_client_library/primary/package_header.h"
+#include "ur_client_library/primary/robot_message.h"
+#include "ur_client_library/rtde/package_header.h"
+#include "ur_client_library/rtde/rtde_client.h"
+
+namespace urcl
+{
+namespace
+{
+// Robot modes as reported through RTDE
+const int32_t ROBOT_MODE_POWER_OFF = 3;
+const int32_t ROBOT_MODE_IDLE = 5;
+const int32_t ROBOT_MODE_RUNNING = 7;
+const int32_t SAFETY_MODE_NORMAL = 1;
+
+// A freshly started controller would make RTDE clients wait for the interface to restart
+const double BOOT_TIME = 100.0;
+
+const uint8_t RECIPE_ID = 1;
+
+const size_t MAX_CONNECT_TRIES = 50;
+const std::chrono::milliseconds RECONNECTION_TIME(100);
+const std::chrono::milliseconds POLL_TIMEOUT(10);
+
+// Number of integers per message as read by external_control.urscript
+const size_t REVERSE_MESSAGE_SIZE = 8;
+const size_t TRAJECTORY_MESSAGE_SIZE = 21;
+const size_t SCRIPT_COMMAND_MESSAGE_SIZE = 26;
+
+// Small packages have to be sent right away, as the clients rely on receiving them in time
+void disableNagle(const int fd)
+{
+  int flag = 1;
+  setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(int));
+}
+
+std::string rtdeTypeName(const rtde_interface::DataPackage::_rtde_type_variant* type)
+{
+  static const char* const TYPE_NAMES[] = { "BOOL",     "UINT8",    "UINT32",       "UINT64",        "INT32", "DOUBLE",
+                                            "VECTOR3D", "VECTOR6D", "VECTOR6INT32", "VECTOR6UINT32", "STRING" };
+  static_assert(sizeof(TYPE_NAMES) / sizeof(TYPE_NAMES[0]) ==
+                    std::variant_size<rtde_interface::DataPackage::_rtde_type_variant>::value,
+                "Every RTDE type needs a name");
+  if (type == nullptr)
+  {
+    return "NOT_FOUND";
+  }
+  return TYPE_NAMES[type->index()];
+}
+
+std::vector<std::string> splitRecipe(const std::string& variables)
+{
+  std::vector<std::string> recipe;
+  std::stringstream ss(variables);
+  std::string name;
+  while (std::getline(ss, name, ','))
+  {
+    recipe.push_back(name);
+  }
+  return recipe;
+}
+
+template <typename T>
+void setField(rtde_interface::DataPackage& package, const rtde_interface::DataPackage::RecipeLayout& layout,
+              const std::string& name, T val)
+{
+  auto field = layout.findField(name);
+  if (field != nullptr && field->type != nullptr && std::holds_alternative<T>(*field->type))
+  {
+    package.setData(name, val);
+  }
+}
+
+std::string trim(const std::string& str)
+{
+  const char* whitespace = " \t\r\n";
+  size_t begin = str.find_first_not_of(whitespace);
+  if (begin == std::string::npos)
+  {
+    return "";
+  }
+  return str.substr(begin, str.find_last_not_of(whitespace) - begin + 1);
+}
+
+std::string robotModeName(const int32_t robot_mode)
+{
+  switch (robot_mode)
+  {
+    case ROBOT_MODE_POWER_OFF:
+      return "POWER_OFF";
+    case ROBOT_MODE_IDLE:
+      return "IDLE";
+    default:
+      return "RUNNING";
+  }
+}
+
+vector6d_t toVector(const int32_t* values)
+{
+  vector6d_t vec;
+  for (size_t i = 0; i < vec.size(); ++i)
+  {
+    vec[i] = static_cast<double>(values[i]) / control::ReverseInterface::MULT_JOINTSTATE;
+  }
+  return vec;
+}
+
+void decodeMessage(const uint8_t* buffer, int32_t* message, const size_t length)
+{
+  for (size_t i = 0; i < length; ++i)
+  {
+    int32_t val;
+    std::memcpy(&val, buffer + i * sizeof(int32_t), sizeof(int32_t));
+    message[i] = be32toh(val);
+  }
+}
+}  // namespace
+
+bool FakeRobot::ProgramSocket::connect(const std::string& host, const int port)
+{
+  timeval tv;
+  tv.tv_sec = 1;
+  tv.tv_usec = 0;
+  setReceiveTimeout(tv);
+  return setup(host, port, MAX_CONNECT_TRIES, RECONNECTION_TIME);
+}
+
+bool FakeRobot::ProgramSocket::readAll(uint8_t* buf, const size_t buf_len)
+{
+  size_t total = 0;
+  while (total < buf_len)
+  {
+    size_t read_bytes;
+    if (!read(buf + total, buf_len - total, read_bytes))
+    {
+      return false;
+    }
+    total += read_bytes;
+  }
+  return true;
+}
+
+FakeRobot::FakeRobot(const double frequency, const VersionInformation& version, const uint32_t script_sender_port,
+                     const FakeRobotPorts& ports)
+  : frequency_(frequency)
+  , version_(version)
+  , script_sender_port_(script_sender_port)
+  , rtde_server_(ports.rtde, 1)
+  , primary_server_(ports.primary, 1)
+  , secondary_server_(ports.secondary, 1)
+  , dashboard_server_(ports.dashboard, 1)
+  , running_(true)
+  , cycle_(0)
+  , last_sent_ns_(0)
+  , q_{ 0, -1.57, 1.57, -1.57, -1.57, 0 }
+  , qd_{}
+  , target_q_(q_)
+  , control_mode_(comm::ControlMode::MODE_STOPPED)
+  , loaded_program_("external_control.urp")
+  , robot_mode_(ROBOT_MODE_RUNNING)
+  , program_running_(false)
+  , stop_program_(false)
+{
+  if (frequency_ <= 0.0)
+  {
+    throw UrException("The frequency of a FakeRobot has to be positive");
+  }
+
+  rtde_server_.setMessageCallback(std::bind(&FakeRobot::rtdeMessageCallback, this, std::placeholders::_1,
+                                            std::placeholders::_2, std::placeholders::_3));
+  rtde_server_.setConnectCallback(&disableNagle);
+  rtde_server_.setDisconnectCallback([this](const int fd) {
+    std::lock_guard<std::mutex> lk(rtde_mutex_);
+    rtde_sessions_.erase(fd);
+  });
+
+  for (comm::TCPServer* server : { &primary_server_, &secondary_server_ })
+  {
+    server->setConnectCallback([this, server](const int fd) { primaryConnectCallback(*server, fd); });
+    server->setMessageCallback(std::bind(&FakeRobot::primaryMessageCallback, this, std::placeholders::_1,
+                                         std::placeholders::_2, std::placeholders::_3));
+    server->setDisconnectCallback([this](const int fd) {
+      std::lock_guard<std::mutex> lk(script_mutex_);
+      script_connections_.erase(fd);
+    });
+  }
+
+  dashboard_server_.setConnectCallback(std::bind(&FakeRobot::dashboardConnectCallback, this, std::placeholders::_1));
+  dashboard_server_.setMessageCallback(std::bind(&FakeRobot::dashboardMessageCallback, this, std::placeholders::_1,
+                                                 std::placeholders::_2, std::placeholders::_3));
+  dashboard_server_.setDisconnectCallback([this](const int fd) {
+    std::lock_guard<std::mutex> lk(script_mutex_);
+    dashboard_buffers_.erase(fd);
+  });
+
+  rtde_server_.start();
+  primary_server_.start();
+  secondary_server_.start();
+  dashboard_server_.start();
+  rtde_thread_ = std::thread(&FakeRobot::rtdeLoop, this);
+}
+
+FakeRobot::~FakeRobot()
+{
+  stopProgram();
+  running_ = false;
+  if (rtde_thread_.joinable())
+  {
+    rtde_thread_.join();
+  }
+
+  rtde_server_.shutdown();
+  primary_server_.shutdown();
+  secondary_server_.shutdown();
+  dashboard_server_.shutdown();
+
+  // The servers don't close their client connections, so clients wouldn't notice the robot going
+  // away.
+  for (auto& session : rtde_sessions_)
+  {
+    ::close(session.first);
+  }
+  for (auto& connection : script_connections_)
+  {
+    ::close(connection.first);
+  }
+  for (auto& buffer : dashboard_buffers_)
+  {
+    ::close(buffer.first);
+  }
+}
+
+std::string FakeRobot::getProgram() const
+{
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  return program_;
+}
+
+vector6d_t FakeRobot::getJointPositions() const
+{
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  return q_;
+}
+
+void FakeRobot::setJointPositions(const vector6d_t& positions)
+{
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  q_ = positions;
+  target_q_ = positions;
+  qd_ = {};
+}
+
+void FakeRobot::setCommandCallback(std::function<void(const Command&)> callback)
+{
+  std::lock_guard<std::mutex> lk(callback_mutex_);
+  command_callback_ = callback;
+}
+
+void FakeRobot::setOutputCallback(std::function<void(rtde_interface::DataPackage&)> callback)
+{
+  std::lock_guard<std::mutex> lk(rtde_mutex_);
+  output_callback_ = callback;
+}
+
+void FakeRobot::sendTextMessage(const std::string& message, const std::string& source)
+{
+  const uint8_t warning_level = 3;  // Info
+  uint8_t buffer[1024];
+  uint8_t* payload = buffer + sizeof(rtde_interface::PackageHeader::_package_size_type) +
+                     sizeof(rtde_interface::PackageType);
+
+  std::lock_guard<std::mutex> lk(rtde_mutex_);
+  for (auto& item : rtde_sessions_)
+  {
+    size_t payload_size = 0;
+    if (item.second.protocol_version == 2)
+    {
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, static_cast<uint8_t>(message.size()));
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, message);
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, static_cast<uint8_t>(source.size()));
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, source);
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, warning_level);
+    }
+    else
+    {
+      const uint8_t message_type = 'I';
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, message_type);
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, message);
+    }
+    size_t size = rtde_interface::PackageHeader::serializeHeader(
+                      buffer, rtde_interface::PackageType::RTDE_TEXT_MESSAGE, payload_size) +
+                  payload_size;
+    writeRTDE(item.first, buffer, size);
+  }
+}
+
+void FakeRobot::rtdeMessageCallback(const int fd, char* buffer, int nbytesrecv)
+{
+  std::lock_guard<std::mutex> lk(rtde_mutex_);
+  RTDESession& session = rtde_sessions_[fd];
+  session.buffer.insert(session.buffer.end(), buffer, buffer + nbytesrecv);
+
+  size_t pos = 0;
+  while (session.buffer.size() - pos >= sizeof(rtde_interface::PackageHeader::_package_size_type))
+  {
+    size_t size = rtde_interface::PackageHeader::getPackageLength(session.buffer.data() + pos);
+    if (size < sizeof(rtde_interface::PackageHeader::_package_size_type) + sizeof(rtde_interface::PackageType))
+    {
+      URCL_LOG_ERROR("Received RTDE package with invalid size %zu, dropping received data", size);
+      session.buffer.clear();
+      return;
+    }
+    if (session.buffer.size() - pos < size)
+    {
+      break;
+    }
+    handleRTDEPackage(fd, session, session.buffer.data() + pos, size);
+    pos += size;
+  }
+  session.buffer.erase(session.buffer.begin(), session.buffer.begin() + pos);
+}
+
+void FakeRobot::handleRTDEPackage(const int fd, RTDESession& session, uint8_t* package, size_t size)
+{
+  comm::BinParser bp(package, size);
+  rtde_interface::PackageHeader::_package_size_type package_size;
+  rtde_interface::PackageType type;
+  bp.parse(package_size);
+  bp.parse(type);
+
+  uint8_t answer[4096];
+  size_t answer_size = 0;
+  uint8_t* payload = answer + sizeof(package_size) + sizeof(type);
+  size_t payload_size = 0;
+
+  switch (type)
+  {
+    case rtde_interface::PackageType::RTDE_REQUEST_PROTOCOL_VERSION:
+    {
+      uint16_t protocol_version;
+      bp.parse(protocol_version);
+      uint8_t accepted = protocol_version == 1 || protocol_version == 2;
+      if (accepted)
+      {
+        session.protocol_version = protocol_version;
+      }
+      payload_size += comm::PackageSerializer::serialize(payload, accepted);
+      break;
+    }
+    case rtde_interface::PackageType::RTDE_GET_URCONTROL_VERSION:
+    {
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, version_.major);
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, version_.minor);
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, version_.bugfix);
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, version_.build);
+      break;
+    }
+    case rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS:
+    case rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_SETUP_INPUTS:
+    {
+      if (type == rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS && session.protocol_version == 2)
+      {
+        // The requested output frequency is ignored, packages are always sent with the robot's frequency.
+        double output_frequency;
+        bp.parse(output_frequency);
+      }
+      std::string variables;
+      bp.parseRemainder(variables);
+      auto layout = std::make_shared<const rtde_interface::DataPackage::RecipeLayout>(splitRecipe(variables));
+
+      std::string types;
+      for (auto& field : layout->getFields())
+      {
+        types += (types.empty() ? "" : ",") + rtdeTypeName(field.type);
+      }
+
+      if (type == rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_SETUP_OUTPUTS)
+      {
+        session.output_layout = layout->isComplete() ? layout : nullptr;
+        session.output_package.reset();
+        if (session.output_layout != nullptr)
+        {
+          session.output_package.reset(new rtde_interface::DataPackage(layout, session.protocol_version));
+          session.output_package->initEmpty();
+          session.output_package->setRecipeID(RECIPE_ID);
+        }
+      }
+      else
+      {
+        session.input_package.reset();
+        if (layout->isComplete())
+        {
+          session.input_package = std::make_shared<rtde_interface::DataPackage>(layout, session.protocol_version);
+        }
+      }
+
+      if (session.protocol_version == 2 || type == rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_SETUP_INPUTS)
+      {
+        uint8_t recipe_id = layout->isComplete() ? RECIPE_ID : 0;
+        payload_size += comm::PackageSerializer::serialize(payload + payload_size, recipe_id);
+      }
+      payload_size += comm::PackageSerializer::serialize(payload + payload_size, types);
+      break;
+    }
+    case rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_START:
+    {
+      session.streaming = session.output_package != nullptr;
+      uint8_t accepted = session.streaming;
+      payload_size += comm::PackageSerializer::serialize(payload, accepted);
+      break;
+    }
+    case rtde_interface::PackageType::RTDE_CONTROL_PACKAGE_PAUSE:
+    {
+      session.streaming = false;
+      uint8_t accepted = 1;
+      payload_size += comm::PackageSerializer::serialize(payload, accepted);
+      break;
+    }
+    case rtde_interface::PackageType::RTDE_DATA_PACKAGE:
+    {
+      if (session.input_package == nullptr || !session.input_package->parseWith(bp))
+      {
+        URCL_LOG_WARN("Received RTDE input package that doesn't match the input recipe");
+      }
+      else
+      {
+        input_package_ = session.input_package;
+      }
+      return;
+    }
+    default:
+      URCL_LOG_DEBUG("Ignoring RTDE package of type %d", static_cast<int>(type));
+      return;
+  }
+
+  answer_size = rtde_interface::PackageHeader::serializeHeader(answer, type, payload_size) + payload_size;
+  writeRTDE(fd, answer, answer_size);
+}
+
+void FakeRobot::writeRTDE(const int fd, const uint8_t* buffer, size_t size)
+{
+  size_t written;
+  if (!rtde_server_.write(fd, buffer, size, written))
+  {
+    URCL_LOG_ERROR("Could not send RTDE package to client at FD %d", fd);
+  }
+}
+
+void FakeRobot::rtdeLoop()
+{
+  const double dt = 1.0 / frequency_;
+  const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(dt));
+  std::vector<uint8_t> buffer;
+  const auto start = std::chrono::steady_clock::now();
+  auto next_cycle = start;
+  while (running_)
+  {
+    next_cycle += period;
+    std::this_thread::sleep_until(next_cycle);
+    auto now = std::chrono::steady_clock::now();
+    if (now - next_cycle > period)
+    {
+      // Don't try to catch up after being stalled, a real robot wouldn't send the missed packages either
+      next_cycle = now;
+    }
+    updateJointState(dt);
+
+    std::lock_guard<std::mutex> lk(rtde_mutex_);
+    bool sent = false;
+    for (auto& item : rtde_sessions_)
+    {
+      RTDESession& session = item.second;
+      if (!session.streaming)
+      {
+        continue;
+      }
+      // The controller's clock keeps running while cycles are skipped
+      fillOutputPackage(session, BOOT_TIME + std::chrono::duration<double>(next_cycle - start).count());
+      if (output_callback_)
+      {
+        output_callback_(*session.output_package);
+      }
+      buffer.resize(session.output_layout->getStorageSize() + sizeof(rtde_interface::PackageHeader::_package_size_type) +
+                    sizeof(rtde_interface::PackageType) + sizeof(RECIPE_ID));
+      size_t size = session.output_package->serializePackage(buffer.data());
+      writeRTDE(item.first, buffer.data(), size);
+      sent = true;
+    }
+    if (sent)
+    {
+      last_sent_ns_ = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::steady_clock::now().time_since_epoch())
+                          .count();
+      ++cycle_;
+    }
+  }
+}
+
+void FakeRobot::updateJointState(const double dt)
+{
+  std::lock_guard<std::mutex> lk(state_mutex_);
+  switch (control_mode_.load())
+  {
+    case comm::ControlMode::MODE_SERVOJ:
+      for (size_t i = 0; i < q_.size(); ++i)
+      {
+        qd_[i] = (target_q_[i] - q_[i]) / dt;
+      }
+      q_ = target_q_;
+      break;
+    case comm::ControlMode::MODE_SPEEDJ:
+      for (size_t i = 0; i < q_.size(); ++i)
+      {
+        q_[i] += qd_[i] * dt;
+      }
+      target_q_ = q_;
+      break;
+    default:
+      qd_ = {};
+      target_q_ = q_;
+      break;
+  }
+}
+
+void FakeRobot::fillOutputPackage(RTDESession& session, const double timestamp)
+{
+  rtde_interface::DataPackage& package = *session.output_package;
+  const rtde_interface::DataPackage::RecipeLayout& layout = *session.output_layout;
+
+  vector6d_t q, qd;
+  {
+    std::lock_guard<std::mutex> lk(state_mutex_);
+    q = q_;
+    qd = qd_;
+  }
+  const int32_t robot_mode = robot_mode_;
+  const bool program_running = program_running_;
+  uint32_t robot_status_bits = 0;
+  robot_status_bits |= robot_mode != ROBOT_MODE_POWER_OFF ? 1 : 0;
+  robot_status_bits |= program_running ? 2 : 0;
+
+  setField(package, layout, "timestamp", timestamp);
+  setField(package, layout, "actual_q", q);
+  setField(package, layout, "target_q", q);
+  setField(package, layout, "actual_qd", qd);
+  setField(package, layout, "target_qd", qd);
+  setField(package, layout, "speed_scaling", 1.0);
+  setField(package, layout, "target_speed_fraction", 1.0);
+  setField(package, layout, "runtime_state",
+           static_cast<uint32_t>(program_running ? rtde_interface::RUNTIME_STATE::PLAYING :
+                                                   rtde_interface::RUNTIME_STATE::STOPPED));
+  setField(package, layout, "robot_mode", robot_mode);
+  setField(package, layout, "safety_mode", SAFETY_MODE_NORMAL);
+  setField(package, layout, "safety_status", SAFETY_MODE_NORMAL);
+  setField(package, layout, "robot_status_bits", robot_status_bits);
+  setField(package, layout, "safety_status_bits", static_cast<uint32_t>(1));
+}
+
+void FakeRobot::primaryConnectCallback(comm::TCPServer& server, const int fd)
+{
+  disableNagle(fd);
+  {
+    std::lock_guard<std::mutex> lk(script_mutex_);
+    script_connections_[fd] = ScriptConnection();
+  }
+
+  // Every connection starts with a version message
+  const std::string project_name = "URControl";
+  const std::string build_date = "01-01-2024, 00:00:00";
+  uint8_t buffer[256];
+  size_t size = sizeof(primary_interface::PackageHeader::_package_size_type);
+  size += comm::PackageSerializer::serialize(buffer + size, primary_interface::RobotPackageType::ROBOT_MESSAGE);
+  size += comm::PackageSerializer::serialize(buffer + size, static_cast<uint64_t>(0));
+  size += comm::PackageSerializer::serialize(buffer + size, static_cast<int8_t>(-2));
+  size += comm::PackageSerializer::serialize(buffer + size,
+                                             primary_interface::RobotMessagePackageType::ROBOT_MESSAGE_VERSION);
+  size += comm::PackageSerializer::serialize(buffer + size, static_cast<int8_t>(project_name.size()));
+  size += comm::PackageSerializer::serialize(buffer + size, project_name);
+  size += comm::PackageSerializer::serialize(buffer + size, static_cast<uint8_t>(version_.major));
+  size += comm::PackageSerializer::serialize(buffer + size, static_cast<uint8_t>(version_.minor));
+  size += comm::PackageSerializer::serialize(buffer + size, static_cast<int32_t>(version_.bugfix));
+  size += comm::PackageSerializer::serialize(buffer + size, static_cast<int32_t>(version_.build));
+  size += comm::PackageSerializer::serialize(buffer + size, build_date);
+  comm::PackageSerializer::serialize(buffer, static_cast<primary_interface::PackageHeader::_package_size_type>(size));
+
+  size_t written;
+  server.write(fd, buffer, size, written);
+}
+
+void FakeRobot::primaryMessageCallback(const int fd, char* buffer, int nbytesrecv)
+{
+  std::lock_guard<std::mutex> lk(script_mutex_);
+  ScriptConnection& connection = script_connections_[fd];
+  connection.pending.append(buffer, nbytesrecv);
+
+  size_t line_end;
+  while ((line_end = connection.pending.find('\n')) != std::string::npos)
+  {
+    std::string line = connection.pending.substr(0, line_end);
+    connection.pending.erase(0, line_end + 1);
+    handleScriptLine(connection, line);
+  }
+}
+
+void FakeRobot::handleScriptLine(ScriptConnection& connection, const std::string& line)
+{
+  const bool top_level = !line.empty() && line[0] != ' ' && line[0] != '\t';
+  if (!connection.program.empty())
+  {
+    connection.program += line + "\n";
+    if (top_level && trim(line) == "end")
+    {
+      if (connection.program.compare(0, 4, "sec ") == 0)
+      {
+        URCL_LOG_DEBUG("Ignoring secondary program");
+      }
+      else
+      {
+        startProgram(connection.program);
+      }
+      connection.program.clear();
+    }
+  }
+  else if (line.compare(0, 4, "def ") == 0 || line.compare(0, 4, "sec ") == 0)
+  {
+    connection.program = line + "\n";
+  }
+  else if (trim(line) == "stop program")
+  {
+    stopProgram();
+  }
+  else if (!trim(line).empty())
+  {
+    // A single statement is run as a program of its own, stopping the currently running program.
+    startProgram(line + "\n");
+  }
+}
+
+void FakeRobot::dashboardConnectCallback(const int fd)
+{
+  disableNagle(fd);
+  {
+    std::lock_guard<std::mutex> lk(script_mutex_);
+    dashboard_buffers_[fd] = "";
+  }
+  const std::string welcome = "Connected: Universal Robots Dashboard Server\n";
+  size_t written;
+  dashboard_server_.write(fd, reinterpret_cast<const uint8_t*>(welcome.c_str()), welcome.size(), written);
+}
+
+void FakeRobot::dashboardMessageCallback(const int fd, char* buffer, int nbytesrecv)
+{
+  std::vector<std::string> commands;
+  {
+    std::lock_guard<std::mutex> lk(script_mutex_);
+    std::string& pending = dashboard_buffers_[fd];
+    pending.append(buffer, nbytesrecv);
+    size_t line_end;
+    while ((line_end = pending.find('\n')) != std::string::npos)
+    {
+      commands.push_back(trim(pending.substr(0, line_end)));
+      pending.erase(0, line_end + 1);
+    }
+  }
+
+  for (auto& command : commands)
+  {
+    std::string answer = handleDashboardCommand(fd, command) + "\n";
+    size_t written;
+    dashboard_server_.write(fd, reinterpret_cast<const uint8_t*>(answer.c_str()), answer.size(), written);
+  }
+}
+
+std::string FakeRobot::handleDashboardCommand(const int fd, const std::string& command)
+{
+  std::string loaded_program;
+  {
+    std::lock_guard<std::mutex> lk(script_mutex_);
+    if (command.compare(0, 5, "load ") == 0 && command.compare(0, 18, "load installation ") != 0)
+    {
+      loaded_program_ = command.substr(5);
+      return "Loading program: " + loaded_program_;
+    }
+    loaded_program = loaded_program_;
+  }
+
+  if (command == "power on")
+  {
+    robot_mode_ = ROBOT_MODE_IDLE;
+    return "Powering on";
+  }
+  if (command == "power off")
+  {
+    stopProgram();
+    robot_mode_ = ROBOT_MODE_POWER_OFF;
+    return "Powering off";
+  }
+  if (command == "brake release")
+  {
+    robot_mode_ = ROBOT_MODE_RUNNING;
+    return "Brake releasing";
+  }
+  if (command == "play")
+  {
+    if (robot_mode_ != ROBOT_MODE_RUNNING)
+    {
+      return "Failed to execute: play";
+    }
+    sockaddr_in address;
+    socklen_t address_len = sizeof(address);
+    char host[INET_ADDRSTRLEN] = "127.0.0.1";
+    if (::getpeername(fd, reinterpret_cast<sockaddr*>(&address), &address_len) == 0)
+    {
+      inet_ntop(AF_INET, &address.sin_addr, host, sizeof(host));
+    }
+    startProgram("", host);
+    return "Starting program";
+  }
+  if (command == "stop")
+  {
+    stopProgram();
+    return "Stopped";
+  }
+  if (command == "programState")
+  {
+    return (program_running_ ? "PLAYING " : "STOPPED ") + loaded_program;
+  }
+  if (command == "running")
+  {
+    return std::string("Program running: ") + (program_running_ ? "true" : "false");
+  }
+  if (command == "get loaded program")
+  {
+    return "Loaded program: " + loaded_program;
+  }
+  if (command == "isProgramSaved")
+  {
+    return "true " + loaded_program;
+  }
+  if (command == "robotmode")
+  {
+    return "Robotmode: " + robotModeName(robot_mode_);
+  }
+  if (command == "safetymode")
+  {
+    return "Safetymode: NORMAL";
+  }
+  if (command == "safetystatus")
+  {
+    return "Safetystatus: NORMAL";
+  }
+  if (command == "PolyscopeVersion")
+  {
+    std::stringstream ss;
+    ss << "URSoftware " << version_.major << "." << version_.minor << "." << version_.bugfix << "." << version_.build;
+    return ss.str();
+  }
+  if (command == "get robot model")
+  {
+    return "UR5";
+  }
+  if (command == "get serial number")
+  {
+    return "20000000000";
+  }
+  if (command == "unlock protective stop")
+  {
+    return "Protective stop releasing";
+  }
+  if (command == "close popup")
+  {
+    return "closing popup";
+  }
+  if (command == "close safety popup")
+  {
+    return "closing safety popup";
+  }
+  if (command.compare(0, 9, "addToLog ") == 0)
+  {
+    return "Added log message";
+  }
+  if (command == "quit")
+  {
+    return "Disconnected";
+  }
+  return "could not understand: '" + command + "'";
+}
+
+void FakeRobot::stopProgram()
+{
+  std::lock_guard<std::mutex> lk(program_mutex_);
+  stop_program_ = true;
+  if (program_thread_.joinable())
+  {
+    program_thread_.join();
+  }
+  stop_program_ = false;
+  program_running_ = false;
+}
+
+void FakeRobot::startProgram(const std::string& program, const std::string& script_sender_host)
+{
+  std::lock_guard<std::mutex> lk(program_mutex_);
+  stop_program_ = true;
+  if (program_thread_.joinable())
+  {
+    program_thread_.join();
+  }
+  stop_program_ = false;
+  program_running_ = true;
+  program_thread_ = std::thread(&FakeRobot::runProgram, this, program, script_sender_host);
+}
+
+std::string FakeRobot::requestProgram(const std::string& host)
+{
+  ProgramSocket socket;
+  if (!socket.connect(host, script_sender_port_))
+  {
+    return "";
+  }
+
+  const std::string request = "request_program\n";
+  size_t written;
+  if (!socket.write(reinterpret_cast<const uint8_t*>(request.c_str()), request.size(), written))
+  {
+    return "";
+  }
+
+  // The program is sent as one stream of text without any delimiter, so read until no more data
+  // arrives.
+  timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = 200000;
+  socket.setReceiveTimeout(tv);
+  std::string program;
+  char buffer[1024];
+  size_t read_bytes;
+  while (socket.read(reinterpret_cast<uint8_t*>(buffer), sizeof(buffer), read_bytes))
+  {
+    program.append(buffer, read_bytes);
+  }
+  return program;
+}
+
+void FakeRobot::runProgram(std::string program, const std::string& script_sender_host)
+{
+  if (program.empty())
+  {
+    program = requestProgram(script_sender_host);
+    if (program.empty())
+    {
+      URCL_LOG_ERROR("Could not receive a program from %s:%u", script_sender_host.c_str(),
+                     script_sender_port_.load());
+      program_running_ = false;
+      return;
+    }
+  }
+  {
+    std::lock_guard<std::mutex> lk(state_mutex_);
+    program_ = program;
+  }
+  control_mode_ = comm::ControlMode::MODE_UNINITIALIZED;
+
+  // Open all sockets in the order given in the program
+  static const std::regex SOCKET_OPEN(R"re(socket_open\(\s*"([^"]*)"\s*,\s*(\d+)\s*,\s*"(\w+)"\s*\))re");
+  std::map<std::string, std::unique_ptr<ProgramSocket>> sockets;
+  bool sockets_opened = true;
+  for (auto it = std::sregex_iterator(program.begin(), program.end(), SOCKET_OPEN);
+       it != std::sregex_iterator() && !stop_program_; ++it)
+  {
+    std::unique_ptr<ProgramSocket> socket(new ProgramSocket());
+    if (!socket->connect((*it)[1], std::stoi((*it)[2])))
+    {
+      URCL_LOG_ERROR("Program could not open socket '%s'", (*it)[3].str().c_str());
+      sockets_opened = false;
+      break;
+    }
+    sockets[(*it)[3]] = std::move(socket);
+  }
+
+  auto getSocket = [&sockets](const std::string& name) -> ProgramSocket* {
+    auto it = sockets.find(name);
+    return it == sockets.end() ? nullptr : it->second.get();
+  };
+  ProgramSocket* reverse_socket = getSocket("reverse_socket");
+  ProgramSocket* trajectory_socket = getSocket("trajectory_socket");
+  ProgramSocket* script_command_socket = getSocket("script_command_socket");
+
+  int32_t points_left = 0;
+  std::chrono::milliseconds read_timeout(0);
+  auto last_command = std::chrono::steady_clock::now();
+  while (sockets_opened && reverse_socket != nullptr && !stop_program_ &&
+         control_mode_ != comm::ControlMode::MODE_STOPPED)
+  {
+    pollfd fds[3];
+    ProgramSocket* polled_sockets[3] = { reverse_socket, trajectory_socket, script_command_socket };
+    for (size_t i = 0; i < 3; ++i)
+    {
+      fds[i].fd = polled_sockets[i] != nullptr ? polled_sockets[i]->getSocketFD() : -1;
+      fds[i].events = POLLIN;
+      fds[i].revents = 0;
+    }
+    if (::poll(fds, 3, POLL_TIMEOUT.count()) < 0 && errno != EINTR)
+    {
+      URCL_LOG_ERROR("Polling the program's sockets failed");
+      break;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (fds[0].revents != 0)
+    {
+      uint8_t buffer[REVERSE_MESSAGE_SIZE * sizeof(int32_t)];
+      if (!reverse_socket->readAll(buffer, sizeof(buffer)))
+      {
+        URCL_LOG_INFO("Reverse connection was closed. The program will exit now.");
+        break;
+      }
+      int32_t message[REVERSE_MESSAGE_SIZE];
+      decodeMessage(buffer, message, REVERSE_MESSAGE_SIZE);
+      last_command = now;
+      read_timeout = std::chrono::milliseconds(message[0]);
+      handleReverseCommand(message, now, trajectory_socket, points_left);
+    }
+    else if (read_timeout.count() > 0 && now - last_command > read_timeout)
+    {
+      URCL_LOG_WARN("Socket timed out waiting for command on reverse_socket. The program will exit now.");
+      break;
+    }
+
+    if (fds[1].revents != 0)
+    {
+      uint8_t buffer[TRAJECTORY_MESSAGE_SIZE * sizeof(int32_t)];
+      if (!trajectory_socket->readAll(buffer, sizeof(buffer)))
+      {
+        trajectory_socket = nullptr;
+      }
+      else if (points_left > 0)
+      {
+        int32_t point[TRAJECTORY_MESSAGE_SIZE];
+        decodeMessage(buffer, point, TRAJECTORY_MESSAGE_SIZE);
+        // Without kinematics only joint points can be followed. They are reached immediately.
+        if (point[TRAJECTORY_MESSAGE_SIZE - 1] != static_cast<int32_t>(control::TrajectoryMotionType::CARTESIAN_POINT))
+        {
+          std::lock_guard<std::mutex> lk(state_mutex_);
+          q_ = toVector(point);
+          target_q_ = q_;
+        }
+        if (--points_left == 0)
+        {
+          sendTrajectoryResult(trajectory_socket,
+                               static_cast<int32_t>(control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS));
+        }
+      }
+    }
+
+    if (fds[2].revents != 0)
+    {
+      // Script commands are accepted, but have no effect on the fake robot
+      uint8_t buffer[SCRIPT_COMMAND_MESSAGE_SIZE * sizeof(int32_t)];
+      if (!script_command_socket->readAll(buffer, sizeof(buffer)))
+      {
+        script_command_socket = nullptr;
+      }
+    }
+  }
+
+  for (auto& socket : sockets)
+  {
+    socket.second->close();
+  }
+  control_mode_ = comm::ControlMode::MODE_STOPPED;
+  program_running_ = false;
+}
+
+void FakeRobot::handleReverseCommand(const int32_t* message, const std::chrono::steady_clock::time_point received,
+                                     ProgramSocket* trajectory_socket, int32_t& points_left)
+{
+  Command command;
+  command.control_mode = static_cast<comm::ControlMode>(message[REVERSE_MESSAGE_SIZE - 1]);
+  command.values = toVector(message + 1);
+  command.read_timeout = std::chrono::milliseconds(message[0] > 0 ? message[0] : 0);
+  command.cycle = cycle_;
+  command.round_trip_time = received.time_since_epoch() - std::chrono::nanoseconds(last_sent_ns_.load());
+
+  const comm::ControlMode previous_mode = control_mode_;
+  if (previous_mode != command.control_mode && previous_mode == comm::ControlMode::MODE_FORWARD)
+  {
+    points_left = 0;
+    sendTrajectoryResult(trajectory_socket, static_cast<int32_t>(control::TrajectoryResult::TRAJECTORY_RESULT_CANCELED));
+  }
+  control_mode_ = command.control_mode;
+
+  switch (command.control_mode)
+  {
+    case comm::ControlMode::MODE_SERVOJ:
+    {
+      std::lock_guard<std::mutex> lk(state_mutex_);
+      target_q_ = command.values;
+      break;
+    }
+    case comm::ControlMode::MODE_SPEEDJ:
+    {
+      std::lock_guard<std::mutex> lk(state_mutex_);
+      qd_ = command.values;
+      break;
+    }
+    case comm::ControlMode::MODE_FORWARD:
+    {
+      if (message[1] == static_cast<int32_t>(control::TrajectoryControlMessage::TRAJECTORY_START))
+      {
+        points_left = message[2];
+        if (points_left <= 0)
+        {
+          points_left = 0;
+          sendTrajectoryResult(trajectory_socket,
+                               static_cast<int32_t>(control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS));
+        }
+      }
+      else if (message[1] == static_cast<int32_t>(control::TrajectoryControlMessage::TRAJECTORY_CANCEL))
+      {
+        points_left = 0;
+        sendTrajectoryResult(trajectory_socket,
+                             static_cast<int32_t>(control::TrajectoryResult::TRAJECTORY_RESULT_CANCELED));
+      }
+      break;
+    }
+    default:
+      break;
+  }
+
+  std::lock_guard<std::mutex> lk(callback_mutex_);
+  if (command_callback_)
+  {
+    command_callback_(command);
+  }
+}
+
+void FakeRobot::sendTrajectoryResult(ProgramSocket* trajectory_socket, const int32_t result)
+{
+  if (trajectory_socket == nullptr)
+  {
+    return;
+  }
+  int32_t val = htobe32(result);
+  size_t written;
+  trajectory_socket->write(reinterpret_cast<const uint8_t*>(&val), sizeof(val), written);
+}
+}  // namespace urcl
@@ -0,0 +1,118 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/ur/latency_statistics.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+namespace urcl
+{
+LatencyMonitor::LatencyMonitor(const std::chrono::nanoseconds step_time) : step_time_ns_(step_time.count())
+{
+  reset();
+}
+
+void LatencyMonitor::setStepTime(const std::chrono::nanoseconds step_time)
+{
+  step_time_ns_ = step_time.count();
+}
+
+void LatencyMonitor::packageFetched(const comm::PackageTimestamps& timestamps)
+{
+  receive_to_parse_.record(timestamps.parsed - timestamps.received);
+  parse_to_enqueue_.record(timestamps.enqueued - timestamps.parsed);
+  enqueue_to_dequeue_.record(timestamps.dequeued - timestamps.enqueued);
+
+  const int64_t received = toNs(timestamps.received);
+  const int64_t previous = last_received_ns_.exchange(received, std::memory_order_relaxed);
+  const int64_t step_time = step_time_ns_.load(std::memory_order_relaxed);
+  if (previous != 0 && step_time > 0 && received > previous)
+  {
+    // Packages in between the fetched ones were never seen by the application
+    const int64_t interval = received - previous;
+    const int64_t cycles = std::max<int64_t>(1, (interval + step_time / 2) / step_time);
+    missed_cycles_.fetch_add(cycles - 1, std::memory_order_relaxed);
+    cycle_jitter_.record(std::chrono::nanoseconds(std::llabs(interval - cycles * step_time)));
+  }
+
+  last_dequeued_ns_.store(toNs(timestamps.dequeued), std::memory_order_relaxed);
+  answer_pending_.store(true, std::memory_order_release);
+  num_cycles_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LatencyMonitor::commandWritten(const std::chrono::steady_clock::time_point written)
+{
+  if (!answer_pending_.exchange(false, std::memory_order_acq_rel))
+  {
+    return;
+  }
+
+  const int64_t written_ns = toNs(written);
+  const int64_t round_trip = written_ns - last_received_ns_.load(std::memory_order_relaxed);
+  dequeue_to_write_.record(std::chrono::nanoseconds(written_ns - last_dequeued_ns_.load(std::memory_order_relaxed)));
+  round_trip_.record(std::chrono::nanoseconds(round_trip));
+  if (round_trip > step_time_ns_.load(std::memory_order_relaxed))
+  {
+    late_commands_.fetch_add(1, std::memory_order_relaxed);
+  }
+}
+
+LatencyStatistics LatencyMonitor::getStatistics() const
+{
+  LatencyStatistics statistics;
+  statistics.receive_to_parse = receive_to_parse_.getSummary();
+  statistics.parse_to_enqueue = parse_to_enqueue_.getSummary();
+  statistics.enqueue_to_dequeue = enqueue_to_dequeue_.getSummary();
+  statistics.dequeue_to_write = dequeue_to_write_.getSummary();
+  statistics.round_trip = round_trip_.getSummary();
+  statistics.cycle_jitter = cycle_jitter_.getSummary();
+  statistics.num_cycles = num_cycles_.load(std::memory_order_relaxed);
+  statistics.missed_cycles = missed_cycles_.load(std::memory_order_relaxed);
+  statistics.late_commands = late_commands_.load(std::memory_order_relaxed);
+  return statistics;
+}
+
+void LatencyMonitor::reset()
+{
+  receive_to_parse_.reset();
+  parse_to_enqueue_.reset();
+  enqueue_to_dequeue_.reset();
+  dequeue_to_write_.reset();
+  round_trip_.reset();
+  cycle_jitter_.reset();
+  num_cycles_ = 0;
+  missed_cycles_ = 0;
+  late_commands_ = 0;
+  last_received_ns_ = 0;
+  last_dequeued_ns_ = 0;
+  answer_pending_ = false;
+}
+}  // namespace urcl
@@ -59,37 +59,91 @@ urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_
                          const uint32_t script_sender_port, int servoj_gain, double servoj_lookahead_time,
                          bool non_blocking_read, const std::string& reverse_ip, const uint32_t trajectory_port,
                          const uint32_t script_command_port, double force_mode_damping, double force_mode_gain_scaling)
-  : servoj_gain_(servoj_gain)
-  , servoj_lookahead_time_(servoj_lookahead_time)
-  , step_time_(std::chrono::milliseconds(8))
-  , handle_program_state_(handle_program_state)
-  , robot_ip_(robot_ip)
 {
+  UrDriverConfiguration config;
+  config.robot_ip = robot_ip;
+  config.script_file = script_file;
+  config.output_recipe_file = output_recipe_file;
+  config.input_recipe_file = input_recipe_file;
+  config.handle_program_state = handle_program_state;
+  config.headless_mode = headless_mode;
+  config.tool_comm_setup = std::move(tool_comm_setup);
+  config.reverse_port = reverse_port;
+  config.script_sender_port = script_sender_port;
+  config.servoj_gain = servoj_gain;
+  config.servoj_lookahead_time = servoj_lookahead_time;
+  config.non_blocking_read = non_blocking_read;
+  config.reverse_ip = reverse_ip;
+  config.trajectory_port = trajectory_port;
+  config.script_command_port = script_command_port;
+  config.force_mode_damping = force_mode_damping;
+  config.force_mode_gain_scaling = force_mode_gain_scaling;
+  init(config);
+}
+
+urcl::UrDriver::UrDriver(const UrDriverConfiguration& config)
+{
+  init(config);
+}
+
+void UrDriver::init(const UrDriverConfiguration& config)
+{
+  servoj_gain_ = config.servoj_gain;
+  servoj_lookahead_time_ = config.servoj_lookahead_time;
+  step_time_ = std::chrono::milliseconds(8);
+  handle_program_state_ = config.handle_program_state;
+  robot_ip_ = config.robot_ip;
+  double force_mode_damping = config.force_mode_damping;
+  double force_mode_gain_scaling = config.force_mode_gain_scaling;
+
   URCL_LOG_DEBUG("Initializing urdriver");
+  if (config.event_loop != nullptr)
+  {
+    event_loop_ = config.event_loop;
+  }
+  else if (config.shared_event_loop)
+  {
+    event_loop_ = std::make_shared<comm::EventLoop>("UrDriver", config.event_loop_cpu);
+    event_loop_->start();
+  }
   URCL_LOG_DEBUG("Initializing RTDE client");
-  rtde_client_.reset(new rtde_interface::RTDEClient(robot_ip_, notifier_, output_recipe_file, input_recipe_file));
+  rtde_client_.reset(
+      new rtde_interface::RTDEClient(robot_ip_, notifier_, config.output_recipe_file, config.input_recipe_file, 0.0,
+                                     config.rtde_transport, config.rtde_port));
+  rtde_client_->setReceiveTimestamping(config.rtde_receive_timestamping);
 
-  primary_stream_.reset(
-      new comm::URStream<primary_interface::PrimaryPackage>(robot_ip_, urcl::primary_interface::UR_PRIMARY_PORT));
-  secondary_stream_.reset(
-      new comm::URStream<primary_interface::PrimaryPackage>(robot_ip_, urcl::primary_interface::UR_SECONDARY_PORT));
+  primary_stream_.reset(new comm::URStream<primary_interface::PrimaryPackage>(robot_ip_, config.primary_port));
+  secondary_stream_.reset(new comm::URStream<primary_interface::PrimaryPackage>(robot_ip_, config.secondary_port));
   secondary_stream_->connect();
 
-  non_blocking_read_ = non_blocking_read;
+  non_blocking_read_ = config.non_blocking_read;
   get_packet_timeout_ = non_blocking_read_ ? 0 : 100;
+  predictive_read_ = config.predictive_read && !non_blocking_read_;
 
   if (!rtde_client_->init())
   {
     throw UrException("Initialization of RTDE client went wrong.");
   }
+  if (config.rtde_state_history_duration > 0.0)
+  {
+    rtde_client_->enableStateHistory(std::chrono::duration<double>(config.rtde_state_history_duration));
+  }
 
   rtde_frequency_ = rtde_client_->getMaxFrequency();
   step_time_ = std::chrono::milliseconds(1000 / rtde_frequency_);
+  latency_monitor_.setStepTime(std::chrono::nanoseconds(1000000000 / rtde_frequency_));
 
   // Figure out the ip automatically if the user didn't provide it
-  std::string local_ip = reverse_ip.empty() ? rtde_client_->getIP() : reverse_ip;
+  std::string local_ip = config.reverse_ip.empty() ? rtde_client_->getIP() : config.reverse_ip;
+
+  // The servers are created before the program is built, as it contains their ports. Ports given
+  // as 0 are chosen by the operating system.
+  reverse_interface_.reset(
+      new control::ReverseInterface(config.reverse_port, config.handle_program_state, step_time_, event_loop_));
+  trajectory_interface_.reset(new control::TrajectoryPointInterface(config.trajectory_port, event_loop_));
+  script_command_interface_.reset(new control::ScriptCommandInterface(config.script_command_port, event_loop_));
 
-  std::string prog = readScriptFile(script_file);
+  std::string prog = readScriptFile(config.script_file);
   while (prog.find(JOINT_STATE_REPLACE) != std::string::npos)
   {
     prog.replace(prog.find(JOINT_STATE_REPLACE), JOINT_STATE_REPLACE.length(),
@@ -115,18 +169,20 @@ urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_
 
   while (prog.find(SERVER_PORT_REPLACE) != std::string::npos)
   {
-    prog.replace(prog.find(SERVER_PORT_REPLACE), SERVER_PORT_REPLACE.length(), std::to_string(reverse_port));
+    prog.replace(prog.find(SERVER_PORT_REPLACE), SERVER_PORT_REPLACE.length(),
+                 std::to_string(reverse_interface_->getPort()));
   }
 
   while (prog.find(TRAJECTORY_PORT_REPLACE) != std::string::npos)
   {
-    prog.replace(prog.find(TRAJECTORY_PORT_REPLACE), TRAJECTORY_PORT_REPLACE.length(), std::to_string(trajectory_port));
+    prog.replace(prog.find(TRAJECTORY_PORT_REPLACE), TRAJECTORY_PORT_REPLACE.length(),
+                 std::to_string(trajectory_interface_->getPort()));
   }
 
   while (prog.find(SCRIPT_COMMAND_PORT_REPLACE) != std::string::npos)
   {
     prog.replace(prog.find(SCRIPT_COMMAND_PORT_REPLACE), SCRIPT_COMMAND_PORT_REPLACE.length(),
-                 std::to_string(script_command_port));
+                 std::to_string(script_command_interface_->getPort()));
   }
 
   while (prog.find(FORCE_MODE_SET_DAMPING_REPLACE) != std::string::npos)
@@ -171,7 +227,7 @@ urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_
   robot_version_ = rtde_client_->getVersion();
 
   std::stringstream begin_replace;
-  if (tool_comm_setup != nullptr)
+  if (config.tool_comm_setup != nullptr)
   {
     if (robot_version_.major < 5)
     {
@@ -180,17 +236,18 @@ urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_
                                  5, robot_version_.major);
     }
     begin_replace << "set_tool_voltage("
-                  << static_cast<std::underlying_type<ToolVoltage>::type>(tool_comm_setup->getToolVoltage()) << ")\n";
+                  << static_cast<std::underlying_type<ToolVoltage>::type>(config.tool_comm_setup->getToolVoltage())
+                  << ")\n";
     begin_replace << "set_tool_communication("
                   << "True"
-                  << ", " << tool_comm_setup->getBaudRate() << ", "
-                  << static_cast<std::underlying_type<Parity>::type>(tool_comm_setup->getParity()) << ", "
-                  << tool_comm_setup->getStopBits() << ", " << tool_comm_setup->getRxIdleChars() << ", "
-                  << tool_comm_setup->getTxIdleChars() << ")";
+                  << ", " << config.tool_comm_setup->getBaudRate() << ", "
+                  << static_cast<std::underlying_type<Parity>::type>(config.tool_comm_setup->getParity()) << ", "
+                  << config.tool_comm_setup->getStopBits() << ", " << config.tool_comm_setup->getRxIdleChars() << ", "
+                  << config.tool_comm_setup->getTxIdleChars() << ")";
   }
   prog.replace(prog.find(BEGIN_REPLACE), BEGIN_REPLACE.length(), begin_replace.str());
 
-  in_headless_mode_ = headless_mode;
+  in_headless_mode_ = config.headless_mode;
   if (in_headless_mode_)
   {
     full_robot_program_ = "stop program\n";
@@ -206,14 +263,10 @@ urcl::UrDriver::UrDriver(const std::string& robot_ip, const std::string& script_
   }
   else
   {
-    script_sender_.reset(new control::ScriptSender(script_sender_port, prog));
+    script_sender_.reset(new control::ScriptSender(config.script_sender_port, prog, event_loop_));
     URCL_LOG_DEBUG("Created script sender");
   }
 
-  reverse_interface_.reset(new control::ReverseInterface(reverse_port, handle_program_state, step_time_));
-  trajectory_interface_.reset(new control::TrajectoryPointInterface(trajectory_port));
-  script_command_interface_.reset(new control::ScriptCommandInterface(script_command_port));
-
   URCL_LOG_DEBUG("Initialization done");
 }
 
@@ -256,13 +309,49 @@ std::unique_ptr<rtde_interface::DataPackage> urcl::UrDriver::getDataPackage()
   // something else (combined_robot_hw)
   std::chrono::milliseconds timeout(get_packet_timeout_);
 
-  return rtde_client_->getDataPackage(timeout);
+  std::unique_ptr<rtde_interface::DataPackage> data_package;
+  if (predictive_read_)
+  {
+    rtde_client_->waitForDataPackage(data_package, timeout);
+  }
+  else
+  {
+    data_package = rtde_client_->getDataPackage(timeout);
+  }
+  if (data_package != nullptr)
+  {
+    latency_monitor_.packageFetched(data_package->getTimestamps());
+  }
+  return data_package;
+}
+
+bool urcl::UrDriver::getDataPackage(std::unique_ptr<rtde_interface::DataPackage>& data_package)
+{
+  return getDataPackage(data_package, std::chrono::milliseconds(get_packet_timeout_));
+}
+
+bool urcl::UrDriver::getDataPackage(std::unique_ptr<rtde_interface::DataPackage>& data_package,
+                                    const std::chrono::milliseconds timeout)
+{
+  const bool fetched = predictive_read_ ? rtde_client_->waitForDataPackage(data_package, timeout) :
+                                          rtde_client_->getDataPackage(data_package, timeout);
+  if (!fetched)
+  {
+    return false;
+  }
+  latency_monitor_.packageFetched(data_package->getTimestamps());
+  return true;
 }
 
 bool UrDriver::writeJointCommand(const vector6d_t& values, const comm::ControlMode control_mode,
                                  const RobotReceiveTimeout& robot_receive_timeout)
 {
-  return reverse_interface_->write(&values, control_mode, robot_receive_timeout);
+  if (!reverse_interface_->write(&values, control_mode, robot_receive_timeout))
+  {
+    return false;
+  }
+  latency_monitor_.commandWritten();
+  return true;
 }
 
 bool UrDriver::writeTrajectoryPoint(const vector6d_t& positions, const bool cartesian, const float goal_time,
@@ -515,6 +604,7 @@ bool UrDriver::checkCalibration(const std::string& checksum)
     throw std::runtime_error("checkCalibration() called without a primary interface connection being established.");
   }
   primary_interface::PrimaryParser parser;
+  parser.subscribe({ primary_interface::RobotStateType::KINEMATICS_INFO });
   comm::URProducer<primary_interface::PrimaryPackage> prod(*primary_stream_, parser);
   prod.setupProducer();
 
@@ -533,6 +623,26 @@ bool UrDriver::checkCalibration(const std::string& checksum)
   return consumer.checkSuccessful();
 }
 
+int UrDriver::getReversePort() const
+{
+  return reverse_interface_->getPort();
+}
+
+int UrDriver::getScriptSenderPort() const
+{
+  return script_sender_ == nullptr ? 0 : script_sender_->getPort();
+}
+
+int UrDriver::getTrajectoryPort() const
+{
+  return trajectory_interface_->getPort();
+}
+
+int UrDriver::getScriptCommandPort() const
+{
+  return script_command_interface_->getPort();
+}
+
 rtde_interface::RTDEWriter& UrDriver::getRTDEWriter()
 {
   return rtde_client_->getWriter();
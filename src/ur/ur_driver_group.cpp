@@ -0,0 +1,179 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include "ur_client_library/ur/ur_driver_group.h"
+
+#include <algorithm>
+#include <string>
+
+#include "ur_client_library/exceptions.h"
+
+namespace urcl
+{
+UrDriverGroup::UrDriverGroup(const size_t num_io_threads, const uint32_t first_port,
+                             const std::vector<int>& io_thread_cpus)
+  : first_port_(first_port)
+{
+  if (num_io_threads == 0)
+  {
+    throw UrException("A UrDriverGroup needs at least one I/O thread.");
+  }
+  if (!io_thread_cpus.empty() && io_thread_cpus.size() != num_io_threads)
+  {
+    throw UrException("The number of CPU cores has to match the number of I/O threads of a UrDriverGroup.");
+  }
+
+  for (size_t i = 0; i < num_io_threads; ++i)
+  {
+    const int cpu = io_thread_cpus.empty() ? -1 : io_thread_cpus[i];
+    event_loops_.push_back(std::make_shared<comm::EventLoop>("UrDriverGroup" + std::to_string(i), cpu));
+    event_loops_.back()->start();
+  }
+}
+
+UrDriverGroup::~UrDriverGroup()
+{
+  // The drivers' servers have to be removed from the event loops before the loops get stopped.
+  drivers_.clear();
+  for (auto& event_loop : event_loops_)
+  {
+    event_loop->stop();
+  }
+}
+
+UrDriver& UrDriverGroup::addRobot(UrDriverConfiguration config)
+{
+  if (first_port_ == 0)
+  {
+    config.reverse_port = 0;
+    config.script_sender_port = 0;
+    config.trajectory_port = 0;
+    config.script_command_port = 0;
+    URCL_LOG_INFO("Adding robot %s to driver group using automatically chosen ports", config.robot_ip.c_str());
+  }
+  else
+  {
+    const uint32_t base_port = first_port_ + static_cast<uint32_t>(drivers_.size()) * PORTS_PER_ROBOT;
+    config.reverse_port = base_port;
+    config.script_sender_port = base_port + 1;
+    config.trajectory_port = base_port + 2;
+    config.script_command_port = base_port + 3;
+    URCL_LOG_INFO("Adding robot %s to driver group using ports %u to %u", config.robot_ip.c_str(), base_port,
+                  base_port + PORTS_PER_ROBOT - 1);
+  }
+  config.event_loop = event_loops_[drivers_.size() % event_loops_.size()];
+
+  drivers_.emplace_back(new UrDriver(config));
+  timestamp_handles_.push_back(drivers_.back()->getRTDEFieldHandle<double>("timestamp"));
+  return *drivers_.back();
+}
+
+void UrDriverGroup::startRTDECommunication()
+{
+  for (auto& driver : drivers_)
+  {
+    driver->startRTDECommunication();
+  }
+}
+
+bool UrDriverGroup::waitForAll(std::vector<std::unique_ptr<rtde_interface::DataPackage>>& packages,
+                               const std::chrono::milliseconds timeout)
+{
+  packages.resize(drivers_.size());
+  const auto deadline = std::chrono::steady_clock::now() + timeout;
+  for (size_t i = 0; i < drivers_.size(); ++i)
+  {
+    const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+    if (!drivers_[i]->getDataPackage(packages[i], std::max(remaining, std::chrono::milliseconds(0))))
+    {
+      return false;
+    }
+  }
+
+  // Robots whose packages were fetched first might have sent newer ones in the meantime.
+  for (size_t i = 0; i + 1 < drivers_.size(); ++i)
+  {
+    drivers_[i]->getDataPackage(packages[i], std::chrono::milliseconds(0));
+  }
+
+  // The packages of a robot might still lag behind, e.g. if its RTDE thread got delayed and hasn't
+  // processed the latest packages, yet. Newer packages of such robots are waited for.
+  while (true)
+  {
+    std::vector<std::chrono::steady_clock::time_point> send_times(drivers_.size());
+    for (size_t i = 0; i < drivers_.size(); ++i)
+    {
+      send_times[i] = getSendTime(i, *packages[i]);
+    }
+    const auto newest = *std::max_element(send_times.begin(), send_times.end());
+
+    bool aligned = true;
+    for (size_t i = 0; i < drivers_.size(); ++i)
+    {
+      // The latest packages of robots with different phases are up to one cycle apart. Half a cycle
+      // is added for the estimation error of the send times.
+      const auto cycle = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(1.0 / drivers_[i]->getControlFrequency()));
+      if (newest - send_times[i] <= cycle + cycle / 2)
+      {
+        continue;
+      }
+      aligned = false;
+      const auto remaining = std::chrono::ceil<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+      if (remaining <= std::chrono::milliseconds(0))
+      {
+        return false;
+      }
+      drivers_[i]->getDataPackage(packages[i], remaining);
+    }
+    if (aligned)
+    {
+      return true;
+    }
+  }
+}
+
+std::chrono::steady_clock::time_point UrDriverGroup::getSendTime(const size_t index,
+                                                                 const rtde_interface::DataPackage& package) const
+{
+  // Robots don't share a clock, so their timestamps are converted to the host's clock. Until an
+  // estimate is available, the receive time is used instead.
+  double timestamp;
+  if (package.getData(timestamp_handles_[index], timestamp))
+  {
+    const auto send_time = drivers_[index]->getClockOffsetEstimator().toHostTime(timestamp);
+    if (send_time != std::chrono::steady_clock::time_point())
+    {
+      return send_time;
+    }
+  }
+  return package.getTimestamps().received;
+}
+}  // namespace urcl
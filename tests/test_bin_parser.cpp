@@ -270,6 +270,50 @@ TEST(bin_parser, parse_outside_buffer_length)
   EXPECT_THROW(bp.parse<int32_t>(parsed_int), UrException);
 }
 
+TEST(bin_parser, parse_array_bulk)
+{
+  // Use odd counts and unaligned targets, so every code path of the conversion kernels is used
+  uint8_t buffer[8 * 41];
+  for (size_t i = 0; i < sizeof(buffer); ++i)
+  {
+    buffer[i] = static_cast<uint8_t>(i * 13 + 1);
+  }
+
+  for (size_t count = 0; count <= 40; ++count)
+  {
+    uint8_t target[8 * 41 + 1];
+    comm::BinParser bp64(buffer, sizeof(buffer));
+    bp64.parseArray(target + 1, 8, count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      uint64_t expected;
+      std::memcpy(&expected, buffer + i * 8, 8);
+      uint64_t parsed;
+      std::memcpy(&parsed, target + 1 + i * 8, 8);
+      EXPECT_EQ(be64toh(expected), parsed);
+    }
+    EXPECT_TRUE(bp64.checkSize(sizeof(buffer) - count * 8));
+    EXPECT_FALSE(bp64.checkSize(sizeof(buffer) - count * 8 + 1));
+
+    comm::BinParser bp32(buffer, sizeof(buffer));
+    bp32.parseArray(target + 1, 4, count);
+    for (size_t i = 0; i < count; ++i)
+    {
+      uint32_t expected;
+      std::memcpy(&expected, buffer + i * 4, 4);
+      uint32_t parsed;
+      std::memcpy(&parsed, target + 1 + i * 4, 4);
+      EXPECT_EQ(be32toh(expected), parsed);
+    }
+  }
+
+  double values[42];
+  comm::BinParser bp(buffer, sizeof(buffer));
+  EXPECT_THROW(bp.parseArray(values, 42), UrException);
+  uint8_t target[4];
+  EXPECT_THROW(bp.parseArray(target, 2, 2), UrException);
+}
+
 TEST(bin_parser, bin_parser_parent)
 {
   // The buffer represents the string 'String to be parsed'
@@ -0,0 +1,226 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <ur_client_library/comm/clock_offset_estimator.h>
+
+using namespace urcl;
+using namespace std::chrono_literals;
+
+namespace
+{
+const std::chrono::steady_clock::time_point HOST_START = std::chrono::steady_clock::time_point(1000s);
+
+std::chrono::steady_clock::time_point hostTime(const double seconds)
+{
+  return HOST_START + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                          std::chrono::duration<double>(seconds));
+}
+}  // namespace
+
+TEST(clock_offset_estimator, no_estimate_without_samples)
+{
+  comm::ClockOffsetEstimator estimator;
+  EXPECT_EQ(estimator.getEstimate().num_samples, 0u);
+
+  estimator.addSample(10.0, HOST_START);
+  comm::ClockOffsetEstimate estimate = estimator.getEstimate();
+  EXPECT_EQ(estimate.num_samples, 1u);
+  EXPECT_EQ(estimate.offset, 0ns);
+  EXPECT_EQ(estimator.toHostTime(10.0), std::chrono::steady_clock::time_point());
+  EXPECT_EQ(estimator.toRobotTime(HOST_START), 0.0);
+}
+
+TEST(clock_offset_estimator, estimates_offset_and_drift)
+{
+  comm::ClockOffsetEstimator estimator(500);
+  const double robot_start = 100.0;
+  const double drift = 50e-6;
+  for (size_t i = 0; i < 500; ++i)
+  {
+    const double robot_time = robot_start + i * 0.002;
+    estimator.addSample(robot_time, hostTime((robot_time - robot_start) * (1.0 + drift)));
+  }
+
+  comm::ClockOffsetEstimate estimate = estimator.getEstimate();
+  EXPECT_EQ(estimate.num_samples, 500u);
+  EXPECT_DOUBLE_EQ(estimate.robot_time, robot_start + 499 * 0.002);
+  EXPECT_NEAR(estimate.drift, drift, 1e-9);
+  EXPECT_LT(estimate.jitter, 10ns);
+  const double expected_host_time = 499 * 0.002 * (1.0 + drift);
+  EXPECT_NEAR(std::chrono::duration<double>(estimate.host_time - HOST_START).count(), expected_host_time, 1e-8);
+  EXPECT_NEAR(std::chrono::duration<double>(estimate.offset).count(),
+              std::chrono::duration<double>(HOST_START.time_since_epoch()).count() + expected_host_time -
+                  estimate.robot_time,
+              1e-8);
+
+  // Conversions extrapolate into the future
+  const double future_robot_time = robot_start + 2.0;
+  EXPECT_NEAR(std::chrono::duration<double>(estimator.toHostTime(future_robot_time) - HOST_START).count(),
+              2.0 * (1.0 + drift), 1e-8);
+  EXPECT_NEAR(estimator.toRobotTime(hostTime(2.0 * (1.0 + drift))), future_robot_time, 1e-8);
+}
+
+TEST(clock_offset_estimator, jitter_reflects_delay_spread)
+{
+  comm::ClockOffsetEstimator estimator(1000);
+  std::mt19937 generator(42);
+  // Uniformly distributed delays have a standard deviation of width / sqrt(12)
+  const double delay_width = 100e-6;
+  std::uniform_real_distribution<double> delay(0.0, delay_width);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    const double robot_time = i * 0.002;
+    estimator.addSample(robot_time, hostTime(robot_time + delay(generator)));
+  }
+
+  comm::ClockOffsetEstimate estimate = estimator.getEstimate();
+  EXPECT_NEAR(estimate.drift, 0.0, 1e-5);
+  const double expected_jitter = delay_width / std::sqrt(12.0);
+  EXPECT_NEAR(std::chrono::duration<double>(estimate.jitter).count(), expected_jitter, 0.1 * expected_jitter);
+  // The offset contains the minimum delay
+  EXPECT_NEAR(std::chrono::duration<double>(estimate.host_time - HOST_START).count(), 999 * 0.002, 10e-6);
+}
+
+TEST(clock_offset_estimator, queued_samples_do_not_skew_drift)
+{
+  comm::ClockOffsetEstimator estimator(1000);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> delay(0.0, 50e-6);
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    const double robot_time = i * 0.002;
+    // A backlog of queued packages gets worked off at startup
+    const double queuing_delay = i < 50 ? (50 - i) * 0.001 : 0.0;
+    estimator.addSample(robot_time, hostTime(robot_time + queuing_delay + delay(generator)));
+  }
+
+  comm::ClockOffsetEstimate estimate = estimator.getEstimate();
+  EXPECT_EQ(estimate.num_samples, 1000u);
+  EXPECT_NEAR(estimate.drift, 0.0, 1e-5);
+  EXPECT_NEAR(std::chrono::duration<double>(estimate.host_time - HOST_START).count(), 999 * 0.002, 10e-6);
+}
+
+TEST(clock_offset_estimator, scheduling_stalls_do_not_move_estimate)
+{
+  comm::ClockOffsetEstimator estimator(1000);
+  std::mt19937 generator(42);
+  std::uniform_real_distribution<double> delay(0.0, 50e-6);
+  std::vector<std::pair<double, std::chrono::steady_clock::time_point>> samples;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    const double robot_time = i * 0.002;
+    double host_time = robot_time + delay(generator);
+    // Every 100 packages, the receiving thread is stalled for 20 ms and receives the packages sent
+    // in the meantime at once.
+    const size_t cycle = i % 100;
+    if (cycle >= 90)
+    {
+      host_time = (i - cycle + 100) * 0.002;
+    }
+    samples.emplace_back(robot_time, hostTime(host_time));
+    estimator.addSample(samples.back().first, samples.back().second);
+  }
+
+  comm::ClockOffsetEstimate estimate = estimator.getEstimate();
+  EXPECT_NEAR(estimate.drift, 0.0, 1e-5);
+  EXPECT_NEAR(std::chrono::duration<double>(estimate.host_time - HOST_START).count(), 999 * 0.002, 10e-6);
+  // Packages that weren't stalled arrive close to the time predicted from their timestamp
+  for (size_t i = 0; i < samples.size(); ++i)
+  {
+    if (i % 100 < 90)
+    {
+      EXPECT_LT(std::chrono::abs(estimator.toHostTime(samples[i].first) - samples[i].second), 100us);
+    }
+  }
+}
+
+TEST(clock_offset_estimator, window_is_discarded_by_segment)
+{
+  comm::ClockOffsetEstimator estimator(100);
+  for (size_t i = 0; i < 101; ++i)
+  {
+    estimator.addSample(i * 0.002, hostTime(i * 0.002));
+  }
+  // Starting a new segment discarded the oldest one
+  EXPECT_EQ(estimator.getEstimate().num_samples, 91u);
+}
+
+TEST(clock_offset_estimator, only_latest_samples_are_used)
+{
+  comm::ClockOffsetEstimator estimator(10);
+  for (size_t i = 0; i < 100; ++i)
+  {
+    const double robot_time = i * 0.002;
+    // The offset changes after 50 samples, so only the latest ones describe it correctly
+    const double offset = i < 50 ? 0.0 : 0.5;
+    estimator.addSample(robot_time, hostTime(robot_time + offset));
+  }
+
+  comm::ClockOffsetEstimate estimate = estimator.getEstimate();
+  EXPECT_EQ(estimate.num_samples, 10u);
+  // Host times are given in nanoseconds, which limits the drift's precision over the short window.
+  EXPECT_NEAR(estimate.drift, 0.0, 1e-6);
+  EXPECT_LT(estimate.jitter, 10ns);
+  EXPECT_NEAR(std::chrono::duration<double>(estimate.host_time - HOST_START).count(), 99 * 0.002 + 0.5, 1e-8);
+}
+
+TEST(clock_offset_estimator, robot_clock_reset_discards_samples)
+{
+  comm::ClockOffsetEstimator estimator;
+  for (size_t i = 0; i < 100; ++i)
+  {
+    estimator.addSample(50.0 + i * 0.002, hostTime(i * 0.002));
+  }
+  EXPECT_EQ(estimator.getEstimate().num_samples, 100u);
+
+  // The controller was restarted
+  estimator.addSample(1.0, hostTime(10.0));
+  estimator.addSample(1.002, hostTime(10.002));
+  comm::ClockOffsetEstimate estimate = estimator.getEstimate();
+  EXPECT_EQ(estimate.num_samples, 2u);
+  EXPECT_NEAR(std::chrono::duration<double>(estimator.toHostTime(1.0) - HOST_START).count(), 10.0, 1e-8);
+
+  estimator.reset();
+  EXPECT_EQ(estimator.getEstimate().num_samples, 0u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
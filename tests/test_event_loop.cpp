@@ -0,0 +1,246 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <pthread.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <ur_client_library/comm/event_loop.h>
+#include <ur_client_library/comm/tcp_server.h>
+#include <ur_client_library/comm/tcp_socket.h>
+
+using namespace urcl;
+
+class EventLoopTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    ASSERT_EQ(pipe(pipe_), 0);
+    fcntl(pipe_[0], F_SETFL, fcntl(pipe_[0], F_GETFL) | O_NONBLOCK);
+  }
+
+  void TearDown() override
+  {
+    close(pipe_[0]);
+    close(pipe_[1]);
+  }
+
+  void writeToPipe()
+  {
+    ASSERT_EQ(::write(pipe_[1], "x", 1), 1);
+  }
+
+  void drainPipe()
+  {
+    char buffer[16];
+    while (read(pipe_[0], buffer, sizeof(buffer)) > 0)
+    {
+    }
+  }
+
+  template <typename Predicate>
+  bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds(1))
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate())
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  int pipe_[2];
+};
+
+TEST_F(EventLoopTest, handlers_are_called_from_loop_thread)
+{
+  comm::EventLoop loop;
+  std::atomic<int> calls(0);
+  std::atomic<bool> in_loop_thread(false);
+  ASSERT_TRUE(loop.add(pipe_[0], EPOLLIN, [&](const uint32_t events) {
+    drainPipe();
+    in_loop_thread = loop.isInLoopThread();
+    calls++;
+  }));
+  loop.start();
+  EXPECT_FALSE(loop.isInLoopThread());
+
+  writeToPipe();
+  ASSERT_TRUE(waitFor([&]() { return calls == 1; }));
+  EXPECT_TRUE(in_loop_thread);
+
+  writeToPipe();
+  ASSERT_TRUE(waitFor([&]() { return calls == 2; }));
+}
+
+TEST_F(EventLoopTest, removed_handlers_are_not_called)
+{
+  comm::EventLoop loop;
+  std::atomic<int> calls(0);
+  ASSERT_TRUE(loop.add(pipe_[0], EPOLLIN, [&](const uint32_t events) {
+    drainPipe();
+    calls++;
+  }));
+  loop.start();
+  loop.remove(pipe_[0]);
+  // Removing an unknown file descriptor is fine
+  loop.remove(pipe_[0]);
+
+  writeToPipe();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(calls, 0);
+}
+
+TEST_F(EventLoopTest, remove_waits_for_running_handler)
+{
+  comm::EventLoop loop;
+  std::atomic<bool> handler_started(false);
+  std::atomic<bool> handler_finished(false);
+  ASSERT_TRUE(loop.add(pipe_[0], EPOLLIN, [&](const uint32_t events) {
+    drainPipe();
+    handler_started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    handler_finished = true;
+  }));
+  loop.start();
+
+  writeToPipe();
+  ASSERT_TRUE(waitFor([&]() { return handler_started.load(); }));
+  loop.remove(pipe_[0]);
+  EXPECT_TRUE(handler_finished);
+}
+
+TEST_F(EventLoopTest, handler_can_remove_itself)
+{
+  comm::EventLoop loop;
+  std::atomic<int> calls(0);
+  ASSERT_TRUE(loop.add(pipe_[0], EPOLLIN, [&](const uint32_t events) {
+    loop.remove(pipe_[0]);
+    calls++;
+  }));
+  loop.start();
+
+  // The pipe isn't drained, so the handler would be called again if it was still registered
+  writeToPipe();
+  ASSERT_TRUE(waitFor([&]() { return calls == 1; }));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  EXPECT_EQ(calls, 1);
+}
+
+TEST_F(EventLoopTest, loop_thread_is_pinned_to_cpu)
+{
+  comm::EventLoop loop("pinned", 0);
+  EXPECT_EQ(loop.getCPU(), 0);
+  std::atomic<bool> checked(false);
+  std::atomic<bool> pinned(false);
+  ASSERT_TRUE(loop.add(pipe_[0], EPOLLIN, [&](const uint32_t events) {
+    drainPipe();
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    pthread_getaffinity_np(pthread_self(), sizeof(cpuset), &cpuset);
+    pinned = CPU_COUNT(&cpuset) == 1 && CPU_ISSET(0, &cpuset);
+    checked = true;
+  }));
+  loop.start();
+
+  writeToPipe();
+  ASSERT_TRUE(waitFor([&]() { return checked.load(); }));
+  EXPECT_TRUE(pinned);
+}
+
+TEST_F(EventLoopTest, servers_share_one_loop)
+{
+  class Client : public comm::TCPSocket
+  {
+  public:
+    Client(const int port)
+    {
+      std::string host = "127.0.0.1";
+      TCPSocket::setup(host, port);
+    }
+
+    void send(const std::string& text)
+    {
+      size_t written;
+      TCPSocket::write(reinterpret_cast<const uint8_t*>(text.c_str()), text.size(), written);
+    }
+  };
+
+  auto loop = std::make_shared<comm::EventLoop>();
+  comm::TCPServer server1(50001, 0, std::chrono::seconds(1), loop);
+  comm::TCPServer server2(50002, 0, std::chrono::seconds(1), loop);
+  std::atomic<int> messages1(0);
+  std::atomic<int> messages2(0);
+  std::atomic<bool> same_thread(true);
+  server1.setMessageCallback([&](const int fd, char* buffer, int nbytesrecv) {
+    same_thread = same_thread && loop->isInLoopThread();
+    messages1++;
+  });
+  server2.setMessageCallback([&](const int fd, char* buffer, int nbytesrecv) {
+    same_thread = same_thread && loop->isInLoopThread();
+    messages2++;
+  });
+  server1.start();
+  server2.start();
+  loop->start();
+
+  Client client1(50001);
+  Client client2(50002);
+  client1.send("message");
+  client2.send("message");
+  ASSERT_TRUE(waitFor([&]() { return messages1 == 1 && messages2 == 1; }));
+  EXPECT_TRUE(same_thread);
+
+  // Shutting down one server doesn't affect the other one
+  server1.shutdown();
+  client1.send("message");
+  client2.send("message");
+  ASSERT_TRUE(waitFor([&]() { return messages2 == 2; }));
+  EXPECT_EQ(messages1, 1);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
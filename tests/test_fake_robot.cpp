@@ -0,0 +1,559 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <unistd.h>
+
+#include <ur_client_library/rtde/rtde_client.h>
+#include <ur_client_library/ur/dashboard_client.h>
+#include <ur_client_library/ur/fake_robot.h>
+#include <ur_client_library/ur/ur_driver.h>
+#include <ur_client_library/ur/ur_driver_group.h>
+
+using namespace urcl;
+
+const std::string SCRIPT_FILE = "../resources/external_control.urscript";
+const std::string OUTPUT_RECIPE = "resources/rtde_output_recipe.txt";
+const std::string INPUT_RECIPE = "resources/rtde_input_recipe.txt";
+const std::string ROBOT_IP = "127.0.0.1";
+const std::chrono::milliseconds PACKAGE_TIMEOUT(100);
+
+class FakeRobotTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    startRobot(500.0);
+  }
+
+  void TearDown() override
+  {
+    client_.reset();
+    robot_.reset();
+  }
+
+  void startRobot(const double frequency,
+                  const VersionInformation& version = VersionInformation::fromString("5.9.4.1031232"))
+  {
+    // All ports are chosen by the operating system, so the tests can run in parallel. The script
+    // sender's port is set once a driver was created.
+    FakeRobotPorts ports;
+    ports.rtde = 0;
+    ports.primary = 0;
+    ports.secondary = 0;
+    ports.dashboard = 0;
+    robot_.reset(new FakeRobot(frequency, version, 0, ports));
+  }
+
+  rtde_interface::RTDEClient& createClient(const comm::PipelineTransport transport = comm::PipelineTransport::QUEUE)
+  {
+    client_.reset(new rtde_interface::RTDEClient(ROBOT_IP, notifier_, OUTPUT_RECIPE, INPUT_RECIPE, 0.0, transport,
+                                                 robot_->getRTDEPort()));
+    return *client_;
+  }
+
+  // Creates a client and starts the data package stream
+  void startClient()
+  {
+    createClient();
+    ASSERT_TRUE(client_->init());
+    ASSERT_TRUE(client_->start());
+  }
+
+  // Receives the given number of data packages and checks that their timestamps increase
+  void receivePackages(const size_t num_packages, std::unique_ptr<rtde_interface::DataPackage>& package)
+  {
+    double last_timestamp = 0.0;
+    for (size_t i = 0; i < num_packages; ++i)
+    {
+      ASSERT_TRUE(client_->getDataPackage(package, PACKAGE_TIMEOUT));
+      double timestamp = 0.0;
+      ASSERT_TRUE(package->getData("timestamp", timestamp));
+      EXPECT_GT(timestamp, last_timestamp);
+      last_timestamp = timestamp;
+    }
+  }
+
+  void handleProgramState(bool program_running)
+  {
+    std::lock_guard<std::mutex> lk(program_state_mutex_);
+    program_running_ = program_running;
+    program_state_cv_.notify_all();
+  }
+
+  bool waitForProgramState(bool program_running, std::chrono::milliseconds timeout = std::chrono::seconds(10))
+  {
+    std::unique_lock<std::mutex> lk(program_state_mutex_);
+    return program_state_cv_.wait_for(lk, timeout, [&]() { return program_running_ == program_running; });
+  }
+
+  template <typename Predicate>
+  bool waitFor(Predicate predicate, std::chrono::milliseconds timeout = std::chrono::seconds(5))
+  {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!predicate())
+    {
+      if (std::chrono::steady_clock::now() > deadline)
+      {
+        return false;
+      }
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+  }
+
+  UrDriverConfiguration createDriverConfiguration(const bool headless)
+  {
+    UrDriverConfiguration config;
+    config.robot_ip = ROBOT_IP;
+    config.script_file = SCRIPT_FILE;
+    config.output_recipe_file = OUTPUT_RECIPE;
+    config.input_recipe_file = INPUT_RECIPE;
+    config.handle_program_state = [this](bool program_running) { handleProgramState(program_running); };
+    config.headless_mode = headless;
+    config.reverse_port = 0;
+    config.script_sender_port = 0;
+    config.trajectory_port = 0;
+    config.script_command_port = 0;
+    config.rtde_port = robot_->getRTDEPort();
+    config.primary_port = robot_->getPrimaryPort();
+    config.secondary_port = robot_->getSecondaryPort();
+    return config;
+  }
+
+  std::unique_ptr<UrDriver> createDriver(const bool headless)
+  {
+    std::unique_ptr<UrDriver> driver(new UrDriver(createDriverConfiguration(headless)));
+    robot_->setScriptSenderPort(driver->getScriptSenderPort());
+    return driver;
+  }
+
+  std::unique_ptr<FakeRobot> robot_;
+  comm::INotifier notifier_;
+  std::unique_ptr<rtde_interface::RTDEClient> client_;
+
+  std::mutex program_state_mutex_;
+  std::condition_variable program_state_cv_;
+  bool program_running_ = false;
+};
+
+TEST_F(FakeRobotTest, rtde_client_receives_packages_at_robot_frequency)
+{
+  rtde_interface::RTDEClient& client = createClient();
+  ASSERT_TRUE(client.init());
+  EXPECT_EQ(client.getVersion().major, 5u);
+  EXPECT_EQ(client.getMaxFrequency(), 500.0);
+  ASSERT_TRUE(client.start());
+
+  std::unique_ptr<rtde_interface::DataPackage> package;
+  ASSERT_NO_FATAL_FAILURE(receivePackages(10, package));
+  vector6d_t actual_q = { 0, 0, 0, 0, 0, 0 };
+  ASSERT_TRUE(package->getData("actual_q", actual_q));
+  EXPECT_EQ(actual_q, robot_->getJointPositions());
+  EXPECT_GT(robot_->getNumCycles(), 0u);
+
+  ASSERT_TRUE(client.getWriter().sendSpeedSlider(0.5));
+  double speed_slider_fraction = 0.0;
+  EXPECT_TRUE(waitFor([&]() {
+    return robot_->getInputData("speed_slider_fraction", speed_slider_fraction) && speed_slider_fraction == 0.5;
+  }));
+}
+
+TEST_F(FakeRobotTest, latest_value_client_receives_answers_to_requests)
+{
+  rtde_interface::RTDEClient& client = createClient(comm::PipelineTransport::LATEST_VALUE);
+  ASSERT_TRUE(client.init());
+
+  // Data packages arriving right after the answer to the start request must not overwrite it
+  std::unique_ptr<rtde_interface::DataPackage> package;
+  for (size_t i = 0; i < 10; ++i)
+  {
+    ASSERT_TRUE(client.start());
+    ASSERT_TRUE(client.getDataPackage(package, PACKAGE_TIMEOUT));
+    ASSERT_TRUE(client.pause());
+  }
+}
+
+TEST_F(FakeRobotTest, latest_value_client_answers_requests_after_text_messages)
+{
+  rtde_interface::RTDEClient& client = createClient(comm::PipelineTransport::LATEST_VALUE);
+  ASSERT_TRUE(client.init());
+  ASSERT_TRUE(client.start());
+
+  // More text messages than the queue for answers can hold arrive while data packages are streamed
+  std::unique_ptr<rtde_interface::DataPackage> package;
+  for (size_t i = 0; i < 40; ++i)
+  {
+    robot_->sendTextMessage("Message " + std::to_string(i));
+    ASSERT_TRUE(client.getDataPackage(package, PACKAGE_TIMEOUT));
+  }
+
+  ASSERT_TRUE(client.pause());
+  ASSERT_TRUE(client.start());
+  ASSERT_TRUE(client.getDataPackage(package, PACKAGE_TIMEOUT));
+}
+
+TEST_F(FakeRobotTest, client_keeps_data_package_when_fetching_text_message)
+{
+  ASSERT_NO_FATAL_FAILURE(startClient());
+
+  std::unique_ptr<rtde_interface::DataPackage> package;
+  ASSERT_TRUE(client_->getDataPackage(package, PACKAGE_TIMEOUT));
+  double last_timestamp = 0.0;
+  ASSERT_TRUE(package->getData("timestamp", last_timestamp));
+  for (size_t i = 0; i < 100; ++i)
+  {
+    // All packages are queued, so the text message is fetched, if no data package arrived after it
+    robot_->sendTextMessage("Message " + std::to_string(i));
+    const bool received = client_->getDataPackage(package, PACKAGE_TIMEOUT);
+    ASSERT_NE(package, nullptr);
+    double timestamp = 0.0;
+    ASSERT_TRUE(package->getData("timestamp", timestamp));
+    if (received)
+    {
+      EXPECT_GT(timestamp, last_timestamp);
+    }
+    else
+    {
+      EXPECT_EQ(timestamp, last_timestamp);
+    }
+    last_timestamp = timestamp;
+  }
+
+  // Text messages in the queue don't hide the answer to a request
+  robot_->sendTextMessage("Message before pausing");
+  EXPECT_TRUE(client_->pause());
+}
+
+TEST_F(FakeRobotTest, synchronous_writer_sends_inputs_with_robot_cycle)
+{
+  ASSERT_NO_FATAL_FAILURE(startClient());
+
+  rtde_interface::RTDEWriter& writer = client_->getWriter();
+  writer.setSynchronous(true);
+  writer.beginBatch();
+  ASSERT_TRUE(writer.sendSpeedSlider(0.25));
+  ASSERT_TRUE(writer.sendStandardDigitalOutput(1, true));
+  ASSERT_TRUE(writer.commit());
+
+  // The changes are sent after the next data package was received without calling flush()
+  double speed_slider_fraction = 0.0;
+  uint8_t standard_digital_output_mask = 0;
+  EXPECT_TRUE(waitFor([&]() {
+    return robot_->getInputData("speed_slider_fraction", speed_slider_fraction) && speed_slider_fraction == 0.25;
+  }));
+  ASSERT_TRUE(robot_->getInputData("standard_digital_output_mask", standard_digital_output_mask));
+  EXPECT_EQ(standard_digital_output_mask, 2);
+}
+
+TEST_F(FakeRobotTest, rtde_client_estimates_clock_offset)
+{
+  ASSERT_NO_FATAL_FAILURE(startClient());
+
+  std::unique_ptr<rtde_interface::DataPackage> package;
+  // Enough packages for the estimate to span several segments
+  ASSERT_NO_FATAL_FAILURE(receivePackages(500, package));
+  double timestamp = 0.0;
+  ASSERT_TRUE(package->getData("timestamp", timestamp));
+
+  // The precision of the estimate, also with delayed packages, is tested with simulated samples in
+  // test_clock_offset_estimator.cpp
+  const comm::ClockOffsetEstimator& estimator = client_->getClockOffsetEstimator();
+  comm::ClockOffsetEstimate estimate = estimator.getEstimate();
+  EXPECT_GE(estimate.num_samples, 500u);
+  EXPECT_GE(estimate.robot_time, timestamp);
+  // The fake robot's clock is derived from the host's clock, so it doesn't drift.
+  EXPECT_LT(std::abs(estimate.drift), 0.01);
+  EXPECT_NEAR(estimator.toRobotTime(estimator.toHostTime(timestamp)), timestamp, 1e-6);
+}
+
+TEST_F(FakeRobotTest, rtde_client_keeps_state_history)
+{
+  rtde_interface::RTDEClient& client = createClient();
+  EXPECT_EQ(client.getStateHistory(), nullptr);
+  ASSERT_TRUE(client.init());
+  ASSERT_TRUE(client.enableStateHistory(std::chrono::milliseconds(100)));
+  ASSERT_TRUE(client.start());
+  EXPECT_FALSE(client.enableStateHistory(std::chrono::milliseconds(100)));
+
+  std::unique_ptr<rtde_interface::DataPackage> package;
+  ASSERT_NO_FATAL_FAILURE(receivePackages(100, package));
+  double timestamp = 0.0;
+  vector6d_t actual_q;
+  ASSERT_TRUE(package->getData("timestamp", timestamp));
+  ASSERT_TRUE(package->getData("actual_q", actual_q));
+
+  std::shared_ptr<const rtde_interface::StateHistory> history = client.getStateHistory();
+  ASSERT_NE(history, nullptr);
+  EXPECT_EQ(history->capacity(), 50u);
+  EXPECT_EQ(history->size(), 50u);
+
+  double oldest, newest;
+  ASSERT_TRUE(history->getTimeRange(oldest, newest));
+  EXPECT_GE(newest, timestamp);
+  EXPECT_LE(oldest, timestamp);
+
+  vector6d_t history_q;
+  ASSERT_TRUE(history->getData(client.getFieldHandle<vector6d_t>("actual_q"), timestamp, history_q));
+  EXPECT_EQ(history_q, actual_q);
+}
+
+TEST_F(FakeRobotTest, rtde_client_records_data_packages)
+{
+  // Other tests might record at the same time
+  const std::string filename = "fake_robot_recording_" + std::to_string(getpid()) + ".urcl";
+  rtde_interface::RTDEClient& client = createClient();
+  ASSERT_TRUE(client.init());
+  EXPECT_FALSE(client.startRecording("/does/not/exist.urcl"));
+  ASSERT_TRUE(client.startRecording(filename));
+  ASSERT_TRUE(client.start());
+
+  std::unique_ptr<rtde_interface::DataPackage> package;
+  double first_timestamp = 0.0;
+  for (size_t i = 0; i < 50; ++i)
+  {
+    ASSERT_TRUE(client.getDataPackage(package, PACKAGE_TIMEOUT));
+    if (i == 0)
+    {
+      ASSERT_TRUE(package->getData("timestamp", first_timestamp));
+    }
+  }
+  client.stopRecording();
+
+  comm::RecordingReader reader(filename);
+  EXPECT_EQ(reader.getType(), comm::RecordingType::RTDE);
+  EXPECT_EQ(rtde_interface::RTDERecorder::metadataToRecipe(reader.getMetadata()), client.getOutputRecipe());
+  EXPECT_GE(reader.getNumFrames(), 50u);
+
+  rtde_interface::RTDEParser parser(client.getOutputRecipe());
+  parser.setProtocolVersion(reader.getProtocolVersion());
+  comm::RecordedFrame frame;
+  bool found_first = false;
+  while (reader.next(frame))
+  {
+    comm::BinParser bp(const_cast<uint8_t*>(frame.data), frame.size);
+    std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> packages;
+    ASSERT_TRUE(parser.parse(bp, packages));
+    double timestamp;
+    ASSERT_TRUE(dynamic_cast<rtde_interface::DataPackage*>(packages[0].get())->getData("timestamp", timestamp));
+    found_first |= timestamp == first_timestamp;
+  }
+  EXPECT_TRUE(found_first);
+  std::remove(filename.c_str());
+}
+
+TEST_F(FakeRobotTest, rtde_client_predicts_package_arrivals)
+{
+  ASSERT_NO_FATAL_FAILURE(startClient());
+
+  std::unique_ptr<rtde_interface::DataPackage> package;
+  double last_timestamp = 0.0;
+  for (size_t i = 0; i < 50; ++i)
+  {
+    ASSERT_TRUE(client_->waitForDataPackage(package, PACKAGE_TIMEOUT));
+    double timestamp = 0.0;
+    ASSERT_TRUE(package->getData("timestamp", timestamp));
+    EXPECT_GT(timestamp, last_timestamp);
+    last_timestamp = timestamp;
+  }
+
+  // The precision of the prediction is tested with simulated arrivals in test_wake_up_scheduler.cpp
+  const comm::WakeUpScheduler& scheduler = client_->getWakeUpScheduler();
+  EXPECT_TRUE(scheduler.hasPrediction());
+  EXPECT_NEAR(std::chrono::duration<double>(scheduler.getPeriod()).count(), 0.002, 0.0005);
+}
+
+TEST_F(FakeRobotTest, cb3_robot_is_limited_to_125_hz)
+{
+  startRobot(125.0, VersionInformation::fromString("3.14.3.1031232"));
+  rtde_interface::RTDEClient& client = createClient();
+  ASSERT_TRUE(client.init());
+  EXPECT_EQ(client.getVersion().major, 3u);
+  EXPECT_EQ(client.getMaxFrequency(), 125.0);
+}
+
+TEST_F(FakeRobotTest, headless_driver_controls_robot)
+{
+  std::mutex commands_mutex;
+  std::vector<FakeRobot::Command> commands;
+  robot_->setCommandCallback([&](const FakeRobot::Command& command) {
+    std::lock_guard<std::mutex> lk(commands_mutex);
+    commands.push_back(command);
+  });
+
+  auto driver = createDriver(true);
+  ASSERT_TRUE(waitForProgramState(true));
+  EXPECT_TRUE(robot_->isProgramRunning());
+  EXPECT_NE(robot_->getProgram().find("def externalControl():"), std::string::npos);
+  driver->startRTDECommunication();
+
+  vector6d_t target = robot_->getJointPositions();
+  for (size_t i = 0; i < 20; ++i)
+  {
+    std::unique_ptr<rtde_interface::DataPackage> package = driver->getDataPackage();
+    ASSERT_NE(package, nullptr);
+    target[0] += 0.001;
+    ASSERT_TRUE(driver->writeJointCommand(target, comm::ControlMode::MODE_SERVOJ,
+                                          RobotReceiveTimeout::millisec(1000)));
+  }
+  // Commands are transmitted as fixed point values, so the robot only reaches the target up to their resolution
+  ASSERT_TRUE(waitFor([&]() { return std::abs(robot_->getJointPositions()[0] - target[0]) < 1e-6; }));
+  EXPECT_EQ(robot_->getControlMode(), comm::ControlMode::MODE_SERVOJ);
+
+  {
+    std::lock_guard<std::mutex> lk(commands_mutex);
+    ASSERT_FALSE(commands.empty());
+    EXPECT_EQ(commands.back().control_mode, comm::ControlMode::MODE_SERVOJ);
+    EXPECT_GT(commands.back().cycle, 0u);
+    EXPECT_GT(commands.back().round_trip_time.count(), 0);
+  }
+
+  LatencyStatistics statistics = driver->getLatencyStatistics();
+  EXPECT_EQ(statistics.num_cycles, 20u);
+  EXPECT_EQ(statistics.round_trip.count, 20u);
+  EXPECT_GT(statistics.round_trip.max.count(), 0);
+  EXPECT_GE(statistics.round_trip.max, statistics.dequeue_to_write.max);
+
+  ASSERT_TRUE(driver->stopControl());
+  EXPECT_TRUE(waitForProgramState(false));
+  EXPECT_TRUE(waitFor([&]() { return !robot_->isProgramRunning(); }));
+}
+
+TEST_F(FakeRobotTest, driver_with_shared_event_loop_controls_robot)
+{
+  UrDriverConfiguration config = createDriverConfiguration(true);
+  config.shared_event_loop = true;
+  config.event_loop_cpu = 0;
+  UrDriver driver(config);
+  ASSERT_TRUE(waitForProgramState(true));
+
+  std::atomic<bool> trajectory_done(false);
+  driver.registerTrajectoryDoneCallback([&](control::TrajectoryResult result) { trajectory_done = true; });
+  const vector6d_t point = { 0.1, -1.5, 1.5, -1.5, -1.5, 0.1 };
+  ASSERT_TRUE(driver.writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 1,
+                                                   RobotReceiveTimeout::off()));
+  // The program opens the trajectory socket after the reverse socket, so it might not be connected, yet
+  ASSERT_TRUE(waitFor([&]() { return driver.writeTrajectoryPoint(point, false, 1.0); }));
+  ASSERT_TRUE(waitFor([&]() { return trajectory_done.load(); }));
+  EXPECT_EQ(robot_->getJointPositions(), point);
+
+  ASSERT_TRUE(driver.stopControl());
+  EXPECT_TRUE(waitForProgramState(false));
+}
+
+TEST_F(FakeRobotTest, driver_group_shares_threads_and_reads_all_robots)
+{
+  // Both drivers connect to the same fake robot, which serves an RTDE session for each of them.
+  UrDriverGroup group(1, 0);
+  for (size_t i = 0; i < 2; ++i)
+  {
+    group.addRobot(createDriverConfiguration(false));
+  }
+  ASSERT_EQ(group.size(), 2u);
+  group.startRTDECommunication();
+
+  // Each robot got its own ports, which are reachable through the shared event loop.
+  EXPECT_NE(group.getDriver(0).getScriptSenderPort(), group.getDriver(1).getScriptSenderPort());
+  comm::URStream<rtde_interface::RTDEPackage> script_sender_stream(ROBOT_IP,
+                                                                   group.getDriver(1).getScriptSenderPort());
+  EXPECT_TRUE(script_sender_stream.connect(1));
+  script_sender_stream.close();
+
+  std::vector<std::unique_ptr<rtde_interface::DataPackage>> packages;
+  std::vector<double> last_timestamps(2, 0.0);
+  for (size_t cycle = 0; cycle < 50; ++cycle)
+  {
+    ASSERT_TRUE(group.waitForAll(packages, PACKAGE_TIMEOUT));
+    ASSERT_EQ(packages.size(), 2u);
+    for (size_t i = 0; i < packages.size(); ++i)
+    {
+      double timestamp = 0.0;
+      ASSERT_TRUE(packages[i]->getData("timestamp", timestamp));
+      EXPECT_GT(timestamp, last_timestamps[i]);
+      last_timestamps[i] = timestamp;
+    }
+    // The packages are sent at most one and a half cycles apart, so they are from the same cycle or
+    // neighboring ones
+    EXPECT_NEAR(last_timestamps[0], last_timestamps[1], 0.0041);
+  }
+}
+
+TEST_F(FakeRobotTest, trajectory_points_are_executed)
+{
+  auto driver = createDriver(true);
+  ASSERT_TRUE(waitForProgramState(true));
+
+  std::atomic<bool> trajectory_done(false);
+  std::atomic<control::TrajectoryResult> trajectory_result(control::TrajectoryResult::TRAJECTORY_RESULT_FAILURE);
+  driver->registerTrajectoryDoneCallback([&](control::TrajectoryResult result) {
+    trajectory_result = result;
+    trajectory_done = true;
+  });
+
+  const vector6d_t first_point = { 0.1, -1.5, 1.5, -1.5, -1.5, 0.1 };
+  const vector6d_t last_point = { 0.2, -1.4, 1.4, -1.4, -1.4, 0.2 };
+  ASSERT_TRUE(
+      driver->writeTrajectoryControlMessage(control::TrajectoryControlMessage::TRAJECTORY_START, 2,
+                                            RobotReceiveTimeout::off()));
+  // The program opens the trajectory socket after the reverse socket, so it might not be connected, yet
+  ASSERT_TRUE(waitFor([&]() { return driver->writeTrajectoryPoint(first_point, false, 1.0); }));
+  ASSERT_TRUE(driver->writeTrajectoryPoint(last_point, false, 1.0));
+
+  ASSERT_TRUE(waitFor([&]() { return trajectory_done.load(); }));
+  EXPECT_EQ(trajectory_result, control::TrajectoryResult::TRAJECTORY_RESULT_SUCCESS);
+  EXPECT_EQ(robot_->getJointPositions(), last_point);
+}
+
+TEST_F(FakeRobotTest, dashboard_play_requests_program_from_script_sender)
+{
+  auto driver = createDriver(false);
+  EXPECT_FALSE(robot_->isProgramRunning());
+
+  DashboardClient dashboard_client(ROBOT_IP, robot_->getDashboardPort());
+  ASSERT_TRUE(dashboard_client.connect());
+  ASSERT_TRUE(dashboard_client.commandPlay());
+  ASSERT_TRUE(waitForProgramState(true));
+  EXPECT_NE(robot_->getProgram().find("socket_open"), std::string::npos);
+
+  ASSERT_TRUE(dashboard_client.commandStop());
+  EXPECT_TRUE(waitForProgramState(false));
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
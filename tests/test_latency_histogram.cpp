@@ -0,0 +1,205 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include <ur_client_library/comm/latency_histogram.h>
+#include <ur_client_library/ur/latency_statistics.h>
+
+using namespace urcl;
+using namespace std::chrono_literals;
+
+TEST(latency_histogram, empty_histogram_reports_zero)
+{
+  comm::LatencyHistogram histogram;
+  comm::LatencySummary summary = histogram.getSummary();
+  EXPECT_EQ(summary.count, 0u);
+  EXPECT_EQ(summary.min, 0ns);
+  EXPECT_EQ(summary.max, 0ns);
+  EXPECT_EQ(histogram.getValueAtPercentile(50.0), 0ns);
+}
+
+TEST(latency_histogram, small_values_are_exact)
+{
+  comm::LatencyHistogram histogram;
+  for (int i = 1; i <= 20; ++i)
+  {
+    histogram.record(std::chrono::nanoseconds(i));
+  }
+  EXPECT_EQ(histogram.getCount(), 20u);
+  EXPECT_EQ(histogram.getValueAtPercentile(50.0), 10ns);
+  EXPECT_EQ(histogram.getValueAtPercentile(100.0), 20ns);
+  EXPECT_EQ(histogram.getValueAtPercentile(0.0), 1ns);
+}
+
+TEST(latency_histogram, percentiles_have_bounded_relative_error)
+{
+  comm::LatencyHistogram histogram;
+  for (int64_t i = 1; i <= 10000; ++i)
+  {
+    histogram.record(std::chrono::microseconds(i));
+  }
+
+  comm::LatencySummary summary = histogram.getSummary();
+  EXPECT_EQ(summary.count, 10000u);
+  EXPECT_EQ(summary.min, 1us);
+  EXPECT_EQ(summary.max, 10000us);
+  EXPECT_NEAR(summary.mean.count(), 5000500, 1);
+
+  const std::vector<std::pair<std::chrono::nanoseconds, std::chrono::nanoseconds>> expected = {
+    { summary.p50, 5000us }, { summary.p90, 9000us }, { summary.p99, 9900us }, { summary.p999, 9990us }
+  };
+  for (auto& item : expected)
+  {
+    EXPECT_GE(item.first, item.second);
+    EXPECT_LE(item.first.count(), item.second.count() * 1.04);
+  }
+}
+
+TEST(latency_histogram, negative_and_huge_values_are_clamped)
+{
+  comm::LatencyHistogram histogram;
+  histogram.record(-5ns);
+  histogram.record(std::chrono::hours(1));
+  EXPECT_EQ(histogram.getSummary().min, 0ns);
+  EXPECT_GT(histogram.getSummary().max, std::chrono::minutes(18));
+  EXPECT_LT(histogram.getSummary().max, std::chrono::minutes(19));
+  EXPECT_EQ(histogram.getValueAtPercentile(100.0), histogram.getSummary().max);
+}
+
+TEST(latency_histogram, concurrent_recording_counts_all_values)
+{
+  comm::LatencyHistogram histogram;
+  std::vector<std::thread> threads;
+  for (int t = 0; t < 4; ++t)
+  {
+    threads.emplace_back([&histogram, t]() {
+      for (int i = 0; i < 10000; ++i)
+      {
+        histogram.record(std::chrono::nanoseconds(100 * (t + 1)));
+      }
+    });
+  }
+  for (auto& thread : threads)
+  {
+    thread.join();
+  }
+  EXPECT_EQ(histogram.getCount(), 40000u);
+  EXPECT_EQ(histogram.getSummary().min, 100ns);
+  EXPECT_EQ(histogram.getSummary().max, 400ns);
+}
+
+TEST(latency_histogram, reset_discards_values)
+{
+  comm::LatencyHistogram histogram;
+  histogram.record(10us);
+  histogram.reset();
+  EXPECT_EQ(histogram.getCount(), 0u);
+  histogram.record(20us);
+  EXPECT_EQ(histogram.getSummary().min, 20us);
+  EXPECT_EQ(histogram.getSummary().max, 20us);
+}
+
+namespace
+{
+comm::PackageTimestamps makeTimestamps(const std::chrono::steady_clock::time_point received)
+{
+  comm::PackageTimestamps timestamps;
+  timestamps.received = received;
+  timestamps.parsed = received + 10us;
+  timestamps.enqueued = received + 12us;
+  timestamps.dequeued = received + 50us;
+  return timestamps;
+}
+}  // namespace
+
+TEST(latency_monitor, stages_are_recorded)
+{
+  LatencyMonitor monitor(2ms);
+  const auto start = std::chrono::steady_clock::time_point(1s);
+  monitor.packageFetched(makeTimestamps(start));
+  monitor.commandWritten(start + 150us);
+
+  LatencyStatistics statistics = monitor.getStatistics();
+  EXPECT_EQ(statistics.num_cycles, 1u);
+  EXPECT_EQ(statistics.receive_to_parse.max, 10us);
+  EXPECT_EQ(statistics.parse_to_enqueue.max, 2us);
+  EXPECT_EQ(statistics.enqueue_to_dequeue.max, 38us);
+  EXPECT_EQ(statistics.dequeue_to_write.max, 100us);
+  EXPECT_EQ(statistics.round_trip.max, 150us);
+  EXPECT_EQ(statistics.missed_cycles, 0u);
+  EXPECT_EQ(statistics.late_commands, 0u);
+}
+
+TEST(latency_monitor, only_first_command_answers_package)
+{
+  LatencyMonitor monitor(2ms);
+  const auto start = std::chrono::steady_clock::time_point(1s);
+  monitor.commandWritten(start);
+  monitor.packageFetched(makeTimestamps(start));
+  monitor.commandWritten(start + 100us);
+  monitor.commandWritten(start + 200us);
+
+  EXPECT_EQ(monitor.getStatistics().round_trip.count, 1u);
+  EXPECT_EQ(monitor.getStatistics().round_trip.max, 100us);
+}
+
+TEST(latency_monitor, missed_cycles_and_late_commands_are_counted)
+{
+  LatencyMonitor monitor(2ms);
+  const auto start = std::chrono::steady_clock::time_point(1s);
+  monitor.packageFetched(makeTimestamps(start));
+  monitor.commandWritten(start + 100us);
+  // Two packages in between were never fetched
+  monitor.packageFetched(makeTimestamps(start + 6ms + 30us));
+  monitor.commandWritten(start + 9ms);
+
+  LatencyStatistics statistics = monitor.getStatistics();
+  EXPECT_EQ(statistics.num_cycles, 2u);
+  EXPECT_EQ(statistics.missed_cycles, 2u);
+  EXPECT_EQ(statistics.late_commands, 1u);
+  EXPECT_EQ(statistics.cycle_jitter.max, 30us);
+
+  monitor.reset();
+  statistics = monitor.getStatistics();
+  EXPECT_EQ(statistics.num_cycles, 0u);
+  EXPECT_EQ(statistics.missed_cycles, 0u);
+  EXPECT_EQ(statistics.round_trip.count, 0u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,209 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <ur_client_library/log.h>
+
+using namespace urcl;
+
+struct LoggedMessage
+{
+  std::string file;
+  int line;
+  LogLevel level;
+  std::string text;
+  std::thread::id thread;
+};
+
+std::mutex g_messages_mutex;
+std::vector<LoggedMessage> g_messages;
+
+class CollectingLogHandler : public LogHandler
+{
+public:
+  void log(const char* file, int line, LogLevel loglevel, const char* log) override
+  {
+    std::lock_guard<std::mutex> lock(g_messages_mutex);
+    g_messages.push_back({ file, line, loglevel, log, std::this_thread::get_id() });
+  }
+};
+
+class LogTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    g_messages.clear();
+    registerLogHandler(std::unique_ptr<LogHandler>(new CollectingLogHandler()));
+  }
+
+  void TearDown() override
+  {
+    stopAsyncLogging();
+    unregisterLogHandler();
+  }
+
+  // Number of collected messages starting with the given prefix
+  size_t countMessages(const std::string& prefix)
+  {
+    std::lock_guard<std::mutex> lock(g_messages_mutex);
+    size_t count = 0;
+    for (auto& message : g_messages)
+    {
+      count += message.text.compare(0, prefix.size(), prefix) == 0 ? 1 : 0;
+    }
+    return count;
+  }
+};
+
+TEST_F(LogTest, long_messages_are_logged_synchronously)
+{
+  const std::string text(3000, 'x');
+  URCL_LOG_INFO("%s", text.c_str());
+
+  ASSERT_EQ(g_messages.size(), 1u);
+  EXPECT_EQ(g_messages[0].text, text);
+  EXPECT_EQ(g_messages[0].thread, std::this_thread::get_id());
+}
+
+TEST_F(LogTest, async_messages_are_handled_by_logging_thread)
+{
+  startAsyncLogging();
+  const int line = __LINE__ + 1;
+  URCL_LOG_WARN("Message %d from %s", 1, "test");
+  stopAsyncLogging();
+
+  ASSERT_EQ(g_messages.size(), 1u);
+  EXPECT_EQ(g_messages[0].file, __FILE__);
+  EXPECT_EQ(g_messages[0].line, line);
+  EXPECT_EQ(g_messages[0].level, LogLevel::WARN);
+  EXPECT_EQ(g_messages[0].text, "Message 1 from test");
+  EXPECT_NE(g_messages[0].thread, std::this_thread::get_id());
+}
+
+TEST_F(LogTest, async_messages_of_ended_threads_are_handled)
+{
+  startAsyncLogging();
+  std::thread thread([] { URCL_LOG_INFO("Message from thread"); });
+  thread.join();
+  stopAsyncLogging();
+
+  EXPECT_EQ(countMessages("Message from thread"), 1u);
+}
+
+TEST_F(LogTest, repeated_messages_are_deduplicated)
+{
+  startAsyncLogging(128, 0);
+  for (size_t i = 0; i < 10; ++i)
+  {
+    URCL_LOG_ERROR("Pipeline producer overflowed!");
+  }
+  stopAsyncLogging();
+
+  ASSERT_EQ(g_messages.size(), 2u);
+  EXPECT_EQ(g_messages[0].text, "Pipeline producer overflowed!");
+  EXPECT_EQ(g_messages[1].text, "Last message repeated 9 times");
+  EXPECT_EQ(g_messages[1].line, g_messages[0].line);
+}
+
+TEST_F(LogTest, rate_limit_suppresses_messages)
+{
+  startAsyncLogging(128, 5);
+  for (int i = 0; i < 20; ++i)
+  {
+    URCL_LOG_INFO("Message %d", i);
+  }
+  stopAsyncLogging();
+
+  // Tokens might have been refilled while logging
+  const size_t passed = countMessages("Message");
+  EXPECT_GE(passed, 5u);
+  EXPECT_LT(passed, 20u);
+  EXPECT_EQ(countMessages("Suppressed " + std::to_string(20 - passed) + " messages"), 1u);
+}
+
+TEST_F(LogTest, full_buffer_drops_messages)
+{
+  const size_t num_messages = 100;
+  startAsyncLogging(4, 0);
+  for (size_t i = 0; i < num_messages; ++i)
+  {
+    URCL_LOG_INFO("Message %zu", i);
+  }
+  stopAsyncLogging();
+
+  size_t dropped = 0;
+  for (auto& message : g_messages)
+  {
+    std::sscanf(message.text.c_str(), "Dropped %zu log messages", &dropped);
+  }
+  EXPECT_EQ(countMessages("Message") + dropped, num_messages);
+}
+
+TEST_F(LogTest, no_messages_are_lost_when_stopping)
+{
+  const size_t num_messages = 2000;
+  std::atomic<bool> done(false);
+  std::thread thread([&] {
+    for (size_t i = 0; i < num_messages; ++i)
+    {
+      URCL_LOG_INFO("Message %zu", i);
+      std::this_thread::sleep_for(std::chrono::microseconds(10));
+    }
+    done = true;
+  });
+
+  // Switch between asynchronous and synchronous logging while the thread logs
+  while (!done)
+  {
+    startAsyncLogging(num_messages, 0);
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+    stopAsyncLogging();
+  }
+  thread.join();
+
+  EXPECT_EQ(countMessages("Message"), num_messages);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
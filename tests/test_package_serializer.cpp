@@ -30,6 +30,7 @@
 
 #include <gtest/gtest.h>
 #include <ur_client_library/comm/package_serializer.h>
+#include <ur_client_library/types.h>
 
 using namespace urcl;
 
@@ -80,6 +81,24 @@ TEST(package_serializer, serialize_int32)
   }
 }
 
+TEST(package_serializer, serialize_vector6d)
+{
+  uint8_t buffer[6 * sizeof(double)];
+  vector6d_t values = { 2.341, 0.0, 0.0, 0.0, 0.0, -2.341 };
+  size_t expected_size = sizeof(buffer);
+  size_t actual_size = comm::PackageSerializer::serialize(buffer, values);
+
+  EXPECT_EQ(expected_size, actual_size);
+
+  uint8_t expected_first[] = { 0x40, 0x02, 0xba, 0x5e, 0x35, 0x3f, 0x7c, 0xee };
+  uint8_t expected_last[] = { 0xc0, 0x02, 0xba, 0x5e, 0x35, 0x3f, 0x7c, 0xee };
+  for (unsigned int i = 0; i < sizeof(double); ++i)
+  {
+    EXPECT_EQ(expected_first[i], buffer[i]);
+    EXPECT_EQ(expected_last[i], buffer[5 * sizeof(double) + i]);
+  }
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
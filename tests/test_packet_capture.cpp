@@ -0,0 +1,265 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <thread>
+#include <unistd.h>
+
+#include <ur_client_library/comm/packet_capture.h>
+#include <ur_client_library/comm/stream.h>
+#include <ur_client_library/comm/tcp_server.h>
+#include <ur_client_library/rtde/rtde_package.h>
+
+using namespace urcl;
+
+class PacketCaptureTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // ctest runs the tests in separate processes, possibly in parallel, so each of them needs its own file
+    const std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    capture_file_ = "test_capture_" + test_name + "_" + std::to_string(getpid()) + ".urcl";
+  }
+
+  void TearDown() override
+  {
+    std::remove(capture_file_.c_str());
+  }
+
+  std::vector<comm::RecordedFrame> readFrames(comm::RecordingReader& reader)
+  {
+    std::vector<comm::RecordedFrame> frames;
+    comm::RecordedFrame frame;
+    while (reader.next(frame))
+    {
+      frames.push_back(frame);
+    }
+    return frames;
+  }
+
+  std::string toString(const comm::RecordedFrame& frame)
+  {
+    return std::string(reinterpret_cast<const char*>(frame.data), frame.size);
+  }
+
+  std::string capture_file_;
+};
+
+TEST_F(PacketCaptureTest, directions_and_channels_are_stored)
+{
+  const std::string request = "request";
+  const std::string answer = "answer";
+  {
+    comm::PacketCapture capture(capture_file_);
+    EXPECT_TRUE(capture.capture(comm::CaptureDirection::OUTBOUND, reinterpret_cast<const uint8_t*>(request.data()),
+                                request.size(), 5));
+    EXPECT_TRUE(capture.capture(comm::CaptureDirection::INBOUND, reinterpret_cast<const uint8_t*>(answer.data()),
+                                answer.size(), 7));
+  }
+
+  comm::RecordingReader reader(capture_file_);
+  EXPECT_EQ(reader.getType(), comm::RecordingType::CAPTURE);
+  std::vector<comm::RecordedFrame> frames = readFrames(reader);
+  ASSERT_EQ(frames.size(), 2u);
+
+  EXPECT_EQ(toString(frames[0]), request);
+  EXPECT_EQ(comm::PacketCapture::getDirection(frames[0]), comm::CaptureDirection::OUTBOUND);
+  EXPECT_EQ(comm::PacketCapture::getChannel(frames[0]), 5u);
+  EXPECT_EQ(toString(frames[1]), answer);
+  EXPECT_EQ(comm::PacketCapture::getDirection(frames[1]), comm::CaptureDirection::INBOUND);
+  EXPECT_EQ(comm::PacketCapture::getChannel(frames[1]), 7u);
+  EXPECT_LE(frames[0].time, frames[1].time);
+}
+
+TEST_F(PacketCaptureTest, chunks_larger_than_buffer_are_dropped)
+{
+  comm::PacketCapture capture(capture_file_, 256);
+  std::vector<uint8_t> chunk(256);
+  EXPECT_FALSE(capture.capture(comm::CaptureDirection::INBOUND, chunk.data(), chunk.size()));
+  EXPECT_EQ(capture.getNumDropped(), 1u);
+}
+
+TEST_F(PacketCaptureTest, ring_buffer_wraps_around)
+{
+  const size_t num_chunks = 200;
+  {
+    comm::PacketCapture capture(capture_file_, 256);
+    std::vector<uint8_t> chunk;
+    for (size_t i = 0; i < num_chunks; ++i)
+    {
+      // Varying sizes, so chunks end at different positions of the ring buffer
+      chunk.assign(1 + i % 50, static_cast<uint8_t>(i));
+      while (!capture.capture(comm::CaptureDirection::INBOUND, chunk.data(), chunk.size()))
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+  }
+
+  comm::RecordingReader reader(capture_file_);
+  std::vector<comm::RecordedFrame> frames = readFrames(reader);
+  ASSERT_EQ(frames.size(), num_chunks);
+  for (size_t i = 0; i < num_chunks; ++i)
+  {
+    ASSERT_EQ(frames[i].size, 1 + i % 50);
+    EXPECT_EQ(frames[i].data[0], static_cast<uint8_t>(i));
+    EXPECT_EQ(frames[i].data[frames[i].size - 1], static_cast<uint8_t>(i));
+  }
+}
+
+TEST_F(PacketCaptureTest, multiple_threads_capture_concurrently)
+{
+  const size_t num_threads = 4;
+  const size_t num_chunks = 500;
+  {
+    comm::PacketCapture capture(capture_file_, 1024);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < num_threads; ++t)
+    {
+      threads.emplace_back([&capture, t]() {
+        std::vector<uint8_t> chunk;
+        for (size_t i = 0; i < num_chunks; ++i)
+        {
+          chunk.assign(1 + i % 40, static_cast<uint8_t>(i));
+          while (!capture.capture(comm::CaptureDirection::OUTBOUND, chunk.data(), chunk.size(), t))
+          {
+            std::this_thread::yield();
+          }
+        }
+      });
+    }
+    for (auto& thread : threads)
+    {
+      thread.join();
+    }
+  }
+
+  comm::RecordingReader reader(capture_file_);
+  std::vector<comm::RecordedFrame> frames = readFrames(reader);
+  ASSERT_EQ(frames.size(), num_threads * num_chunks);
+
+  // Each thread's chunks are complete and keep their order
+  std::vector<size_t> next(num_threads, 0);
+  for (const auto& frame : frames)
+  {
+    const uint32_t t = comm::PacketCapture::getChannel(frame);
+    ASSERT_LT(t, num_threads);
+    const size_t i = next[t]++;
+    ASSERT_EQ(frame.size, 1 + i % 40);
+    for (size_t j = 0; j < frame.size; ++j)
+    {
+      ASSERT_EQ(frame.data[j], static_cast<uint8_t>(i));
+    }
+  }
+  for (size_t t = 0; t < num_threads; ++t)
+  {
+    EXPECT_EQ(next[t], num_chunks);
+  }
+}
+
+TEST_F(PacketCaptureTest, stream_and_server_traffic_is_captured)
+{
+  std::mutex mutex;
+  std::condition_variable cv;
+  int client_fd = -1;
+  std::string received;
+
+  // Both sides share one capture and are told apart by their channels
+  const uint32_t stream_channel = 1000;
+  auto capture = std::make_shared<comm::PacketCapture>(capture_file_);
+  {
+    comm::TCPServer server(60010);
+    server.setConnectCallback([&](const int fd) {
+      std::lock_guard<std::mutex> lk(mutex);
+      client_fd = fd;
+      cv.notify_one();
+    });
+    server.setMessageCallback([&](const int fd, char* buffer, int nbytesrecv) {
+      std::lock_guard<std::mutex> lk(mutex);
+      received.append(buffer, nbytesrecv);
+      cv.notify_one();
+    });
+    server.setPacketCapture(capture);
+    server.start();
+
+    comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60010);
+    stream.setPacketCapture(capture, stream_channel);
+    ASSERT_TRUE(stream.connect());
+
+    const std::string request = "request";
+    size_t written;
+    ASSERT_TRUE(stream.write(reinterpret_cast<const uint8_t*>(request.data()), request.size(), written));
+    {
+      std::unique_lock<std::mutex> lk(mutex);
+      ASSERT_TRUE(cv.wait_for(lk, std::chrono::seconds(1), [&] { return client_fd >= 0 && received == request; }));
+    }
+
+    // RTDE package consisting of the header only
+    const uint8_t answer[] = { 0x00, 0x03, 0x56 };
+    ASSERT_TRUE(server.write(client_fd, answer, sizeof(answer), written));
+    uint8_t* package;
+    size_t length;
+    ASSERT_TRUE(stream.readPackage(package, length));
+    EXPECT_EQ(length, sizeof(answer));
+  }
+  capture.reset();
+
+  comm::RecordingReader reader(capture_file_);
+  std::vector<comm::RecordedFrame> stream_frames;
+  std::vector<comm::RecordedFrame> server_frames;
+  for (const auto& frame : readFrames(reader))
+  {
+    (comm::PacketCapture::getChannel(frame) == stream_channel ? stream_frames : server_frames).push_back(frame);
+  }
+
+  ASSERT_EQ(stream_frames.size(), 2u);
+  EXPECT_EQ(comm::PacketCapture::getDirection(stream_frames[0]), comm::CaptureDirection::OUTBOUND);
+  EXPECT_EQ(toString(stream_frames[0]), "request");
+  EXPECT_EQ(comm::PacketCapture::getDirection(stream_frames[1]), comm::CaptureDirection::INBOUND);
+  EXPECT_EQ(stream_frames[1].size, 3u);
+
+  ASSERT_EQ(server_frames.size(), 2u);
+  EXPECT_EQ(comm::PacketCapture::getDirection(server_frames[0]), comm::CaptureDirection::INBOUND);
+  EXPECT_EQ(comm::PacketCapture::getChannel(server_frames[0]), static_cast<uint32_t>(client_fd));
+  EXPECT_EQ(toString(server_frames[0]), "request");
+  EXPECT_EQ(comm::PacketCapture::getDirection(server_frames[1]), comm::CaptureDirection::OUTBOUND);
+  EXPECT_EQ(server_frames[1].size, 3u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
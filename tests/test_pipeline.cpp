@@ -29,6 +29,7 @@
 // -- END LICENSE BLOCK ------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <condition_variable>
 
 #include <ur_client_library/comm/pipeline.h>
@@ -197,6 +198,148 @@ TEST_F(PipelineTest, stop_pipeline)
   EXPECT_EQ(pipeline_->getLatestProduct(urpackage, timeout), false);
 }
 
+TEST_F(PipelineTest, count_flushed_products)
+{
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  // Three RTDE packages with timestamps 7103.8579, 7103.8580 and 7103.8581
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0x9f, 0x55, 0x9b, 0x3d,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf8,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xac, 0x71, 0x0c, 0xb3 };
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+  EXPECT_TRUE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(500)));
+  rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(urpackage.get());
+  ASSERT_NE(data, nullptr);
+  double timestamp;
+  data->getData("timestamp", timestamp);
+  EXPECT_DOUBLE_EQ(timestamp, 7103.8581);
+  EXPECT_EQ(pipeline_->getNumDroppedProducts(), 2u);
+}
+
+TEST_F(PipelineTest, latest_value_pipeline)
+{
+  pipeline_.reset(new comm::Pipeline<rtde_interface::RTDEPackage>(*producer_.get(), "RTDE_PIPELINE", notifier_, false,
+                                                                  comm::PipelineTransport::LATEST_VALUE));
+  EXPECT_EQ(pipeline_->getTransport(), comm::PipelineTransport::LATEST_VALUE);
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+  EXPECT_FALSE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(100)));
+
+  // Three RTDE packages with timestamps 7103.8579, 7103.8580 and 7103.8581
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0x9f, 0x55, 0x9b, 0x3d,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf8,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xac, 0x71, 0x0c, 0xb3 };
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // Only the latest package is handed out, the others got overwritten
+  EXPECT_TRUE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(500)));
+  rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(urpackage.get());
+  ASSERT_NE(data, nullptr);
+  double timestamp;
+  data->getData("timestamp", timestamp);
+  EXPECT_DOUBLE_EQ(timestamp, 7103.8581);
+  EXPECT_EQ(pipeline_->getNumDroppedProducts(), 2u);
+
+  // The package was already fetched
+  EXPECT_FALSE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(100)));
+
+  // Waiting for a package
+  std::thread writer([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    server_->write(client_fd_, data_packages, 12, written);
+  });
+  EXPECT_TRUE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(1000)));
+  data = dynamic_cast<rtde_interface::DataPackage*>(urpackage.get());
+  ASSERT_NE(data, nullptr);
+  data->getData("timestamp", timestamp);
+  EXPECT_FLOAT_EQ(timestamp, 7103.8579);
+  writer.join();
+
+  pipeline_->stop();
+}
+
+TEST_F(PipelineTest, latest_value_pipeline_routes_products)
+{
+  pipeline_.reset(new comm::Pipeline<rtde_interface::RTDEPackage>(*producer_.get(), "RTDE_PIPELINE", notifier_, false,
+                                                                  comm::PipelineTransport::LATEST_VALUE));
+  pipeline_->setProductRouter([](const rtde_interface::RTDEPackage& package) {
+    if (dynamic_cast<const rtde_interface::DataPackage*>(&package) != nullptr)
+    {
+      return comm::ProductRoute::LATEST_VALUE;
+    }
+    if (dynamic_cast<const rtde_interface::TextMessage*>(&package) != nullptr)
+    {
+      return comm::ProductRoute::DISCARD;
+    }
+    return comm::ProductRoute::QUEUE;
+  });
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  // An accepted start request and a text message followed by two data packages, which would
+  // overwrite the answer
+  uint8_t packages[] = { 0x00, 0x04, 0x53, 0x01, 0x00, 0x09, 0x4d, 0x02, 0x68, 0x69, 0x01, 0x78,
+                         0x03, 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0x9f, 0x55, 0x9b,
+                         0x3d, 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf8 };
+  size_t written;
+  server_->write(client_fd_, packages, sizeof(packages), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+  EXPECT_TRUE(pipeline_->getQueuedProduct(urpackage, std::chrono::milliseconds(500)));
+  rtde_interface::ControlPackageStart* start = dynamic_cast<rtde_interface::ControlPackageStart*>(urpackage.get());
+  ASSERT_NE(start, nullptr);
+  EXPECT_TRUE(start->accepted_);
+  EXPECT_FALSE(pipeline_->getQueuedProduct(urpackage, std::chrono::milliseconds(100)));
+
+  EXPECT_TRUE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(500)));
+  rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(urpackage.get());
+  ASSERT_NE(data, nullptr);
+  double timestamp;
+  data->getData("timestamp", timestamp);
+  EXPECT_DOUBLE_EQ(timestamp, 7103.8580);
+  EXPECT_EQ(pipeline_->getNumDroppedProducts(), 1u);
+
+  pipeline_->stop();
+}
+
+TEST_F(PipelineTest, produced_callback_is_called_for_every_product)
+{
+  pipeline_.reset(new comm::Pipeline<rtde_interface::RTDEPackage>(*producer_.get(), "RTDE_PIPELINE", notifier_, false,
+                                                                  comm::PipelineTransport::LATEST_VALUE));
+  std::atomic<size_t> num_produced(0);
+  pipeline_->setProducedCallback([&num_produced](const rtde_interface::RTDEPackage& package) {
+    EXPECT_NE(dynamic_cast<const rtde_interface::DataPackage*>(&package), nullptr);
+    num_produced++;
+  });
+  waitForConnectionCallback();
+  pipeline_->run();
+
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0x9f, 0x55, 0x9b, 0x3d,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf8,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xac, 0x71, 0x0c, 0xb3 };
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+
+  std::unique_ptr<rtde_interface::RTDEPackage> urpackage;
+  EXPECT_TRUE(pipeline_->getLatestProduct(urpackage, std::chrono::milliseconds(500)));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  // Products that got overwritten in the latest-value buffer were seen by the callback as well
+  EXPECT_EQ(num_produced, 3u);
+
+  pipeline_->stop();
+}
+
 TEST_F(PipelineTest, consumer_pipeline)
 {
   stream_.reset(new comm::URStream<rtde_interface::RTDEPackage>("127.0.0.1", 60002));
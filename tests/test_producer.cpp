@@ -31,6 +31,7 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <condition_variable>
+#include <thread>
 
 #include <ur_client_library/comm/producer.h>
 #include <ur_client_library/comm/stream.h>
@@ -120,6 +121,124 @@ TEST_F(ProducerTest, get_data_package)
   producer.stopProducer();
 }
 
+TEST_F(ProducerTest, get_all_received_data_packages_at_once)
+{
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60002);
+  std::vector<std::string> recipe = { "timestamp" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+
+  producer.setupProducer();
+  waitForConnectionCallback();
+  producer.startProducer();
+
+  // Three RTDE packages with timestamps 7103.8579, 7103.8580 and 7103.8581 followed by the first
+  // part of another package
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0x9f, 0x55, 0x9b, 0x3d,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf8,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xac, 0x71, 0x0c, 0xb3,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb };
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  EXPECT_TRUE(producer.tryGet(products));
+  ASSERT_EQ(products.size(), 3u);
+
+  const double expected_timestamps[] = { 7103.8579, 7103.8580, 7103.8581 };
+  for (size_t i = 0; i < products.size(); ++i)
+  {
+    rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(products[i].get());
+    ASSERT_NE(data, nullptr);
+    double timestamp;
+    data->getData("timestamp", timestamp);
+    EXPECT_DOUBLE_EQ(timestamp, expected_timestamps[i]);
+    // All packages were received in a single read, even though they are parsed one after another
+    EXPECT_EQ(products[i]->getTimestamps().received, products[0]->getTimestamps().received);
+    EXPECT_LE(products[i]->getTimestamps().received, products[i]->getTimestamps().parsed);
+  }
+  EXPECT_EQ(products[0]->getTimestamps().received, stream.getLastReadTime());
+
+  // The incomplete package is produced as soon as its remainder arrives
+  uint8_t remainder[] = { 0xbf, 0xdb, 0x9f, 0x55, 0x9b, 0x3d };
+  server_->write(client_fd_, remainder, sizeof(remainder), written);
+  products.clear();
+  const auto before_remainder = std::chrono::steady_clock::now();
+  EXPECT_TRUE(producer.tryGet(products));
+  ASSERT_EQ(products.size(), 1u);
+  EXPECT_GE(products[0]->getTimestamps().received, before_remainder);
+
+  producer.stopProducer();
+}
+
+TEST_F(ProducerTest, packages_before_broken_package_are_returned)
+{
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60002);
+  std::vector<std::string> recipe = { "timestamp" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+
+  producer.setupProducer();
+  waitForConnectionCallback();
+  producer.startProducer();
+
+  // Two RTDE packages with timestamps 7103.8579 and 7103.8581 with a package in between that
+  // contains one byte more than the recipe
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0x9f, 0x55, 0x9b, 0x3d, 0x00,
+                              0x0d, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf8, 0x00, 0x00,
+                              0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xac, 0x71, 0x0c, 0xb3 };
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  EXPECT_TRUE(producer.tryGet(products));
+  ASSERT_EQ(products.size(), 1u);
+  rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(products[0].get());
+  ASSERT_NE(data, nullptr);
+  double timestamp;
+  data->getData("timestamp", timestamp);
+  EXPECT_DOUBLE_EQ(timestamp, 7103.8579);
+
+  // The broken package is reported afterwards
+  products.clear();
+  EXPECT_FALSE(producer.tryGet(products));
+  EXPECT_TRUE(products.empty());
+
+  producer.stopProducer();
+}
+
+TEST_F(ProducerTest, data_packages_carry_receive_timestamps)
+{
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60002);
+  stream.setReceiveTimestamping(true);
+  std::vector<std::string> recipe = { "timestamp" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  comm::URProducer<rtde_interface::RTDEPackage> producer(stream, parser);
+
+  producer.setupProducer();
+  waitForConnectionCallback();
+  producer.startProducer();
+
+  const auto before = std::chrono::system_clock::now();
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf7 };
+  size_t written;
+  server_->write(client_fd_, data_package, sizeof(data_package), written);
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  ASSERT_TRUE(producer.tryGet(products));
+  ASSERT_EQ(products.size(), 1u);
+  const comm::PackageTimestamps& timestamps = products[0]->getTimestamps();
+  EXPECT_GE(timestamps.kernel_received, before - std::chrono::milliseconds(1));
+  EXPECT_LE(timestamps.kernel_received, std::chrono::system_clock::now());
+
+  producer.stopProducer();
+}
+
 TEST_F(ProducerTest, connect_non_connected_robot)
 {
   comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 12321);
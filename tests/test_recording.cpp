@@ -0,0 +1,246 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <unistd.h>
+
+#include <ur_client_library/comm/recording.h>
+#include <ur_client_library/exceptions.h>
+#include <ur_client_library/rtde/rtde_parser.h>
+#include <ur_client_library/rtde/rtde_recorder.h>
+
+using namespace urcl;
+
+class RecordingTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // ctest runs the tests in separate processes, possibly in parallel, so each of them needs its own file
+    const std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    recording_file_ = "test_recording_" + test_name + "_" + std::to_string(getpid()) + ".urcl";
+  }
+
+  void TearDown() override
+  {
+    std::remove(recording_file_.c_str());
+  }
+
+  std::chrono::steady_clock::time_point timeOf(const size_t frame)
+  {
+    return std::chrono::steady_clock::time_point(std::chrono::milliseconds(1000 + 2 * frame));
+  }
+
+  // Writes frames of the given size, each filled with its index
+  void writeFrames(comm::RecordingWriter& writer, const size_t num_frames, const size_t size)
+  {
+    std::vector<uint8_t> data(size);
+    for (size_t i = 0; i < num_frames; ++i)
+    {
+      std::fill(data.begin(), data.end(), static_cast<uint8_t>(i));
+      ASSERT_TRUE(writer.append(timeOf(i), data.data(), data.size()));
+    }
+  }
+
+  std::string recording_file_;
+};
+
+TEST_F(RecordingTest, frames_are_read_back)
+{
+  {
+    comm::RecordingWriter writer(recording_file_, comm::RecordingType::PRIMARY, 3, "some metadata");
+    writeFrames(writer, 3, 13);
+    EXPECT_EQ(writer.getNumFrames(), 3u);
+  }
+
+  comm::RecordingReader reader(recording_file_);
+  EXPECT_EQ(reader.getType(), comm::RecordingType::PRIMARY);
+  EXPECT_EQ(reader.getProtocolVersion(), 3u);
+  EXPECT_EQ(reader.getMetadata(), "some metadata");
+  EXPECT_EQ(reader.getNumFrames(), 3u);
+
+  comm::RecordedFrame frame;
+  for (size_t i = 0; i < 3; ++i)
+  {
+    ASSERT_TRUE(reader.peek(frame));
+    EXPECT_EQ(frame.time, timeOf(i));
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_EQ(frame.time, timeOf(i));
+    ASSERT_EQ(frame.size, 13u);
+    EXPECT_EQ(frame.data[0], i);
+    EXPECT_EQ(frame.data[12], i);
+  }
+  EXPECT_FALSE(reader.peek(frame));
+  EXPECT_FALSE(reader.next(frame));
+
+  reader.rewind();
+  ASSERT_TRUE(reader.next(frame));
+  EXPECT_EQ(frame.time, timeOf(0));
+}
+
+TEST_F(RecordingTest, seek_finds_frames_in_all_blocks)
+{
+  {
+    // Small blocks, so the frames are spread over many blocks
+    comm::RecordingWriter writer(recording_file_, comm::RecordingType::PRIMARY, 1, "", 4096);
+    writeFrames(writer, 100, 1000);
+    std::vector<uint8_t> too_large(8192);
+    EXPECT_FALSE(writer.append(timeOf(100), too_large.data(), too_large.size()));
+  }
+
+  comm::RecordingReader reader(recording_file_);
+  EXPECT_EQ(reader.getNumFrames(), 100u);
+
+  comm::RecordedFrame frame;
+  for (size_t i : { 57u, 0u, 99u, 4u, 3u })
+  {
+    reader.seek(timeOf(i));
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_EQ(frame.time, timeOf(i));
+    EXPECT_EQ(frame.data[999], i);
+  }
+
+  // Times between frames continue with the next frame
+  reader.seek(timeOf(41) + std::chrono::milliseconds(1));
+  ASSERT_TRUE(reader.next(frame));
+  EXPECT_EQ(frame.data[0], 42);
+
+  reader.seek(timeOf(0) - std::chrono::seconds(1));
+  ASSERT_TRUE(reader.next(frame));
+  EXPECT_EQ(frame.data[0], 0);
+
+  reader.seek(timeOf(100));
+  EXPECT_FALSE(reader.next(frame));
+}
+
+TEST_F(RecordingTest, recording_is_readable_while_being_written)
+{
+  comm::RecordingWriter writer(recording_file_, comm::RecordingType::PRIMARY, 1, "", 4096);
+  writeFrames(writer, 10, 100);
+
+  comm::RecordingReader reader(recording_file_);
+  EXPECT_EQ(reader.getNumFrames(), 10u);
+  comm::RecordedFrame frame;
+  size_t num_frames = 0;
+  while (reader.next(frame))
+  {
+    num_frames++;
+  }
+  EXPECT_EQ(num_frames, 10u);
+}
+
+TEST_F(RecordingTest, invalid_files_are_rejected)
+{
+  EXPECT_THROW(comm::RecordingReader("does_not_exist.urcl"), UrException);
+
+  std::ofstream file(recording_file_);
+  file << "This is not a recording, but it is long enough to contain a header.";
+  file.close();
+  EXPECT_THROW(comm::RecordingReader reader(recording_file_), UrException);
+}
+
+TEST_F(RecordingTest, rtde_recorder_records_data_packages)
+{
+  const std::vector<std::string> recipe = { "timestamp", "actual_q", "robot_mode" };
+  auto layout = std::make_shared<const rtde_interface::DataPackage::RecipeLayout>(recipe);
+  auto timestamp = layout->getFieldHandle<double>("timestamp");
+  auto robot_mode = layout->getFieldHandle<int32_t>("robot_mode");
+
+  {
+    rtde_interface::RTDERecorder recorder(recording_file_, layout);
+    rtde_interface::DataPackage package(layout);
+    for (int32_t i = 0; i < 100; ++i)
+    {
+      package.setData(timestamp, 0.002 * i);
+      package.setData(robot_mode, i);
+      package.getTimestamps().received = timeOf(i);
+      ASSERT_TRUE(recorder.record(package));
+    }
+    rtde_interface::DataPackage other({ "timestamp" });
+    EXPECT_FALSE(recorder.record(other));
+  }
+
+  comm::RecordingReader reader(recording_file_);
+  EXPECT_EQ(reader.getType(), comm::RecordingType::RTDE);
+  EXPECT_EQ(rtde_interface::RTDERecorder::metadataToRecipe(reader.getMetadata()), recipe);
+  EXPECT_EQ(reader.getNumFrames(), 100u);
+
+  rtde_interface::RTDEParser parser(rtde_interface::RTDERecorder::metadataToRecipe(reader.getMetadata()));
+  parser.setProtocolVersion(reader.getProtocolVersion());
+  comm::RecordedFrame frame;
+  for (int32_t i = 0; i < 100; ++i)
+  {
+    ASSERT_TRUE(reader.next(frame));
+    EXPECT_EQ(frame.time, timeOf(i));
+
+    comm::BinParser bp(const_cast<uint8_t*>(frame.data), frame.size);
+    std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> packages;
+    ASSERT_TRUE(parser.parse(bp, packages));
+    ASSERT_EQ(packages.size(), 1u);
+    auto* package = dynamic_cast<rtde_interface::DataPackage*>(packages[0].get());
+    ASSERT_NE(package, nullptr);
+    double recorded_timestamp;
+    int32_t recorded_robot_mode;
+    ASSERT_TRUE(package->getData("timestamp", recorded_timestamp));
+    ASSERT_TRUE(package->getData("robot_mode", recorded_robot_mode));
+    EXPECT_DOUBLE_EQ(recorded_timestamp, 0.002 * i);
+    EXPECT_EQ(recorded_robot_mode, i);
+  }
+}
+
+TEST_F(RecordingTest, rtde_recorder_drops_packages_when_buffer_is_full)
+{
+  auto layout = std::make_shared<const rtde_interface::DataPackage::RecipeLayout>(std::vector<std::string>{
+      "timestamp" });
+  uint64_t num_accepted = 0;
+  {
+    rtde_interface::RTDERecorder recorder(recording_file_, layout, 4);
+    rtde_interface::DataPackage package(layout);
+    for (size_t i = 0; i < 100; ++i)
+    {
+      num_accepted += recorder.record(package) ? 1 : 0;
+    }
+    EXPECT_LT(num_accepted, 100u);
+    EXPECT_EQ(recorder.getNumDropped(), 100u - num_accepted);
+  }
+
+  comm::RecordingReader reader(recording_file_);
+  EXPECT_EQ(reader.getNumFrames(), num_accepted);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
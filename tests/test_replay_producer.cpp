@@ -0,0 +1,284 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+
+#include <ur_client_library/comm/package_serializer.h>
+#include <ur_client_library/comm/replay_producer.h>
+#include <ur_client_library/primary/primary_parser.h>
+#include <ur_client_library/rtde/rtde_parser.h>
+#include <ur_client_library/rtde/rtde_recorder.h>
+#include <ur_client_library/ur/calibration_checker.h>
+
+using namespace urcl;
+
+class TimestampCollector : public comm::IConsumer<rtde_interface::RTDEPackage>
+{
+public:
+  bool consume(std::shared_ptr<rtde_interface::RTDEPackage> product) override
+  {
+    auto* package = dynamic_cast<rtde_interface::DataPackage*>(product.get());
+    double timestamp;
+    if (package == nullptr || !package->getData("timestamp", timestamp))
+    {
+      return false;
+    }
+    std::lock_guard<std::mutex> lock(mutex_);
+    timestamps_.push_back(timestamp);
+    received_.push_back(product->getTimestamps().received);
+    return true;
+  }
+
+  std::mutex mutex_;
+  std::vector<double> timestamps_;
+  std::vector<std::chrono::steady_clock::time_point> received_;
+};
+
+class StopNotifier : public comm::INotifier
+{
+public:
+  void stopped(std::string name) override
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+    cv_.notify_one();
+  }
+
+  bool waitForStop(const std::chrono::milliseconds timeout)
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    return cv_.wait_for(lock, timeout, [this]() { return stopped_; });
+  }
+
+private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  bool stopped_ = false;
+};
+
+class ReplayProducerTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    // ctest runs the tests in separate processes, possibly in parallel, so each of them needs its own file
+    const std::string test_name = ::testing::UnitTest::GetInstance()->current_test_info()->name();
+    recording_file_ = "test_replay_" + test_name + "_" + std::to_string(getpid()) + ".urcl";
+  }
+
+  void TearDown() override
+  {
+    std::remove(recording_file_.c_str());
+  }
+
+  std::chrono::steady_clock::time_point timeOf(const size_t frame, const std::chrono::milliseconds period)
+  {
+    return std::chrono::steady_clock::time_point(std::chrono::seconds(1) + frame * period);
+  }
+
+  // Records data packages with increasing timestamps
+  void recordDataPackages(const size_t num_packages, const std::chrono::milliseconds period)
+  {
+    comm::RecordingWriter writer(recording_file_, comm::RecordingType::RTDE, 2,
+                                 rtde_interface::RTDERecorder::recipeToMetadata(recipe_));
+    rtde_interface::DataPackage package(recipe_);
+    package.initEmpty();
+    uint8_t buffer[4096];
+    for (size_t i = 0; i < num_packages; ++i)
+    {
+      double timestamp = 0.002 * i;
+      package.setData("timestamp", timestamp);
+      const size_t size = package.serializePackage(buffer);
+      ASSERT_TRUE(writer.append(timeOf(i, period), buffer, size));
+    }
+  }
+
+  const std::vector<std::string> recipe_ = { "timestamp", "actual_q", "speed_scaling" };
+
+  std::string recording_file_;
+};
+
+TEST_F(ReplayProducerTest, replay_as_fast_as_possible)
+{
+  recordDataPackages(500, std::chrono::milliseconds(2));
+
+  comm::RecordingReader reader(recording_file_);
+  rtde_interface::RTDEParser parser(rtde_interface::RTDERecorder::metadataToRecipe(reader.getMetadata()));
+  parser.setProtocolVersion(reader.getProtocolVersion());
+  comm::ReplayProducer<rtde_interface::RTDEPackage> producer(reader, parser, comm::ReplayTiming::AS_FAST_AS_POSSIBLE);
+  producer.setupProducer();
+
+  TimestampCollector collector;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(producer.replay(collector), 500u);
+  // The recording spans one second
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+  EXPECT_TRUE(producer.finished());
+
+  ASSERT_EQ(collector.timestamps_.size(), 500u);
+  for (size_t i = 0; i < 500; ++i)
+  {
+    EXPECT_DOUBLE_EQ(collector.timestamps_[i], 0.002 * i);
+    EXPECT_EQ(collector.received_[i], timeOf(i, std::chrono::milliseconds(2)));
+  }
+}
+
+TEST_F(ReplayProducerTest, replay_with_original_timing)
+{
+  recordDataPackages(21, std::chrono::milliseconds(10));
+
+  comm::RecordingReader reader(recording_file_);
+  rtde_interface::RTDEParser parser(recipe_);
+  parser.setProtocolVersion(2);
+  comm::ReplayProducer<rtde_interface::RTDEPackage> producer(reader, parser);
+  producer.setupProducer();
+
+  TimestampCollector collector;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_EQ(producer.replay(collector), 21u);
+  EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(200));
+
+  // Replaying again starts from the position of the reader
+  reader.seek(timeOf(15, std::chrono::milliseconds(10)));
+  producer.setupProducer();
+  EXPECT_EQ(producer.replay(collector), 6u);
+  EXPECT_DOUBLE_EQ(collector.timestamps_.back(), 0.04);
+}
+
+TEST_F(ReplayProducerTest, stopping_keeps_frame_that_is_not_due)
+{
+  recordDataPackages(3, std::chrono::milliseconds(300));
+
+  comm::RecordingReader reader(recording_file_);
+  rtde_interface::RTDEParser parser(recipe_);
+  parser.setProtocolVersion(2);
+  comm::ReplayProducer<rtde_interface::RTDEPackage> producer(reader, parser);
+  producer.setupProducer();
+
+  // The producer gets stopped while waiting for the second frame
+  TimestampCollector collector;
+  size_t num_replayed = 0;
+  std::thread replay_thread([&]() { num_replayed = producer.replay(collector); });
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  producer.stopProducer();
+  replay_thread.join();
+  EXPECT_EQ(num_replayed, 1u);
+  EXPECT_FALSE(producer.finished());
+
+  // Resuming continues with the frame that wasn't due
+  EXPECT_EQ(producer.replay(collector), 2u);
+  EXPECT_TRUE(producer.finished());
+  ASSERT_EQ(collector.timestamps_.size(), 3u);
+  EXPECT_DOUBLE_EQ(collector.timestamps_[1], 0.002);
+  EXPECT_DOUBLE_EQ(collector.timestamps_[2], 0.004);
+}
+
+TEST_F(ReplayProducerTest, pipeline_stops_at_end_of_recording)
+{
+  recordDataPackages(50, std::chrono::milliseconds(4));
+
+  comm::RecordingReader reader(recording_file_);
+  rtde_interface::RTDEParser parser(recipe_);
+  parser.setProtocolVersion(2);
+  comm::ReplayProducer<rtde_interface::RTDEPackage> producer(reader, parser);
+  TimestampCollector collector;
+  StopNotifier notifier;
+  comm::Pipeline<rtde_interface::RTDEPackage> pipeline(producer, &collector, "replay", notifier);
+  pipeline.init();
+  pipeline.run();
+
+  EXPECT_TRUE(notifier.waitForStop(std::chrono::seconds(5)));
+  pipeline.stop();
+  EXPECT_TRUE(producer.finished());
+  std::lock_guard<std::mutex> lock(collector.mutex_);
+  ASSERT_FALSE(collector.timestamps_.empty());
+  EXPECT_DOUBLE_EQ(collector.timestamps_.front(), 0.0);
+}
+
+TEST_F(ReplayProducerTest, replay_primary_packages_into_calibration_checker)
+{
+  // Robot state containing only kinematics information
+  uint8_t buffer[512];
+  size_t size = sizeof(int32_t) + sizeof(uint8_t);
+  const size_t sub_package_start = size;
+  size += sizeof(uint32_t) + sizeof(uint8_t);
+  size += comm::PackageSerializer::serialize(buffer + size, vector6uint32_t{ 1, 2, 3, 4, 5, 6 });
+  size += comm::PackageSerializer::serialize(buffer + size, vector6d_t{ 0, 0, 0, 0, 0, 0 });
+  size += comm::PackageSerializer::serialize(buffer + size, vector6d_t{ 0, -0.425, -0.3922, 0, 0, 0 });
+  size += comm::PackageSerializer::serialize(buffer + size, vector6d_t{ 0.1625, 0, 0, 0.1333, 0.0997, 0.0996 });
+  size += comm::PackageSerializer::serialize(buffer + size, vector6d_t{ 1.570796327, 0, 0, 1.570796327, -1.570796327, 0 });
+  size += comm::PackageSerializer::serialize(buffer + size, uint32_t(0));
+  comm::PackageSerializer::serialize(buffer, static_cast<int32_t>(size));
+  buffer[sizeof(int32_t)] = static_cast<uint8_t>(primary_interface::RobotPackageType::ROBOT_STATE);
+  comm::PackageSerializer::serialize(buffer + sub_package_start, static_cast<uint32_t>(size - sub_package_start));
+  buffer[sub_package_start + sizeof(uint32_t)] = static_cast<uint8_t>(primary_interface::RobotStateType::KINEMATICS_INFO);
+
+  {
+    comm::RecordingWriter writer(recording_file_, comm::RecordingType::PRIMARY, 0, "");
+    for (size_t i = 0; i < 3; ++i)
+    {
+      ASSERT_TRUE(writer.append(timeOf(i, std::chrono::milliseconds(100)), buffer, size));
+    }
+  }
+
+  primary_interface::KinematicsInfo expected(primary_interface::RobotStateType::KINEMATICS_INFO);
+  expected.dh_theta_ = { 0, 0, 0, 0, 0, 0 };
+  expected.dh_a_ = { 0, -0.425, -0.3922, 0, 0, 0 };
+  expected.dh_d_ = { 0.1625, 0, 0, 0.1333, 0.0997, 0.0996 };
+  expected.dh_alpha_ = { 1.570796327, 0, 0, 1.570796327, -1.570796327, 0 };
+
+  comm::RecordingReader reader(recording_file_);
+  primary_interface::PrimaryParser parser;
+  comm::ReplayProducer<primary_interface::PrimaryPackage> producer(reader, parser,
+                                                                    comm::ReplayTiming::AS_FAST_AS_POSSIBLE);
+  CalibrationChecker matching_checker(expected.toHash());
+  EXPECT_EQ(producer.replay(matching_checker), 3u);
+  EXPECT_TRUE(matching_checker.isChecked());
+  EXPECT_TRUE(matching_checker.checkSuccessful());
+
+  reader.rewind();
+  CalibrationChecker other_checker("calib_0");
+  EXPECT_EQ(producer.replay(other_checker), 3u);
+  EXPECT_TRUE(other_checker.isChecked());
+  EXPECT_FALSE(other_checker.checkSuccessful());
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
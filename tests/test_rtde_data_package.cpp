@@ -160,6 +160,154 @@ TEST(rtde_data_package, parse_and_get_bitset_data)
   EXPECT_EQ(expected_robot_status_bits, actual_robot_status_bits);
 }
 
+TEST(rtde_data_package, parse_mixed_field_types)
+{
+  std::vector<std::string> recipe{ "output_bit_register_64", "output_bit_register_65", "standard_analog_output_mask",
+                                   "robot_mode",             "runtime_state",          "timestamp",
+                                   "actual_q",               "joint_mode" };
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+
+  // Consecutive fields with values of the same size are parsed together
+  auto& runs = package.getRecipeLayout()->getRuns();
+  ASSERT_EQ(runs.size(), 5u);
+  EXPECT_TRUE(runs[0].is_bool);
+  EXPECT_EQ(runs[0].count, 2u);
+  EXPECT_EQ(runs[1].value_size, 1u);
+  EXPECT_EQ(runs[2].value_size, 4u);
+  EXPECT_EQ(runs[2].count, 2u);
+  EXPECT_EQ(runs[3].value_size, 8u);
+  EXPECT_EQ(runs[3].count, 7u);
+  EXPECT_EQ(runs[4].offset, 3u + 8u + 56u);
+
+  uint8_t data_package[] = { 0x01, 0x01, 0x02, 0x05, 0xff, 0xff, 0xff, 0xfe, 0x00, 0x00, 0x00, 0x02, 0x40, 0x01,
+                             0x99, 0x99, 0x99, 0x99, 0x99, 0x9a, 0xc0, 0x01, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a,
+                             0x40, 0x08, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcd, 0x40, 0x11, 0xcc, 0xcc, 0xcc, 0xcc,
+                             0xcc, 0xcd, 0x3f, 0xf1, 0x99, 0x99, 0x99, 0x99, 0x99, 0x9a, 0x40, 0x08, 0xcc, 0xcc,
+                             0xcc, 0xcc, 0xcc, 0xcd, 0xc0, 0x10, 0xcc, 0xcc, 0xcc, 0xcc, 0xcc, 0xcd, 0xff, 0xff,
+                             0xff, 0xfe, 0x00, 0x00, 0x00, 0x03, 0xff, 0xff, 0xff, 0xff, 0x00, 0x00, 0x00, 0x04,
+                             0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x05 };
+  comm::BinParser bp(data_package, sizeof(data_package));
+  EXPECT_TRUE(package.parseWith(bp));
+  EXPECT_TRUE(bp.empty());
+
+  bool bit_register = false;
+  package.getData("output_bit_register_64", bit_register);
+  EXPECT_TRUE(bit_register);
+  package.getData("output_bit_register_65", bit_register);
+  EXPECT_TRUE(bit_register);
+  uint8_t mask = 0;
+  package.getData("standard_analog_output_mask", mask);
+  EXPECT_EQ(mask, 5);
+  int32_t robot_mode = 0;
+  package.getData("robot_mode", robot_mode);
+  EXPECT_EQ(robot_mode, -2);
+  uint32_t runtime_state = 0;
+  package.getData("runtime_state", runtime_state);
+  EXPECT_EQ(runtime_state, 2u);
+  double timestamp = 0.0;
+  package.getData("timestamp", timestamp);
+  EXPECT_EQ(timestamp, 2.2);
+  vector6d_t actual_q;
+  package.getData("actual_q", actual_q);
+  EXPECT_EQ(actual_q, vector6d_t({ -2.2, 3.1, 4.45, 1.1, 3.1, -4.2 }));
+  vector6int32_t joint_mode;
+  package.getData("joint_mode", joint_mode);
+  EXPECT_EQ(joint_mode, vector6int32_t({ -2, 3, -1, 4, 14, 5 }));
+}
+
+TEST(rtde_data_package, get_data_with_field_handle)
+{
+  std::vector<std::string> recipe{ "timestamp", "actual_q" };
+  auto layout = std::make_shared<const rtde_interface::DataPackage::RecipeLayout>(recipe);
+  rtde_interface::DataPackage package(layout);
+  package.initEmpty();
+
+  uint8_t data_package[] = { 0x01, 0x40, 0xd0, 0x75, 0x8c, 0x49, 0xba, 0x5e, 0x35, 0xbf, 0xf9, 0x9c, 0x77, 0xd1, 0x10,
+                             0xb4, 0x60, 0xbf, 0xfb, 0xa2, 0x33, 0xd1, 0x10, 0xb4, 0x60, 0xc0, 0x01, 0x9f, 0xbe, 0x68,
+                             0x88, 0x5a, 0x30, 0xbf, 0xe9, 0xdb, 0x22, 0xa2, 0x21, 0x68, 0xc0, 0x3f, 0xf9, 0x85, 0x87,
+                             0xa0, 0x00, 0x00, 0x00, 0xbf, 0x9f, 0xbe, 0x74, 0x44, 0x2d, 0x18, 0x00 };
+  comm::BinParser bp(data_package, sizeof(data_package));
+  EXPECT_TRUE(package.parseWith(bp));
+
+  rtde_interface::FieldHandle<double> timestamp_handle = layout->getFieldHandle<double>("timestamp");
+  rtde_interface::FieldHandle<vector6d_t> actual_q_handle = layout->getFieldHandle<vector6d_t>("actual_q");
+
+  double actual_timestamp;
+  EXPECT_TRUE(package.getData(timestamp_handle, actual_timestamp));
+  EXPECT_NEAR(16854.1919, actual_timestamp, 1e-4);
+
+  vector6d_t actual_q;
+  vector6d_t actual_q_by_name;
+  EXPECT_TRUE(package.getData(actual_q_handle, actual_q));
+  EXPECT_TRUE(package.getData("actual_q", actual_q_by_name));
+  EXPECT_EQ(actual_q, actual_q_by_name);
+
+  // Handles can be reused with every package using the same layout
+  rtde_interface::DataPackage other_package(layout);
+  other_package.initEmpty();
+  double new_timestamp = 42.0;
+  EXPECT_TRUE(other_package.setData(timestamp_handle, new_timestamp));
+  double read_timestamp;
+  other_package.getData("timestamp", read_timestamp);
+  EXPECT_EQ(new_timestamp, read_timestamp);
+}
+
+TEST(rtde_data_package, invalid_field_handle)
+{
+  std::vector<std::string> recipe{ "timestamp", "actual_q" };
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+  auto layout = package.getRecipeLayout();
+
+  EXPECT_THROW(layout->getFieldHandle<uint32_t>("speed_slider_mask"), UrException);
+  EXPECT_THROW(layout->getFieldHandle<uint32_t>("timestamp"), UrException);
+
+  rtde_interface::FieldHandle<double> handle;
+  double timestamp;
+  EXPECT_FALSE(handle.isValid());
+  EXPECT_FALSE(package.getData(handle, timestamp));
+}
+
+TEST(rtde_data_package, field_handle_of_other_layout)
+{
+  std::vector<std::string> recipe{ "timestamp", "actual_q" };
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+
+  // A layout of the same recipe places the field at the same offset, but is a different layout
+  rtde_interface::DataPackage other_package(recipe);
+  other_package.initEmpty();
+  rtde_interface::FieldHandle<double> handle =
+      other_package.getRecipeLayout()->getFieldHandle<double>("timestamp");
+
+  double timestamp = 42.0;
+  EXPECT_FALSE(package.setData(handle, timestamp));
+  EXPECT_FALSE(package.getData(handle, timestamp));
+  EXPECT_TRUE(other_package.setData(handle, timestamp));
+}
+
+TEST(rtde_data_package, copy_keeps_data_and_recipe_id)
+{
+  std::vector<std::string> recipe{ "speed_slider_mask" };
+  rtde_interface::DataPackage package(recipe);
+  package.initEmpty();
+
+  uint32_t value = 1;
+  package.setData("speed_slider_mask", value);
+  package.setRecipeID(1);
+  rtde_interface::DataPackage copy(package);
+
+  uint8_t buffer[4096];
+  uint8_t copy_buffer[4096];
+  size_t size = package.serializePackage(buffer);
+  ASSERT_EQ(size, copy.serializePackage(copy_buffer));
+  for (size_t i = 0; i < size; ++i)
+  {
+    EXPECT_EQ(buffer[i], copy_buffer[i]);
+  }
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
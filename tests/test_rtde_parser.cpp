@@ -27,12 +27,57 @@
 //----------------------------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <atomic>
+#include <cstdlib>
+#include <new>
 
 #include <ur_client_library/comm/bin_parser.h>
+#include <ur_client_library/comm/pipeline.h>
 #include <ur_client_library/rtde/rtde_parser.h>
 
 using namespace urcl;
 
+// Allocation counting hook, used to check that the steady-state receive path doesn't allocate memory
+static std::atomic<bool> g_count_allocations{ false };
+static std::atomic<size_t> g_num_allocations{ 0 };
+
+void* operator new(size_t size)
+{
+  if (g_count_allocations)
+  {
+    g_num_allocations++;
+  }
+  void* ptr = std::malloc(size);
+  if (ptr == nullptr)
+  {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+// Not inlined, as gcc would otherwise warn about a mismatch between operator new and free
+__attribute__((noinline)) void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+__attribute__((noinline)) void operator delete(void* ptr, size_t size) noexcept
+{
+  std::free(ptr);
+}
+
+void startCountingAllocations()
+{
+  g_num_allocations = 0;
+  g_count_allocations = true;
+}
+
+size_t stopCountingAllocations()
+{
+  g_count_allocations = false;
+  return g_num_allocations;
+}
+
 TEST(rtde_parser, request_protocol_version)
 {
   // Accepted request protocol version
@@ -255,6 +300,155 @@ TEST(rtde_parser, test_buffer_too_long)
   EXPECT_FALSE(parser.parse(bp, products));
 }
 
+TEST(rtde_parser, recycled_data_packages_are_reused)
+{
+  unsigned char raw_data[] = { 0x00, 0x14, 0x55, 0x01, 0x40, 0xd0, 0x07, 0x0d, 0x2f, 0x1a,
+                               0x9f, 0xbe, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  std::vector<std::string> recipe = { "timestamp", "target_speed_fraction" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  products.reserve(1);
+  {
+    comm::BinParser bp(raw_data, sizeof(raw_data));
+    ASSERT_TRUE(parser.parse(bp, products));
+  }
+  rtde_interface::RTDEPackage* first_package = products[0].get();
+  parser.recycle(std::move(products[0]));
+  products.clear();
+
+  startCountingAllocations();
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    comm::BinParser bp(raw_data, sizeof(raw_data));
+    ASSERT_TRUE(parser.parse(bp, products));
+    parser.recycle(std::move(products[0]));
+    products.clear();
+  }
+  EXPECT_EQ(stopCountingAllocations(), 0u);
+
+  comm::BinParser bp(raw_data, sizeof(raw_data));
+  ASSERT_TRUE(parser.parse(bp, products));
+  EXPECT_EQ(products[0].get(), first_package);
+}
+
+TEST(rtde_parser, recycle_data_package_with_different_recipe)
+{
+  unsigned char raw_data[] = { 0x00, 0x14, 0x55, 0x01, 0x40, 0xd0, 0x07, 0x0d, 0x2f, 0x1a,
+                               0x9f, 0xbe, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+  std::vector<std::string> recipe = { "timestamp", "target_speed_fraction" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+
+  // Packages that don't belong to the parser's recipe must not be reused
+  parser.recycle(std::unique_ptr<rtde_interface::RTDEPackage>(new rtde_interface::DataPackage(recipe)));
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> products;
+  comm::BinParser bp(raw_data, sizeof(raw_data));
+  ASSERT_TRUE(parser.parse(bp, products));
+  rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(products[0].get());
+  ASSERT_NE(data, nullptr);
+  EXPECT_EQ(data->getRecipeLayout(), parser.getRecipeLayout());
+}
+
+// Producer parsing a canned RTDE data package every time a new package is requested
+class CannedDataProducer : public comm::IProducer<rtde_interface::RTDEPackage>
+{
+public:
+  CannedDataProducer(rtde_interface::RTDEParser& parser) : parser_(parser), requested_(0), running_(false)
+  {
+  }
+
+  void startProducer() override
+  {
+    running_ = true;
+  }
+
+  void stopProducer() override
+  {
+    running_ = false;
+  }
+
+  bool tryGet(std::vector<std::unique_ptr<rtde_interface::RTDEPackage>>& products) override
+  {
+    while (running_ && requested_ == 0)
+    {
+      std::this_thread::yield();
+    }
+    if (!running_)
+    {
+      return true;
+    }
+    requested_--;
+    comm::BinParser bp(raw_data_, sizeof(raw_data_));
+    return parser_.parse(bp, products);
+  }
+
+  void recycle(std::unique_ptr<rtde_interface::RTDEPackage> product) override
+  {
+    parser_.recycle(std::move(product));
+  }
+
+  void requestPackage()
+  {
+    requested_++;
+  }
+
+private:
+  rtde_interface::RTDEParser& parser_;
+  std::atomic<int> requested_;
+  std::atomic<bool> running_;
+  uint8_t raw_data_[20] = { 0x00, 0x14, 0x55, 0x01, 0x40, 0xd0, 0x07, 0x0d, 0x2f, 0x1a,
+                            0x9f, 0xbe, 0x3f, 0xf0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 };
+};
+
+void runSteadyStatePipeline(const comm::PipelineTransport transport)
+{
+  std::vector<std::string> recipe = { "timestamp", "target_speed_fraction" };
+  rtde_interface::RTDEParser parser(recipe);
+  parser.setProtocolVersion(2);
+  CannedDataProducer producer(parser);
+  comm::INotifier notifier;
+  comm::Pipeline<rtde_interface::RTDEPackage> pipeline(producer, "RTDE_PIPELINE", notifier, false, transport);
+  pipeline.init();
+  pipeline.run();
+
+  std::unique_ptr<rtde_interface::RTDEPackage> package;
+  // Fill the package pool and all slots of the transport
+  for (size_t i = 0; i < 5; ++i)
+  {
+    producer.requestPackage();
+    ASSERT_TRUE(pipeline.getLatestProduct(package, std::chrono::milliseconds(1000)));
+  }
+
+  startCountingAllocations();
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    producer.requestPackage();
+    ASSERT_TRUE(pipeline.getLatestProduct(package, std::chrono::milliseconds(1000)));
+  }
+  size_t num_allocations = stopCountingAllocations();
+  pipeline.stop();
+
+  EXPECT_EQ(num_allocations, 0u);
+  rtde_interface::DataPackage* data = dynamic_cast<rtde_interface::DataPackage*>(package.get());
+  ASSERT_NE(data, nullptr);
+  double timestamp;
+  data->getData("timestamp", timestamp);
+  EXPECT_FLOAT_EQ(timestamp, 16412.2);
+}
+
+TEST(rtde_parser, steady_state_pipeline_does_not_allocate)
+{
+  runSteadyStatePipeline(comm::PipelineTransport::QUEUE);
+}
+
+TEST(rtde_parser, steady_state_latest_value_pipeline_does_not_allocate)
+{
+  runSteadyStatePipeline(comm::PipelineTransport::LATEST_VALUE);
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
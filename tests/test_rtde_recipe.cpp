@@ -0,0 +1,154 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+
+#include <gtest/gtest.h>
+
+#include "ur_client_library/exceptions.h"
+#include "ur_client_library/rtde/recipe.h"
+#include "ur_client_library/rtde/rtde_parser.h"
+
+using namespace urcl;
+using namespace urcl::rtde_interface::fields;
+
+using OutputRecipe = rtde_interface::Recipe<Timestamp, ActualQ, RobotMode, TargetSpeedFraction>;
+using InputRecipe = rtde_interface::Recipe<SpeedSliderMask, SpeedSliderFraction, StandardDigitalOutputMask>;
+
+URCL_RTDE_FIELD(WrongTimestamp, "timestamp", uint32_t);
+URCL_RTDE_FIELD(UnknownField, "unknown_field", double);
+
+TEST(rtde_recipe, names_and_offsets)
+{
+  std::vector<std::string> expected_names = { "timestamp", "actual_q", "robot_mode", "target_speed_fraction" };
+  EXPECT_EQ(OutputRecipe::getNames(), expected_names);
+  EXPECT_EQ(OutputRecipe::STORAGE_SIZE, 8u + 48u + 4u + 8u);
+
+  static_assert(OutputRecipe::offsetOf<Timestamp>() == 0, "Unexpected offset");
+  static_assert(OutputRecipe::offsetOf<ActualQ>() == 8, "Unexpected offset");
+  static_assert(OutputRecipe::offsetOf<RobotMode>() == 56, "Unexpected offset");
+  static_assert(OutputRecipe::offsetOf<TargetSpeedFraction>() == 60, "Unexpected offset");
+
+  // The compile time layout has to match the layout resolved from the field names
+  rtde_interface::DataPackage::RecipeLayout layout(OutputRecipe::getNames());
+  EXPECT_EQ(OutputRecipe::getLayout()->getStorageSize(), layout.getStorageSize());
+  EXPECT_EQ(OutputRecipe::getLayout()->findField("robot_mode")->offset, layout.findField("robot_mode")->offset);
+  EXPECT_EQ(OutputRecipe::getLayout()->getRecipe(), expected_names);
+}
+
+TEST(rtde_recipe, layout_is_shared)
+{
+  EXPECT_EQ(OutputRecipe::getLayout(), OutputRecipe::getLayout());
+  EXPECT_NE(OutputRecipe::getLayout()->getParseFunction(), nullptr);
+  EXPECT_NE(OutputRecipe::getLayout()->getSerializeFunction(), nullptr);
+}
+
+TEST(rtde_recipe, mismatching_fields_throw)
+{
+  EXPECT_THROW(rtde_interface::Recipe<WrongTimestamp>::getLayout(), UrException);
+  EXPECT_THROW((rtde_interface::Recipe<Timestamp, UnknownField>::getLayout()), UrException);
+}
+
+TEST(rtde_recipe, parse_equals_string_recipe)
+{
+  uint8_t data_package[] = { 0x00, 0x47, 0x55, 0x01, 0x40, 0xd0, 0x75, 0x8c, 0x49, 0xba, 0x5e, 0x35, 0xbf, 0xf9,
+                             0x9c, 0x77, 0xd1, 0x10, 0xb4, 0x60, 0xbf, 0xfb, 0xa2, 0x33, 0xd1, 0x10, 0xb4, 0x60,
+                             0xc0, 0x01, 0x9f, 0xbe, 0x68, 0x88, 0x5a, 0x30, 0xbf, 0xe9, 0xdb, 0x22, 0xa2, 0x21,
+                             0x68, 0xc0, 0x3f, 0xf9, 0x85, 0x87, 0xa0, 0x00, 0x00, 0x00, 0xbf, 0x9f, 0xbe, 0x74,
+                             0x44, 0x2d, 0x18, 0x00, 0x00, 0x00, 0x00, 0x07, 0x3f, 0xe0, 0x00, 0x00, 0x00, 0x00,
+                             0x00, 0x00 };
+
+  rtde_interface::RTDEParser typed_parser(OutputRecipe::getLayout());
+  typed_parser.setProtocolVersion(2);
+  rtde_interface::RTDEParser string_parser(OutputRecipe::getNames());
+  string_parser.setProtocolVersion(2);
+
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> typed_products;
+  comm::BinParser typed_bp(data_package, sizeof(data_package));
+  ASSERT_TRUE(typed_parser.parse(typed_bp, typed_products));
+  std::vector<std::unique_ptr<rtde_interface::RTDEPackage>> string_products;
+  comm::BinParser string_bp(data_package, sizeof(data_package));
+  ASSERT_TRUE(string_parser.parse(string_bp, string_products));
+
+  auto typed = dynamic_cast<rtde_interface::DataPackage*>(typed_products[0].get());
+  auto by_name = dynamic_cast<rtde_interface::DataPackage*>(string_products[0].get());
+  ASSERT_NE(typed, nullptr);
+  ASSERT_NE(by_name, nullptr);
+  EXPECT_EQ(typed->getRecipeLayout(), OutputRecipe::getLayout());
+
+  double timestamp;
+  by_name->getData("timestamp", timestamp);
+  EXPECT_EQ(OutputRecipe::get<Timestamp>(*typed), timestamp);
+  EXPECT_NEAR(OutputRecipe::get<Timestamp>(*typed), 16854.1919, 1e-4);
+  vector6d_t actual_q;
+  by_name->getData("actual_q", actual_q);
+  EXPECT_EQ(OutputRecipe::get<ActualQ>(*typed), actual_q);
+  EXPECT_EQ(OutputRecipe::get<RobotMode>(*typed), 7);
+  EXPECT_EQ(OutputRecipe::get<TargetSpeedFraction>(*typed), 0.5);
+
+  // Access by name works on typed packages as well
+  int32_t robot_mode;
+  EXPECT_TRUE(typed->getData("robot_mode", robot_mode));
+  EXPECT_EQ(robot_mode, 7);
+}
+
+TEST(rtde_recipe, serialize_equals_string_recipe)
+{
+  rtde_interface::DataPackage typed(InputRecipe::getLayout());
+  InputRecipe::set<SpeedSliderMask>(typed, 1);
+  InputRecipe::set<SpeedSliderFraction>(typed, 0.25);
+  InputRecipe::set<StandardDigitalOutputMask>(typed, 3);
+  typed.setRecipeID(1);
+
+  rtde_interface::DataPackage by_name(InputRecipe::getNames());
+  uint32_t mask = 1;
+  double fraction = 0.25;
+  uint8_t digital_output_mask = 3;
+  by_name.setData("speed_slider_mask", mask);
+  by_name.setData("speed_slider_fraction", fraction);
+  by_name.setData("standard_digital_output_mask", digital_output_mask);
+  by_name.setRecipeID(1);
+
+  uint8_t typed_buffer[4096];
+  uint8_t expected_buffer[4096];
+  size_t size = typed.serializePackage(typed_buffer);
+  ASSERT_EQ(size, by_name.serializePackage(expected_buffer));
+  EXPECT_EQ(size, 3u + 1u + 4u + 8u + 1u);
+  for (size_t i = 0; i < size; ++i)
+  {
+    EXPECT_EQ(typed_buffer[i], expected_buffer[i]);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
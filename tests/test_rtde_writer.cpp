@@ -29,6 +29,7 @@
 // -- END LICENSE BLOCK ------------------------------------------------
 
 #include <gtest/gtest.h>
+#include <atomic>
 #include <condition_variable>
 
 #include <ur_client_library/rtde/rtde_writer.h>
@@ -74,6 +75,12 @@ protected:
     uint16_t size;
     uint8_t type, recipe_id;
     bp.parse(size);
+    // Packages sent in quick succession might be split up or merged into one message. Only check
+    // messages containing exactly one package.
+    if (size != nbytesrecv)
+    {
+      return;
+    }
     bp.parse(type);
     bp.parse(recipe_id);
     parseMessage(bp);
@@ -441,6 +448,154 @@ TEST_F(RTDEWriterTest, send_input_double_register)
   EXPECT_FALSE(writer_->sendInputDoubleRegister(register_id, send_register_value));
 }
 
+TEST_F(RTDEWriterTest, batch_merges_changes_into_one_package)
+{
+  writer_->beginBatch();
+  EXPECT_TRUE(writer_->sendStandardDigitalOutput(0, true));
+  EXPECT_TRUE(writer_->sendStandardDigitalOutput(1, false));
+  EXPECT_TRUE(writer_->sendStandardDigitalOutput(2, true));
+  EXPECT_TRUE(writer_->sendToolDigitalOutput(1, true));
+  EXPECT_TRUE(writer_->sendSpeedSlider(0.3));
+  EXPECT_TRUE(writer_->sendInputIntRegister(25, 7));
+  EXPECT_TRUE(writer_->sendInputIntRegister(25, 42));
+
+  // Nothing is sent before the batch is committed
+  EXPECT_FALSE(waitForMessageCallback(100));
+
+  EXPECT_TRUE(writer_->commit());
+  ASSERT_TRUE(waitForMessageCallback(1000));
+
+  EXPECT_EQ(7, std::get<uint8_t>(parsed_data_["standard_digital_output_mask"]));
+  EXPECT_EQ(5, std::get<uint8_t>(parsed_data_["standard_digital_output"]) & 7);
+  EXPECT_EQ(2, std::get<uint8_t>(parsed_data_["tool_digital_output_mask"]));
+  EXPECT_NE(0, std::get<uint8_t>(parsed_data_["tool_digital_output"]) & 2);
+  EXPECT_EQ(1u, std::get<uint32_t>(parsed_data_["speed_slider_mask"]));
+  EXPECT_EQ(0.3, std::get<double>(parsed_data_["speed_slider_fraction"]));
+  EXPECT_EQ(42, std::get<int32_t>(parsed_data_["input_int_register_25"]));
+  EXPECT_EQ(0, std::get<uint8_t>(parsed_data_["configurable_digital_output_mask"]));
+
+  // After the commit, changes are sent immediately again and the masks of the batch are cleared
+  EXPECT_TRUE(writer_->sendConfigurableDigitalOutput(4, true));
+  ASSERT_TRUE(waitForMessageCallback(1000));
+
+  EXPECT_EQ(16, std::get<uint8_t>(parsed_data_["configurable_digital_output_mask"]));
+  EXPECT_EQ(0, std::get<uint8_t>(parsed_data_["standard_digital_output_mask"]));
+  EXPECT_EQ(0, std::get<uint8_t>(parsed_data_["tool_digital_output_mask"]));
+  EXPECT_EQ(0u, std::get<uint32_t>(parsed_data_["speed_slider_mask"]));
+  EXPECT_EQ(42, std::get<int32_t>(parsed_data_["input_int_register_25"]));
+}
+
+TEST_F(RTDEWriterTest, batch_merges_analog_outputs)
+{
+  writer_->beginBatch();
+  EXPECT_TRUE(writer_->sendStandardAnalogOutput(0, 0.25, AnalogOutputType::VOLTAGE));
+  EXPECT_TRUE(writer_->sendStandardAnalogOutput(1, 0.75, AnalogOutputType::CURRENT));
+  EXPECT_TRUE(writer_->commit());
+
+  ASSERT_TRUE(waitForMessageCallback(1000));
+
+  EXPECT_EQ(3, std::get<uint8_t>(parsed_data_["standard_analog_output_mask"]));
+  EXPECT_EQ(1, std::get<uint8_t>(parsed_data_["standard_analog_output_type"]));
+  EXPECT_EQ(0.25, std::get<double>(parsed_data_["standard_analog_output_0"]));
+  EXPECT_EQ(0.75, std::get<double>(parsed_data_["standard_analog_output_1"]));
+}
+
+TEST_F(RTDEWriterTest, commit_without_batch_fails)
+{
+  EXPECT_FALSE(writer_->commit());
+
+  writer_->beginBatch();
+  EXPECT_TRUE(writer_->commit());
+  EXPECT_FALSE(writer_->commit());
+}
+
+TEST_F(RTDEWriterTest, synchronous_mode_sends_changes_on_flush)
+{
+  writer_->setSynchronous(true);
+  EXPECT_TRUE(writer_->isSynchronous());
+
+  // Nothing to send, yet
+  EXPECT_TRUE(writer_->flush());
+  EXPECT_FALSE(waitForMessageCallback(100));
+
+  EXPECT_TRUE(writer_->sendStandardDigitalOutput(3, true));
+  EXPECT_TRUE(writer_->sendSpeedSlider(0.2));
+  EXPECT_TRUE(writer_->sendSpeedSlider(0.4));
+  EXPECT_FALSE(waitForMessageCallback(100));
+
+  EXPECT_TRUE(writer_->flush());
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(8, std::get<uint8_t>(parsed_data_["standard_digital_output_mask"]));
+  EXPECT_EQ(1u, std::get<uint32_t>(parsed_data_["speed_slider_mask"]));
+  EXPECT_EQ(0.4, std::get<double>(parsed_data_["speed_slider_fraction"]));
+
+  // Batches are only sent with a flush after they got committed
+  writer_->beginBatch();
+  EXPECT_TRUE(writer_->sendInputIntRegister(25, 3));
+  EXPECT_TRUE(writer_->flush());
+  EXPECT_FALSE(waitForMessageCallback(100));
+  EXPECT_TRUE(writer_->commit());
+  EXPECT_FALSE(waitForMessageCallback(100));
+  EXPECT_TRUE(writer_->flush());
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(3, std::get<int32_t>(parsed_data_["input_int_register_25"]));
+  EXPECT_EQ(0, std::get<uint8_t>(parsed_data_["standard_digital_output_mask"]));
+
+  // Pending changes are sent when leaving the synchronous mode
+  EXPECT_TRUE(writer_->sendToolDigitalOutput(0, true));
+  writer_->setSynchronous(false);
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(1, std::get<uint8_t>(parsed_data_["tool_digital_output_mask"]));
+}
+
+TEST_F(RTDEWriterTest, changes_made_while_flushing_are_sent)
+{
+  writer_->setSynchronous(true);
+
+  // Flush from another thread like the RTDEClient's receive thread does
+  std::atomic<bool> running(true);
+  std::thread flusher([&] {
+    while (running)
+    {
+      writer_->flush();
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+  });
+  for (int i = 0; i < 1000; ++i)
+  {
+    ASSERT_TRUE(writer_->sendInputIntRegister(25, i));
+    ASSERT_TRUE(writer_->sendStandardDigitalOutput(i % 8, i % 2 == 0));
+  }
+  running = false;
+  flusher.join();
+  EXPECT_TRUE(writer_->flush());
+
+  // Only the tool output is sent with the last flush, everything else has been flushed before
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  waitForMessageCallback(1);
+  EXPECT_TRUE(writer_->sendToolDigitalOutput(1, true));
+  EXPECT_TRUE(writer_->flush());
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(999, std::get<int32_t>(parsed_data_["input_int_register_25"]));
+  EXPECT_EQ(0, std::get<uint8_t>(parsed_data_["standard_digital_output_mask"]));
+  EXPECT_EQ(2, std::get<uint8_t>(parsed_data_["tool_digital_output_mask"]));
+}
+
+TEST_F(RTDEWriterTest, many_packages_can_be_sent)
+{
+  // Packages are taken from a fixed pool, which has to be refilled by the writer thread
+  for (int i = 0; i < 200; ++i)
+  {
+    ASSERT_TRUE(writer_->sendInputIntRegister(25, i));
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  EXPECT_TRUE(writer_->sendInputIntRegister(25, 1234));
+  ASSERT_TRUE(waitForMessageCallback(1000));
+  EXPECT_EQ(1234, std::get<int32_t>(parsed_data_["input_int_register_25"]));
+}
+
 int main(int argc, char* argv[])
 {
   ::testing::InitGoogleTest(&argc, argv);
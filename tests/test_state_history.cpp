@@ -0,0 +1,278 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <ur_client_library/exceptions.h>
+#include <ur_client_library/rtde/state_history.h>
+
+using namespace urcl;
+using namespace urcl::rtde_interface;
+
+class StateHistoryTest : public ::testing::Test
+{
+protected:
+  void SetUp() override
+  {
+    layout_ = std::make_shared<const DataPackage::RecipeLayout>(
+        std::vector<std::string>{ "timestamp", "actual_q", "robot_mode", "speed_scaling" });
+    timestamp_ = layout_->getFieldHandle<double>("timestamp");
+    actual_q_ = layout_->getFieldHandle<vector6d_t>("actual_q");
+    robot_mode_ = layout_->getFieldHandle<int32_t>("robot_mode");
+    speed_scaling_ = layout_->getFieldHandle<double>("speed_scaling");
+  }
+
+  // Creates a sample whose joint positions and speed scaling equal its timestamp
+  DataPackage makeSample(const double timestamp, const int32_t robot_mode = 7)
+  {
+    DataPackage package(layout_);
+    package.setData(timestamp_, timestamp);
+    package.setData(actual_q_, vector6d_t{ timestamp, timestamp, timestamp, timestamp, timestamp, timestamp });
+    package.setData(robot_mode_, robot_mode);
+    package.setData(speed_scaling_, timestamp);
+    return package;
+  }
+
+  std::shared_ptr<const DataPackage::RecipeLayout> layout_;
+  FieldHandle<double> timestamp_;
+  FieldHandle<vector6d_t> actual_q_;
+  FieldHandle<int32_t> robot_mode_;
+  FieldHandle<double> speed_scaling_;
+};
+
+TEST_F(StateHistoryTest, requires_timestamp_and_capacity)
+{
+  auto layout = std::make_shared<const DataPackage::RecipeLayout>(std::vector<std::string>{ "actual_q" });
+  EXPECT_THROW(StateHistory(layout, 10), UrException);
+  EXPECT_THROW(StateHistory(layout_, 1), UrException);
+}
+
+TEST_F(StateHistoryTest, empty_history_has_no_data)
+{
+  StateHistory history(layout_, 10);
+  EXPECT_EQ(history.size(), 0u);
+  double oldest, newest;
+  EXPECT_FALSE(history.getTimeRange(oldest, newest));
+  int32_t robot_mode;
+  EXPECT_FALSE(history.getData(robot_mode_, 1.0, robot_mode));
+}
+
+TEST_F(StateHistoryTest, get_data_returns_sample_at_or_before_timestamp)
+{
+  StateHistory history(layout_, 10);
+  for (int32_t i = 0; i < 5; ++i)
+  {
+    EXPECT_TRUE(history.add(makeSample(1.0 + 0.002 * i, i)));
+  }
+  EXPECT_EQ(history.size(), 5u);
+
+  double oldest, newest;
+  ASSERT_TRUE(history.getTimeRange(oldest, newest));
+  EXPECT_DOUBLE_EQ(oldest, 1.0);
+  EXPECT_DOUBLE_EQ(newest, 1.008);
+
+  int32_t robot_mode = -1;
+  ASSERT_TRUE(history.getData(robot_mode_, 1.0, robot_mode));
+  EXPECT_EQ(robot_mode, 0);
+  ASSERT_TRUE(history.getData(robot_mode_, 1.0055, robot_mode));
+  EXPECT_EQ(robot_mode, 2);
+  ASSERT_TRUE(history.getData(robot_mode_, 1.008, robot_mode));
+  EXPECT_EQ(robot_mode, 4);
+
+  // Times outside of the history are unknown
+  EXPECT_FALSE(history.getData(robot_mode_, 0.999, robot_mode));
+  EXPECT_FALSE(history.getData(robot_mode_, 1.0081, robot_mode));
+
+  // Packages of other recipes are rejected
+  DataPackage other({ "timestamp" });
+  EXPECT_FALSE(history.add(other));
+
+  // Handles of other layouts are rejected, even if the field is at the same offset
+  auto other_layout = std::make_shared<const DataPackage::RecipeLayout>(
+      std::vector<std::string>{ "timestamp", "actual_q", "robot_mode", "speed_scaling" });
+  EXPECT_FALSE(history.getData(other_layout->getFieldHandle<int32_t>("robot_mode"), 1.0, robot_mode));
+}
+
+TEST_F(StateHistoryTest, get_interpolated_interpolates_linearly)
+{
+  StateHistory history(layout_, 10);
+  history.add(makeSample(1.0));
+  history.add(makeSample(1.002));
+  history.add(makeSample(1.004));
+
+  double speed_scaling;
+  ASSERT_TRUE(history.getInterpolated(speed_scaling_, 1.0015, speed_scaling));
+  EXPECT_NEAR(speed_scaling, 1.0015, 1e-12);
+
+  vector6d_t actual_q;
+  ASSERT_TRUE(history.getInterpolated(actual_q_, 1.0035, actual_q));
+  for (auto& q : actual_q)
+  {
+    EXPECT_NEAR(q, 1.0035, 1e-12);
+  }
+  ASSERT_TRUE(history.getInterpolated(actual_q_, 1.004, actual_q));
+  EXPECT_DOUBLE_EQ(actual_q[0], 1.004);
+  EXPECT_FALSE(history.getInterpolated(actual_q_, 1.005, actual_q));
+
+  auto other_layout = std::make_shared<const DataPackage::RecipeLayout>(
+      std::vector<std::string>{ "timestamp", "actual_q", "robot_mode", "speed_scaling" });
+  EXPECT_FALSE(history.getInterpolated(other_layout->getFieldHandle<double>("speed_scaling"), 1.0015, speed_scaling));
+}
+
+TEST_F(StateHistoryTest, state_at_reconstructs_package)
+{
+  StateHistory history(layout_, 10);
+  history.add(makeSample(1.0, 5));
+  history.add(makeSample(1.002, 7));
+
+  DataPackage state(layout_);
+  ASSERT_TRUE(history.stateAt(1.0005, state));
+
+  double timestamp, speed_scaling;
+  vector6d_t actual_q;
+  int32_t robot_mode;
+  ASSERT_TRUE(state.getData(timestamp_, timestamp));
+  ASSERT_TRUE(state.getData(actual_q_, actual_q));
+  ASSERT_TRUE(state.getData(robot_mode_, robot_mode));
+  ASSERT_TRUE(state.getData(speed_scaling_, speed_scaling));
+  EXPECT_DOUBLE_EQ(timestamp, 1.0005);
+  EXPECT_NEAR(actual_q[3], 1.0005, 1e-12);
+  EXPECT_NEAR(speed_scaling, 1.0005, 1e-12);
+  // Fields that cannot be interpolated keep the value of the sample before
+  EXPECT_EQ(robot_mode, 5);
+
+  DataPackage other({ "timestamp" });
+  EXPECT_FALSE(history.stateAt(1.0005, other));
+}
+
+TEST_F(StateHistoryTest, oldest_samples_get_overwritten)
+{
+  StateHistory history(layout_, 10);
+  for (int32_t i = 0; i < 25; ++i)
+  {
+    history.add(makeSample(i, i));
+  }
+  EXPECT_EQ(history.size(), 10u);
+
+  double oldest, newest;
+  ASSERT_TRUE(history.getTimeRange(oldest, newest));
+  EXPECT_DOUBLE_EQ(oldest, 15.0);
+  EXPECT_DOUBLE_EQ(newest, 24.0);
+
+  int32_t robot_mode;
+  EXPECT_FALSE(history.getData(robot_mode_, 14.5, robot_mode));
+  ASSERT_TRUE(history.getData(robot_mode_, 15.5, robot_mode));
+  EXPECT_EQ(robot_mode, 15);
+}
+
+TEST_F(StateHistoryTest, history_restarts_when_time_goes_backwards)
+{
+  StateHistory history(layout_, 10);
+  for (int32_t i = 0; i < 5; ++i)
+  {
+    history.add(makeSample(100.0 + i));
+  }
+  history.add(makeSample(1.0));
+  history.add(makeSample(2.0));
+  EXPECT_EQ(history.size(), 2u);
+
+  double oldest, newest;
+  ASSERT_TRUE(history.getTimeRange(oldest, newest));
+  EXPECT_DOUBLE_EQ(oldest, 1.0);
+  EXPECT_DOUBLE_EQ(newest, 2.0);
+
+  history.clear();
+  EXPECT_EQ(history.size(), 0u);
+  history.add(makeSample(3.0));
+  EXPECT_EQ(history.size(), 1u);
+}
+
+TEST_F(StateHistoryTest, readers_never_see_torn_samples)
+{
+  StateHistory history(layout_, 16);
+  std::atomic<bool> running(true);
+
+  std::thread writer([&]() {
+    std::vector<DataPackage> samples;
+    for (int32_t i = 0; i < 1000; ++i)
+    {
+      samples.push_back(makeSample(i));
+    }
+    for (size_t round = 0; running; ++round)
+    {
+      if (round % 1000 == 0)
+      {
+        history.clear();
+      }
+      history.add(samples[round % 1000]);
+    }
+  });
+
+  DataPackage state(layout_);
+  size_t num_found = 0;
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (num_found < 10000 && std::chrono::steady_clock::now() < deadline)
+  {
+    double oldest, newest;
+    if (!history.getTimeRange(oldest, newest))
+    {
+      continue;
+    }
+    const double timestamp = (oldest + newest) / 2;
+    if (!history.stateAt(timestamp, state))
+    {
+      continue;
+    }
+    ++num_found;
+    vector6d_t actual_q;
+    double speed_scaling;
+    state.getData(actual_q_, actual_q);
+    state.getData(speed_scaling_, speed_scaling);
+    for (auto& q : actual_q)
+    {
+      ASSERT_NEAR(q, timestamp, 1e-9);
+    }
+    ASSERT_NEAR(speed_scaling, timestamp, 1e-9);
+  }
+  running = false;
+  writer.join();
+  EXPECT_EQ(num_found, 10000u);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}
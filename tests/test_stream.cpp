@@ -31,6 +31,7 @@
 #include <gtest/gtest.h>
 #include <chrono>
 #include <condition_variable>
+#include <thread>
 
 #include <ur_client_library/comm/stream.h>
 #include <ur_client_library/comm/tcp_server.h>
@@ -301,6 +302,101 @@ TEST_F(StreamTest, read_primary_data_package)
   }
 }
 
+TEST_F(StreamTest, read_multiple_packages_received_at_once)
+{
+  // Three RTDE packages with timestamps
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0x9f, 0x55, 0x9b, 0x3d,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xa5, 0xe3, 0x53, 0xf8,
+                              0x00, 0x0c, 0x55, 0x01, 0x40, 0xbb, 0xbf, 0xdb, 0xac, 0x71, 0x0c, 0xb3 };
+
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60003);
+  stream.connect();
+
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  for (size_t i = 0; i < 3; ++i)
+  {
+    uint8_t* package = nullptr;
+    size_t length = 0;
+    ASSERT_TRUE(stream.readPackage(package, length));
+    ASSERT_EQ(length, 12u);
+    for (size_t j = 0; j < length; ++j)
+    {
+      EXPECT_EQ(data_packages[i * 12 + j], package[j]);
+    }
+  }
+
+  // All packages have been handed out, so reading has to wait for new data
+  timeval tv;
+  tv.tv_sec = 0;
+  tv.tv_usec = 100000;
+  stream.setReceiveTimeout(tv);
+  uint8_t* package = nullptr;
+  size_t length = 0;
+  EXPECT_FALSE(stream.readPackage(package, length));
+}
+
+TEST_F(StreamTest, read_package_split_across_messages)
+{
+  // RTDE package with timestamp
+  uint8_t data_package[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xcf, 0x8f, 0xf9, 0xdb, 0x22, 0xd0, 0xe5 };
+
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60003);
+  stream.connect();
+
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  std::thread writer([&]() {
+    size_t written;
+    server_->write(client_fd_, data_package, 1, written);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    server_->write(client_fd_, data_package + 1, 6, written);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    server_->write(client_fd_, data_package + 7, sizeof(data_package) - 7, written);
+  });
+
+  uint8_t buf[4096];
+  size_t read = 0;
+  EXPECT_TRUE(stream.read(buf, sizeof(buf), read));
+  writer.join();
+
+  ASSERT_EQ(sizeof(data_package), read);
+  for (unsigned int i = 0; i < read; ++i)
+  {
+    EXPECT_EQ(data_package[i], buf[i]);
+  }
+}
+
+TEST_F(StreamTest, read_continues_after_discarded_package)
+{
+  // RTDE package with timestamp followed by a text message
+  uint8_t data_packages[] = { 0x00, 0x0c, 0x55, 0x01, 0x40, 0xcf, 0x8f, 0xf9, 0xdb, 0x22, 0xd0, 0xe5,
+                              0x00, 0x05, 0x4d, 0x01, 0x02 };
+
+  comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60003);
+  stream.connect();
+
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  size_t written;
+  server_->write(client_fd_, data_packages, sizeof(data_packages), written);
+
+  // The first package doesn't fit and is skipped
+  uint8_t buf[10];
+  size_t read = 0;
+  EXPECT_FALSE(stream.read(buf, sizeof(buf), read));
+  EXPECT_TRUE(stream.read(buf, sizeof(buf), read));
+  ASSERT_EQ(5u, read);
+  for (unsigned int i = 0; i < read; ++i)
+  {
+    EXPECT_EQ(data_packages[12 + i], buf[i]);
+  }
+}
+
 TEST_F(StreamTest, write_data_package)
 {
   comm::URStream<rtde_interface::RTDEPackage> stream("127.0.0.1", 60003);
@@ -104,8 +104,7 @@ protected:
   bool waitForConnectionCallback(int milliseconds = 100)
   {
     std::unique_lock<std::mutex> lk(connect_mutex_);
-    if (connect_cv_.wait_for(lk, std::chrono::milliseconds(milliseconds)) == std::cv_status::no_timeout ||
-        connection_callback_ == true)
+    if (connect_cv_.wait_for(lk, std::chrono::milliseconds(milliseconds), [&]() { return connection_callback_; }))
     {
       connection_callback_ = false;
       return true;
@@ -119,8 +118,7 @@ protected:
   bool waitForDisconnectionCallback(int milliseconds = 100)
   {
     std::unique_lock<std::mutex> lk(disconnect_mutex_);
-    if (disconnect_cv_.wait_for(lk, std::chrono::milliseconds(milliseconds)) == std::cv_status::no_timeout ||
-        disconnection_callback_ == true)
+    if (disconnect_cv_.wait_for(lk, std::chrono::milliseconds(milliseconds), [&]() { return disconnection_callback_; }))
     {
       disconnection_callback_ = false;
       return true;
@@ -134,8 +132,7 @@ protected:
   bool waitForMessageCallback(int milliseconds = 100)
   {
     std::unique_lock<std::mutex> lk(message_mutex_);
-    if (message_cv_.wait_for(lk, std::chrono::milliseconds(milliseconds)) == std::cv_status::no_timeout ||
-        message_callback_ == true)
+    if (message_cv_.wait_for(lk, std::chrono::milliseconds(milliseconds), [&]() { return message_callback_; }))
     {
       message_callback_ = false;
       return true;
@@ -326,11 +323,63 @@ TEST_F(TCPServerTest, client_connections)
   EXPECT_FALSE(server.write(client2_fd, data, len, written));
   EXPECT_FALSE(server.write(client3_fd, data, len, written));
 }
+TEST_F(TCPServerTest, large_messages_are_received_completely)
+{
+  comm::TCPServer server(port_);
+  std::mutex received_mutex;
+  std::condition_variable received_cv;
+  std::string received;
+  server.setMessageCallback([&](const int filedescriptor, char* buffer, int nbytesrecv) {
+    std::lock_guard<std::mutex> lk(received_mutex);
+    // Received data is terminated, so it can be used as a C string
+    EXPECT_EQ(buffer[nbytesrecv], '\0');
+    received.append(buffer, nbytesrecv);
+    received_cv.notify_one();
+  });
+  server.start();
+
+  Client client(port_);
+  std::string message;
+  for (size_t i = 0; i < 10000; ++i)
+  {
+    message += static_cast<char>('a' + i % 26);
+  }
+  client.send(message);
+
+  std::unique_lock<std::mutex> lk(received_mutex);
+  EXPECT_TRUE(received_cv.wait_for(lk, std::chrono::seconds(1), [&]() { return received.size() >= message.size(); }));
+  EXPECT_EQ(received, message);
+}
+
+TEST_F(TCPServerTest, busy_polling_keeps_connection_usable)
+{
+  comm::TCPServer server(port_);
+  EXPECT_EQ(server.getBusyPollTime(), std::chrono::microseconds(0));
+  server.setBusyPollTime(std::chrono::microseconds(50));
+  EXPECT_EQ(server.getBusyPollTime(), std::chrono::microseconds(50));
+  server.setMessageCallback(std::bind(&TCPServerTest_busy_polling_keeps_connection_usable_Test::messageCallback, this,
+                                      std::placeholders::_1, std::placeholders::_2));
+  server.setConnectCallback(std::bind(&TCPServerTest_busy_polling_keeps_connection_usable_Test::connectionCallback,
+                                      this, std::placeholders::_1));
+  server.start();
+
+  // Busy polling might not be permitted, but the connection has to work either way
+  Client client(port_);
+  EXPECT_TRUE(waitForConnectionCallback());
+  std::string message = "test message\n";
+  client.send(message);
+  EXPECT_TRUE(waitForMessageCallback());
+  EXPECT_EQ(message, message_);
+}
+
 TEST_F(TCPServerTest, check_address_already_in_use)
 {
-  comm::TCPServer blocking_server(12321);
+  // Port 12321 has to stay closed for the tests connecting to a port nobody listens on
+  comm::TCPServer blocking_server(0);
+  EXPECT_NE(blocking_server.getPort(), 0);
 
-  EXPECT_THROW(comm::TCPServer test_server(12321, 2, std::chrono::milliseconds(500)), std::system_error);
+  EXPECT_THROW(comm::TCPServer test_server(blocking_server.getPort(), 2, std::chrono::milliseconds(500)),
+               std::system_error);
 }
 
 int main(int argc, char* argv[])
@@ -300,6 +300,56 @@ TEST_F(TCPSocketTest, read_on_connected_socket)
   EXPECT_EQ(send_message, received_message);
 }
 
+TEST_F(TCPSocketTest, read_available_does_not_wait)
+{
+  client_->setup();
+
+  // Make sure the client has connected to the server, before writing to the client
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  uint8_t buf[64];
+  size_t read = 0;
+  auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(client_->readAvailable(buf, sizeof(buf), read));
+  EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(100));
+  EXPECT_EQ(read, 0u);
+  EXPECT_EQ(client_->getState(), comm::SocketState::Connected);
+
+  std::string send_message = "test message";
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(send_message.c_str());
+  size_t written;
+  server_->write(client_fd_, data, send_message.size(), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  EXPECT_TRUE(client_->readAvailable(buf, sizeof(buf), read));
+  EXPECT_EQ(send_message, std::string(reinterpret_cast<char*>(buf), read));
+}
+
+TEST_F(TCPSocketTest, receive_timestamps)
+{
+  client_->setReceiveTimestamping(true);
+  EXPECT_TRUE(client_->getReceiveTimestamping());
+  client_->setup();
+  EXPECT_TRUE(waitForConnectionCallback());
+
+  const auto before = std::chrono::system_clock::now();
+  std::string send_message = "test message";
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(send_message.c_str());
+  size_t written;
+  server_->write(client_fd_, data, send_message.size(), written);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  uint8_t buf[64];
+  size_t read = 0;
+  ASSERT_TRUE(client_->read(buf, sizeof(buf), read));
+  EXPECT_EQ(send_message, std::string(reinterpret_cast<char*>(buf), read));
+
+  // The data arrived before it was read
+  const auto kernel_received = client_->getLastKernelReceiveTime();
+  EXPECT_GE(kernel_received, before - std::chrono::milliseconds(1));
+  EXPECT_LE(kernel_received, std::chrono::system_clock::now() - std::chrono::milliseconds(40));
+}
+
 TEST_F(TCPSocketTest, get_socket_fd)
 {
   // When the client is not connected to any socket the fd should be -1
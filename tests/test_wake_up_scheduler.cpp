@@ -0,0 +1,220 @@
+// -- BEGIN LICENSE BLOCK ----------------------------------------------
+// Copyright 2024 Universal Robots A/S
+//
+// Redistribution and use in source and binary forms, with or without
+// modification, are permitted provided that the following conditions are met:
+//
+//    * Redistributions of source code must retain the above copyright
+//      notice, this list of conditions and the following disclaimer.
+//
+//    * Redistributions in binary form must reproduce the above copyright
+//      notice, this list of conditions and the following disclaimer in the
+//      documentation and/or other materials provided with the distribution.
+//
+//    * Neither the name of the {copyright_holder} nor the names of its
+//      contributors may be used to endorse or promote products derived from
+//      this software without specific prior written permission.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+// LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+// CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+// SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+// INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+// CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+// ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+// POSSIBILITY OF SUCH DAMAGE.
+// -- END LICENSE BLOCK ------------------------------------------------
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <ur_client_library/comm/wake_up_scheduler.h>
+
+using namespace urcl;
+using namespace std::chrono_literals;
+
+namespace
+{
+const std::chrono::steady_clock::time_point START = std::chrono::steady_clock::time_point(1000s);
+
+// Runs the scheduler on a simulated clock, which only advances when sleeping or when the test
+// advances it
+class SimulatedClockScheduler : public comm::WakeUpScheduler
+{
+public:
+  using comm::WakeUpScheduler::WakeUpScheduler;
+
+  mutable std::chrono::steady_clock::time_point time = START;
+
+protected:
+  std::chrono::steady_clock::time_point now() const override
+  {
+    return time;
+  }
+
+  void sleep(const std::chrono::steady_clock::time_point time_point) const override
+  {
+    time = std::max(time, time_point);
+  }
+};
+}  // namespace
+
+TEST(wake_up_scheduler, no_prediction_without_arrivals)
+{
+  comm::WakeUpScheduler scheduler;
+  EXPECT_FALSE(scheduler.hasPrediction());
+  EXPECT_EQ(scheduler.getNextArrival(), std::chrono::steady_clock::time_point());
+  EXPECT_FALSE(scheduler.waitForNextArrival([]() { return true; }));
+
+  // The period is learned from the first two arrivals
+  scheduler.addArrival(START);
+  EXPECT_FALSE(scheduler.hasPrediction());
+  scheduler.addArrival(START + 2ms);
+  EXPECT_TRUE(scheduler.hasPrediction());
+  EXPECT_EQ(scheduler.getPeriod(), 2ms);
+  EXPECT_EQ(scheduler.getNextArrival(), START + 4ms);
+}
+
+TEST(wake_up_scheduler, nominal_period_allows_prediction_after_first_arrival)
+{
+  comm::WakeUpScheduler scheduler;
+  scheduler.reset(8ms);
+  EXPECT_FALSE(scheduler.hasPrediction());
+  scheduler.addArrival(START);
+  EXPECT_TRUE(scheduler.hasPrediction());
+  EXPECT_EQ(scheduler.getNextArrival(), START + 8ms);
+}
+
+TEST(wake_up_scheduler, learns_period_and_phase)
+{
+  comm::WakeUpScheduler scheduler;
+  // The nominal period is slightly off and the arrivals are delayed by varying amounts.
+  scheduler.reset(2010us);
+  std::mt19937 generator(42);
+  std::uniform_int_distribution<int> delay(0, 40);
+  const std::chrono::steady_clock::time_point phase = START + 300us;
+  std::chrono::steady_clock::time_point last_arrival;
+  for (int i = 0; i < 2000; ++i)
+  {
+    last_arrival = phase + i * 2ms + std::chrono::microseconds(delay(generator));
+    scheduler.addArrival(last_arrival);
+  }
+
+  EXPECT_NEAR(scheduler.getPeriod().count(), std::chrono::nanoseconds(2ms).count(), 1000);
+  EXPECT_LT(scheduler.getJitter(), 20us);
+  // The prediction lies within the spread of the delays
+  const std::chrono::steady_clock::time_point next_arrival = phase + 2000 * 2ms;
+  EXPECT_GE(scheduler.getNextArrival(), next_arrival - 5us);
+  EXPECT_LE(scheduler.getNextArrival(), next_arrival + 45us);
+}
+
+TEST(wake_up_scheduler, missing_and_repeated_arrivals_keep_the_phase)
+{
+  comm::WakeUpScheduler scheduler;
+  scheduler.reset(2ms);
+  for (int i = 0; i < 100; ++i)
+  {
+    // Every tenth package is missing, every fifth one was received together with another one.
+    if (i % 10 == 9)
+    {
+      continue;
+    }
+    scheduler.addArrival(START + i * 2ms);
+    if (i % 5 == 0)
+    {
+      scheduler.addArrival(START + i * 2ms + 10us);
+    }
+  }
+
+  EXPECT_NEAR(scheduler.getPeriod().count(), std::chrono::nanoseconds(2ms).count(), 1000);
+  // The last package was missing, so the prediction follows the second to last one.
+  const auto deviation = scheduler.getNextArrival() - (START + 99 * 2ms);
+  EXPECT_LT(std::chrono::abs(deviation), 5us);
+}
+
+TEST(wake_up_scheduler, sleep_until_waits_for_absolute_time)
+{
+  const std::chrono::steady_clock::time_point wake_up = std::chrono::steady_clock::now() + 5ms;
+  comm::WakeUpScheduler::sleepUntil(wake_up);
+  EXPECT_GE(std::chrono::steady_clock::now(), wake_up);
+
+  // Points in time in the past return immediately
+  const std::chrono::steady_clock::time_point before = std::chrono::steady_clock::now();
+  comm::WakeUpScheduler::sleepUntil(before - 1s);
+  EXPECT_LT(std::chrono::steady_clock::now() - before, 1ms);
+}
+
+TEST(wake_up_scheduler, wait_for_next_arrival_polls_around_prediction)
+{
+  SimulatedClockScheduler scheduler(100us);
+  scheduler.reset(10ms);
+  scheduler.addArrival(START);
+  const std::chrono::steady_clock::time_point next_arrival = START + 10ms;
+  ASSERT_EQ(scheduler.getNextArrival(), next_arrival);
+
+  // Each poll takes 10us. Polling starts the spin duration before the predicted arrival.
+  std::vector<std::chrono::steady_clock::time_point> polls;
+  EXPECT_TRUE(scheduler.waitForNextArrival([&]() {
+    polls.push_back(scheduler.time);
+    scheduler.time += 10us;
+    return polls.back() >= next_arrival;
+  }));
+  ASSERT_EQ(polls.size(), 11u);
+  EXPECT_EQ(polls.front(), next_arrival - 100us);
+  EXPECT_EQ(polls.back(), next_arrival);
+
+  // A package that doesn't arrive is given up on the spin duration after the predicted arrival
+  scheduler.addArrival(next_arrival);
+  polls.clear();
+  EXPECT_FALSE(scheduler.waitForNextArrival([&]() {
+    polls.push_back(scheduler.time);
+    scheduler.time += 10us;
+    return false;
+  }));
+  ASSERT_EQ(polls.size(), 20u);
+  EXPECT_EQ(polls.front(), next_arrival + 10ms - 100us);
+  EXPECT_EQ(scheduler.time, next_arrival + 10ms + 100us);
+}
+
+TEST(wake_up_scheduler, wait_window_grows_with_jitter)
+{
+  SimulatedClockScheduler scheduler(100us);
+  scheduler.reset(10ms);
+  // Arrivals alternate between 20us early and 20us late
+  for (int i = 0; i < 200; ++i)
+  {
+    scheduler.addArrival(START + i * 10ms + (i % 2 == 0 ? -20us : 20us));
+  }
+  const std::chrono::nanoseconds jitter = scheduler.getJitter();
+  EXPECT_GT(jitter, 10us);
+  EXPECT_LT(jitter, 40us);
+
+  // Polling starts the spin duration and three times the jitter before the predicted arrival
+  scheduler.time = scheduler.getNextArrival() - 5ms;
+  const std::chrono::steady_clock::time_point next_arrival = scheduler.getNextArrival();
+  std::chrono::steady_clock::time_point first_poll;
+  EXPECT_FALSE(scheduler.waitForNextArrival([&]() {
+    if (first_poll == std::chrono::steady_clock::time_point())
+    {
+      first_poll = scheduler.time;
+    }
+    scheduler.time += 1us;
+    return false;
+  }));
+  // The jitter is reported in whole nanoseconds
+  EXPECT_LE(std::chrono::abs(first_poll - (next_arrival - 100us - 3 * jitter)), 3ns);
+  EXPECT_LE(std::chrono::abs(scheduler.time - (next_arrival + 100us + 3 * jitter)), 1us);
+}
+
+int main(int argc, char* argv[])
+{
+  ::testing::InitGoogleTest(&argc, argv);
+
+  return RUN_ALL_TESTS();
+}